@@ -0,0 +1,195 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    AsynchronousCoProcessing.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the asynchronous mode of vtkCPProcessor with the different
+// back-pressure policies.
+
+#include "vtkCPDataDescription.h"
+#include "vtkCPInputDataDescription.h"
+#include "vtkCPPipeline.h"
+#include "vtkCPProcessor.h"
+#include "vtkDataObject.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+class SlowPipeline : public vtkCPPipeline
+{
+public:
+  static SlowPipeline* New();
+  vtkTypeMacro(SlowPipeline, vtkCPPipeline);
+
+  int RequestDataDescription(vtkCPDataDescription* dataDescription) override
+  {
+    dataDescription->GetInputDescriptionByName("input")->AllFieldsOn();
+    dataDescription->GetInputDescriptionByName("input")->GenerateMeshOn();
+    return 1;
+  }
+
+  int CoProcess(vtkCPDataDescription* dataDescription) override
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // the simulation overwrites "values" right after CoProcess returns, the
+    // snapshot must still hold the values of this step.
+    vtkDataObject* grid = dataDescription->GetInputDescriptionByName("input")->GetGrid();
+    vtkIntArray* values = vtkIntArray::SafeDownCast(
+      vtkImageData::SafeDownCast(grid)->GetPointData()->GetArray("values"));
+    const int step = static_cast<int>(dataDescription->GetTimeStep());
+    for (vtkIdType cc = 0; cc < values->GetNumberOfValues(); ++cc)
+    {
+      if (values->GetValue(cc) != step)
+      {
+        this->Corrupted = true;
+        break;
+      }
+    }
+    this->ProcessedSteps.push_back(step);
+    return 1;
+  }
+
+  std::vector<int> ProcessedSteps;
+  bool Corrupted = false;
+
+protected:
+  SlowPipeline() = default;
+  ~SlowPipeline() override = default;
+
+private:
+  SlowPipeline(const SlowPipeline&) = delete;
+  void operator=(const SlowPipeline&) = delete;
+};
+vtkStandardNewMacro(SlowPipeline);
+
+class StepObserver
+{
+public:
+  void OnStepCompleted(vtkObject*, unsigned long, void* callData)
+  {
+    const auto* timing = static_cast<const vtkCPProcessor::StepTiming*>(callData);
+    this->Count += (timing->Status == 1 && timing->ProcessTime > 0.0) ? 1 : 0;
+  }
+  int Count = 0;
+};
+
+bool RunSimulation(vtkCPProcessor* processor, int policy, int numberOfSteps)
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(10, 10, 10);
+  vtkNew<vtkIntArray> values;
+  values->SetName("values");
+  values->SetNumberOfTuples(image->GetNumberOfPoints());
+  image->GetPointData()->AddArray(values);
+
+  vtkNew<vtkCPDataDescription> dataDescription;
+  dataDescription->AddInput("input");
+  dataDescription->GetInputDescriptionByName("input")->AddMutableField(
+    "values", vtkDataObject::POINT);
+
+  vtkNew<SlowPipeline> pipeline;
+  processor->AddPipeline(pipeline);
+  processor->SetAsynchronous(true);
+  processor->SetBackPressurePolicy(policy);
+  StepObserver observer;
+  unsigned long observerId = processor->AddObserver(
+    vtkCPProcessor::StepCompletedEvent, &observer, &StepObserver::OnStepCompleted);
+  const vtkIdType dropped = processor->GetNumberOfDroppedSteps();
+  const vtkIdType coalesced = processor->GetNumberOfCoalescedSteps();
+
+  for (int step = 0; step < numberOfSteps; ++step)
+  {
+    values->FillValue(step);
+    dataDescription->SetTimeData(step, step);
+    if (processor->RequestDataDescription(dataDescription))
+    {
+      dataDescription->GetInputDescriptionByName("input")->SetGrid(image);
+      processor->CoProcess(dataDescription);
+    }
+    // the simulation moves on and modifies its arrays in place.
+    values->FillValue(-1);
+  }
+  processor->WaitForCoProcessing();
+  processor->RemoveObserver(observerId);
+  processor->RemoveAllPipelines();
+
+  const int processed = static_cast<int>(pipeline->ProcessedSteps.size());
+  bool success = !pipeline->Corrupted;
+  if (pipeline->Corrupted)
+  {
+    cerr << "ERROR: pipeline saw values modified after CoProcess." << endl;
+  }
+  for (int cc = 1; cc < processed; ++cc)
+  {
+    if (pipeline->ProcessedSteps[cc] <= pipeline->ProcessedSteps[cc - 1])
+    {
+      cerr << "ERROR: steps processed out of order." << endl;
+      success = false;
+    }
+  }
+  if (observer.Count != processed)
+  {
+    cerr << "ERROR: " << observer.Count << " StepCompletedEvent for " << processed << " steps."
+         << endl;
+    success = false;
+  }
+
+  int expected = numberOfSteps;
+  switch (policy)
+  {
+    case vtkCPProcessor::DROP:
+      expected -= static_cast<int>(processor->GetNumberOfDroppedSteps() - dropped);
+      break;
+    case vtkCPProcessor::COALESCE:
+      expected -= static_cast<int>(processor->GetNumberOfCoalescedSteps() - coalesced);
+      break;
+    default:
+      break;
+  }
+  if (processed != expected || processed == 0)
+  {
+    cerr << "ERROR: policy " << policy << " processed " << processed << " steps, expected "
+         << expected << "." << endl;
+    success = false;
+  }
+  if (processed > 0 && pipeline->ProcessedSteps.back() != numberOfSteps - 1 &&
+    policy != vtkCPProcessor::DROP)
+  {
+    cerr << "ERROR: the last step was not processed." << endl;
+    success = false;
+  }
+  return success;
+}
+}
+
+int AsynchronousCoProcessing(int, char* [])
+{
+  vtkNew<vtkCPProcessor> processor;
+  processor->Initialize();
+
+  bool success = true;
+  success &= RunSimulation(processor, vtkCPProcessor::BLOCK, 10);
+  success &= RunSimulation(processor, vtkCPProcessor::DROP, 10);
+  success &= RunSimulation(processor, vtkCPProcessor::COALESCE, 10);
+
+  processor->Finalize();
+  return success ? 0 : 1;
+}
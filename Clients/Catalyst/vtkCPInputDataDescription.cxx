@@ -31,6 +31,7 @@ class vtkCPInputDataDescription::vtkInternals
 public:
   typedef std::vector<std::string> FieldType;
   std::map<int, FieldType> Fields;
+  std::map<int, FieldType> MutableFields;
 };
 
 vtkStandardNewMacro(vtkCPInputDataDescription);
@@ -41,6 +42,7 @@ vtkCPInputDataDescription::vtkCPInputDataDescription()
   this->Grid = NULL;
   this->GenerateMesh = false;
   this->AllFields = false;
+  this->MutableMesh = false;
   this->Internals = new vtkCPInputDataDescription::vtkInternals();
   this->WholeExtent[0] = this->WholeExtent[2] = this->WholeExtent[4] = 0;
   this->WholeExtent[1] = this->WholeExtent[3] = this->WholeExtent[5] = -1;
@@ -75,6 +77,34 @@ void vtkCPInputDataDescription::AddField(const char* fieldName, int type)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkCPInputDataDescription::AddMutableField(const char* fieldName, int type)
+{
+  vtkInternals::FieldType& fields = this->Internals->MutableFields[type];
+  if (fieldName && std::find(fields.begin(), fields.end(), fieldName) == fields.end())
+  {
+    fields.push_back(fieldName);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkCPInputDataDescription::ClearMutableFields()
+{
+  this->Internals->MutableFields.clear();
+}
+
+//----------------------------------------------------------------------------
+bool vtkCPInputDataDescription::IsFieldMutable(const char* fieldName, int type)
+{
+  if (this->MutableMesh)
+  {
+    return true;
+  }
+  auto iter = this->Internals->MutableFields.find(type);
+  return fieldName && iter != this->Internals->MutableFields.end() &&
+    std::find(iter->second.begin(), iter->second.end(), fieldName) != iter->second.end();
+}
+
 //----------------------------------------------------------------------------
 unsigned int vtkCPInputDataDescription::GetNumberOfFields()
 {
@@ -170,9 +200,11 @@ void vtkCPInputDataDescription::ShallowCopy(vtkCPInputDataDescription* idd)
   }
   this->AllFields = idd->AllFields;
   this->GenerateMesh = idd->GenerateMesh;
+  this->MutableMesh = idd->MutableMesh;
   this->SetGrid(idd->Grid);
   memcpy(this->WholeExtent, idd->WholeExtent, 6 * sizeof(int));
   this->Internals->Fields = idd->Internals->Fields;
+  this->Internals->MutableFields = idd->Internals->MutableFields;
 }
 
 //----------------------------------------------------------------------------
@@ -181,6 +213,7 @@ void vtkCPInputDataDescription::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "AllFields: " << this->AllFields << "\n";
   os << indent << "GenerateMesh: " << this->GenerateMesh << "\n";
+  os << indent << "MutableMesh: " << this->MutableMesh << "\n";
   if (this->Grid)
   {
     os << indent << "Grid: " << this->Grid << "\n";
@@ -93,6 +93,25 @@ public:
   vtkSetVector6Macro(WholeExtent, int);
   vtkGetVector6Macro(WholeExtent, int);
 
+  // Description:
+  // Mark an array with name *fieldName* of type *type* (from
+  // vtkDataObject::AttributeTypes) as mutable, i.e. the simulation will
+  // modify its values in place after vtkCPProcessor::CoProcess() returns.
+  // In asynchronous mode, vtkCPProcessor deep-copies mutable arrays when
+  // taking its snapshot of the grid and shares all other arrays. Unlike the
+  // requested fields, mutable fields are not cleared by Reset().
+  void AddMutableField(const char* fieldName, int type);
+  void ClearMutableFields();
+  bool IsFieldMutable(const char* fieldName, int type);
+
+  // Description:
+  // When set, the whole grid (points, topology and all arrays) is deep-copied
+  // when vtkCPProcessor takes its snapshot in asynchronous mode. Use this when
+  // the simulation modifies the mesh in place. Off by default.
+  vtkSetMacro(MutableMesh, bool);
+  vtkGetMacro(MutableMesh, bool);
+  vtkBooleanMacro(MutableMesh, bool);
+
   // Description:
   // Shallow copy.
   void ShallowCopy(vtkCPInputDataDescription*);
@@ -109,6 +128,10 @@ protected:
   // On when the mesh should be generated.
   bool GenerateMesh;
 
+  // Description:
+  // On when the mesh is modified in place by the simulation.
+  bool MutableMesh;
+
   // Description:
   // The grid for coprocessing. The grid is not owned by the object.
   vtkDataObject* Grid;
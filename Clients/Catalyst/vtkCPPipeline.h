@@ -48,6 +48,11 @@ public:
   /// is given. Returns 1 for success and 0 for failure.
   virtual int Finalize();
 
+  /// Returns true if the pipeline can be executed on the analysis thread of
+  /// vtkCPProcessor's asynchronous mode. Pipelines that must run on the
+  /// simulation thread return false. The default implementation returns true.
+  virtual bool SupportsAsynchronousCoProcessing() { return true; }
+
 protected:
   vtkCPPipeline();
   virtual ~vtkCPPipeline();
@@ -16,10 +16,14 @@
 
 #include "vtkPVConfig.h" // need ParaView defines before MPI stuff
 
+#include "vtkAbstractArray.h"
 #include "vtkCPCxxHelper.h"
 #include "vtkCPDataDescription.h"
 #include "vtkCPInputDataDescription.h"
 #include "vtkCPPipeline.h"
+#include "vtkCommunicator.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataObject.h"
 #include "vtkDoubleArray.h"
 #include "vtkFieldData.h"
@@ -39,14 +43,220 @@
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 
+#include <chrono>
+#include <condition_variable>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
+namespace
+{
+double Now()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+// Snapshot of a leaf dataset: arrays are shared, except the mutable ones.
+vtkSmartPointer<vtkDataObject> SnapshotLeaf(vtkDataObject* input, vtkCPInputDataDescription* idd)
+{
+  vtkSmartPointer<vtkDataObject> snapshot;
+  snapshot.TakeReference(input->NewInstance());
+  if (idd->GetMutableMesh())
+  {
+    snapshot->DeepCopy(input);
+    return snapshot;
+  }
+  snapshot->ShallowCopy(input);
+  for (int type = 0; type < vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES; ++type)
+  {
+    vtkFieldData* fd =
+      type != vtkDataObject::POINT_THEN_CELL ? snapshot->GetAttributesAsFieldData(type) : nullptr;
+    for (int cc = 0, max = fd ? fd->GetNumberOfArrays() : 0; cc < max; ++cc)
+    {
+      vtkAbstractArray* array = fd->GetAbstractArray(cc);
+      if (array && idd->IsFieldMutable(array->GetName(), type))
+      {
+        vtkSmartPointer<vtkAbstractArray> copy;
+        copy.TakeReference(array->NewInstance());
+        copy->DeepCopy(array);
+        // AddArray replaces the array with the same name, keeping attributes.
+        fd->AddArray(copy);
+      }
+    }
+  }
+  return snapshot;
+}
+
+vtkSmartPointer<vtkDataObject> Snapshot(vtkDataObject* input, vtkCPInputDataDescription* idd)
+{
+  vtkCompositeDataSet* cd = vtkCompositeDataSet::SafeDownCast(input);
+  if (!cd)
+  {
+    return SnapshotLeaf(input, idd);
+  }
+  vtkSmartPointer<vtkCompositeDataSet> snapshot;
+  snapshot.TakeReference(cd->NewInstance());
+  snapshot->CopyStructure(cd);
+  snapshot->GetFieldData()->ShallowCopy(cd->GetFieldData());
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(cd->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    snapshot->SetDataSet(iter, SnapshotLeaf(iter->GetCurrentDataObject(), idd));
+  }
+  return snapshot;
+}
+}
+
 struct vtkCPProcessorInternals
 {
   typedef std::list<vtkSmartPointer<vtkCPPipeline> > PipelineList;
   typedef PipelineList::iterator PipelineListIterator;
   PipelineList Pipelines;
+
+  // Asynchronous mode state.
+  enum Decisions
+  {
+    NO_DECISION,
+    PROCESS,
+    COALESCE
+  };
+
+  struct Job
+  {
+    vtkSmartPointer<vtkCPDataDescription> DataDescription;
+    vtkCPProcessor::StepTiming Timing;
+  };
+
+  // Used to make back-pressure decisions consistently across ranks, separate
+  // from the global controller used by the pipelines on the analysis thread.
+  vtkSmartPointer<vtkMultiProcessController> DecisionController;
+  bool DecisionControllerInitialized = false;
+  int Decision = NO_DECISION;
+  double BlockedTime = 0.0;
+
+  // Only accessed from the simulation thread.
+  std::unique_ptr<Job> Pending;
+  // 0 if a step failed since the last WaitForCoProcessing.
+  int CompletedStatus = 1;
+  vtkCPProcessor::StepTiming LastStepTiming = { 0, 0.0, 0.0, 0.0, 0.0, 1 };
+
+  // Shared with the analysis thread, protected by Mutex.
+  std::thread Worker;
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::unique_ptr<Job> Running;
+  std::vector<vtkCPProcessor::StepTiming> Completed;
+  bool Stop = false;
+
+  bool IsRunning()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->Running != nullptr;
+  }
+
+  // Waits for the running job, returns the time spent waiting.
+  double WaitForRunning()
+  {
+    const double start = Now();
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Condition.wait(lock, [this]() { return this->Running == nullptr; });
+    return Now() - start;
+  }
+
+  void Dispatch(vtkCPProcessor* self, std::unique_ptr<Job> job)
+  {
+    if (!this->Worker.joinable())
+    {
+      this->Worker = std::thread([this, self]() { this->Run(self); });
+    }
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Running = std::move(job);
+    this->Condition.notify_all();
+  }
+
+  void Run(vtkCPProcessor* self)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->Condition.wait(lock, [this]() { return this->Stop || this->Running != nullptr; });
+      if (this->Running == nullptr)
+      {
+        return;
+      }
+      Job* job = this->Running.get();
+      lock.unlock();
+      const double start = Now();
+      job->Timing.Status = self->ProcessPipelines(job->DataDescription);
+      job->Timing.ProcessTime = Now() - start;
+      lock.lock();
+      this->Completed.push_back(job->Timing);
+      this->Running.reset();
+      this->Condition.notify_all();
+    }
+  }
+
+  void StopWorker()
+  {
+    if (this->Worker.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->Stop = true;
+        this->Condition.notify_all();
+      }
+      this->Worker.join();
+      this->Stop = false;
+    }
+  }
+
+  // Sets up the decision controller. Returns false if the asynchronous mode
+  // cannot be used safely. Collective.
+  bool InitializeDecisionController()
+  {
+    if (this->DecisionControllerInitialized)
+    {
+      return true;
+    }
+    vtkMultiProcessController* global = vtkMultiProcessController::GetGlobalController();
+    if (global && global->GetNumberOfProcesses() > 1)
+    {
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+      int provided = MPI_THREAD_SINGLE;
+      MPI_Query_thread(&provided);
+      if (provided < MPI_THREAD_MULTIPLE)
+      {
+        return false;
+      }
+#endif
+      this->DecisionController.TakeReference(
+        global->PartitionController(0, global->GetLocalProcessId()));
+      if (!this->DecisionController)
+      {
+        return false;
+      }
+    }
+    this->DecisionControllerInitialized = true;
+    return true;
+  }
+
+  // Returns true if any rank is processing a step.
+  bool IsAnyRankRunning()
+  {
+    int running = this->IsRunning() ? 1 : 0;
+    if (this->DecisionController)
+    {
+      int anyRunning = 0;
+      this->DecisionController->AllReduce(&running, &anyRunning, 1, vtkCommunicator::MAX_OP);
+      running = anyRunning;
+    }
+    return running != 0;
+  }
 };
 
 vtkStandardNewMacro(vtkCPProcessor);
@@ -57,6 +267,10 @@ vtkCPProcessor::vtkCPProcessor()
   this->Internal = new vtkCPProcessorInternals;
   this->InitializationHelper = nullptr;
   this->WorkingDirectory = nullptr;
+  this->Asynchronous = false;
+  this->BackPressurePolicy = BLOCK;
+  this->NumberOfDroppedSteps = 0;
+  this->NumberOfCoalescedSteps = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -64,6 +278,7 @@ vtkCPProcessor::~vtkCPProcessor()
 {
   if (this->Internal)
   {
+    this->Internal->StopWorker();
     delete this->Internal;
     this->Internal = nullptr;
   }
@@ -85,6 +300,12 @@ int vtkCPProcessor::AddPipeline(vtkCPPipeline* pipeline)
     return 0;
   }
 
+  if (this->Asynchronous && !pipeline->SupportsAsynchronousCoProcessing())
+  {
+    vtkErrorMacro(<< pipeline->GetClassName() << " does not support asynchronous co-processing. "
+                  << "Falling back to synchronous co-processing.");
+    this->SetAsynchronous(false);
+  }
   this->Internal->Pipelines.push_back(pipeline);
   return 1;
 }
@@ -214,6 +435,55 @@ int vtkCPProcessor::RequestDataDescription(vtkCPDataDescription* dataDescription
   }
 
   dataDescription->ResetInputDescriptions();
+  if (this->Asynchronous)
+  {
+    vtkCPProcessorInternals* internal = this->Internal;
+    if (!internal->InitializeDecisionController())
+    {
+      vtkWarningMacro("Asynchronous co-processing requires MPI_THREAD_MULTIPLE support when "
+                      "running in parallel. Falling back to synchronous co-processing.");
+      this->Asynchronous = false;
+    }
+    else
+    {
+      bool running = internal->IsAnyRankRunning();
+      if (!running && internal->Pending)
+      {
+        // process the step coalesced while the previous one was running.
+        internal->Dispatch(this, std::move(internal->Pending));
+        running = true;
+      }
+      this->ReportCompletedSteps();
+      internal->Decision = vtkCPProcessorInternals::PROCESS;
+      internal->BlockedTime = 0.0;
+      if (running)
+      {
+        switch (this->BackPressurePolicy)
+        {
+          case DROP:
+            ++this->NumberOfDroppedSteps;
+            internal->Decision = vtkCPProcessorInternals::NO_DECISION;
+            return 0;
+
+          case COALESCE:
+            // pipelines will be queried when the step is processed.
+            for (unsigned int i = 0; i < dataDescription->GetNumberOfInputDescriptions(); i++)
+            {
+              dataDescription->GetInputDescription(i)->GenerateMeshOn();
+              dataDescription->GetInputDescription(i)->AllFieldsOn();
+            }
+            internal->Decision = vtkCPProcessorInternals::COALESCE;
+            return 1;
+
+          default:
+            internal->BlockedTime = internal->WaitForRunning();
+            this->ReportCompletedSteps();
+            break;
+        }
+      }
+    }
+  }
+
   int doCoProcessing = 0;
   for (vtkCPProcessorInternals::PipelineListIterator iter = this->Internal->Pipelines.begin();
        iter != this->Internal->Pipelines.end(); iter++)
@@ -259,6 +529,83 @@ int vtkCPProcessor::CoProcess(vtkCPDataDescription* dataDescription)
     }
   }
 
+  if (!this->Asynchronous)
+  {
+    const double start = Now();
+    vtkCPProcessor::StepTiming timing = { dataDescription->GetTimeStep(),
+      dataDescription->GetTime(), 0.0, 0.0, 0.0, 0 };
+    success = this->ProcessPipelines(dataDescription);
+    timing.ProcessTime = Now() - start;
+    timing.Status = success;
+    this->Internal->LastStepTiming = timing;
+    this->InvokeEvent(StepCompletedEvent, &this->Internal->LastStepTiming);
+
+    // we want to reset everything here to make sure that new information
+    // is properly passed in the next time.
+    dataDescription->ResetAll();
+    return success;
+  }
+
+  // Asynchronous mode: hand a snapshot of the inputs to the analysis thread.
+  vtkCPProcessorInternals* internal = this->Internal;
+  if (internal->Decision == vtkCPProcessorInternals::NO_DECISION)
+  {
+    // RequestDataDescription was not called for this step.
+    const double waitStart = Now();
+    this->WaitForCoProcessing();
+    internal->BlockedTime = Now() - waitStart;
+    internal->Decision = vtkCPProcessorInternals::PROCESS;
+  }
+
+  const double start = Now();
+  std::unique_ptr<vtkCPProcessorInternals::Job> job(new vtkCPProcessorInternals::Job);
+  job->DataDescription = vtkSmartPointer<vtkCPDataDescription>::New();
+  job->DataDescription->Copy(dataDescription);
+  if (vtkFieldData* userData = dataDescription->GetUserData())
+  {
+    vtkNew<vtkFieldData> userDataCopy;
+    userDataCopy->DeepCopy(userData);
+    job->DataDescription->SetUserData(userDataCopy);
+  }
+  for (unsigned int i = 0; i < dataDescription->GetNumberOfInputDescriptions(); i++)
+  {
+    vtkCPInputDataDescription* idd = job->DataDescription->GetInputDescription(i);
+    if (vtkDataObject* input = idd->GetGrid())
+    {
+      idd->SetGrid(Snapshot(input, idd));
+    }
+  }
+  job->Timing.TimeStep = dataDescription->GetTimeStep();
+  job->Timing.Time = dataDescription->GetTime();
+  job->Timing.SnapshotTime = Now() - start;
+  job->Timing.WaitTime = internal->BlockedTime;
+  job->Timing.ProcessTime = 0.0;
+  job->Timing.Status = 0;
+
+  if (internal->Decision == vtkCPProcessorInternals::COALESCE)
+  {
+    if (internal->Pending)
+    {
+      ++this->NumberOfCoalescedSteps;
+    }
+    internal->Pending = std::move(job);
+  }
+  else
+  {
+    internal->Dispatch(this, std::move(job));
+  }
+  internal->Decision = vtkCPProcessorInternals::NO_DECISION;
+
+  // we want to reset everything here to make sure that new information
+  // is properly passed in the next time.
+  dataDescription->ResetAll();
+  return success;
+}
+
+//----------------------------------------------------------------------------
+int vtkCPProcessor::ProcessPipelines(vtkCPDataDescription* dataDescription)
+{
+  int success = 1;
   std::string originalWorkingDirectory;
   if (this->WorkingDirectory)
   {
@@ -317,15 +664,84 @@ int vtkCPProcessor::CoProcess(vtkCPDataDescription* dataDescription)
   {
     vtksys::SystemTools::ChangeDirectory(originalWorkingDirectory);
   }
-  // we want to reset everything here to make sure that new information
-  // is properly passed in the next time.
-  dataDescription->ResetAll();
   return success;
 }
 
+//----------------------------------------------------------------------------
+void vtkCPProcessor::SetAsynchronous(bool asynchronous)
+{
+  if (this->Asynchronous == asynchronous)
+  {
+    return;
+  }
+  if (asynchronous)
+  {
+    for (const auto& pipeline : this->Internal->Pipelines)
+    {
+      if (!pipeline->SupportsAsynchronousCoProcessing())
+      {
+        vtkErrorMacro("Cannot enable asynchronous co-processing: "
+          << pipeline->GetClassName() << " does not support it.");
+        return;
+      }
+    }
+  }
+  else
+  {
+    this->WaitForCoProcessing();
+  }
+  this->Asynchronous = asynchronous;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkCPProcessor::WaitForCoProcessing()
+{
+  vtkCPProcessorInternals* internal = this->Internal;
+  const double waitTime = internal->WaitForRunning();
+  if (internal->Pending)
+  {
+    internal->Pending->Timing.WaitTime += waitTime;
+    internal->Dispatch(this, std::move(internal->Pending));
+    internal->WaitForRunning();
+  }
+  this->ReportCompletedSteps();
+  const int status = internal->CompletedStatus;
+  internal->CompletedStatus = 1;
+  return status;
+}
+
+//----------------------------------------------------------------------------
+void vtkCPProcessor::ReportCompletedSteps()
+{
+  vtkCPProcessorInternals* internal = this->Internal;
+  std::vector<vtkCPProcessor::StepTiming> completed;
+  {
+    std::lock_guard<std::mutex> lock(internal->Mutex);
+    completed.swap(internal->Completed);
+  }
+  for (const auto& timing : completed)
+  {
+    internal->CompletedStatus = internal->CompletedStatus && timing.Status;
+    internal->LastStepTiming = timing;
+    this->InvokeEvent(StepCompletedEvent, &internal->LastStepTiming);
+  }
+}
+
+//----------------------------------------------------------------------------
+const vtkCPProcessor::StepTiming& vtkCPProcessor::GetLastStepTiming() const
+{
+  return this->Internal->LastStepTiming;
+}
+
 //----------------------------------------------------------------------------
 int vtkCPProcessor::Finalize()
 {
+  this->WaitForCoProcessing();
+  this->Internal->StopWorker();
+  this->Internal->DecisionController = nullptr;
+  this->Internal->DecisionControllerInitialized = false;
+
   if (this->Controller)
   {
     this->Controller->SetGlobalController(nullptr);
@@ -350,4 +766,8 @@ int vtkCPProcessor::Finalize()
 void vtkCPProcessor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "Asynchronous: " << this->Asynchronous << "\n";
+  os << indent << "BackPressurePolicy: " << this->BackPressurePolicy << "\n";
+  os << indent << "NumberOfDroppedSteps: " << this->NumberOfDroppedSteps << "\n";
+  os << indent << "NumberOfCoalescedSteps: " << this->NumberOfCoalescedSteps << "\n";
 }
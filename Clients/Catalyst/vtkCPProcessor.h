@@ -15,6 +15,7 @@
 #ifndef vtkCPProcessor_h
 #define vtkCPProcessor_h
 
+#include "vtkCommand.h"         // For vtkCommand::UserEvent
 #include "vtkObject.h"
 #include "vtkPVCatalystModule.h" // For windows import/export of shared libraries
 
@@ -54,6 +55,23 @@ class vtkMultiProcessController;
 /// actual data that it has been asked to provide, if any. If no data was
 /// selected during the Configuration Step than the priovided vtkDataObject
 /// may be NULL.
+///
+/// Asynchronous mode:\n
+/// When Asynchronous is on, CoProcess takes a snapshot of the input grids
+/// and returns immediately, while the pipelines process the snapshot on a
+/// dedicated analysis thread. The snapshot shares the arrays of the input
+/// grids, except the ones marked mutable in the vtkCPInputDataDescription
+/// (see vtkCPInputDataDescription::AddMutableField), which are deep-copied.
+/// BackPressurePolicy controls what happens when a step is requested while
+/// the previous one is still being processed. Completed steps are reported
+/// on the simulation thread with StepCompletedEvent. All decisions are made
+/// consistently across ranks, which requires MPI to be initialized with
+/// MPI_THREAD_MULTIPLE when running in parallel; Catalyst falls back to the
+/// synchronous mode otherwise. Since the working directory is process wide,
+/// the simulation should not rely on relative paths while a step is being
+/// processed if *WorkingDirectory* is set. Pipelines that must run on the
+/// simulation thread, such as Python pipelines, cannot be used in this mode
+/// (see vtkCPPipeline::SupportsAsynchronousCoProcessing).
 class VTKPVCATALYST_EXPORT vtkCPProcessor : public vtkObject
 {
 public:
@@ -113,6 +131,71 @@ public:
   /// implementation an opportunity to clean up, before it is destroyed.
   virtual int Finalize();
 
+  /// Events fired by the co-processor, on the thread calling its methods.
+  enum
+  {
+    /// Fired for each co-processed step once its pipelines have executed. The
+    /// call data is a pointer to the step's vtkCPProcessor::StepTiming.
+    StepCompletedEvent = vtkCommand::UserEvent + 1
+  };
+
+  /// Back-pressure policies for the asynchronous mode, applied when a step is
+  /// requested while the previous one is still being processed.\n
+  /// DROP: skip the new step (RequestDataDescription returns 0).\n
+  /// BLOCK: wait for the previous step to complete.\n
+  /// COALESCE: take a snapshot of the new step and process it once the
+  /// previous one completes, replacing any step already waiting. All grids
+  /// and fields are requested for such steps since the pipelines are only
+  /// queried when the step is processed.
+  enum BackPressurePolicies
+  {
+    DROP = 0,
+    BLOCK = 1,
+    COALESCE = 2
+  };
+
+#ifndef __WRAP__
+  /// Timing of a co-processed step, in seconds.
+  struct StepTiming
+  {
+    vtkIdType TimeStep;
+    double Time;
+    /// Time spent in CoProcess taking the snapshot of the grids.
+    double SnapshotTime;
+    /// Time the simulation thread was blocked waiting for previous steps.
+    double WaitTime;
+    /// Time spent executing the pipelines.
+    double ProcessTime;
+    /// 1 if all pipelines succeeded, 0 otherwise.
+    int Status;
+  };
+
+  /// Timing of the last completed step.
+  const StepTiming& GetLastStepTiming() const;
+#endif
+
+  /// Enable/disable the asynchronous mode. Off by default. Disabling it waits
+  /// for the pending steps. Must be set identically on all ranks. Enabling it
+  /// fails while a pipeline that does not support it is registered, and
+  /// adding such a pipeline disables it.
+  virtual void SetAsynchronous(bool);
+  vtkGetMacro(Asynchronous, bool);
+  vtkBooleanMacro(Asynchronous, bool);
+
+  /// Set the back-pressure policy for the asynchronous mode. Default is BLOCK.
+  vtkSetClampMacro(BackPressurePolicy, int, DROP, COALESCE);
+  vtkGetMacro(BackPressurePolicy, int);
+
+  /// Block until all steps handed to the analysis thread have been
+  /// processed. Must be called on all ranks. Returns 1 if all steps processed
+  /// since the last call succeeded and 0 otherwise.
+  virtual int WaitForCoProcessing();
+
+  /// Number of steps skipped with the DROP policy, or replaced by a newer
+  /// step with the COALESCE policy.
+  vtkGetMacro(NumberOfDroppedSteps, vtkIdType);
+  vtkGetMacro(NumberOfCoalescedSteps, vtkIdType);
+
   /// Get the current working directory for outputting Catalyst files.
   /// If not set then Catalyst output files will be relative to the
   /// current working directory. This will not affect where Catalyst
@@ -132,10 +215,23 @@ protected:
   /// set this through the *Initialize()* methods.
   vtkSetStringMacro(WorkingDirectory);
 
+  /// Execute the pipelines that need to be executed for dataDescription.
+  /// Called on the analysis thread in asynchronous mode.
+  int ProcessPipelines(vtkCPDataDescription* dataDescription);
+
+  /// Fire StepCompletedEvent for the steps completed on the analysis thread.
+  void ReportCompletedSteps();
+
+  bool Asynchronous;
+  int BackPressurePolicy;
+  vtkIdType NumberOfDroppedSteps;
+  vtkIdType NumberOfCoalescedSteps;
+
 private:
   vtkCPProcessor(const vtkCPProcessor&) = delete;
   void operator=(const vtkCPProcessor&) = delete;
 
+  friend struct vtkCPProcessorInternals;
   vtkCPProcessorInternals* Internal;
   vtkObject* InitializationHelper;
   static vtkMultiProcessController* Controller;
@@ -0,0 +1,75 @@
+# Checks that the state pushed while a state transaction is open reaches the
+# server and is sent before the requests that need the server to be
+# up-to-date: gathering information and pulling state.
+
+from paraview import servermanager
+import paraview.simple as smp
+
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+
+def runTest():
+
+    options = servermanager.vtkProcessModule.GetProcessModule().GetOptions()
+    url = options.GetServerURL()
+
+    smp.Connect(getHost(url), getPort(url))
+
+    session = servermanager.ActiveConnection.Session
+    # only client sessions hold the pushed state until a commit.
+    assert session.IsA("vtkSMSessionClient")
+
+    sphere = smp.Sphere()
+    sphere.UpdatePipeline()
+
+    # pushed state is sent before gathering information, even when the
+    # transaction is still open.
+    session.BeginStateTransaction()
+    sphere.ThetaResolution = 16
+    sphere.PhiResolution = 16
+    sphere.UpdatePipeline()
+    assert sphere.GetDataInformation().GetNumberOfPoints() == 16 * 14 + 2
+    session.CommitStateTransaction()
+
+    # with nested transactions, the state is sent once the outermost one is
+    # committed.
+    session.BeginStateTransaction()
+    session.BeginStateTransaction()
+    sphere.ThetaResolution = 8
+    session.CommitStateTransaction()
+    sphere.PhiResolution = 8
+    session.CommitStateTransaction()
+    sphere.UpdatePipeline()
+    assert sphere.GetDataInformation().GetNumberOfPoints() == 8 * 6 + 2
+
+    # pushed state, including the creation of the objects on the server, is
+    # sent before pulling state. FileNameInfo is pulled from the reader.
+    pxm = servermanager.ActiveConnection.Session.GetSessionProxyManager()
+    if pxm.GetPrototypeProxy("sources", "TecplotTableReaderCore"):
+        reader = pxm.NewProxy("sources", "TecplotTableReaderCore")
+        session.BeginStateTransaction()
+        reader.GetProperty("FileName").SetElement(0, "transaction.dat")
+        reader.UpdateVTKObjects()
+        reader.UpdatePropertyInformation(reader.GetProperty("FileNameInfo"))
+        assert reader.GetProperty("FileNameInfo").GetElement(0) == "transaction.dat"
+        session.CommitStateTransaction()
+
+    # after a commit, the state is sent right away.
+    sphere.ThetaResolution = 32
+    sphere.UpdatePipeline()
+    assert sphere.GetDataInformation().GetNumberOfPoints() == 32 * 6 + 2
+
+    smp.Disconnect()
+
+
+runTest()
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    AsynchronousPythonPipeline.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkCPProcessor does not run Python pipelines on the analysis
+// thread of the asynchronous mode: enabling it is refused while a Python
+// pipeline is registered, and registering one falls back to the synchronous
+// mode. The pipeline then runs on the simulation thread.
+
+#include "vtkCPDataDescription.h"
+#include "vtkCPInputDataDescription.h"
+#include "vtkCPProcessor.h"
+#include "vtkCPPythonStringPipeline.h"
+#include "vtkCommand.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPythonInterpreter.h"
+
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+#include "vtkMPI.h"
+#endif
+
+namespace
+{
+const char* PipelineScript =
+  "import sys, threading\n"
+  "def RequestDataDescription(datadescription):\n"
+  "  datadescription.GetInputDescriptionByName('input').GenerateMeshOn()\n"
+  "def DoCoProcessing(datadescription):\n"
+  "  sys.modules['__main__'].coprocessed_threads.append(threading.current_thread().ident)\n";
+
+class ErrorCounter
+{
+public:
+  void OnError(vtkObject*, unsigned long, void*) { ++this->Count; }
+  int Count = 0;
+};
+
+bool RunSteps(vtkCPProcessor* processor, int numberOfSteps)
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(4, 4, 4);
+  vtkNew<vtkCPDataDescription> dataDescription;
+  dataDescription->AddInput("input");
+  for (int step = 0; step < numberOfSteps; ++step)
+  {
+    dataDescription->SetTimeData(step, step);
+    if (processor->RequestDataDescription(dataDescription))
+    {
+      dataDescription->GetInputDescriptionByName("input")->SetGrid(image);
+      processor->CoProcess(dataDescription);
+    }
+  }
+  return processor->WaitForCoProcessing() == 1;
+}
+}
+
+int main(int argc, char* argv[])
+{
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  MPI_Init(&argc, &argv);
+#else
+  (void)argc;
+  (void)argv;
+#endif
+  bool success = true;
+  {
+    vtkNew<vtkCPProcessor> processor;
+    processor->Initialize();
+    ErrorCounter errors;
+    processor->AddObserver(vtkCommand::ErrorEvent, &errors, &ErrorCounter::OnError);
+
+    vtkNew<vtkCPPythonStringPipeline> pipeline;
+    pipeline->Initialize(PipelineScript);
+    vtkPythonInterpreter::RunSimpleString("import threading\n"
+                                          "coprocessed_threads = []\n"
+                                          "simulation_thread = threading.current_thread().ident\n");
+
+    // registering a Python pipeline in asynchronous mode falls back to the
+    // synchronous mode.
+    processor->SetAsynchronous(true);
+    processor->AddPipeline(pipeline);
+    if (processor->GetAsynchronous() || errors.Count != 1)
+    {
+      cerr << "ERROR: adding a Python pipeline did not disable the asynchronous mode." << endl;
+      success = false;
+    }
+
+    // enabling the asynchronous mode with a Python pipeline is refused.
+    processor->SetAsynchronous(true);
+    if (processor->GetAsynchronous() || errors.Count != 2)
+    {
+      cerr << "ERROR: the asynchronous mode was enabled with a Python pipeline." << endl;
+      success = false;
+    }
+
+    success &= RunSteps(processor, 3);
+    if (vtkPythonInterpreter::RunSimpleString(
+          "assert coprocessed_threads == [simulation_thread] * 3, coprocessed_threads\n") != 0)
+    {
+      cerr << "ERROR: the Python pipeline did not run on the simulation thread." << endl;
+      success = false;
+    }
+
+    // once the Python pipeline is gone, the asynchronous mode is available.
+    processor->RemoveAllPipelines();
+    processor->SetAsynchronous(true);
+    if (!processor->GetAsynchronous() || errors.Count != 2)
+    {
+      cerr << "ERROR: the asynchronous mode could not be enabled." << endl;
+      success = false;
+    }
+    processor->SetAsynchronous(false);
+    processor->Finalize();
+  }
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  MPI_Finalize();
+#endif
+  return success ? 0 : 1;
+}
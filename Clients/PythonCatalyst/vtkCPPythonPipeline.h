@@ -30,6 +30,11 @@ class VTKPVPYTHONCATALYST_EXPORT vtkCPPythonPipeline : public vtkCPPipeline
 public:
   vtkTypeMacro(vtkCPPythonPipeline, vtkCPPipeline);
 
+  /// Python pipelines run in the embedded interpreter, which is only used
+  /// from the simulation thread, so they do not support the asynchronous
+  /// mode.
+  bool SupportsAsynchronousCoProcessing() override { return false; }
+
 protected:
   /// For things like programmable filters that have a '\n' in their strings,
   /// we need to fix them to have \\n so that everything works smoothly
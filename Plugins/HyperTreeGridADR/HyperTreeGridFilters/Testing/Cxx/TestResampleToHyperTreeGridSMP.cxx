@@ -0,0 +1,125 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestResampleToHyperTreeGridSMP.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkResampleToHyperTreeGrid, which bins the input points and
+// cells concurrently, produces the same hyper tree grid as a serial run.
+
+#include "vtkArithmeticMeanArrayMeasurement.h"
+#include "vtkBitArray.h"
+#include "vtkDataArray.h"
+#include "vtkHyperTreeGrid.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointDataToCellData.h"
+#include "vtkQuantileArrayMeasurement.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkResampleToHyperTreeGrid.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+#include <cstdlib>
+
+#define CHECK(cond)                                                                                \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: Condition FAILED!! : " << #cond << " (line " << __LINE__ << ")" << endl;       \
+    success = false;                                                                               \
+  }
+
+namespace
+{
+// Returns a copy of the output of `resample` computed with `numThreads`
+// threads (0 for the default).
+vtkSmartPointer<vtkHyperTreeGrid> Execute(vtkResampleToHyperTreeGrid* resample, int numThreads)
+{
+  vtkSMPTools::Initialize(numThreads);
+  resample->Modified();
+  resample->Update();
+  vtkSmartPointer<vtkHyperTreeGrid> output = vtkSmartPointer<vtkHyperTreeGrid>::New();
+  output->DeepCopy(resample->GetOutputDataObject(0));
+  return output;
+}
+
+bool CheckOutput(const char* name, vtkResampleToHyperTreeGrid* resample)
+{
+  bool success = true;
+  vtkSmartPointer<vtkHyperTreeGrid> serial = Execute(resample, 1);
+  vtkSmartPointer<vtkHyperTreeGrid> parallel = Execute(resample, 0);
+
+  // the trees must have the same structure.
+  CHECK(serial->GetNumberOfVertices() > serial->GetMaxNumberOfTrees());
+  CHECK(serial->GetNumberOfVertices() == parallel->GetNumberOfVertices());
+  CHECK(serial->GetNumberOfLevels() == parallel->GetNumberOfLevels());
+  vtkBitArray* serialMask = serial->GetMask();
+  vtkBitArray* parallelMask = parallel->GetMask();
+  CHECK((serialMask == nullptr) == (parallelMask == nullptr));
+  for (vtkIdType cc = 0; success && serialMask && cc < serialMask->GetNumberOfValues(); ++cc)
+  {
+    CHECK(serialMask->GetValue(cc) == parallelMask->GetValue(cc));
+  }
+
+  // and the same values, up to the order in which values were summed.
+  vtkPointData* expected = serial->GetPointData();
+  vtkPointData* actual = parallel->GetPointData();
+  CHECK(expected->GetNumberOfArrays() == actual->GetNumberOfArrays());
+  for (int array = 0; success && array < expected->GetNumberOfArrays(); ++array)
+  {
+    vtkDataArray* a = expected->GetArray(array);
+    vtkDataArray* b = actual->GetArray(a->GetName());
+    CHECK(b != nullptr && a->GetNumberOfValues() == b->GetNumberOfValues());
+    for (vtkIdType cc = 0; success && cc < a->GetNumberOfValues(); ++cc)
+    {
+      const double va = a->GetComponent(cc, 0);
+      const double vb = b->GetComponent(cc, 0);
+      CHECK(
+        (std::isnan(va) && std::isnan(vb)) || std::abs(va - vb) <= 1e-9 * (1.0 + std::abs(va)));
+    }
+  }
+  if (!success)
+  {
+    cerr << "ERROR: unexpected output when binning " << name << "." << endl;
+  }
+  return success;
+}
+}
+
+int TestResampleToHyperTreeGridSMP(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-15, 15, -15, 15, -15, 15);
+  vtkNew<vtkPointDataToCellData> cellData;
+  cellData->SetInputConnection(wavelet->GetOutputPort());
+
+  vtkNew<vtkArithmeticMeanArrayMeasurement> mean;
+  vtkNew<vtkQuantileArrayMeasurement> median;
+  vtkNew<vtkResampleToHyperTreeGrid> resample;
+  resample->SetDimensions(3, 3, 3);
+  resample->SetMaxDepth(3);
+  resample->SetMinimumNumberOfPointsInSubtree(4);
+  resample->SetArrayMeasurement(mean);
+  resample->SetArrayMeasurementDisplay(median);
+
+  bool success = true;
+  resample->SetInputConnection(wavelet->GetOutputPort());
+  resample->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "RTData");
+  success &= CheckOutput("points", resample);
+
+  resample->SetInputConnection(cellData->GetOutputPort());
+  resample->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "RTData");
+  success &= CheckOutput("cells", resample);
+
+  vtkSMPTools::Initialize(0);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -26,6 +26,7 @@
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
 #include "vtkHexahedron.h"
 #include "vtkHyperTree.h"
 #include "vtkHyperTreeGrid.h"
@@ -36,11 +37,15 @@
 #include "vtkLongArray.h"
 #include "vtkMath.h"
 #include "vtkMathUtilities.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolygon.h"
 #include "vtkPolyhedron.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTuple.h"
 #include "vtkVoxel.h"
@@ -49,8 +54,11 @@
 #include <array>
 #include <cmath>
 #include <cstring>
+#include <functional>
 #include <limits>
 #include <set>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 vtkStandardNewMacro(vtkResampleToHyperTreeGrid);
@@ -813,131 +821,204 @@ bool vtkResampleToHyperTreeGrid::IntersectedVolume(const double bboxBounds[6], v
 }
 
 //----------------------------------------------------------------------------
-void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
-  vtkDataSet* dataSet, vtkDataArray* data, int fieldAssociation)
+struct vtkResampleToHyperTreeGrid::BinningWorker
 {
-  double* bounds = dataSet->GetBounds();
+  /**
+   * Position of a GridElement: index of the tree, depth and index in the multi resolution grid
+   * of the tree.
+   */
+  struct NodeKey
+  {
+    std::size_t TreeIdx;
+    std::size_t Depth;
+    vtkIdType Idx;
 
-  // Creating the grid of multi resolution grids
-  this->GridOfMultiResolutionGrids.resize(
-    this->CellDims[0] * this->CellDims[1] * this->CellDims[2]);
-  for (std::size_t multiResGridIdx = 0; multiResGridIdx < this->GridOfMultiResolutionGrids.size();
-       ++multiResGridIdx)
+    bool operator==(const NodeKey& key) const
+    {
+      return this->Idx == key.Idx && this->TreeIdx == key.TreeIdx && this->Depth == key.Depth;
+    }
+  };
+
+  struct NodeKeyHash
   {
-    this->GridOfMultiResolutionGrids[multiResGridIdx].resize(this->MaxDepth + 1);
+    std::size_t operator()(const NodeKey& key) const
+    {
+      std::size_t hash = std::hash<vtkIdType>()(key.Idx);
+      hash ^= std::hash<std::size_t>()(key.TreeIdx) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      hash ^= std::hash<std::size_t>()(key.Depth) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      return hash;
+    }
+  };
+
+  typedef std::unordered_map<NodeKey, GridElement, NodeKeyHash> NodeStoreType;
+
+  struct LocalData
+  {
+    NodeStoreType Nodes;
+    std::vector<double> Tuple;
+    std::vector<double> Weights;
+    vtkSmartPointer<vtkGenericCell> Cell;
+    std::string UnsupportedCellType;
+  };
+
+  vtkResampleToHyperTreeGrid* Self;
+  vtkDataSet* DataSet;
+  vtkDataArray* Data;
+  const double* Bounds;
+  bool CellBased;
+  vtkSMPThreadLocal<LocalData> Local;
+  // Set by Reduce() if cells that cannot be binned were met. Errors are reported once the
+  // loop is over, from the calling thread.
+  std::string UnsupportedCellType;
+
+  BinningWorker(vtkResampleToHyperTreeGrid* self, vtkDataSet* dataSet, vtkDataArray* data,
+    const double* bounds, bool cellBased)
+    : Self(self)
+    , DataSet(dataSet)
+    , Data(data)
+    , Bounds(bounds)
+    , CellBased(cellBased)
+  {
+    // Making sure that the data set is ready for concurrent random access
+    if (cellBased && dataSet->GetNumberOfCells())
+    {
+      vtkNew<vtkGenericCell> cell;
+      dataSet->GetCell(0, cell);
+    }
+    else if (!cellBased && dataSet->GetNumberOfPoints())
+    {
+      double point[3];
+      dataSet->GetPoint(0, point);
+    }
   }
 
-  // First pass, we fill the highest resolution grid with input values
-  if (fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS)
+  void Initialize()
   {
-    for (vtkIdType pointId = 0; pointId < dataSet->GetNumberOfPoints(); ++pointId)
+    LocalData& local = this->Local.Local();
+    local.Tuple.resize(this->Data->GetNumberOfComponents());
+    if (this->CellBased)
     {
-      double* point = dataSet->GetPoint(pointId);
+      // Needed to compute the distance between a point and a cell.
+      local.Weights.resize(std::max(this->DataSet->GetMaxCellSize(), 1));
+      local.Cell = vtkSmartPointer<vtkGenericCell>::New();
+    }
+  }
+
+  /**
+   * Adds tuple to the GridElement at the given position, creating the element and its
+   * accumulators the first time this thread passes by this position.
+   * NOTE: GridElement::CanSubdivide does not need to be set at this stage
+   */
+  void Accumulate(LocalData& local, std::size_t treeIdx, std::size_t depth, vtkIdType idx,
+    double weight) const
+  {
+    GridElement& element = local.Nodes[NodeKey{ treeIdx, depth, idx }];
+    if (!element.NumberOfPointsInSubtree)
+    {
+      element.NumberOfLeavesInSubtree = 1;
+      element.UnmaskedChildrenHaveNoMaskedLeaves = true;
+      element.Accumulators.resize(this->Self->Accumulators.size());
+      for (std::size_t l = 0; l < this->Self->Accumulators.size(); ++l)
+      {
+        element.Accumulators[l] = this->Self->Accumulators[l]->NewInstance();
+        element.Accumulators[l]->DeepCopy(this->Self->Accumulators[l]);
+      }
+    }
+    for (auto& accumulator : element.Accumulators)
+    {
+      accumulator->Add(local.Tuple.data(), static_cast<vtkIdType>(local.Tuple.size()), weight);
+    }
+    ++element.NumberOfPointsInSubtree;
+    element.AccumulatedWeight += weight;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    if (this->CellBased)
+    {
+      this->BinCells(begin, end);
+    }
+    else
+    {
+      this->BinPoints(begin, end);
+    }
+  }
+
+  void BinPoints(vtkIdType begin, vtkIdType end)
+  {
+    vtkResampleToHyperTreeGrid* self = this->Self;
+    const double* bounds = this->Bounds;
+    LocalData& local = this->Local.Local();
+    double point[3];
+    for (vtkIdType pointId = begin; pointId < end; ++pointId)
+    {
+      this->DataSet->GetPoint(pointId, point);
 
       // (i, j, k) are the coordinates of the corresponding hyper tree
       vtkIdType i = static_cast<vtkIdType>(((point[0] - bounds[0]) / (bounds[1] - bounds[0]) *
-                                             this->CellDims[0] * this->MaxResolutionPerTree) *
+                                             self->CellDims[0] * self->MaxResolutionPerTree) *
                   (1.0 - VTK_DBL_EPSILON)),
                 j = static_cast<vtkIdType>(((point[1] - bounds[2]) / (bounds[3] - bounds[2]) *
-                                             this->CellDims[1] * this->MaxResolutionPerTree) *
+                                             self->CellDims[1] * self->MaxResolutionPerTree) *
                   (1.0 - VTK_DBL_EPSILON)),
                 k = static_cast<vtkIdType>(((point[2] - bounds[4]) / (bounds[5] - bounds[4]) *
-                                             this->CellDims[2] * this->MaxResolutionPerTree) *
+                                             self->CellDims[2] * self->MaxResolutionPerTree) *
                   (1.0 - VTK_DBL_EPSILON));
 
-      // We bijectively convert the local coordinates within a hyper tree grid to an integer to pass
-      // it
-      // to the std::unordered_map at highest resolution
-      vtkIdType idx = this->MultiResGridCoordinatesToIndex(i % this->MaxResolutionPerTree,
-        j % this->MaxResolutionPerTree, k % this->MaxResolutionPerTree, this->MaxDepth);
-
-      auto& grid =
-        this
-          ->GridOfMultiResolutionGrids[this->GridCoordinatesToIndex(i / this->MaxResolutionPerTree,
-            j / this->MaxResolutionPerTree, k / this->MaxResolutionPerTree)][this->MaxDepth];
-
-      auto it = grid.find(idx);
-      // if this is the first time we pass by this grid location, we create a new ArrayMeasurement
-      // instance
-      // NOTE: GridElement::CanSubdivide does not need to be set at the highest resolution
-      if (it == grid.end())
-      {
-        GridElement& element = grid[idx];
-        element.NumberOfLeavesInSubtree = 1;
-        element.NumberOfPointsInSubtree = 1;
-        element.AccumulatedWeight = 1.0;
-        element.UnmaskedChildrenHaveNoMaskedLeaves = true;
-        element.Accumulators.resize(this->Accumulators.size());
-        for (std::size_t l = 0; l < this->Accumulators.size(); ++l)
-        {
-          element.Accumulators[l] = this->Accumulators[l]->NewInstance();
-          element.Accumulators[l]->DeepCopy(this->Accumulators[l]);
-          element.Accumulators[l]->Add(data->GetTuple(pointId), data->GetNumberOfComponents());
-        }
-      }
-      // if not, then the grid location is already created, just need to add the element into it
-      else
-      {
-        for (auto& accumulator : it->second.Accumulators)
-        {
-          accumulator->Add(data->GetTuple(pointId), data->GetNumberOfComponents());
-        }
-        ++(it->second.NumberOfPointsInSubtree);
-        ++(it->second.AccumulatedWeight);
-      }
+      // We bijectively convert the local coordinates within a hyper tree grid to an integer
+      // to key the element at highest resolution
+      vtkIdType idx = self->MultiResGridCoordinatesToIndex(i % self->MaxResolutionPerTree,
+        j % self->MaxResolutionPerTree, k % self->MaxResolutionPerTree, self->MaxDepth);
+      std::size_t treeIdx = self->GridCoordinatesToIndex(i / self->MaxResolutionPerTree,
+        j / self->MaxResolutionPerTree, k / self->MaxResolutionPerTree);
+
+      this->Data->GetTuple(pointId, local.Tuple.data());
+      this->Accumulate(local, treeIdx, self->MaxDepth, idx, 1.0);
     }
   }
-  else if (fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_CELLS)
-  {
-    // We allocate weights which are needed to compute the distance between a point and a cell.
-    vtkIdType maxNumberOfPoints = 0;
-    for (vtkIdType cellId = 0; cellId < dataSet->GetNumberOfCells(); ++cellId)
-    {
-      vtkCell* cell = dataSet->GetCell(cellId);
-      maxNumberOfPoints = maxNumberOfPoints > cell->GetNumberOfPoints() ? maxNumberOfPoints
-                                                                        : cell->GetNumberOfPoints();
-    }
-
-    // We allocate those variables to avoid unnecessary allocation inside the recursive function.
-    // Those are used to check the distance between a point and the cell.
-    double* weights = new double[maxNumberOfPoints];
 
+  void BinCells(vtkIdType begin, vtkIdType end)
+  {
+    vtkResampleToHyperTreeGrid* self = this->Self;
+    const double* bounds = this->Bounds;
+    LocalData& local = this->Local.Local();
+    const std::vector<vtkIdType>& resolutionPerTree = self->ResolutionPerTree;
     double volumeUnit = 1.0;
-    for (vtkIdType cellId = 0; cellId < dataSet->GetNumberOfCells(); ++cellId)
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
     {
-      vtkCell* cell = dataSet->GetCell(cellId);
+      this->DataSet->GetCell(cellId, local.Cell);
+      vtkCell* cell = local.Cell->GetRepresentativeCell();
       double* cellBounds = cell->GetBounds();
       std::size_t depth = static_cast<std::size_t>(~0);
       vtkIdType imin, imax, jmin, jmax, kmin, kmax;
       do
       {
         ++depth;
-        imin = static_cast<vtkIdType>((cellBounds[0] - bounds[0]) * this->ResolutionPerTree[depth] *
-          this->CellDims[0] / (bounds[1] - bounds[0]));
-        imax =
-          static_cast<vtkIdType>(((cellBounds[1] - bounds[0]) * this->ResolutionPerTree[depth] *
-                                   this->CellDims[0] / (bounds[1] - bounds[0])) *
-            (1.0 - VTK_DBL_EPSILON));
-        jmin = static_cast<vtkIdType>((cellBounds[2] - bounds[2]) * this->ResolutionPerTree[depth] *
-          this->CellDims[1] / (bounds[3] - bounds[2]));
-        jmax =
-          static_cast<vtkIdType>(((cellBounds[3] - bounds[2]) * this->ResolutionPerTree[depth] *
-                                   this->CellDims[1] / (bounds[3] - bounds[2])) *
-            (1.0 - VTK_DBL_EPSILON));
-        kmin = static_cast<vtkIdType>((cellBounds[4] - bounds[4]) * this->ResolutionPerTree[depth] *
-          this->CellDims[2] / (bounds[5] - bounds[4]));
-        kmax =
-          static_cast<vtkIdType>(((cellBounds[5] - bounds[4]) * this->ResolutionPerTree[depth] *
-                                   this->CellDims[2] / (bounds[5] - bounds[4])) *
-            (1.0 - VTK_DBL_EPSILON));
-      } while ((imin == imax || jmin == jmax || kmin == kmax) && depth != this->MaxDepth);
-
-      vtkIdType igridmin = imin / this->ResolutionPerTree[depth],
-                igridmax = imax / this->ResolutionPerTree[depth],
-                jgridmin = jmin / this->ResolutionPerTree[depth],
-                jgridmax = jmax / this->ResolutionPerTree[depth],
-                kgridmin = kmin / this->ResolutionPerTree[depth],
-                kgridmax = kmax / this->ResolutionPerTree[depth];
+        imin = static_cast<vtkIdType>((cellBounds[0] - bounds[0]) * resolutionPerTree[depth] *
+          self->CellDims[0] / (bounds[1] - bounds[0]));
+        imax = static_cast<vtkIdType>(((cellBounds[1] - bounds[0]) * resolutionPerTree[depth] *
+                                        self->CellDims[0] / (bounds[1] - bounds[0])) *
+          (1.0 - VTK_DBL_EPSILON));
+        jmin = static_cast<vtkIdType>((cellBounds[2] - bounds[2]) * resolutionPerTree[depth] *
+          self->CellDims[1] / (bounds[3] - bounds[2]));
+        jmax = static_cast<vtkIdType>(((cellBounds[3] - bounds[2]) * resolutionPerTree[depth] *
+                                        self->CellDims[1] / (bounds[3] - bounds[2])) *
+          (1.0 - VTK_DBL_EPSILON));
+        kmin = static_cast<vtkIdType>((cellBounds[4] - bounds[4]) * resolutionPerTree[depth] *
+          self->CellDims[2] / (bounds[5] - bounds[4]));
+        kmax = static_cast<vtkIdType>(((cellBounds[5] - bounds[4]) * resolutionPerTree[depth] *
+                                        self->CellDims[2] / (bounds[5] - bounds[4])) *
+          (1.0 - VTK_DBL_EPSILON));
+      } while ((imin == imax || jmin == jmax || kmin == kmax) && depth != self->MaxDepth);
+
+      const vtkIdType resolution = resolutionPerTree[depth];
+      vtkIdType igridmin = imin / resolution, igridmax = imax / resolution,
+                jgridmin = jmin / resolution, jgridmax = jmax / resolution,
+                kgridmin = kmin / resolution, kgridmax = kmax / resolution;
+
+      vtkCell3D* cell3D = vtkCell3D::SafeDownCast(cell);
+      vtkVoxel* voxel = vtkVoxel::SafeDownCast(cell);
+      bool tupleFetched = false;
 
       for (vtkIdType igrid = igridmin; igrid <= igridmax; ++igrid)
       {
@@ -945,100 +1026,60 @@ void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
         {
           for (vtkIdType kgrid = kgridmin; kgrid <= kgridmax; ++kgrid)
           {
-            auto& grid =
-              this->GridOfMultiResolutionGrids[this->GridCoordinatesToIndex(igrid, jgrid, kgrid)]
-                                              [depth];
-
-            for (vtkIdType ii = (igrid == igridmin ? imin % this->ResolutionPerTree[depth] : 0);
-                 ii <= (igrid == igridmax ? imax % this->ResolutionPerTree[depth]
-                                          : this->ResolutionPerTree[depth] - 1);
-                 ++ii)
+            std::size_t treeIdx = self->GridCoordinatesToIndex(igrid, jgrid, kgrid);
+
+            for (vtkIdType ii = (igrid == igridmin ? imin % resolution : 0);
+                 ii <= (igrid == igridmax ? imax % resolution : resolution - 1); ++ii)
             {
-              for (vtkIdType jj = (jgrid == jgridmin ? jmin % this->ResolutionPerTree[depth] : 0);
-                   jj <= (jgrid == jgridmax ? jmax % this->ResolutionPerTree[depth]
-                                            : this->ResolutionPerTree[depth] - 1);
-                   ++jj)
+              for (vtkIdType jj = (jgrid == jgridmin ? jmin % resolution : 0);
+                   jj <= (jgrid == jgridmax ? jmax % resolution : resolution - 1); ++jj)
               {
-                for (vtkIdType kk = (kgrid == kgridmin ? kmin % this->ResolutionPerTree[depth] : 0);
-                     kk <= (kgrid == kgridmax ? kmax % this->ResolutionPerTree[depth]
-                                              : this->ResolutionPerTree[depth] - 1);
-                     ++kk)
+                for (vtkIdType kk = (kgrid == kgridmin ? kmin % resolution : 0);
+                     kk <= (kgrid == kgridmax ? kmax % resolution : resolution - 1); ++kk)
                 {
-                  vtkIdType ires = ii + igrid * this->ResolutionPerTree[depth];
-                  vtkIdType jres = jj + jgrid * this->ResolutionPerTree[depth];
-                  vtkIdType kres = kk + kgrid * this->ResolutionPerTree[depth];
+                  vtkIdType ires = ii + igrid * resolution;
+                  vtkIdType jres = jj + jgrid * resolution;
+                  vtkIdType kres = kk + kgrid * resolution;
 
                   double boxBounds[6] = { bounds[0] +
-                      (0.0 + ires) / (this->CellDims[0] * this->ResolutionPerTree[depth]) *
-                        (bounds[1] - bounds[0]),
+                      (0.0 + ires) / (self->CellDims[0] * resolution) * (bounds[1] - bounds[0]),
                     bounds[0] +
-                      (1.0 + ires) / (this->CellDims[0] * this->ResolutionPerTree[depth]) *
-                        (bounds[1] - bounds[0]),
+                      (1.0 + ires) / (self->CellDims[0] * resolution) * (bounds[1] - bounds[0]),
                     bounds[2] +
-                      (0.0 + jres) / (this->CellDims[1] * this->ResolutionPerTree[depth]) *
-                        (bounds[3] - bounds[2]),
+                      (0.0 + jres) / (self->CellDims[1] * resolution) * (bounds[3] - bounds[2]),
                     bounds[2] +
-                      (1.0 + jres) / (this->CellDims[1] * this->ResolutionPerTree[depth]) *
-                        (bounds[3] - bounds[2]),
+                      (1.0 + jres) / (self->CellDims[1] * resolution) * (bounds[3] - bounds[2]),
                     bounds[4] +
-                      (0.0 + kres) / (this->CellDims[2] * this->ResolutionPerTree[depth]) *
-                        (bounds[5] - bounds[4]),
+                      (0.0 + kres) / (self->CellDims[2] * resolution) * (bounds[5] - bounds[4]),
                     bounds[4] +
-                      (1.0 + kres) / (this->CellDims[2] * this->ResolutionPerTree[depth]) *
-                        (bounds[5] - bounds[4]) };
+                      (1.0 + kres) / (self->CellDims[2] * resolution) * (bounds[5] - bounds[4]) };
 
                   double volume = 0.0;
                   bool nonZeroVolume = false;
 
-                  vtkCell3D* cell3D = vtkCell3D::SafeDownCast(cell);
-                  vtkVoxel* voxel = vtkVoxel::SafeDownCast(cell);
-
                   if (voxel)
                   {
-                    nonZeroVolume = this->IntersectedVolume(boxBounds, voxel, volumeUnit, volume);
+                    nonZeroVolume = self->IntersectedVolume(boxBounds, voxel, volumeUnit, volume);
                   }
                   else if (cell3D)
                   {
-                    nonZeroVolume =
-                      this->IntersectedVolume(boxBounds, cell3D, volumeUnit, volume, weights);
+                    nonZeroVolume = self->IntersectedVolume(
+                      boxBounds, cell3D, volumeUnit, volume, local.Weights.data());
                   }
                   else
                   {
-                    vtkErrorMacro(<< "cell type " << cell->GetClassName() << " not supported");
+                    local.UnsupportedCellType = cell->GetClassName();
                   }
 
                   if (nonZeroVolume)
                   {
-                    vtkIdType gridIdx = this->MultiResGridCoordinatesToIndex(ii, jj, kk, depth);
-                    auto it = grid.find(gridIdx);
-                    if (it == grid.end())
-                    {
-                      GridElement& element = grid[gridIdx];
-                      element.NumberOfLeavesInSubtree = 1;
-                      element.NumberOfPointsInSubtree = 1;
-                      element.UnmaskedChildrenHaveNoMaskedLeaves = true;
-                      element.AccumulatedWeight = volume;
-                      element.Accumulators.resize(this->Accumulators.size());
-                      for (std::size_t l = 0; l < this->Accumulators.size(); ++l)
-                      {
-                        element.Accumulators[l] = this->Accumulators[l]->NewInstance();
-                        element.Accumulators[l]->DeepCopy(this->Accumulators[l]);
-                        element.Accumulators[l]->Add(
-                          data->GetTuple(cellId), data->GetNumberOfComponents(), volume);
-                      }
-                    }
-                    // if not, then the grid location is already created, just need to add the
-                    // element into it
-                    else
+                    if (!tupleFetched)
                     {
-                      for (auto& accumulator : it->second.Accumulators)
-                      {
-                        accumulator->Add(
-                          data->GetTuple(cellId), data->GetNumberOfComponents(), volume);
-                      }
-                      ++(it->second.NumberOfPointsInSubtree);
-                      it->second.AccumulatedWeight += volume;
+                      this->Data->GetTuple(cellId, local.Tuple.data());
+                      tupleFetched = true;
                     }
+                    this->Accumulate(local, treeIdx, depth,
+                      self->MultiResGridCoordinatesToIndex(ii, jj, kk, depth), volume);
                   }
                 }
               }
@@ -1047,113 +1088,187 @@ void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
         }
       }
     }
-    delete[] weights;
-  }
-  else
-  {
-    vtkWarningMacro(<< "Unknown field association. Supported are points and cells");
   }
 
-  // Now, we fill the multi-resolution grid bottom-up
-  for (std::size_t multiResGridIdx = 0; multiResGridIdx < this->GridOfMultiResolutionGrids.size();
-       ++multiResGridIdx)
+  /**
+   * Merges the thread local stores into this->Self->GridOfMultiResolutionGrids.
+   * The first store passing by a position hands its accumulators over, the following ones
+   * are added to them.
+   */
+  void Reduce()
   {
-    auto& multiResolutionGrid = this->GridOfMultiResolutionGrids[multiResGridIdx];
-    for (std::size_t depth = this->MaxDepth; depth; --depth)
+    GridOfMultiResGridsType& grids = this->Self->GridOfMultiResolutionGrids;
+    for (auto local = this->Local.begin(); local != this->Local.end(); ++local)
     {
-      // The strategy is the following:
-      // Given an iterator on the elements of the grid at resolution depth,
-      // we propagate the accumulated values to the lower resolution depth-1
-      // using correct indexing
-      for (const auto& mapElement : multiResolutionGrid[depth])
+      for (auto& node : (*local).Nodes)
       {
-        vtkTuple<vtkIdType, 3> coord =
-          this->IndexToMultiResGridCoordinates(mapElement.first, depth);
-        coord[0] /= this->BranchFactor;
-        coord[1] /= this->BranchFactor;
-        coord[2] /= this->BranchFactor;
-        vtkIdType idx =
-          this->MultiResGridCoordinatesToIndex(coord[0], coord[1], coord[2], depth - 1);
-
-        // Same as before: if the grid location is not created yet, we create it, if not,
-        // we merge the corresponding accumulated values
-        auto it = multiResolutionGrid[depth - 1].find(idx);
-        // if the grid element does not exist yet, we create it
-        if (it == multiResolutionGrid[depth - 1].end())
+        GridElement& source = node.second;
+        GridElement& element = grids[node.first.TreeIdx][node.first.Depth][node.first.Idx];
+        if (!element.NumberOfPointsInSubtree)
         {
-          GridElement& element = multiResolutionGrid[depth - 1][idx];
-
-          // Initializing element
-          element.NumberOfLeavesInSubtree = mapElement.second.NumberOfLeavesInSubtree;
-          element.NumberOfPointsInSubtree = mapElement.second.NumberOfPointsInSubtree;
-          element.NumberOfNonMaskedChildren = 1;
-          element.AccumulatedWeight = mapElement.second.AccumulatedWeight;
-
-          // mapElement, from higher depth, can have no children with any masked leaves,
-          // but have a masked children, which we propagate upward.
-          element.UnmaskedChildrenHaveNoMaskedLeaves =
-            mapElement.second.UnmaskedChildrenHaveNoMaskedLeaves &&
-            mapElement.second.NumberOfNonMaskedChildren == this->NumberOfChildren;
-
-          // A leaf can be subivided if each of the hypothetical child:
-          // - Has at least MinimumNumberOfPointsInSubtree set by the user
-          // - Has enough points to be measured
-          // Here we check with the first child.
-          element.CanSubdivide =
-            mapElement.second.NumberOfPointsInSubtree >= this->MinimumNumberOfPointsInSubtree &&
-            (!this->ArrayMeasurement ||
-              this->ArrayMeasurement->CanMeasure(
-                mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight)) &&
-            (!this->ArrayMeasurementDisplay ||
-              this->ArrayMeasurementDisplay->CanMeasure(
-                mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight));
-
-          // We copy the accumulator of the child
-          element.Accumulators.resize(this->Accumulators.size());
-          for (std::size_t l = 0; l < this->Accumulators.size(); ++l)
-          {
-            element.Accumulators[l] = this->Accumulators[l]->NewInstance();
-            element.Accumulators[l]->DeepCopy(this->Accumulators[l]);
-            element.Accumulators[l]->Add(mapElement.second.Accumulators[l]);
-          }
+          element.NumberOfLeavesInSubtree = source.NumberOfLeavesInSubtree;
+          element.NumberOfPointsInSubtree = source.NumberOfPointsInSubtree;
+          element.AccumulatedWeight = source.AccumulatedWeight;
+          element.UnmaskedChildrenHaveNoMaskedLeaves = source.UnmaskedChildrenHaveNoMaskedLeaves;
+          element.Accumulators.swap(source.Accumulators);
         }
-        // else, the grid element is already created, we add data to it
         else
         {
-          // Adding information from subtree
-          it->second.NumberOfLeavesInSubtree += mapElement.second.NumberOfLeavesInSubtree;
-          it->second.NumberOfPointsInSubtree += mapElement.second.NumberOfPointsInSubtree;
-          it->second.AccumulatedWeight += mapElement.second.AccumulatedWeight;
-
-          // mapElement, from higher depth, can have no children with any masked leaves,
-          // but have a masked children, which we propagate upward.
-          it->second.UnmaskedChildrenHaveNoMaskedLeaves &=
-            mapElement.second.UnmaskedChildrenHaveNoMaskedLeaves &&
-            mapElement.second.NumberOfNonMaskedChildren == this->NumberOfChildren;
-          ++(it->second.NumberOfNonMaskedChildren);
-
-          // A leaf can be subivided if each of the hypothetical child:
-          // - Has at least MinimumNumberOfPointsInSubtree set by the user
-          // - Has enough points to be measured
-          // Here we accumulate for each child
-          it->second.CanSubdivide &=
-            it->second.NumberOfPointsInSubtree >= this->MinimumNumberOfPointsInSubtree &&
-            (!this->ArrayMeasurement ||
-              this->ArrayMeasurement->CanMeasure(
-                mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight)) &&
-            (!this->ArrayMeasurementDisplay ||
-              this->ArrayMeasurementDisplay->CanMeasure(
-                mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight));
-
-          // We add the accumulators from the child
-          for (std::size_t l = 0; l < this->Accumulators.size(); ++l)
+          for (std::size_t l = 0; l < element.Accumulators.size(); ++l)
           {
-            it->second.Accumulators[l]->Add(mapElement.second.Accumulators[l]);
+            element.Accumulators[l]->Add(source.Accumulators[l]);
           }
+          element.NumberOfPointsInSubtree += source.NumberOfPointsInSubtree;
+          element.AccumulatedWeight += source.AccumulatedWeight;
         }
       }
+      (*local).Nodes.clear();
+      if (!(*local).UnsupportedCellType.empty())
+      {
+        this->UnsupportedCellType = (*local).UnsupportedCellType;
+      }
     }
   }
+};
+
+//----------------------------------------------------------------------------
+void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
+  vtkDataSet* dataSet, vtkDataArray* data, int fieldAssociation)
+{
+  double* bounds = dataSet->GetBounds();
+
+  // Creating the grid of multi resolution grids
+  this->GridOfMultiResolutionGrids.resize(
+    this->CellDims[0] * this->CellDims[1] * this->CellDims[2]);
+  for (std::size_t multiResGridIdx = 0; multiResGridIdx < this->GridOfMultiResolutionGrids.size();
+       ++multiResGridIdx)
+  {
+    this->GridOfMultiResolutionGrids[multiResGridIdx].resize(this->MaxDepth + 1);
+  }
+
+  // First pass, we fill the highest resolution grid with input values.
+  // Each thread bins its range of points or cells in its own node store, stores are then merged.
+  if (fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS ||
+    fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_CELLS)
+  {
+    const bool cellBased = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_CELLS;
+    BinningWorker worker(this, dataSet, data, bounds, cellBased);
+    vtkSMPTools::For(
+      0, cellBased ? dataSet->GetNumberOfCells() : dataSet->GetNumberOfPoints(), worker);
+    if (!worker.UnsupportedCellType.empty())
+    {
+      vtkErrorMacro(<< "cell type " << worker.UnsupportedCellType << " not supported");
+    }
+  }
+  else
+  {
+    vtkWarningMacro(<< "Unknown field association. Supported are points and cells");
+  }
+
+  // Now, we fill the multi-resolution grid bottom-up, each tree being independent
+  vtkSMPTools::For(0, static_cast<vtkIdType>(this->GridOfMultiResolutionGrids.size()),
+    [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType multiResGridIdx = begin; multiResGridIdx < end; ++multiResGridIdx)
+      {
+        auto& multiResolutionGrid = this->GridOfMultiResolutionGrids[multiResGridIdx];
+        for (std::size_t depth = this->MaxDepth; depth; --depth)
+        {
+          // The strategy is the following:
+          // Given an iterator on the elements of the grid at resolution depth,
+          // we propagate the accumulated values to the lower resolution depth-1
+          // using correct indexing
+          for (const auto& mapElement : multiResolutionGrid[depth])
+          {
+            vtkTuple<vtkIdType, 3> coord =
+              this->IndexToMultiResGridCoordinates(mapElement.first, depth);
+            coord[0] /= this->BranchFactor;
+            coord[1] /= this->BranchFactor;
+            coord[2] /= this->BranchFactor;
+            vtkIdType idx =
+              this->MultiResGridCoordinatesToIndex(coord[0], coord[1], coord[2], depth - 1);
+
+            // Same as before: if the grid location is not created yet, we create it, if not,
+            // we merge the corresponding accumulated values
+            auto it = multiResolutionGrid[depth - 1].find(idx);
+            // if the grid element does not exist yet, we create it
+            if (it == multiResolutionGrid[depth - 1].end())
+            {
+              GridElement& element = multiResolutionGrid[depth - 1][idx];
+
+              // Initializing element
+              element.NumberOfLeavesInSubtree = mapElement.second.NumberOfLeavesInSubtree;
+              element.NumberOfPointsInSubtree = mapElement.second.NumberOfPointsInSubtree;
+              element.NumberOfNonMaskedChildren = 1;
+              element.AccumulatedWeight = mapElement.second.AccumulatedWeight;
+
+              // mapElement, from higher depth, can have no children with any masked leaves,
+              // but have a masked children, which we propagate upward.
+              element.UnmaskedChildrenHaveNoMaskedLeaves =
+                mapElement.second.UnmaskedChildrenHaveNoMaskedLeaves &&
+                mapElement.second.NumberOfNonMaskedChildren == this->NumberOfChildren;
+
+              // A leaf can be subivided if each of the hypothetical child:
+              // - Has at least MinimumNumberOfPointsInSubtree set by the user
+              // - Has enough points to be measured
+              // Here we check with the first child.
+              element.CanSubdivide =
+                mapElement.second.NumberOfPointsInSubtree >= this->MinimumNumberOfPointsInSubtree &&
+                (!this->ArrayMeasurement ||
+                  this->ArrayMeasurement->CanMeasure(mapElement.second.NumberOfPointsInSubtree,
+                    mapElement.second.AccumulatedWeight)) &&
+                (!this->ArrayMeasurementDisplay ||
+                  this->ArrayMeasurementDisplay->CanMeasure(
+                    mapElement.second.NumberOfPointsInSubtree,
+                    mapElement.second.AccumulatedWeight));
+
+              // We copy the accumulator of the child
+              element.Accumulators.resize(this->Accumulators.size());
+              for (std::size_t l = 0; l < this->Accumulators.size(); ++l)
+              {
+                element.Accumulators[l] = this->Accumulators[l]->NewInstance();
+                element.Accumulators[l]->DeepCopy(this->Accumulators[l]);
+                element.Accumulators[l]->Add(mapElement.second.Accumulators[l]);
+              }
+            }
+            // else, the grid element is already created, we add data to it
+            else
+            {
+              // Adding information from subtree
+              it->second.NumberOfLeavesInSubtree += mapElement.second.NumberOfLeavesInSubtree;
+              it->second.NumberOfPointsInSubtree += mapElement.second.NumberOfPointsInSubtree;
+              it->second.AccumulatedWeight += mapElement.second.AccumulatedWeight;
+
+              // mapElement, from higher depth, can have no children with any masked leaves,
+              // but have a masked children, which we propagate upward.
+              it->second.UnmaskedChildrenHaveNoMaskedLeaves &=
+                mapElement.second.UnmaskedChildrenHaveNoMaskedLeaves &&
+                mapElement.second.NumberOfNonMaskedChildren == this->NumberOfChildren;
+              ++(it->second.NumberOfNonMaskedChildren);
+
+              // A leaf can be subivided if each of the hypothetical child:
+              // - Has at least MinimumNumberOfPointsInSubtree set by the user
+              // - Has enough points to be measured
+              // Here we accumulate for each child
+              it->second.CanSubdivide &=
+                it->second.NumberOfPointsInSubtree >= this->MinimumNumberOfPointsInSubtree &&
+                (!this->ArrayMeasurement ||
+                  this->ArrayMeasurement->CanMeasure(mapElement.second.NumberOfPointsInSubtree,
+                    mapElement.second.AccumulatedWeight)) &&
+                (!this->ArrayMeasurementDisplay ||
+                  this->ArrayMeasurementDisplay->CanMeasure(
+                    mapElement.second.NumberOfPointsInSubtree,
+                    mapElement.second.AccumulatedWeight));
+
+              // We add the accumulators from the child
+              for (std::size_t l = 0; l < this->Accumulators.size(); ++l)
+              {
+                it->second.Accumulators[l]->Add(mapElement.second.Accumulators[l]);
+              }
+            }
+          }
+        }
+      }
+    });
 
   if (this->NoEmptyCells ||
     (this->Extrapolate && fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS))
@@ -305,6 +305,14 @@ protected:
    */
   typedef std::vector<std::unordered_map<vtkIdType, GridElement> > MultiResGridType;
 
+  /**
+   * Only needed internally. Functor binning input points or cells into a flat hashed
+   * store of GridElement per thread, keyed by tree, depth and position in the multi resolution
+   * grid, and merging the stores into this->GridOfMultiResolutionGrids once every thread is done.
+   * It is defined in the implementation file.
+   */
+  struct BinningWorker;
+
   //@{
   /**
    * Priority queue / element used for extrapolating empty leaves in the case of point based htg
@@ -422,6 +430,9 @@ protected:
    * Given an input dataSet and its corresponding scalar field data, fills a grid of multi
    * resolution grids
    * matching the subdivision scheme of the output hyper tree grid.
+   * Input points or cells are binned concurrently into thread local node stores
+   * (see BinningWorker) which are then merged into this->GridOfMultiResolutionGrids,
+   * and the multi resolution grids are filled bottom-up concurrently, one tree per task.
    */
   void CreateGridOfMultiResolutionGrids(
     vtkDataSet* dataSet, vtkDataArray* data, int fieldAssociation);
@@ -47,6 +47,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vtkCollection.h>
 #include <vtkCollectionIterator.h>
 #include <vtkDirectory.h>
+#include <vtkNew.h>
 #include <vtkPVFileInformation.h>
 #include <vtkPVFileInformationHelper.h>
 #include <vtkSMDirectoryProxy.h>
@@ -250,6 +251,13 @@ Q_GLOBAL_STATIC(pqFileDialogModelIconProvider, Icons);
 namespace
 {
 
+/// Number of items of a remote directory listing fetched at a time.
+const int ListingPageSize = 10000;
+
+/// Number of times a remote directory listing is fetched again from the start
+/// when the directory is listed again while its pages are being fetched.
+const int MaximumListingAttempts = 3;
+
 ///////////////////////////////////////////////////////////////////////
 // CaseInsensitiveSort
 
@@ -381,8 +389,46 @@ public:
       helper->UpdateVTKObjects();
 
       // get data from server
-      this->FileInformation->Initialize();
-      this->FileInformationHelperProxy->GatherInformation(this->FileInformation);
+      // Listings are fetched one page at a time so that a directory with
+      // many files does not come in a single huge message. When the server
+      // lists the directory again in between, e.g. because it changed, the
+      // pages come from different listings: start over from the first page.
+      pqSMAdaptor::setElementProperty(
+        helper->GetProperty("ListingPageSize"), dirListing ? ListingPageSize : 0);
+      vtkNew<vtkPVFileInformation> page;
+      bool complete = false;
+      for (int attempt = 0; !complete && attempt < MaximumListingAttempts; ++attempt)
+      {
+        pqSMAdaptor::setElementProperty(helper->GetProperty("ListingOffset"), 0);
+        helper->UpdateVTKObjects();
+        this->FileInformation->Initialize();
+        this->FileInformationHelperProxy->GatherInformation(this->FileInformation);
+
+        vtkCollection* contents = this->FileInformation->GetContents();
+        const int generation = this->FileInformation->GetListingGeneration();
+        complete = true;
+        while (dirListing &&
+          contents->GetNumberOfItems() < this->FileInformation->GetTotalNumberOfContents())
+        {
+          pqSMAdaptor::setElementProperty(
+            helper->GetProperty("ListingOffset"), contents->GetNumberOfItems());
+          helper->UpdateVTKObjects();
+          page->Initialize();
+          this->FileInformationHelperProxy->GatherInformation(page);
+          if (page->GetListingGeneration() != generation ||
+            page->GetContents()->GetNumberOfItems() == 0)
+          {
+            complete = false;
+            break;
+          }
+          vtkCollectionSimpleIterator cookie;
+          page->GetContents()->InitTraversal(cookie);
+          while (vtkObject* item = page->GetContents()->GetNextItemAsObject(cookie))
+          {
+            contents->AddItem(item);
+          }
+        }
+      }
     }
     else
     {
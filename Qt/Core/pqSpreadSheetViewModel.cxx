@@ -62,6 +62,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vtkWeakPointer.h"
 
 // Qt Includes.
+#include <QElapsedTimer>
 #include <QItemSelectionModel>
 #include <QPointer>
 #include <QtDebug>
@@ -73,6 +74,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "pqSMAdaptor.h"
 #include "pqTimer.h"
 
+#include <algorithm>
 #include <cassert>
 
 static uint qHash(pqSpreadSheetViewModel::vtkIndex index)
@@ -92,6 +94,7 @@ public:
     this->DecimalPrecision = 6;
     this->FixedRepresentation = false;
     this->ActiveRegion[0] = this->ActiveRegion[1] = -1;
+    this->ScrollVelocity = 0.0;
     this->VTKView = NULL;
 
     this->LastColumnCount = 0;
@@ -101,12 +104,15 @@ public:
   QItemSelectionModel SelectionModel;
   pqTimer Timer;
   pqTimer SelectionTimer;
+  pqTimer PrefetchTimer;
   int DecimalPrecision;
   bool FixedRepresentation;
   vtkIdType LastRowCount;
   vtkIdType LastColumnCount;
 
   int ActiveRegion[2];
+  QElapsedTimer ScrollClock;
+  double ScrollVelocity; // in rows per second.
   vtkSmartPointer<vtkEventQtSlotConnect> VTKConnect;
   QPointer<pqDataRepresentation> ActiveRepresentation;
   vtkWeakPointer<vtkSMProxy> ActiveRepresentationProxy;
@@ -133,6 +139,13 @@ pqSpreadSheetViewModel::pqSpreadSheetViewModel(vtkSMProxy* view, QObject* parent
   this->Internal->Timer.setInterval(500); // milliseconds.
   QObject::connect(&this->Internal->Timer, SIGNAL(timeout()), this, SLOT(delayedUpdate()));
 
+  // blocks are prefetched one per tick so that the view repaints the rows
+  // already available in between fetches.
+  this->Internal->PrefetchTimer.setSingleShot(true);
+  this->Internal->PrefetchTimer.setInterval(50); // milliseconds.
+  QObject::connect(
+    &this->Internal->PrefetchTimer, SIGNAL(timeout()), this, SLOT(prefetchBlocks()));
+
   this->Internal->SelectionTimer.setSingleShot(true);
   this->Internal->SelectionTimer.setInterval(100); // milliseconds.
   QObject::connect(
@@ -210,9 +223,11 @@ void pqSpreadSheetViewModel::forceUpdate()
 {
   this->Internal->ActiveRegion[0] = -1;
   this->Internal->ActiveRegion[1] = -1;
+  this->Internal->ScrollVelocity = 0.0;
   this->Internal->SelectionModel.clear();
   this->Internal->Timer.stop();
   this->Internal->SelectionTimer.stop();
+  this->Internal->PrefetchTimer.stop();
 
   vtkIdType& rows = this->Internal->LastRowCount;
   vtkIdType& columns = this->Internal->LastColumnCount;
@@ -249,6 +264,15 @@ void pqSpreadSheetViewModel::delayedUpdate()
   }
 }
 
+//-----------------------------------------------------------------------------
+void pqSpreadSheetViewModel::prefetchBlocks()
+{
+  if (this->Internal->VTKView && this->Internal->VTKView->PrefetchNextBlock())
+  {
+    this->Internal->PrefetchTimer.start();
+  }
+}
+
 //-----------------------------------------------------------------------------
 void pqSpreadSheetViewModel::triggerSelectionChanged()
 {
@@ -258,8 +282,39 @@ void pqSpreadSheetViewModel::triggerSelectionChanged()
 //-----------------------------------------------------------------------------
 void pqSpreadSheetViewModel::setActiveRegion(int row_top, int row_bottom)
 {
-  this->Internal->ActiveRegion[0] = row_top;
-  this->Internal->ActiveRegion[1] = row_bottom;
+  pqInternal& internal = *this->Internal;
+  if (internal.ActiveRegion[0] == row_top && internal.ActiveRegion[1] == row_bottom)
+  {
+    // this is called on every paint, not only when scrolling.
+    return;
+  }
+
+  // estimate the scroll velocity from the last two scroll steps. A pause of
+  // more than a second means the user stopped scrolling.
+  double velocity = 0.0;
+  if (internal.ActiveRegion[0] >= 0 && internal.ScrollClock.isValid())
+  {
+    const qint64 msecs = std::max<qint64>(internal.ScrollClock.elapsed(), 1);
+    if (msecs < 1000)
+    {
+      velocity =
+        0.5 * (internal.ScrollVelocity + 1000.0 * (row_top - internal.ActiveRegion[0]) / msecs);
+    }
+  }
+  internal.ScrollClock.start();
+  internal.ScrollVelocity = velocity;
+
+  internal.ActiveRegion[0] = row_top;
+  internal.ActiveRegion[1] = row_bottom;
+  if (internal.VTKView == nullptr)
+  {
+    return;
+  }
+  internal.VTKView->SetViewport(row_top, row_bottom, velocity);
+  if (!internal.PrefetchTimer.isActive())
+  {
+    internal.PrefetchTimer.start();
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -159,7 +159,8 @@ public:
   * set the region (in row indices) that is currently being shown in the view.
   * the model will provide data-values only for the active-region. For any
   * other region it will simply return a "..." text for display (in
-  * QAbstractTableModel::data(..) callback).
+  * QAbstractTableModel::data(..) callback). The scroll velocity estimated from
+  * successive calls is used to prefetch the blocks ahead of the active region.
   */
   void setActiveRegion(int row_top, int row_bottom);
 
@@ -219,6 +220,12 @@ private slots:
   */
   void delayedUpdate();
 
+  /**
+  * called when idle to fetch the next block that the view is likely to show,
+  * given the active region and the scroll velocity.
+  */
+  void prefetchBlocks();
+
   void triggerSelectionChanged();
 
   /**
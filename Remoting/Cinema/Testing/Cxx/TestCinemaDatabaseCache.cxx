@@ -0,0 +1,158 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCinemaDatabaseCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the layer cache of vtkCinemaDatabase: translated layers are reused,
+// shared by the databases loading the same store, bounded by
+// MaximumLayerCacheSize, and prefetched layers match the ones translated on
+// demand.
+
+#include "vtkCinemaDatabase.h"
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkProcessModule.h"
+#include "vtkTestUtilities.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define CHECK(cond)                                                                                \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: Condition FAILED!! : " << #cond << " (line " << __LINE__ << ")" << endl;       \
+    success = false;                                                                               \
+  }
+
+namespace
+{
+typedef std::vector<vtkSmartPointer<vtkImageData> > LayersType;
+
+// Returns true if both hold the very same layer objects.
+bool SameLayers(const LayersType& a, const LayersType& b)
+{
+  return !a.empty() && a == b;
+}
+
+// Returns true if the layers have the same dimensions and point data.
+bool SameContent(const LayersType& a, const LayersType& b)
+{
+  if (a.empty() || a.size() != b.size())
+  {
+    return false;
+  }
+  for (size_t cc = 0; cc < a.size(); ++cc)
+  {
+    int dimsA[3], dimsB[3];
+    a[cc]->GetDimensions(dimsA);
+    b[cc]->GetDimensions(dimsB);
+    vtkPointData* pdA = a[cc]->GetPointData();
+    vtkPointData* pdB = b[cc]->GetPointData();
+    if (memcmp(dimsA, dimsB, sizeof(dimsA)) != 0 ||
+      pdA->GetNumberOfArrays() != pdB->GetNumberOfArrays())
+    {
+      return false;
+    }
+    for (int array = 0; array < pdA->GetNumberOfArrays(); ++array)
+    {
+      vtkDataArray* arrayA = pdA->GetArray(array);
+      vtkDataArray* arrayB = pdB->GetArray(array);
+      if (!arrayA || !arrayB || arrayA->GetDataType() != arrayB->GetDataType() ||
+        arrayA->GetNumberOfValues() != arrayB->GetNumberOfValues() ||
+        memcmp(arrayA->GetVoidPointer(0), arrayB->GetVoidPointer(0),
+          static_cast<size_t>(arrayA->GetNumberOfValues()) * arrayA->GetDataTypeSize()) != 0)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestCinemaDatabaseCache(int argc, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestCinemaDatabaseCache");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  char* fname = vtkTestUtilities::ExpandDataFileName(
+    argc, argv, "Testing/Data/cinema-non-composite.cdb/image/info.json");
+  const std::string filename = fname;
+  delete[] fname;
+
+  bool success = true;
+  LayersType first;
+  {
+    vtkNew<vtkCinemaDatabase> database;
+    CHECK(database->Load(filename.c_str()));
+    const std::vector<std::string> phis = database->GetControlParameterValues("phi");
+    CHECK(phis.size() >= 2);
+    if (!success)
+    {
+      vtkInitializationHelper::Finalize();
+      return EXIT_FAILURE;
+    }
+    const std::string query0 = "{'phi' : [" + phis[0] + "]}";
+    const std::string query1 = "{'phi' : [" + phis[1] + "]}";
+
+    // translated layers are cached.
+    first = database->TranslateQuery(query0);
+    CHECK(!first.empty());
+    CHECK(SameLayers(database->TranslateQuery(query0), first));
+
+    // the cache is shared by the databases loading the same store.
+    vtkNew<vtkCinemaDatabase> other;
+    CHECK(other->Load(filename.c_str()));
+    CHECK(SameLayers(other->TranslateQuery(query0), first));
+
+    // cleared layers are translated again.
+    other->ClearLayerCache();
+    LayersType again = database->TranslateQuery(query0);
+    CHECK(!SameLayers(again, first) && SameContent(again, first));
+
+    // layers larger than the cache are not kept.
+    const unsigned long maximumSize = vtkCinemaDatabase::GetMaximumLayerCacheSize();
+    vtkCinemaDatabase::SetMaximumLayerCacheSize(0);
+    database->ClearLayerCache();
+    const LayersType uncached = database->TranslateQuery(query1);
+    CHECK(!SameLayers(database->TranslateQuery(query1), uncached));
+    vtkCinemaDatabase::SetMaximumLayerCacheSize(maximumSize);
+
+    // prefetched layers, whether they are ready yet or not, match the ones
+    // translated on demand and are kept in the cache.
+    database->Prefetch({ query1 });
+    const LayersType prefetched = database->TranslateQuery(query1);
+    CHECK(SameContent(prefetched, uncached));
+    CHECK(SameLayers(database->TranslateQuery(query1), prefetched));
+
+    // a query prefetched again is not translated again.
+    database->Prefetch({ query0, query1 });
+    CHECK(SameLayers(database->TranslateQuery(query1), prefetched));
+  }
+
+  // once no database uses the store, loading it again starts a new cache.
+  {
+    vtkNew<vtkCinemaDatabase> database;
+    CHECK(database->Load(filename.c_str()));
+    const std::vector<std::string> phis = database->GetControlParameterValues("phi");
+    const LayersType layers = database->TranslateQuery("{'phi' : [" + phis[0] + "]}");
+    CHECK(!SameLayers(layers, first) && SameContent(layers, first));
+  }
+
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
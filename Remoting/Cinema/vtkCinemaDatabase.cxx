@@ -23,9 +23,20 @@
 #include "vtkSmartPyObject.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
 namespace
 {
@@ -101,7 +112,11 @@ std::vector<vtkSmartPointer<T> > PyListToVectorOfVTKObjects(vtkSmartPyObject pyo
 }
 }
 
-class vtkCinemaDatabase::vtkInternals
+namespace
+{
+// Provides access to a `cinema_python` FileStore. Each call goes through the
+// Python interpreter and holds the GIL for its duration.
+class vtkCinemaPythonStore
 {
   bool Initialized;
   std::string OldFileName;
@@ -110,13 +125,11 @@ class vtkCinemaDatabase::vtkInternals
   vtkSmartPyObject FileStore;
 
 public:
-  vtkInternals()
+  vtkCinemaPythonStore()
     : Initialized(false)
   {
   }
 
-  bool IsLoaded() const { return this->FileStore; }
-
   // Will import necessary Python modules and return true if all's ready.
   bool InitializePython()
   {
@@ -422,6 +435,272 @@ public:
   }
 };
 
+// Releases the GIL, if the calling thread holds it, for the lifetime of the
+// object: used while waiting for the prefetch worker, which needs the GIL to
+// translate queries.
+class vtkCinemaScopedGILRelease
+{
+public:
+  vtkCinemaScopedGILRelease()
+    : State(nullptr)
+  {
+#if PY_VERSION_HEX >= 0x03040000
+    if (Py_IsInitialized() && PyGILState_Check())
+    {
+      this->State = PyEval_SaveThread();
+    }
+#endif
+  }
+
+  ~vtkCinemaScopedGILRelease()
+  {
+    if (this->State)
+    {
+      PyEval_RestoreThread(this->State);
+    }
+  }
+
+private:
+  vtkCinemaScopedGILRelease(const vtkCinemaScopedGILRelease&) = delete;
+  void operator=(const vtkCinemaScopedGILRelease&) = delete;
+
+  PyThreadState* State;
+};
+
+// Caches the answers of a vtkCinemaPythonStore. The metadata of the store
+// does not change once loaded, so answers to metadata queries are kept for
+// the lifetime of the cache. Layers returned by TranslateQuery() are kept
+// in a least-recently-used cache bounded by memory, and can be prefetched in
+// the background. A single cache is shared by all vtkCinemaDatabase
+// instances loading the same database.
+class vtkCinemaStoreCache
+{
+public:
+  typedef std::vector<vtkSmartPointer<vtkImageData> > LayersType;
+
+  static std::shared_ptr<vtkCinemaStoreCache> Open(const std::string& filename)
+  {
+    static std::mutex RegistryMutex;
+    static std::map<std::string, std::weak_ptr<vtkCinemaStoreCache> > Registry;
+
+    std::lock_guard<std::mutex> lock(RegistryMutex);
+    // forget the databases that are no longer loaded.
+    for (auto iter = Registry.begin(); iter != Registry.end();)
+    {
+      iter = iter->second.expired() ? Registry.erase(iter) : std::next(iter);
+    }
+    auto cache = Registry[filename].lock();
+    if (!cache)
+    {
+      cache = std::make_shared<vtkCinemaStoreCache>();
+      if (!cache->Store.LoadDatabase(filename.c_str()))
+      {
+        Registry.erase(filename);
+        return nullptr;
+      }
+      Registry[filename] = cache;
+    }
+    return cache;
+  }
+
+  vtkCinemaStoreCache()
+    : CachedSize(0)
+    , Stop(false)
+  {
+  }
+
+  ~vtkCinemaStoreCache()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Stop = true;
+      this->Pending.clear();
+    }
+    this->Condition.notify_all();
+    if (this->Worker.joinable())
+    {
+      // the worker may be waiting for the GIL to finish its query.
+      vtkCinemaScopedGILRelease releaseGIL;
+      this->Worker.join();
+    }
+  }
+
+  vtkCinemaPythonStore Store;
+
+  /**
+   * Returns the cached answer for `key`, calling `compute` the first time.
+   */
+  template <typename T, typename Compute>
+  T Get(std::map<std::string, T>& answers, const std::string& key, Compute compute)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      auto iter = answers.find(key);
+      if (iter != answers.end())
+      {
+        return iter->second;
+      }
+    }
+    T answer = compute();
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    answers[key] = answer;
+    return answer;
+  }
+
+  std::map<std::string, std::vector<std::string> > Strings;
+  std::map<std::string, std::vector<double> > Doubles;
+  std::map<std::string, std::string> String;
+  std::map<std::string, bool> Bool;
+  std::map<std::string, std::vector<vtkSmartPointer<vtkCamera> > > Cameras;
+
+  LayersType TranslateQuery(const std::string& query)
+  {
+    {
+      // wait for the worker if it is already translating this query. The
+      // worker needs the GIL to do so: do not hold it while waiting.
+      vtkCinemaScopedGILRelease releaseGIL;
+      std::unique_lock<std::mutex> lock(this->Mutex);
+      this->Condition.wait(lock, [&]() { return this->InFlight.count(query) == 0; });
+      auto iter = this->LayerIndex.find(query);
+      if (iter != this->LayerIndex.end())
+      {
+        this->Layers.splice(this->Layers.begin(), this->Layers, iter->second);
+        return iter->second->Layers;
+      }
+      this->InFlight.insert(query);
+    }
+
+    LayersType layers = this->Store.TranslateQuery(query);
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->InFlight.erase(query);
+    this->AddLayers(query, layers);
+    this->Condition.notify_all();
+    return layers;
+  }
+
+  void Prefetch(const std::vector<std::string>& queries)
+  {
+#ifdef VTK_PYTHON_FULL_THREADSAFE
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    // only the latest request matters, older ones are for a selection the
+    // user already moved away from.
+    this->Pending.clear();
+    for (const auto& query : queries)
+    {
+      if (this->LayerIndex.find(query) == this->LayerIndex.end())
+      {
+        this->Pending.push_back(query);
+      }
+    }
+    if (!this->Pending.empty() && !this->Worker.joinable())
+    {
+      this->Worker = std::thread(&vtkCinemaStoreCache::PrefetchLoop, this);
+    }
+    this->Condition.notify_all();
+#else
+    // without a thread-safe Python, the GIL cannot be acquired from another
+    // thread, so layers are only translated on demand.
+    (void)queries;
+#endif
+  }
+
+  void ClearLayers()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Layers.clear();
+    this->LayerIndex.clear();
+    this->CachedSize = 0;
+  }
+
+  static std::atomic<unsigned long> MaximumLayerCacheSize; // in KiB
+
+private:
+  struct CacheEntry
+  {
+    std::string Query;
+    LayersType Layers;
+    unsigned long Size; // in KiB
+  };
+  typedef std::list<CacheEntry> LayersListType;
+
+  // Must be called with the mutex locked.
+  void AddLayers(const std::string& query, const LayersType& layers)
+  {
+    if (this->LayerIndex.find(query) != this->LayerIndex.end())
+    {
+      return;
+    }
+    CacheEntry entry = { query, layers, 0 };
+    for (const auto& layer : layers)
+    {
+      entry.Size += layer ? layer->GetActualMemorySize() : 0;
+    }
+    if (entry.Size > vtkCinemaStoreCache::MaximumLayerCacheSize)
+    {
+      return;
+    }
+    this->Layers.push_front(entry);
+    this->LayerIndex[query] = this->Layers.begin();
+    this->CachedSize += entry.Size;
+    while (this->CachedSize > vtkCinemaStoreCache::MaximumLayerCacheSize)
+    {
+      const CacheEntry& last = this->Layers.back();
+      this->CachedSize -= last.Size;
+      this->LayerIndex.erase(last.Query);
+      this->Layers.pop_back();
+    }
+  }
+
+  void PrefetchLoop()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->Condition.wait(lock, [this]() { return this->Stop || !this->Pending.empty(); });
+      if (this->Stop)
+      {
+        return;
+      }
+      const std::string query = this->Pending.front();
+      this->Pending.pop_front();
+      if (this->InFlight.count(query) != 0 ||
+        this->LayerIndex.find(query) != this->LayerIndex.end())
+      {
+        continue;
+      }
+      this->InFlight.insert(query);
+      lock.unlock();
+      LayersType layers = this->Store.TranslateQuery(query);
+      lock.lock();
+      this->InFlight.erase(query);
+      this->AddLayers(query, layers);
+      this->Condition.notify_all();
+    }
+  }
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  LayersListType Layers; // most recently used first.
+  std::unordered_map<std::string, LayersListType::iterator> LayerIndex;
+  unsigned long CachedSize;
+  std::set<std::string> InFlight;
+  std::deque<std::string> Pending;
+  std::thread Worker;
+  bool Stop;
+};
+
+std::atomic<unsigned long> vtkCinemaStoreCache::MaximumLayerCacheSize(512 * 1024);
+}
+
+class vtkCinemaDatabase::vtkInternals
+{
+public:
+  std::string FileName;
+  std::shared_ptr<vtkCinemaStoreCache> Cache;
+
+  bool IsLoaded() const { return this->Cache != nullptr; }
+};
+
 vtkStandardNewMacro(vtkCinemaDatabase);
 //----------------------------------------------------------------------------
 vtkCinemaDatabase::vtkCinemaDatabase()
@@ -439,9 +718,15 @@ vtkCinemaDatabase::~vtkCinemaDatabase()
 //----------------------------------------------------------------------------
 bool vtkCinemaDatabase::Load(const char* fname)
 {
+  auto& internals = *this->Internals;
   if (fname && fname[0] != 0)
   {
-    return this->Internals->LoadDatabase(fname);
+    if (!internals.Cache || internals.FileName != fname)
+    {
+      internals.Cache = vtkCinemaStoreCache::Open(fname);
+      internals.FileName = internals.Cache ? fname : "";
+    }
+    return internals.IsLoaded();
   }
 
   return false;
@@ -450,35 +735,44 @@ bool vtkCinemaDatabase::Load(const char* fname)
 //----------------------------------------------------------------------------
 std::vector<std::string> vtkCinemaDatabase::GetPipelineObjects() const
 {
-  return this->Internals->IsLoaded() ? this->Internals->GetPipelineObjects()
-                                     : std::vector<std::string>();
+  auto cache = this->Internals->Cache;
+  return cache ? cache->Get(cache->Strings, "objects",
+                   [&]() { return cache->Store.GetPipelineObjects(); })
+               : std::vector<std::string>();
 }
 
 //----------------------------------------------------------------------------
 std::vector<std::string> vtkCinemaDatabase::GetPipelineObjectParents(const std::string& name) const
 {
-  return this->Internals->IsLoaded() ? this->Internals->GetPipelineObjectParents(name)
-                                     : std::vector<std::string>();
+  auto cache = this->Internals->Cache;
+  return cache ? cache->Get(cache->Strings, "parents:" + name,
+                   [&]() { return cache->Store.GetPipelineObjectParents(name); })
+               : std::vector<std::string>();
 }
 
 //----------------------------------------------------------------------------
 bool vtkCinemaDatabase::GetPipelineObjectVisibility(const std::string& objectname) const
 {
-  return this->Internals->IsLoaded() ? this->Internals->GetPipelineObjectVisibility(objectname)
-                                     : false;
+  auto cache = this->Internals->Cache;
+  return cache ? cache->Get(cache->Bool, "visibility:" + objectname,
+                   [&]() { return cache->Store.GetPipelineObjectVisibility(objectname); })
+               : false;
 }
 
 //----------------------------------------------------------------------------
 std::vector<std::string> vtkCinemaDatabase::GetControlParameters(const std::string& name) const
 {
-  return this->Internals->IsLoaded() ? this->Internals->GetControlParameters(name)
-                                     : std::vector<std::string>();
+  auto cache = this->Internals->Cache;
+  return cache ? cache->Get(cache->Strings, "parameters:" + name,
+                   [&]() { return cache->Store.GetControlParameters(name); })
+               : std::vector<std::string>();
 }
 
 //----------------------------------------------------------------------------
 std::vector<std::string> vtkCinemaDatabase::GetControlParameterValues(const std::string& name) const
 {
-  if (!this->Internals->IsLoaded())
+  auto cache = this->Internals->Cache;
+  if (!cache)
   {
     return std::vector<std::string>();
   }
@@ -486,7 +780,8 @@ std::vector<std::string> vtkCinemaDatabase::GetControlParameterValues(const std:
   std::vector<std::string> parameters = this->GetControlParameters(name);
   if (std::find(parameters.begin(), parameters.end(), name) != parameters.end())
   {
-    return this->Internals->GetControlParameterValues(name);
+    return cache->Get(cache->Strings, "values:" + name,
+      [&]() { return cache->Store.GetControlParameterValues(name); });
   }
 
   return std::vector<std::string>();
@@ -495,51 +790,110 @@ std::vector<std::string> vtkCinemaDatabase::GetControlParameterValues(const std:
 //----------------------------------------------------------------------------
 std::vector<std::string> vtkCinemaDatabase::GetTimeSteps() const
 {
-  return this->Internals->IsLoaded() ? this->Internals->GetTimeSteps() : std::vector<std::string>();
+  auto cache = this->Internals->Cache;
+  return cache
+    ? cache->Get(cache->Strings, "timesteps", [&]() { return cache->Store.GetTimeSteps(); })
+    : std::vector<std::string>();
 }
 
 //----------------------------------------------------------------------------
 std::string vtkCinemaDatabase::GetFieldName(const std::string& objectname) const
 {
-  return this->Internals->IsLoaded() ? this->Internals->GetFieldName(objectname) : std::string();
+  auto cache = this->Internals->Cache;
+  return cache ? cache->Get(cache->String, "fieldname:" + objectname,
+                   [&]() { return cache->Store.GetFieldName(objectname); })
+               : std::string();
 }
 
 //----------------------------------------------------------------------------
 std::vector<std::string> vtkCinemaDatabase::GetFieldValues(
   const std::string& objectname, const std::string& valuetype) const
 {
-  return this->Internals->IsLoaded() ? this->Internals->GetFieldValues(objectname, valuetype)
-                                     : std::vector<std::string>();
+  auto cache = this->Internals->Cache;
+  return cache ? cache->Get(cache->Strings, "fieldvalues:" + objectname + ":" + valuetype,
+                   [&]() { return cache->Store.GetFieldValues(objectname, valuetype); })
+               : std::vector<std::string>();
 }
 
 //----------------------------------------------------------------------------
 bool vtkCinemaDatabase::GetFieldValueRange(
   const std::string& object, const std::string& field, double range[2]) const
 {
-  return this->Internals->IsLoaded() ? this->Internals->GetFieldValueRange(object, field, range)
-                                     : false;
+  auto cache = this->Internals->Cache;
+  if (!cache)
+  {
+    return false;
+  }
+  const std::vector<double> value =
+    cache->Get(cache->Doubles, "fieldvaluerange:" + object + ":" + field, [&]() {
+      double r[2];
+      return cache->Store.GetFieldValueRange(object, field, r) ? std::vector<double>(r, r + 2)
+                                                               : std::vector<double>();
+    });
+  if (value.size() == 2)
+  {
+    range[0] = value[0];
+    range[1] = value[1];
+    return true;
+  }
+  return false;
 }
 
 //----------------------------------------------------------------------------
 std::vector<vtkSmartPointer<vtkImageData> > vtkCinemaDatabase::TranslateQuery(
   const std::string& query) const
 {
-  return this->Internals->IsLoaded() ? this->Internals->TranslateQuery(query)
-                                     : std::vector<vtkSmartPointer<vtkImageData> >();
+  auto cache = this->Internals->Cache;
+  return cache ? cache->TranslateQuery(query) : std::vector<vtkSmartPointer<vtkImageData> >();
+}
+
+//----------------------------------------------------------------------------
+void vtkCinemaDatabase::Prefetch(const std::vector<std::string>& queries) const
+{
+  if (auto cache = this->Internals->Cache)
+  {
+    cache->Prefetch(queries);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkCinemaDatabase::ClearLayerCache()
+{
+  if (auto cache = this->Internals->Cache)
+  {
+    cache->ClearLayers();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkCinemaDatabase::SetMaximumLayerCacheSize(unsigned long kibibytes)
+{
+  vtkCinemaStoreCache::MaximumLayerCacheSize = kibibytes;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkCinemaDatabase::GetMaximumLayerCacheSize()
+{
+  return vtkCinemaStoreCache::MaximumLayerCacheSize;
 }
 
 //----------------------------------------------------------------------------
 std::vector<vtkSmartPointer<vtkCamera> > vtkCinemaDatabase::Cameras(
   const std::string& timestep) const
 {
-  return this->Internals->IsLoaded() ? this->Internals->Cameras(timestep)
-                                     : std::vector<vtkSmartPointer<vtkCamera> >();
+  auto cache = this->Internals->Cache;
+  return cache ? cache->Get(cache->Cameras, timestep,
+                   [&]() { return cache->Store.Cameras(timestep); })
+               : std::vector<vtkSmartPointer<vtkCamera> >();
 }
 
 //----------------------------------------------------------------------------
 int vtkCinemaDatabase::GetSpec() const
 {
-  std::string spec = this->Internals->IsLoaded() ? this->Internals->GetSpec() : std::string("");
+  auto cache = this->Internals->Cache;
+  std::string spec =
+    cache ? cache->Get(cache->String, "spec", [&]() { return cache->Store.GetSpec(); })
+          : std::string("");
   int res = Spec::UNKNOWN;
   if (spec == "specA")
   {
@@ -556,12 +910,14 @@ int vtkCinemaDatabase::GetSpec() const
 std::string vtkCinemaDatabase::GetNearestParameterValue(
   const std::string& param, double value) const
 {
-  if (!this->Internals->IsLoaded())
+  auto cache = this->Internals->Cache;
+  if (!cache)
   {
     return std::string();
   }
 
-  std::vector<double> values = this->Internals->GetControlParameterValuesAsDouble(param);
+  std::vector<double> values = cache->Get(cache->Doubles, "values:" + param,
+    [&]() { return cache->Store.GetControlParameterValuesAsDouble(param); });
   std::vector<double>::iterator valIterator;
   valIterator = std::lower_bound(values.begin(), values.end(), value);
 
@@ -21,6 +21,13 @@
  * `cinema_python.database.file_store.FileStore` instance. The API is
  * limited to the functionality needed for the rendering Cinema layers in
  *  ParaView.
+ *
+ * Answers from the FileStore are cached and shared by all vtkCinemaDatabase
+ * instances that load the same database, so that the Python interpreter is
+ * only called the first time a question is asked. Layers returned by
+ * TranslateQuery() are kept in a least-recently-used cache whose size is set
+ * with SetMaximumLayerCacheSize(), and Prefetch() lets layers that are likely
+ * to be requested next be translated in the background.
  */
 
 #ifndef vtkCinemaDatabase_h
@@ -112,6 +119,28 @@ public:
    */
   std::vector<vtkSmartPointer<vtkImageData> > TranslateQuery(const std::string& query) const;
 
+  /**
+   * Translates the queries in the background, so that later calls to
+   * TranslateQuery() for them return cached layers. A call replaces the
+   * queries pending from the previous one. This does nothing if the Python
+   * interpreter was not built to be used from several threads.
+   */
+  void Prefetch(const std::vector<std::string>& queries) const;
+
+  /**
+   * Releases the cached layers of the database.
+   */
+  void ClearLayerCache();
+
+  //@{
+  /**
+   * Get/Set the maximum size, in KiB, of the layers cached for each database.
+   * Defaults to 512 MiB.
+   */
+  static void SetMaximumLayerCacheSize(unsigned long kibibytes);
+  static unsigned long GetMaximumLayerCacheSize();
+  //@}
+
   /**
    * Get cameras
    */
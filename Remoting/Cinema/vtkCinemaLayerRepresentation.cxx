@@ -32,6 +32,7 @@
 #include "vtkStringArray.h"
 #include "vtkTransform.h"
 
+#include <algorithm>
 #include <sstream>
 
 vtkStandardNewMacro(vtkCinemaLayerRepresentation);
@@ -206,16 +207,6 @@ int vtkCinemaLayerRepresentation::RequestData(
 //----------------------------------------------------------------------------
 void vtkCinemaLayerRepresentation::UpdateMapper()
 {
-  // First, create a query.
-  std::ostringstream query;
-  query << "{";
-
-  // Base query contains parameters
-  if (!this->BaseQueryJSON.empty())
-  {
-    query << this->BaseQueryJSON;
-  }
-
   vtkPVRenderView* pvview = vtkPVRenderView::SafeDownCast(this->GetView());
   vtkCamera* activeCamera = pvview ? pvview->GetActiveCamera() : NULL;
   int cameraIndex = -1;
@@ -229,24 +220,8 @@ void vtkCinemaLayerRepresentation::UpdateMapper()
     layerCamera = this->Cameras->GetCamera(cameraIndex);
   }
 
-  // Spec-dependent query contains camera info
-  if (this->CinemaDatabase->GetSpec() == vtkCinemaDatabase::CINEMA_SPEC_A)
-  {
-    query << this->GetSpecAQuery(cameraIndex);
-  }
-  else if (this->CinemaDatabase->GetSpec() == vtkCinemaDatabase::CINEMA_SPEC_C)
-  {
-    query << this->GetSpecCQuery(cameraIndex);
-  }
-
-  query << "}";
-
-  std::string queryString = query.str();
-  size_t last = queryString.find_last_of(",");
-  if (last != std::string::npos)
-  {
-    queryString.erase(last, 1);
-  }
+  // First, create a query.
+  const std::string queryString = this->GetQuery(this->BaseQueryJSON, cameraIndex);
 
   // If the query didn't change, we don't need to fetch new layers.
   std::vector<vtkSmartPointer<vtkImageData> > layers;
@@ -259,6 +234,7 @@ void vtkCinemaLayerRepresentation::UpdateMapper()
       // Cache first layer (i.e. full image for spec A, but not for spec C)
       this->CachedImage->DeepCopy(layers.at(0));
     }
+    this->PrefetchAdjacentLayers(cameraIndex);
   }
   vtkImageData* image = this->CachedImage.Get();
 
@@ -335,6 +311,96 @@ void vtkCinemaLayerRepresentation::UpdateMapper()
   }
 }
 
+//----------------------------------------------------------------------------
+std::string vtkCinemaLayerRepresentation::GetQuery(const std::string& baseQuery, int cameraIndex)
+{
+  std::ostringstream query;
+  query << "{";
+
+  // Base query contains parameters
+  query << baseQuery;
+
+  // Spec-dependent query contains camera info
+  if (this->CinemaDatabase->GetSpec() == vtkCinemaDatabase::CINEMA_SPEC_A)
+  {
+    query << this->GetSpecAQuery(cameraIndex);
+  }
+  else if (this->CinemaDatabase->GetSpec() == vtkCinemaDatabase::CINEMA_SPEC_C)
+  {
+    query << this->GetSpecCQuery(cameraIndex);
+  }
+
+  query << "}";
+
+  std::string queryString = query.str();
+  size_t last = queryString.find_last_of(",");
+  if (last != std::string::npos)
+  {
+    queryString.erase(last, 1);
+  }
+  return queryString;
+}
+
+//----------------------------------------------------------------------------
+void vtkCinemaLayerRepresentation::PrefetchAdjacentLayers(int cameraIndex)
+{
+  std::vector<std::string> queries;
+
+  // The same camera at the previous and next time steps. The base query
+  // selects the time step as generated by vtkCinemaDatabaseReader.
+  const std::string timeQuery = "'time' : [ '" + this->CinemaTimeStep + "']";
+  const size_t timePos = this->BaseQueryJSON.find(timeQuery);
+  if (!this->CinemaTimeStep.empty() && timePos != std::string::npos)
+  {
+    const std::vector<std::string> timeSteps = this->CinemaDatabase->GetTimeSteps();
+    auto iter = std::find(timeSteps.begin(), timeSteps.end(), this->CinemaTimeStep);
+    if (iter != timeSteps.end())
+    {
+      std::vector<std::string> adjacent;
+      if (iter + 1 != timeSteps.end())
+      {
+        adjacent.push_back(*(iter + 1));
+      }
+      if (iter != timeSteps.begin())
+      {
+        adjacent.push_back(*(iter - 1));
+      }
+      for (const auto& timeStep : adjacent)
+      {
+        std::string baseQuery = this->BaseQueryJSON;
+        baseQuery.replace(timePos, timeQuery.size(), "'time' : [ '" + timeStep + "']");
+        queries.push_back(this->GetQuery(baseQuery, cameraIndex));
+      }
+    }
+  }
+
+  // The cameras next to the current one at the current time step.
+  if (cameraIndex != -1)
+  {
+    std::vector<int> adjacent = { cameraIndex + 1, cameraIndex - 1 };
+    if (this->CinemaDatabase->GetSpec() == vtkCinemaDatabase::CINEMA_SPEC_A)
+    {
+      // cameras are ordered by phi, then theta.
+      const int numberOfThetas =
+        static_cast<int>(this->CinemaDatabase->GetControlParameterValues("theta").size());
+      if (numberOfThetas > 1)
+      {
+        adjacent.push_back(cameraIndex + numberOfThetas);
+        adjacent.push_back(cameraIndex - numberOfThetas);
+      }
+    }
+    for (int index : adjacent)
+    {
+      if (this->Cameras->GetCamera(index) != NULL)
+      {
+        queries.push_back(this->GetQuery(this->BaseQueryJSON, index));
+      }
+    }
+  }
+
+  this->CinemaDatabase->Prefetch(queries);
+}
+
 //----------------------------------------------------------------------------
 std::string vtkCinemaLayerRepresentation::GetSpecCQuery(int cameraIndex)
 {
@@ -90,9 +90,22 @@ protected:
    */
   void UpdateMapper();
 
+  /**
+   * Returns the query for the layers seen from the camera at `cameraIndex`,
+   * given the base query containing the parameters.
+   */
+  std::string GetQuery(const std::string& baseQuery, int cameraIndex);
+
   std::string GetSpecAQuery(int cameraIndex);
   std::string GetSpecCQuery(int cameraIndex);
 
+  /**
+   * Asks the database to prefetch the layers for the time steps and cameras
+   * next to the current ones, so that scrubbing through them does not wait
+   * for the layers to be translated.
+   */
+  void PrefetchAdjacentLayers(int cameraIndex);
+
 private:
   vtkCinemaLayerRepresentation(const vtkCinemaLayerRepresentation&) = delete;
   void operator=(const vtkCinemaLayerRepresentation&) = delete;
@@ -22,9 +22,11 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#include <cstring>
 #include <map>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 vtkStandardNewMacro(vtkClientServerInterpreter);
@@ -76,6 +78,36 @@ public:
   NewInstanceFunctionsType NewInstanceFunctions;
   ClassToFunctionMapType ClassToFunctionMap;
   IDToMessageMapType IDToMessageMap;
+
+  // Class names are looked up for every invoke and for every superclass of
+  // the object, almost always with the same string literals from
+  // GetClassName() and from the generated wrappers. Lookups are cached by
+  // address, the name is still compared since the address may be reused.
+  typedef std::unordered_map<const char*, ClassToFunctionMapType::const_iterator>
+    CommandFunctionCacheType;
+  CommandFunctionCacheType CommandFunctionCache;
+
+  const CommandFunction* FindCommandFunction(const char* cname)
+  {
+    CommandFunctionCacheType::const_iterator cached = this->CommandFunctionCache.find(cname);
+    if (cached != this->CommandFunctionCache.end() &&
+      strcmp(cached->second->first.c_str(), cname) == 0)
+    {
+      return cached->second->second;
+    }
+    ClassToFunctionMapType::const_iterator f = this->ClassToFunctionMap.find(cname);
+    if (f == this->ClassToFunctionMap.end())
+    {
+      return NULL;
+    }
+    if (this->CommandFunctionCache.size() >= 4096)
+    {
+      // Names are not all literals, do not let the cache grow forever.
+      this->CommandFunctionCache.clear();
+    }
+    this->CommandFunctionCache[cname] = f;
+    return f->second;
+  }
 };
 
 //----------------------------------------------------------------------------
@@ -786,29 +818,41 @@ bool vtkClientServerInterpreter::HasCommandFunction(const char* cname)
   {
     return false;
   }
-  return (this->Internal->ClassToFunctionMap.count(cname) > 0);
+  return this->Internal->FindCommandFunction(cname) != NULL;
 }
 
 //----------------------------------------------------------------------------
 int vtkClientServerInterpreter::CallCommandFunction(const char* cname, vtkObjectBase* ptr,
   const char* method, const vtkClientServerStream& msg, vtkClientServerStream& result)
 {
-  vtkClientServerInterpreterInternals::ClassToFunctionMapType::const_iterator f =
-    this->Internal->ClassToFunctionMap.find(cname);
+  const vtkClientServerInterpreterInternals::CommandFunction* n =
+    cname ? this->Internal->FindCommandFunction(cname) : NULL;
 
-  if (f == this->Internal->ClassToFunctionMap.end())
+  if (!n)
   {
     vtkErrorMacro("Cannot find command function for \"" << cname << "\".");
     return 1;
   }
 
-  const vtkClientServerInterpreterInternals::CommandFunction* n = f->second;
-
   vtkClientServerCommandFunction function = n->Function;
   void* ctx = n->Context ? n->Context->Context : 0;
   return function(this, ptr, method, msg, result, ctx);
 }
 
+//----------------------------------------------------------------------------
+vtkTypeUInt32 vtkClientServerInterpreter::GetMethodHash(const char* method, int numberOfArguments)
+{
+  // FNV-1a, the wrapper generator computes the same values for the methods
+  // it wraps.
+  vtkTypeUInt32 hash = 2166136261u;
+  for (const unsigned char* cp = reinterpret_cast<const unsigned char*>(method); cp && *cp; ++cp)
+  {
+    hash = (hash ^ *cp) * 16777619u;
+  }
+  return (hash ^ static_cast<vtkTypeUInt32>(numberOfArguments)) * 16777619u;
+}
+
+//----------------------------------------------------------------------------
 void vtkClientServerInterpreter::AddNewInstanceFunction(const char* name,
   vtkClientServerNewInstanceFunction f, void* ctx, vtkContextFreeFunction freeFunction)
 {
@@ -149,6 +149,12 @@ public:
   int CallCommandFunction(const char* classname, vtkObjectBase* ptr, const char* method,
     const vtkClientServerStream& msg, vtkClientServerStream& result);
 
+  /**
+   * Called by generated code to select the method to call from its name
+   * and the number of arguments of the message.  Do not call directly.
+   */
+  static vtkTypeUInt32 GetMethodHash(const char* method, int numberOfArguments);
+
   /**
    * Add a function used to create new objects.
    */
@@ -0,0 +1,150 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVArrayInformationRanges.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the ranges vtkPVArrayInformation computes in a single pass
+// match vtkDataArray::GetRange()/GetFiniteRange(), that cached ranges are
+// updated when the array changes and that vtkPVDataInformation can skip
+// the ranges of arrays.
+
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+namespace
+{
+bool SameRange(const double* expected, const double* actual)
+{
+  return expected[0] == actual[0] && expected[1] == actual[1];
+}
+
+bool CheckRanges(vtkDataArray* array, vtkPVArrayInformation* info)
+{
+  double expected[2];
+  const int numComps = array->GetNumberOfComponents();
+  for (int comp = (numComps > 1 ? -1 : 0); comp < numComps; ++comp)
+  {
+    array->GetRange(expected, comp);
+    if (!SameRange(expected, info->GetComponentRange(comp)))
+    {
+      cerr << "ERROR: wrong range for component " << comp << " of " << array->GetName() << endl;
+      return false;
+    }
+    array->GetFiniteRange(expected, comp);
+    if (!SameRange(expected, info->GetComponentFiniteRange(comp)))
+    {
+      cerr << "ERROR: wrong finite range for component " << comp << " of " << array->GetName()
+           << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsValidRange(const double* range)
+{
+  return range[0] <= range[1];
+}
+}
+
+int TestPVArrayInformationRanges(int, char* [])
+{
+  bool success = true;
+
+  const vtkIdType numTuples = 100000;
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numTuples);
+  vtkNew<vtkIntArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(numTuples);
+  for (vtkIdType cc = 0; cc < numTuples; ++cc)
+  {
+    vectors->SetTypedComponent(cc, 0, static_cast<double>(cc));
+    vectors->SetTypedComponent(cc, 1, -0.5 * cc);
+    vectors->SetTypedComponent(cc, 2, 1.0);
+    scalars->SetTypedComponent(cc, 0, static_cast<int>(cc % 1000) - 500);
+  }
+  vectors->SetTypedComponent(10, 1, vtkMath::Nan());
+  vectors->SetTypedComponent(20, 2, vtkMath::Inf());
+  vectors->SetTypedComponent(30, 0, vtkMath::NegInf());
+
+  vtkNew<vtkPVArrayInformation> info;
+  info->CopyFromObject(vectors);
+  success &= CheckRanges(vectors, info);
+  info->CopyFromObject(scalars);
+  success &= CheckRanges(scalars, info);
+
+  // The second time, ranges come from the cache.
+  info->CopyFromObject(vectors);
+  success &= CheckRanges(vectors, info);
+
+  // Modified arrays have their ranges computed again.
+  vectors->SetTypedComponent(40, 2, 1000.0);
+  vectors->Modified();
+  info->CopyFromObject(vectors);
+  success &= CheckRanges(vectors, info);
+
+  info->SetComputeRanges(false);
+  info->CopyFromObject(vectors);
+  if (IsValidRange(info->GetComponentRange(0)) || IsValidRange(info->GetComponentRange(-1)))
+  {
+    cerr << "ERROR: ranges computed while ComputeRanges is off." << endl;
+    success = false;
+  }
+
+  // vtkPVDataInformation can restrict the arrays that get ranges.
+  vtkNew<vtkPolyData> polydata;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numTuples);
+  for (vtkIdType cc = 0; cc < numTuples; ++cc)
+  {
+    points->SetPoint(cc, static_cast<double>(cc), 0.0, 0.0);
+  }
+  polydata->SetPoints(points);
+  polydata->GetPointData()->AddArray(vectors);
+  polydata->GetPointData()->AddArray(scalars);
+
+  vtkNew<vtkPVDataInformation> dataInfo;
+  dataInfo->SetRestrictArrayRanges(true);
+  dataInfo->AddRangeArrayName("scalars");
+  dataInfo->CopyFromObject(polydata);
+  vtkPVArrayInformation* scalarsInfo =
+    dataInfo->GetArrayInformation("scalars", vtkDataObject::FIELD_ASSOCIATION_POINTS);
+  vtkPVArrayInformation* vectorsInfo =
+    dataInfo->GetArrayInformation("vectors", vtkDataObject::FIELD_ASSOCIATION_POINTS);
+  if (!scalarsInfo || !vectorsInfo || !IsValidRange(scalarsInfo->GetComponentRange(0)) ||
+    IsValidRange(vectorsInfo->GetComponentRange(0)))
+  {
+    cerr << "ERROR: RestrictArrayRanges did not select the expected arrays." << endl;
+    success = false;
+  }
+
+  dataInfo->SetRestrictArrayRanges(false);
+  dataInfo->CopyFromObject(polydata);
+  vectorsInfo = dataInfo->GetArrayInformation("vectors", vtkDataObject::FIELD_ASSOCIATION_POINTS);
+  if (!vectorsInfo || !CheckRanges(vectors, vectorsInfo))
+  {
+    cerr << "ERROR: ranges missing once RestrictArrayRanges is off." << endl;
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVTraceInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Records events from several threads with vtkPVTraceRecorder, checks that
+// vtkPVTraceInformation gathers them, that they survive serialization and
+// that the oldest events are dropped once a thread's buffer is full, then
+// writes the timeline out in the Chrome trace format.
+
+#include "vtkClientServerStream.h"
+#include "vtkNew.h"
+#include "vtkPVTraceInformation.h"
+#include "vtkPVTraceRecorder.h"
+#include "vtkTestUtilities.h"
+
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+int TestPVTraceInformation(int argc, char* argv[])
+{
+  bool success = true;
+
+  vtkPVTraceRecorder::SetBufferSize(16);
+  {
+    vtkPVTraceScope("test", "ignored while disabled");
+  }
+  vtkPVTraceRecorder::SetEnabled(1);
+
+  const int numThreads = 4;
+  const int numEventsPerThread = 10;
+  std::vector<std::thread> threads;
+  for (int cc = 0; cc < numThreads; ++cc)
+  {
+    threads.emplace_back([cc]() {
+      const std::string name = "thread " + std::to_string(cc);
+      for (int event = 0; event < numEventsPerThread; ++event)
+      {
+        vtkPVTraceScope("test", name.c_str());
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  vtkNew<vtkPVTraceInformation> info;
+  info->CopyFromObject(nullptr);
+  const auto& events = info->GetTimelineEvents(0);
+  std::set<int> threadIds;
+  for (const auto& event : events)
+  {
+    threadIds.insert(event.ThreadId);
+    if (event.Category != "test" || event.Duration < 0 ||
+      event.Name.compare(0, 7, "thread ") != 0)
+    {
+      cerr << "ERROR: unexpected event " << event.Category << "/" << event.Name << endl;
+      success = false;
+    }
+  }
+  if (info->GetNumberOfTimelines() != 1 ||
+    events.size() != static_cast<size_t>(numThreads * numEventsPerThread) ||
+    threadIds.size() != static_cast<size_t>(numThreads))
+  {
+    cerr << "ERROR: expected " << numThreads * numEventsPerThread << " events from "
+         << numThreads << " threads, got " << events.size() << " from " << threadIds.size()
+         << endl;
+    success = false;
+  }
+
+  // round trip through a stream, as when gathered from another process.
+  vtkClientServerStream stream;
+  info->CopyToStream(&stream);
+  vtkNew<vtkPVTraceInformation> copy;
+  copy->CopyFromStream(&stream);
+  copy->AddInformation(info);
+  if (copy->GetNumberOfTimelines() != 2 ||
+    copy->GetTimelineEvents(0).size() != events.size() ||
+    copy->GetTimelineEvents(0).back().Begin != events.back().Begin ||
+    copy->GetTimelineEvents(0).back().Name != events.back().Name ||
+    copy->GetCollectionTime() != info->GetCollectionTime())
+  {
+    cerr << "ERROR: events changed by serialization." << endl;
+    success = false;
+  }
+
+  // only the last 16 events of this thread are kept.
+  vtkPVTraceRecorder::ResetEvents();
+  for (int event = 0; event < 20; ++event)
+  {
+    vtkPVTraceRecorder::RecordEvent(
+      "test", "ring", vtkPVTraceRecorder::GetTime(), vtkPVTraceRecorder::GetTime());
+  }
+  std::vector<vtkPVTraceRecorder::EventRecord> ring;
+  vtkPVTraceRecorder::GetEvents(ring);
+  if (ring.size() != 16)
+  {
+    cerr << "ERROR: expected 16 events once the buffer wrapped, got " << ring.size() << endl;
+    success = false;
+  }
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string filename = std::string(tempDir) + "/TestPVTraceInformation.json";
+  delete[] tempDir;
+  if (!copy->WriteChromeTrace(filename.c_str()))
+  {
+    cerr << "ERROR: failed to write " << filename << endl;
+    success = false;
+  }
+
+  vtkPVTraceRecorder::SetEnabled(0);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -15,21 +15,29 @@
 #include "vtkPVArrayInformation.h"
 
 #include "vtkAbstractArray.h"
+#include "vtkArrayDispatch.h"
 #include "vtkClientServerStream.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkInformation.h"
 #include "vtkInformationIterator.h"
 #include "vtkInformationKey.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVPostFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStringArray.h"
 #include "vtkVariant.h"
 #include "vtkVariantArray.h"
+#include "vtkWeakPointer.h"
 
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <map>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <vector>
@@ -55,6 +63,247 @@ class vtkPVArrayInformation::vtkInternalInformationKeys : public vtkInternalInfo
 {
 };
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Computes the ranges and finite ranges of all the components, and of the
+// magnitude for arrays with several components, in a single parallel pass.
+// Ranges are laid out as in vtkPVArrayInformation: magnitude first, then
+// each component. As in vtkDataArray::GetRange(), NaN values are ignored by
+// the ranges and all non-finite values by the finite ranges.
+template <typename ArrayT>
+class vtkPVArrayRangeFunctor
+{
+public:
+  vtkPVArrayRangeFunctor(ArrayT* array)
+    : Array(array)
+    , NumberOfComponents(array->GetNumberOfComponents())
+    , NumberOfRanges(array->GetNumberOfComponents() > 1 ? array->GetNumberOfComponents() + 1 : 1)
+  {
+  }
+
+  void Initialize()
+  {
+    std::vector<double>& ranges = this->Ranges.Local();
+    ranges.resize(4 * this->NumberOfRanges);
+    for (int cc = 0; cc < 2 * this->NumberOfRanges; ++cc)
+    {
+      ranges[2 * cc] = VTK_DOUBLE_MAX;
+      ranges[2 * cc + 1] = -VTK_DOUBLE_MAX;
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkDataArrayAccessor<ArrayT> accessor(this->Array);
+    double* ranges = this->Ranges.Local().data();
+    double* finiteRanges = ranges + 2 * this->NumberOfRanges;
+    const int numComps = this->NumberOfComponents;
+    const int first = numComps > 1 ? 1 : 0;
+    for (vtkIdType tuple = begin; tuple < end; ++tuple)
+    {
+      double squaredSum = 0.0;
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        const double value = static_cast<double>(accessor.Get(tuple, comp));
+        squaredSum += value * value;
+        double* range = ranges + 2 * (first + comp);
+        double* finiteRange = finiteRanges + 2 * (first + comp);
+        if (!std::isnan(value))
+        {
+          range[0] = std::min(range[0], value);
+          range[1] = std::max(range[1], value);
+          if (!std::isinf(value))
+          {
+            finiteRange[0] = std::min(finiteRange[0], value);
+            finiteRange[1] = std::max(finiteRange[1], value);
+          }
+        }
+      }
+      if (first && !std::isnan(squaredSum))
+      {
+        ranges[0] = std::min(ranges[0], squaredSum);
+        ranges[1] = std::max(ranges[1], squaredSum);
+        if (!std::isinf(squaredSum))
+        {
+          finiteRanges[0] = std::min(finiteRanges[0], squaredSum);
+          finiteRanges[1] = std::max(finiteRanges[1], squaredSum);
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    this->Result.resize(4 * this->NumberOfRanges);
+    for (int cc = 0; cc < 2 * this->NumberOfRanges; ++cc)
+    {
+      this->Result[2 * cc] = VTK_DOUBLE_MAX;
+      this->Result[2 * cc + 1] = -VTK_DOUBLE_MAX;
+    }
+    for (const std::vector<double>& ranges : this->Ranges)
+    {
+      for (int cc = 0; cc < 2 * this->NumberOfRanges; ++cc)
+      {
+        this->Result[2 * cc] = std::min(this->Result[2 * cc], ranges[2 * cc]);
+        this->Result[2 * cc + 1] = std::max(this->Result[2 * cc + 1], ranges[2 * cc + 1]);
+      }
+    }
+    if (this->NumberOfComponents > 1)
+    {
+      // Magnitudes were accumulated squared.
+      for (int offset : { 0, 2 * this->NumberOfRanges })
+      {
+        if (this->Result[offset] <= this->Result[offset + 1])
+        {
+          this->Result[offset] = std::sqrt(this->Result[offset]);
+          this->Result[offset + 1] = std::sqrt(this->Result[offset + 1]);
+        }
+      }
+    }
+  }
+
+  // Ranges followed by finite ranges.
+  std::vector<double> Result;
+
+private:
+  ArrayT* Array;
+  int NumberOfComponents;
+  int NumberOfRanges;
+  vtkSMPThreadLocal<std::vector<double> > Ranges;
+};
+
+struct vtkPVArrayRangeWorker
+{
+  std::vector<double>* Result;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    vtkPVArrayRangeFunctor<ArrayT> functor(array);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), functor);
+    if (functor.Result.empty())
+    {
+      functor.Reduce();
+    }
+    this->Result->swap(functor.Result);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Ranges computed for the arrays seen recently. Information is gathered
+// again after every apply and time change, most arrays have not changed
+// since. An entry is valid while the array is alive and has the same
+// modification time, buffer and size.
+class vtkPVArrayRangeCache
+{
+public:
+  static void GetRanges(vtkDataArray* array, double* ranges, double* finiteRanges)
+  {
+    const int numComps = array->GetNumberOfComponents();
+    const size_t numValues = 2 * static_cast<size_t>(numComps > 1 ? numComps + 1 : 1);
+    void* buffer = array->HasStandardMemoryLayout() ? array->GetVoidPointer(0) : nullptr;
+
+    vtkPVArrayRangeCache& cache = vtkPVArrayRangeCache::GetInstance();
+    {
+      std::lock_guard<std::mutex> lock(cache.Mutex);
+      auto iter = cache.Entries.find(array);
+      if (iter != cache.Entries.end())
+      {
+        const Entry& entry = iter->second;
+        if (entry.Array == array && entry.MTime == array->GetMTime() && entry.Buffer == buffer &&
+          entry.NumberOfTuples == array->GetNumberOfTuples() &&
+          entry.Ranges.size() == 2 * numValues)
+        {
+          std::copy(entry.Ranges.begin(), entry.Ranges.begin() + numValues, ranges);
+          std::copy(entry.Ranges.begin() + numValues, entry.Ranges.end(), finiteRanges);
+          return;
+        }
+      }
+    }
+
+    Entry entry;
+    entry.Array = array;
+    entry.MTime = array->GetMTime();
+    entry.Buffer = buffer;
+    entry.NumberOfTuples = array->GetNumberOfTuples();
+    vtkPVArrayRangeWorker worker = { &entry.Ranges };
+    if (!vtkArrayDispatch::Dispatch::Execute(array, worker))
+    {
+      // the generic vtkDataArray API is not safe to use from several threads.
+      vtkPVArrayRangeCache::GetSerialRanges(array, entry.Ranges);
+    }
+    std::copy(entry.Ranges.begin(), entry.Ranges.begin() + numValues, ranges);
+    std::copy(entry.Ranges.begin() + numValues, entry.Ranges.end(), finiteRanges);
+
+    std::lock_guard<std::mutex> lock(cache.Mutex);
+    if (cache.Entries.size() >= 4096)
+    {
+      cache.Prune();
+    }
+    cache.Entries[array] = std::move(entry);
+  }
+
+private:
+  struct Entry
+  {
+    vtkWeakPointer<vtkDataArray> Array;
+    vtkMTimeType MTime;
+    void* Buffer;
+    vtkIdType NumberOfTuples;
+    std::vector<double> Ranges;
+  };
+
+  // Ranges followed by finite ranges, as computed by vtkPVArrayRangeFunctor,
+  // using vtkDataArray's own serial implementation.
+  static void GetSerialRanges(vtkDataArray* array, std::vector<double>& result)
+  {
+    const int numComps = array->GetNumberOfComponents();
+    result.clear();
+    for (bool finite : { false, true })
+    {
+      for (int comp = (numComps > 1 ? -1 : 0); comp < numComps; ++comp)
+      {
+        double range[2];
+        if (finite)
+        {
+          array->GetFiniteRange(range, comp);
+        }
+        else
+        {
+          array->GetRange(range, comp);
+        }
+        result.push_back(range[0]);
+        result.push_back(range[1]);
+      }
+    }
+  }
+
+  static vtkPVArrayRangeCache& GetInstance()
+  {
+    static vtkPVArrayRangeCache instance;
+    return instance;
+  }
+
+  // Forget the arrays that no longer exist, and everything if that is not
+  // enough.
+  void Prune()
+  {
+    for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+    {
+      iter = iter->second.Array == nullptr ? this->Entries.erase(iter) : std::next(iter);
+    }
+    if (this->Entries.size() >= 4096)
+    {
+      this->Entries.clear();
+    }
+  }
+
+  std::mutex Mutex;
+  std::map<vtkDataArray*, Entry> Entries;
+};
+}
+
 vtkStandardNewMacro(vtkPVArrayInformation);
 
 //----------------------------------------------------------------------------
@@ -67,6 +316,7 @@ vtkPVArrayInformation::vtkPVArrayInformation()
   this->DefaultComponentName = NULL;
   this->InformationKeys = NULL;
   this->IsPartial = 0;
+  this->ComputeRanges = true;
   this->Initialize();
 }
 
@@ -633,39 +883,21 @@ void vtkPVArrayInformation::CopyFromObject(vtkObject* obj)
     }
   }
 
-  if (vtkDataArray* const data_array = vtkDataArray::SafeDownCast(obj))
+  vtkDataArray* const data_array = vtkDataArray::SafeDownCast(obj);
+  if (data_array && this->NumberOfComponents > 0)
   {
-    double range[2];
-    double* ptr;
-    int idx;
-
-    ptr = this->Ranges;
-    if (this->NumberOfComponents > 1)
-    {
-      // First store range of vector magnitude.
-      data_array->GetRange(range, -1);
-      *ptr++ = range[0];
-      *ptr++ = range[1];
-    }
-    for (idx = 0; idx < this->NumberOfComponents; ++idx)
+    const int numRanges = this->NumberOfComponents > 1 ? this->NumberOfComponents + 1 : 1;
+    if (this->ComputeRanges)
     {
-      data_array->GetRange(range, idx);
-      *ptr++ = range[0];
-      *ptr++ = range[1];
+      vtkPVArrayRangeCache::GetRanges(data_array, this->Ranges, this->FiniteRanges);
     }
-    ptr = this->FiniteRanges;
-    if (this->NumberOfComponents > 1)
-    {
-      // First store range of vector magnitude.
-      data_array->GetFiniteRange(range, -1);
-      *ptr++ = range[0];
-      *ptr++ = range[1];
-    }
-    for (idx = 0; idx < this->NumberOfComponents; ++idx)
+    else
     {
-      data_array->GetFiniteRange(range, idx);
-      *ptr++ = range[0];
-      *ptr++ = range[1];
+      for (int idx = 0; idx < numRanges; ++idx)
+      {
+        this->Ranges[2 * idx] = this->FiniteRanges[2 * idx] = VTK_DOUBLE_MAX;
+        this->Ranges[2 * idx + 1] = this->FiniteRanges[2 * idx + 1] = -VTK_DOUBLE_MAX;
+      }
     }
   }
 
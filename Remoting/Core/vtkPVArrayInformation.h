@@ -143,6 +143,18 @@ public:
    */
   void CopyFromObject(vtkObject*) override;
 
+  //@{
+  /**
+   * When false, CopyFromObject() does not compute the ranges of the array
+   * and leaves them invalid (VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX). Default is
+   * true. This only controls how the information is gathered and is not
+   * copied or serialized.
+   */
+  vtkSetMacro(ComputeRanges, bool);
+  vtkGetMacro(ComputeRanges, bool);
+  vtkBooleanMacro(ComputeRanges, bool);
+  //@}
+
   /**
    * Merge another information object.
    */
@@ -201,6 +213,7 @@ protected:
   char* Name;
   double* Ranges;
   double* FiniteRanges;
+  bool ComputeRanges;
 
   // this array is used to store existing information keys (location/name pairs)
 
@@ -63,6 +63,30 @@ vtkStandardNewMacro(vtkPVDataInformation);
 
 std::map<std::string, std::string> helpers;
 
+namespace
+{
+// The vtkPVDataInformation restricting array ranges while it gathers
+// information, for the information objects it creates for the blocks.
+thread_local const vtkPVDataInformation* vtkPVDataInformationRangeRestriction = nullptr;
+
+class vtkPVDataInformationRangeScope
+{
+public:
+  vtkPVDataInformationRangeScope(const vtkPVDataInformation* self, bool restrictRanges)
+    : Previous(vtkPVDataInformationRangeRestriction)
+  {
+    if (restrictRanges)
+    {
+      vtkPVDataInformationRangeRestriction = self;
+    }
+  }
+  ~vtkPVDataInformationRangeScope() { vtkPVDataInformationRangeRestriction = this->Previous; }
+
+private:
+  const vtkPVDataInformation* Previous;
+};
+}
+
 //----------------------------------------------------------------------------
 vtkPVDataInformation::vtkPVDataInformation()
 {
@@ -114,20 +138,60 @@ vtkPVDataInformation::~vtkPVDataInformation()
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyParametersToStream(vtkMultiProcessStream& str)
 {
-  str << 828792 << this->PortNumber;
+  str << 828792 << this->PortNumber << (this->RestrictArrayRanges ? 1 : 0)
+      << static_cast<int>(this->RangeArrayNames.size());
+  for (const std::string& name : this->RangeArrayNames)
+  {
+    str << name;
+  }
 }
 
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
 {
-  int magic_number;
-  str >> magic_number >> this->PortNumber;
+  int magic_number, restrictRanges, count;
+  str >> magic_number >> this->PortNumber >> restrictRanges >> count;
   if (magic_number != 828792)
   {
     vtkErrorMacro("Magic number mismatch.");
+    return;
+  }
+  this->RestrictArrayRanges = restrictRanges != 0;
+  this->RangeArrayNames.clear();
+  for (int cc = 0; cc < count; ++cc)
+  {
+    std::string name;
+    str >> name;
+    this->RangeArrayNames.insert(name);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataInformation::AddRangeArrayName(const char* name)
+{
+  if (name && this->RangeArrayNames.insert(name).second)
+  {
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataInformation::ClearRangeArrayNames()
+{
+  if (!this->RangeArrayNames.empty())
+  {
+    this->RangeArrayNames.clear();
+    this->Modified();
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVDataInformation::ShouldComputeArrayRange(const char* name)
+{
+  const vtkPVDataInformation* self = vtkPVDataInformationRangeRestriction;
+  return self == nullptr || (name && self->RangeArrayNames.count(name) > 0);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -135,6 +199,7 @@ void vtkPVDataInformation::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "PortNumber: " << this->PortNumber << endl;
+  os << indent << "RestrictArrayRanges: " << this->RestrictArrayRanges << endl;
   os << indent << "DataSetType: " << this->DataSetType << endl;
   os << indent << "CompositeDataSetType: " << this->CompositeDataSetType << endl;
   os << indent << "NumberOfPoints: " << this->NumberOfPoints << endl;
@@ -729,6 +794,9 @@ void vtkPVDataInformation::CopyFromHyperTreeGrid(vtkHyperTreeGrid* data)
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyFromObject(vtkObject* object)
 {
+  // Also applies to the information gathered for each block.
+  vtkPVDataInformationRangeScope rangeScope(this, this->RestrictArrayRanges);
+
   vtkDataObject* dobj = vtkDataObject::SafeDownCast(object);
   vtkInformation* info = nullptr;
   // Handle the case where the a vtkAlgorithmOutput is passed instead of
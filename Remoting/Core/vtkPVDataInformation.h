@@ -33,6 +33,9 @@
 #include "vtkPVInformation.h"
 #include "vtkRemotingCoreModule.h" //needed for exports
 
+#include <set>    // for std::set
+#include <string> // for std::string
+
 class vtkCollection;
 class vtkCompositeDataSet;
 class vtkDataObject;
@@ -76,6 +79,30 @@ public:
   vtkGetMacro(PortNumber, int);
   //@}
 
+  //@{
+  /**
+   * By default, the ranges of all arrays are computed, which can take longer
+   * than producing the data itself for datasets with many arrays. When
+   * RestrictArrayRanges is true, ranges are only computed for the point,
+   * cell, field, vertex, edge and row arrays named with AddRangeArrayName(),
+   * e.g. the arrays the application currently displays. Other arrays report
+   * an invalid range (VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX). These parameters are
+   * set on the client-side before gathering the information, like
+   * PortNumber.
+   */
+  vtkSetMacro(RestrictArrayRanges, bool);
+  vtkGetMacro(RestrictArrayRanges, bool);
+  void AddRangeArrayName(const char* name);
+  void ClearRangeArrayNames();
+  //@}
+
+  /**
+   * Returns true if the range of the named array is to be computed by the
+   * vtkPVDataInformation currently gathering information in this thread.
+   * Used by vtkPVDataSetAttributesInformation.
+   */
+  static bool ShouldComputeArrayRange(const char* name);
+
   /**
    * Transfer information about a single object into this object.
    */
@@ -369,6 +396,8 @@ private:
   void operator=(const vtkPVDataInformation&) = delete;
 
   int PortNumber = -1;
+  bool RestrictArrayRanges = false;
+  std::set<std::string> RangeArrayNames;
 };
 
 #endif
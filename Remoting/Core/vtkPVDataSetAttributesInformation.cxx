@@ -24,6 +24,7 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVArrayInformation.h"
+#include "vtkPVDataInformation.h"
 #include "vtkPVGenericAttributeInformation.h"
 #include "vtkSmartPointer.h"
 
@@ -151,6 +152,7 @@ void vtkPVDataSetAttributesInformation::CopyFromFieldData(vtkFieldData* da)
     if (array != NULL && !vtkSkipArray(array->GetName()))
     {
       vtkNew<vtkPVArrayInformation> info;
+      info->SetComputeRanges(vtkPVDataInformation::ShouldComputeArrayRange(array->GetName()));
       info->CopyFromObject(array);
       internals.ArrayInformation[array->GetName()] = info.Get();
     }
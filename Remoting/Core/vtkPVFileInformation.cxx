@@ -24,6 +24,7 @@
 #include "vtkPVFileInformationHelper.h"
 #include "vtkProcessModule.h"
 #include "vtkResourceFileLocator.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkVersion.h"
 
@@ -53,6 +54,7 @@
 #include <set>
 #include <string>
 #include <time.h>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 #include <vtksys/SystemTools.hxx>
 
@@ -351,12 +353,51 @@ class vtkPVFileInformationSet : public std::set<vtkSmartPointer<vtkPVFileInforma
 {
 };
 
+//-----------------------------------------------------------------------------
+// The last directory listing, so that it can be sent one page at a time
+// without listing the directory for every page. Each listing gets a new
+// Generation, sent with every page, so that clients notice when the pages
+// they get come from different listings. The listing is released once its
+// last page is sent, and not reused when it was not used for a while.
+namespace
+{
+struct vtkPVFileInformationListingCache
+{
+  std::string FullPath;
+  time_t ModificationTime = 0;
+  int FastFileTypeDetection = 0;
+  bool ReadDetailedFileInformation = false;
+  std::vector<vtkSmartPointer<vtkPVFileInformation> > Contents;
+  int Generation = 0;
+  time_t LastUsed = 0;
+
+  // in seconds.
+  static const int Lifetime = 60;
+};
+
+vtkPVFileInformationListingCache& GetListingCache()
+{
+  static vtkPVFileInformationListingCache cache;
+  return cache;
+}
+
+time_t vtkPVFileInformationGetModificationTime(const char* path)
+{
+  vtksys::SystemTools::Stat_t status;
+  if (vtksys::SystemTools::Stat(path, &status) == -1)
+  {
+    return 0;
+  }
+  return status.st_mtime;
+}
+}
+
 //-----------------------------------------------------------------------------
 vtkPVFileInformation::vtkPVFileInformation()
 {
   this->RootOnly = 1;
   this->Contents = vtkCollection::New();
-  this->SequenceParser = vtkFileSequenceParser::New();
+  this->SequenceParser = NULL; // only directories need one.
   this->Type = INVALID;
   this->Name = NULL;
   this->FullPath = NULL;
@@ -365,6 +406,8 @@ vtkPVFileInformation::vtkPVFileInformation()
   this->Hidden = false;
   this->Extension = NULL;
   this->Size = 0;
+  this->TotalNumberOfContents = 0;
+  this->ListingGeneration = 0;
 #ifdef _WIN32
   this->ModificationTime = _time64(NULL);
 #else
@@ -376,7 +419,10 @@ vtkPVFileInformation::vtkPVFileInformation()
 vtkPVFileInformation::~vtkPVFileInformation()
 {
   this->Contents->Delete();
-  this->SequenceParser->Delete();
+  if (this->SequenceParser)
+  {
+    this->SequenceParser->Delete();
+  }
   this->SetName(NULL);
   this->SetFullPath(NULL);
   this->SetExtension(NULL);
@@ -466,13 +512,61 @@ void vtkPVFileInformation::CopyFromObject(vtkObject* object)
 
   if (this->IsDirectory(this->Type) && helper->GetDirectoryListing())
   {
+    // The cached listing is used if the directory did not change, except
+    // for the first page of a detailed listing since the size and time of
+    // files are not covered by the modification time of the directory.
+    // Directories that cannot be stat'ed (network roots) are never cached.
+    vtkPVFileInformationListingCache& cache = GetListingCache();
+    const time_t mtime = vtkPVFileInformationGetModificationTime(this->FullPath);
+    const time_t now = time(NULL);
+    const int offset = helper->GetListingOffset();
+    if (mtime == 0 || cache.FullPath != this->FullPath || cache.ModificationTime != mtime ||
+      cache.FastFileTypeDetection != this->FastFileTypeDetection ||
+      cache.ReadDetailedFileInformation != this->ReadDetailedFileInformation ||
+      (offset == 0 && this->ReadDetailedFileInformation) ||
+      now - cache.LastUsed > vtkPVFileInformationListingCache::Lifetime)
+    {
 // Since we want a directory listing, we now to platform specific listing
 // with intelligent pattern matching hee-haa.
 #if defined(_WIN32)
-    this->GetWindowsDirectoryListing();
+      this->GetWindowsDirectoryListing();
 #else
-    this->GetDirectoryListing();
+      this->GetDirectoryListing();
 #endif
+      cache.FullPath = this->FullPath;
+      cache.ModificationTime = mtime;
+      cache.FastFileTypeDetection = this->FastFileTypeDetection;
+      cache.ReadDetailedFileInformation = this->ReadDetailedFileInformation;
+      ++cache.Generation;
+      cache.Contents.clear();
+      cache.Contents.reserve(this->Contents->GetNumberOfItems());
+      vtkCollectionSimpleIterator cookie;
+      this->Contents->InitTraversal(cookie);
+      while (vtkObject* item = this->Contents->GetNextItemAsObject(cookie))
+      {
+        cache.Contents.push_back(vtkPVFileInformation::SafeDownCast(item));
+      }
+      this->Contents->RemoveAllItems();
+    }
+
+    // Only keep the requested page.
+    const int numberOfItems = static_cast<int>(cache.Contents.size());
+    const int pageSize = helper->GetListingPageSize();
+    const int end =
+      (pageSize > 0 && pageSize < numberOfItems - offset) ? offset + pageSize : numberOfItems;
+    for (int cc = offset; cc < end; ++cc)
+    {
+      this->Contents->AddItem(cache.Contents[cc]);
+    }
+    this->TotalNumberOfContents = numberOfItems;
+    this->ListingGeneration = cache.Generation;
+    cache.LastUsed = now;
+    if (end >= numberOfItems)
+    {
+      // the whole listing was sent.
+      cache.FullPath.clear();
+      cache.Contents.clear();
+    }
   }
 }
 
@@ -840,7 +934,7 @@ void vtkPVFileInformation::GetDirectoryListing()
 
 #else
 
-  vtkPVFileInformationSet info_set;
+  std::vector<vtkSmartPointer<vtkPVFileInformation> > entries;
   std::string prefix = this->FullPath;
   vtkPVFileInformationAddTerminatingSlash(prefix);
 
@@ -860,76 +954,101 @@ void vtkPVFileInformation::GetDirectoryListing()
     {
       continue;
     }
-    vtkPVFileInformation* info = vtkPVFileInformation::New();
+    vtkNew<vtkPVFileInformation> info;
     info->SetName(d->d_name);
     info->SetFullPath((prefix + d->d_name).c_str());
     info->Type = INVALID;
     info->SetHiddenFlag();
-
-    vtksys::SystemTools::Stat_t status;
-    int res;
-    if (this->ReadDetailedFileInformation)
+#if !(defined(__SVR4) && defined(__sun))
+    if (d->d_type & DT_DIR)
     {
-      // Recover status info
-      res = vtksys::SystemTools::Stat(info->FullPath, &status);
-      if (res != -1)
+      info->Type = DIRECTORY;
+    }
+#endif
+    info->FastFileTypeDetection = this->FastFileTypeDetection;
+    entries.push_back(info.Get());
+  }
+  closedir(dir);
+
+  // Stat is slow on network file systems, so the entries are stat'ed
+  // concurrently.
+  const bool readDetails = this->ReadDetailedFileInformation;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(entries.size()),
+    [&entries, readDetails](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
       {
-        if (!S_ISDIR(status.st_mode))
+        vtkPVFileInformation* info = entries[cc];
+        vtksys::SystemTools::Stat_t status;
+        int res = -1;
+        if (readDetails)
         {
-          std::string::size_type pos = std::string(d->d_name).rfind('.');
-          if (pos != std::string::npos)
+          // Recover status info
+          res = vtksys::SystemTools::Stat(info->FullPath, &status);
+          if (res != -1)
           {
-            std::string ext = std::string(d->d_name).substr(pos + 1);
-            info->SetExtension(ext.c_str());
+            if (!S_ISDIR(status.st_mode))
+            {
+              std::string::size_type pos = std::string(info->Name).rfind('.');
+              if (pos != std::string::npos)
+              {
+                std::string ext = std::string(info->Name).substr(pos + 1);
+                info->SetExtension(ext.c_str());
+              }
+            }
+            info->Size = status.st_size;
+            info->ModificationTime = status.st_mtime;
           }
         }
-        info->Size = status.st_size;
-        info->ModificationTime = status.st_mtime;
-      }
-    }
 // fix to bug #09452 such that directories with trailing names can be
 // shown in the file dialog
 #if defined(__SVR4) && defined(__sun)
-    if (!this->ReadDetailedFileInformation)
-    {
-      res = vtksys::SystemTools::Stat(info->FullPath, &status);
-    }
-    if (res != -1 && status.st_mode & S_IFDIR)
-    {
-      info->Type = DIRECTORY;
-    }
+        if (!readDetails)
+        {
+          res = vtksys::SystemTools::Stat(info->FullPath, &status);
+        }
+        if (res != -1 && status.st_mode & S_IFDIR)
+        {
+          info->Type = DIRECTORY;
+        }
 #else
-    if (d->d_type & DT_DIR)
-    {
-      info->Type = DIRECTORY;
-    }
+        (void)res;
 #endif
+      }
+    });
 
-    info->FastFileTypeDetection = this->FastFileTypeDetection;
-    info_set.insert(info);
-    info->Delete();
-  }
-  closedir(dir);
+  vtkPVFileInformationSet info_set;
+  info_set.insert(entries.begin(), entries.end());
+  entries.clear();
 
   this->OrganizeCollection(info_set);
 
   // Now we detect the file types for items.
   // We dissolve any groups that contain non-file items.
+  // Detecting the type stats files, so it is done concurrently too.
+  std::vector<vtkPVFileInformation*> items(info_set.begin(), info_set.end());
+  std::vector<unsigned char> detected(items.size(), 0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(items.size()),
+    [&items, &detected](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        detected[cc] = items[cc]->DetectType() ? 1 : 0;
+      }
+    });
 
-  for (vtkPVFileInformationSet::iterator iter = info_set.begin(); iter != info_set.end(); ++iter)
+  for (size_t cc = 0; cc < items.size(); ++cc)
   {
-    vtkPVFileInformation* obj = (*iter);
-    if (obj->DetectType())
+    vtkPVFileInformation* obj = items[cc];
+    if (detected[cc])
     {
       this->Contents->AddItem(obj);
     }
     else
     {
       // Add children to contents.
-      for (int cc = 0; cc < obj->Contents->GetNumberOfItems(); cc++)
+      for (int kk = 0; kk < obj->Contents->GetNumberOfItems(); kk++)
       {
         vtkPVFileInformation* child =
-          vtkPVFileInformation::SafeDownCast(obj->Contents->GetItemAsObject(cc));
+          vtkPVFileInformation::SafeDownCast(obj->Contents->GetItemAsObject(kk));
         if (child->DetectType())
         {
           this->Contents->AddItem(child);
@@ -1019,6 +1138,11 @@ void vtkPVFileInformation::OrganizeCollection(vtkPVFileInformationSet& info_set)
   std::string prefix = this->FullPath;
   vtkPVFileInformationAddTerminatingSlash(prefix);
 
+  if (!this->SequenceParser)
+  {
+    this->SequenceParser = vtkFileSequenceParser::New();
+  }
+
   for (vtkPVFileInformationSet::iterator iter = info_set.begin(); iter != info_set.end();)
   {
     vtkSmartPointer<vtkPVFileInformation> obj = *iter;
@@ -1099,7 +1223,7 @@ void vtkPVFileInformation::CopyToStream(vtkClientServerStream* stream)
 {
   *stream << vtkClientServerStream::Reply << this->Name << this->FullPath << this->Type
           << this->Hidden << this->Contents->GetNumberOfItems() << this->Extension << this->Size
-          << this->ModificationTime;
+          << this->ModificationTime << this->TotalNumberOfContents << this->ListingGeneration;
 
   vtkSmartPointer<vtkCollectionIterator> iter;
   iter.TakeReference(this->Contents->NewIterator());
@@ -1166,11 +1290,21 @@ void vtkPVFileInformation::CopyFromStream(const vtkClientServerStream* css)
     vtkErrorMacro("Error parsing File extension.");
     return;
   }
+  if (!css->GetArgument(0, 8, &this->TotalNumberOfContents))
+  {
+    vtkErrorMacro("Error parsing Total number of contents.");
+    return;
+  }
+  if (!css->GetArgument(0, 9, &this->ListingGeneration))
+  {
+    vtkErrorMacro("Error parsing Listing generation.");
+    return;
+  }
   for (int cc = 0; cc < num_of_children; cc++)
   {
     vtkPVFileInformation* child = vtkPVFileInformation::New();
     vtkClientServerStream childStream;
-    if (!css->GetArgument(0, 8 + cc, &childStream))
+    if (!css->GetArgument(0, 10 + cc, &childStream))
     {
       vtkErrorMacro("Error parsing child #" << cc);
       return;
@@ -1191,6 +1325,8 @@ void vtkPVFileInformation::Initialize()
   this->Contents->RemoveAllItems();
   this->SetExtension(0);
   this->Size = 0;
+  this->TotalNumberOfContents = 0;
+  this->ListingGeneration = 0;
 #ifdef _WIN32
   this->ModificationTime = _time64(NULL);
 #else
@@ -1262,6 +1398,8 @@ void vtkPVFileInformation::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "Hidden: " << this->Hidden << endl;
   os << indent << "FastFileTypeDetection: " << this->FastFileTypeDetection << endl;
+  os << indent << "TotalNumberOfContents: " << this->TotalNumberOfContents << endl;
+  os << indent << "ListingGeneration: " << this->ListingGeneration << endl;
 
   for (int cc = 0; cc < this->Contents->GetNumberOfItems(); cc++)
   {
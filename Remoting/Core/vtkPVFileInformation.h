@@ -20,6 +20,11 @@
  * vtkPVFileInformation can be used to collect information about file
  * or directory. vtkPVFileInformation can collect information
  * from a vtkPVFileInformationHelper object alone.
+ *
+ * Directory listings can be requested one page at a time (see
+ * vtkPVFileInformationHelper::SetListingPageSize). The last listing is kept
+ * on the server so that the following pages do not list the directory again,
+ * it is listed again when the modification time of the directory changes.
  * @sa
  * vtkPVFileInformationHelper
 */
@@ -129,6 +134,20 @@ public:
   vtkGetMacro(ModificationTime, time_t);
   //@}
 
+  /**
+   * Get the number of items in the listing of this directory. When the
+   * listing is requested one page at a time, Contents only holds the
+   * requested page of this many items.
+   */
+  vtkGetMacro(TotalNumberOfContents, int);
+
+  /**
+   * Get the generation of the directory listing the Contents page comes from.
+   * It changes every time the directory is listed again, so pages with
+   * different generations must not be combined.
+   */
+  vtkGetMacro(ListingGeneration, int);
+
   /**
   * Returns the path to the base data directory path holding various files
   * packaged with ParaView.
@@ -159,6 +178,8 @@ protected:
   char* Extension;         // File extension
   long long Size;          // File size
   time_t ModificationTime; // File modification time
+  int TotalNumberOfContents; // Number of items in the whole directory listing
+  int ListingGeneration;     // Generation of the listing the Contents come from
 
   vtkSetStringMacro(Extension);
   vtkSetStringMacro(Name);
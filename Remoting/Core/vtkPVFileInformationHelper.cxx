@@ -34,6 +34,8 @@ vtkPVFileInformationHelper::vtkPVFileInformationHelper()
   this->SetPath(".");
   this->PathSeparator = 0;
   this->FastFileTypeDetection = 1;
+  this->ListingOffset = 0;
+  this->ListingPageSize = 0;
 #if defined(_WIN32) && !defined(__CYGWIN__)
   this->SetPathSeparator("\\");
 #else
@@ -75,6 +77,8 @@ void vtkPVFileInformationHelper::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PathSeparator: " << (this->PathSeparator ? this->PathSeparator : "(null)")
      << endl;
   os << indent << "FastFileTypeDetection: " << this->FastFileTypeDetection << endl;
+  os << indent << "ListingOffset: " << this->ListingOffset << endl;
+  os << indent << "ListingPageSize: " << this->ListingPageSize << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -100,6 +100,21 @@ public:
   vtkSetMacro(FastFileTypeDetection, int);
   //@}
 
+  //@{
+  /**
+   * Get/Set the page of the directory listing to get, when DirectoryListing
+   * is on. ListingOffset is the index of the first item of the page and
+   * ListingPageSize the maximum number of items. A ListingPageSize of 0
+   * (default) gets the whole listing.
+   * vtkPVFileInformation::GetTotalNumberOfContents() tells how many items
+   * there are in all.
+   */
+  vtkGetMacro(ListingOffset, int);
+  vtkSetClampMacro(ListingOffset, int, 0, VTK_INT_MAX);
+  vtkGetMacro(ListingPageSize, int);
+  vtkSetClampMacro(ListingPageSize, int, 0, VTK_INT_MAX);
+  //@}
+
   //@{
   /**
    * Returns the platform specific path separator.
@@ -148,6 +163,8 @@ protected:
   int DirectoryListing;
   int SpecialDirectories;
   int FastFileTypeDetection;
+  int ListingOffset;
+  int ListingPageSize;
 
   bool ReadDetailedFileInformation;
   char* PathSeparator;
@@ -63,6 +63,17 @@ public:
   virtual void CopyParametersFromStream(vtkMultiProcessStream&){};
   //@}
 
+  /**
+   * Returns true if AddInformation() can merge information objects that are
+   * themselves the result of merging several processes, i.e. if the merge is
+   * associative. When true (default), vtkPVSessionCore may collect
+   * information from satellites using a tree-based reduction where
+   * intermediate ranks merge partial results. Results are still merged in
+   * increasing rank order. Subclasses that expect each added object to come
+   * from a single process should override this to return false.
+   */
+  virtual bool GetSupportsTreeReduction() { return true; }
+
   //@{
   /**
    * Set/get whether to gather information only from the root.
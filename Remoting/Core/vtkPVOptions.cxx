@@ -61,6 +61,7 @@ vtkPVOptions::vtkPVOptions()
   this->SymmetricMPIMode = 0;
   this->TellVersion = 0;
   this->EnableStreaming = 0;
+  this->EnableConcurrentUpdates = 0;
   this->SatelliteMessageIds = 0;
   this->PrintMonitors = 0;
   this->ServerURL = 0;
@@ -256,6 +257,12 @@ void vtkPVOptions::Initialize()
     "views and representation types.",
     vtkPVOptions::ALLPROCESS);
 
+  this->AddBooleanArgument("--enable-concurrent-updates", 0, &this->EnableConcurrentUpdates,
+    "EXPERIMENTAL: When specified, views update the independent pipelines "
+    "feeding their representations concurrently. All the readers and filters "
+    "used must be thread-safe.",
+    vtkPVOptions::ALLPROCESS);
+
   this->AddBooleanArgument("--enable-satellite-message-ids", "-satellite",
     &this->SatelliteMessageIds,
     "When specified, server side messages shown on client show rank of originating process",
@@ -636,6 +643,8 @@ void vtkPVOptions::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "SymmetricMPIMode: " << this->SymmetricMPIMode << endl;
   os << indent << "ServerURL: " << (this->ServerURL ? this->ServerURL : "(none)") << endl;
   os << indent << "EnableStreaming:" << (this->EnableStreaming ? "yes" : "no") << endl;
+  os << indent << "EnableConcurrentUpdates:" << (this->EnableConcurrentUpdates ? "yes" : "no")
+     << endl;
 
   os << indent << "EnableStackTrace:" << (this->EnableStackTrace ? "yes" : "no") << endl;
 
@@ -182,6 +182,14 @@ public:
   vtkGetMacro(EnableStreaming, int);
   //@}
 
+  //@{
+  /**
+   * When set, views update the independent pipelines upstream of their
+   * representations concurrently. See vtkPVView::SetEnableConcurrentUpdates().
+   */
+  vtkGetMacro(EnableConcurrentUpdates, int);
+  //@}
+
   //@{
   /**
    * Include originating process id text into server to client messages.
@@ -356,6 +364,7 @@ private:
   int TellVersion;
   char* StereoType;
   int EnableStreaming;
+  int EnableConcurrentUpdates;
   int SatelliteMessageIds;
   int PrintMonitors;
   int EnableStackTrace;
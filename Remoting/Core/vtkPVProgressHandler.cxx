@@ -30,7 +30,11 @@
 #include "vtkTimerLog.h"
 
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 // define this variable to disable progress all together. This may be useful to
 // doing really large runs.
@@ -100,10 +104,19 @@ public:
   // between calls to PrepareProgress() and CleanupPendingProgress().
   bool EnableProgress;
 
+  // Thread that created the handler. Progress and messages reported from other
+  // threads, e.g. by pipelines that vtkPVView updates concurrently, cannot be
+  // forwarded safely: progress is ignored and messages are queued until
+  // FlushPendingMessages() is called from this thread.
+  std::thread::id OwnerThread;
+  std::mutex PendingMessagesMutex;
+  std::vector<std::pair<std::string, int> > PendingMessages;
+
   vtkNew<vtkTimerLog> ProgressTimer;
   vtkInternals()
   {
     this->EnableProgress = false;
+    this->OwnerThread = std::this_thread::get_id();
 
 #ifdef PV_DISABLE_PROGRESS_HANDLING
     this->DisableProgressHandling = true;
@@ -240,6 +253,7 @@ bool vtkPVProgressHandler::GetEnableProgress()
 void vtkPVProgressHandler::CleanupPendingProgress()
 {
   SKIP_IF_DISABLED();
+  this->FlushPendingMessages();
 
   if (!this->Internals->EnableProgress)
   {
@@ -316,7 +330,8 @@ void vtkPVProgressHandler::LocalCleanupPendingProgress()
 void vtkPVProgressHandler::OnProgressEvent(vtkObject* caller, unsigned long eventid, void* calldata)
 {
   SKIP_IF_DISABLED();
-  if (!this->Internals->EnableProgress || eventid != vtkCommand::ProgressEvent)
+  if (!this->Internals->EnableProgress || eventid != vtkCommand::ProgressEvent ||
+    std::this_thread::get_id() != this->Internals->OwnerThread)
   {
     return;
   }
@@ -475,11 +490,40 @@ void vtkPVProgressHandler::OnMessageEvent(vtkObject*, unsigned long eventid, voi
     case vtkCommand::MessageEvent:
     case vtkCommand::ErrorEvent:
     case vtkCommand::TextEvent:
+      if (std::this_thread::get_id() != this->Internals->OwnerThread)
+      {
+        const char* message = reinterpret_cast<const char*>(calldata);
+        std::lock_guard<std::mutex> lock(this->Internals->PendingMessagesMutex);
+        this->Internals->PendingMessages.emplace_back(
+          message ? message : "", static_cast<int>(eventid));
+        return;
+      }
+      // keep the messages in the order in which they were reported.
+      this->FlushPendingMessages();
       this->RefreshMessage(reinterpret_cast<const char*>(calldata), eventid, /*is_local*/ true);
       break;
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVProgressHandler::FlushPendingMessages()
+{
+  if (std::this_thread::get_id() != this->Internals->OwnerThread)
+  {
+    return;
+  }
+
+  std::vector<std::pair<std::string, int> > messages;
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->PendingMessagesMutex);
+    messages.swap(this->Internals->PendingMessages);
+  }
+  for (const auto& message : messages)
+  {
+    this->RefreshMessage(message.first.c_str(), message.second, /*is_local*/ true);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVProgressHandler::RefreshMessage(const char* message, int etype, bool is_local)
 {
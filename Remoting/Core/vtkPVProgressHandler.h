@@ -98,6 +98,15 @@ public:
    */
   void LocalCleanupPendingProgress();
 
+  /**
+   * Forward the warning and error messages reported from threads other than
+   * the one that created this handler, e.g. while vtkPVView updates pipelines
+   * concurrently. These messages cannot be forwarded from those threads and are
+   * held until this method is called. Does nothing when called from another
+   * thread.
+   */
+  void FlushPendingMessages();
+
   //@{
   /**
     * Get/Set the progress interval in seconds. Progress events
@@ -0,0 +1,340 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVTraceInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVTraceInformation.h"
+
+#include "vtkClientServerStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkProcessModule.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <sstream>
+
+namespace
+{
+void WriteJSONString(ostream& os, const std::string& str)
+{
+  os << '"';
+  for (const char c : str)
+  {
+    switch (c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char escaped[8];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+          os << escaped;
+        }
+        else
+        {
+          os << c;
+        }
+        break;
+    }
+  }
+  os << '"';
+}
+
+const char* GetProcessTypeLabel()
+{
+  switch (vtkProcessModule::GetProcessType())
+  {
+    case vtkProcessModule::PROCESS_CLIENT:
+      return "client";
+    case vtkProcessModule::PROCESS_SERVER:
+      return "server";
+    case vtkProcessModule::PROCESS_DATA_SERVER:
+      return "data server";
+    case vtkProcessModule::PROCESS_RENDER_SERVER:
+      return "render server";
+    case vtkProcessModule::PROCESS_BATCH:
+      return "batch";
+    default:
+      return "process";
+  }
+}
+}
+
+vtkStandardNewMacro(vtkPVTraceInformation);
+//----------------------------------------------------------------------------
+vtkPVTraceInformation::vtkPVTraceInformation()
+  : CollectionTime(0)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVTraceInformation::~vtkPVTraceInformation()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::CopyFromObject(vtkObject*)
+{
+  std::ostringstream label;
+  label << GetProcessTypeLabel();
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  if (pm && pm->GetNumberOfLocalPartitions() > 1)
+  {
+    label << " " << pm->GetPartitionId();
+  }
+
+  this->Timelines.clear();
+  this->Timelines.resize(1);
+  this->Timelines[0].Label = label.str();
+  vtkPVTraceRecorder::GetEvents(this->Timelines[0].Events);
+  this->CollectionTime = vtkPVTraceRecorder::GetTime() + vtkPVTraceRecorder::GetClockOffset();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::AddInformation(vtkPVInformation* info)
+{
+  vtkPVTraceInformation* other = vtkPVTraceInformation::SafeDownCast(info);
+  if (other)
+  {
+    this->Timelines.insert(this->Timelines.end(), other->Timelines.begin(), other->Timelines.end());
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << this->CollectionTime
+       << static_cast<int>(this->Timelines.size());
+  for (const auto& timeline : this->Timelines)
+  {
+    // names and categories are repeated a lot; send each only once.
+    std::map<std::string, int> stringIds;
+    std::vector<const std::string*> strings;
+    const size_t numEvents = timeline.Events.size();
+    std::vector<int> categories(numEvents), names(numEvents), threads(numEvents);
+    std::vector<vtkTypeInt64> begins(numEvents), durations(numEvents);
+    for (size_t cc = 0; cc < numEvents; ++cc)
+    {
+      const auto& event = timeline.Events[cc];
+      for (int pass = 0; pass < 2; ++pass)
+      {
+        const std::string& str = pass == 0 ? event.Category : event.Name;
+        auto iter = stringIds.insert(std::make_pair(str, static_cast<int>(strings.size())));
+        if (iter.second)
+        {
+          strings.push_back(&iter.first->first);
+        }
+        (pass == 0 ? categories : names)[cc] = iter.first->second;
+      }
+      threads[cc] = event.ThreadId;
+      begins[cc] = event.Begin;
+      durations[cc] = event.Duration;
+    }
+
+    *css << timeline.Label.c_str() << static_cast<int>(numEvents)
+         << static_cast<int>(strings.size());
+    for (const std::string* str : strings)
+    {
+      *css << str->c_str();
+    }
+    if (numEvents > 0)
+    {
+      const int count = static_cast<int>(numEvents);
+      *css << vtkClientServerStream::InsertArray(categories.data(), count)
+           << vtkClientServerStream::InsertArray(names.data(), count)
+           << vtkClientServerStream::InsertArray(threads.data(), count)
+           << vtkClientServerStream::InsertArray(begins.data(), count)
+           << vtkClientServerStream::InsertArray(durations.data(), count);
+    }
+  }
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  this->Timelines.clear();
+
+  int arg = 0;
+  int numTimelines = 0;
+  if (!css->GetArgument(0, arg++, &this->CollectionTime) ||
+    !css->GetArgument(0, arg++, &numTimelines) || numTimelines < 0)
+  {
+    vtkErrorMacro("Error parsing trace information from message.");
+    return;
+  }
+
+  this->Timelines.resize(numTimelines);
+  for (auto& timeline : this->Timelines)
+  {
+    int numEvents = 0, numStrings = 0;
+    if (!css->GetArgument(0, arg++, &timeline.Label) ||
+      !css->GetArgument(0, arg++, &numEvents) || !css->GetArgument(0, arg++, &numStrings) ||
+      numStrings < 0)
+    {
+      vtkErrorMacro("Error parsing timeline from message.");
+      return;
+    }
+    std::vector<std::string> strings(numStrings);
+    for (auto& str : strings)
+    {
+      if (!css->GetArgument(0, arg++, &str))
+      {
+        vtkErrorMacro("Error parsing event names from message.");
+        return;
+      }
+    }
+    if (numEvents <= 0)
+    {
+      continue;
+    }
+
+    const vtkTypeUInt32 count = static_cast<vtkTypeUInt32>(numEvents);
+    std::vector<int> categories(count), names(count), threads(count);
+    std::vector<vtkTypeInt64> begins(count), durations(count);
+    if (!css->GetArgument(0, arg++, categories.data(), count) ||
+      !css->GetArgument(0, arg++, names.data(), count) ||
+      !css->GetArgument(0, arg++, threads.data(), count) ||
+      !css->GetArgument(0, arg++, begins.data(), count) ||
+      !css->GetArgument(0, arg++, durations.data(), count))
+    {
+      vtkErrorMacro("Error parsing events from message.");
+      return;
+    }
+    timeline.Events.resize(count);
+    for (vtkTypeUInt32 cc = 0; cc < count; ++cc)
+    {
+      auto& event = timeline.Events[cc];
+      if (categories[cc] < 0 || categories[cc] >= numStrings || names[cc] < 0 ||
+        names[cc] >= numStrings)
+      {
+        vtkErrorMacro("Invalid event name in message.");
+        timeline.Events.clear();
+        return;
+      }
+      event.Category = strings[categories[cc]];
+      event.Name = strings[names[cc]];
+      event.ThreadId = threads[cc];
+      event.Begin = begins[cc];
+      event.Duration = durations[cc];
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVTraceInformation::GetTimelineLabel(int idx) const
+{
+  return (idx >= 0 && idx < this->GetNumberOfTimelines()) ? this->Timelines[idx].Label.c_str()
+                                                          : nullptr;
+}
+
+//----------------------------------------------------------------------------
+const std::vector<vtkPVTraceRecorder::EventRecord>& vtkPVTraceInformation::GetTimelineEvents(
+  int idx) const
+{
+  static const std::vector<vtkPVTraceRecorder::EventRecord> empty;
+  return (idx >= 0 && idx < this->GetNumberOfTimelines()) ? this->Timelines[idx].Events : empty;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::ShiftTimes(vtkTypeInt64 offset)
+{
+  for (auto& timeline : this->Timelines)
+  {
+    for (auto& event : timeline.Events)
+    {
+      event.Begin += offset;
+    }
+  }
+  this->CollectionTime += offset;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTraceInformation::WriteChromeTrace(const char* filename)
+{
+  vtksys::ofstream ofs(filename);
+  if (!ofs)
+  {
+    vtkErrorMacro("Failed to open file '" << (filename ? filename : "(null)") << "'.");
+    return false;
+  }
+
+  // timestamps are written relative to the first event.
+  vtkTypeInt64 origin = std::numeric_limits<vtkTypeInt64>::max();
+  for (const auto& timeline : this->Timelines)
+  {
+    for (const auto& event : timeline.Events)
+    {
+      origin = std::min(origin, event.Begin);
+    }
+  }
+
+  ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (size_t pid = 0; pid < this->Timelines.size(); ++pid)
+  {
+    const auto& timeline = this->Timelines[pid];
+    ofs << (first ? "\n" : ",\n") << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" << pid
+        << ",\"tid\":0,\"args\":{\"name\":";
+    WriteJSONString(ofs, timeline.Label);
+    ofs << "}},\n{\"ph\":\"M\",\"name\":\"process_sort_index\",\"pid\":" << pid
+        << ",\"tid\":0,\"args\":{\"sort_index\":" << pid << "}}";
+    first = false;
+
+    for (const auto& event : timeline.Events)
+    {
+      ofs << ",\n{\"ph\":\"X\",\"name\":";
+      WriteJSONString(ofs, event.Name);
+      ofs << ",\"cat\":";
+      WriteJSONString(ofs, event.Category);
+      ofs << ",\"pid\":" << pid << ",\"tid\":" << event.ThreadId
+          << ",\"ts\":" << (event.Begin - origin) << ",\"dur\":" << event.Duration << "}";
+    }
+  }
+  ofs << "\n]}\n";
+  ofs.close();
+  if (ofs.fail())
+  {
+    vtkErrorMacro("Failed to write file '" << filename << "'.");
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "CollectionTime: " << this->CollectionTime << endl;
+  os << indent << "NumberOfTimelines: " << this->Timelines.size() << endl;
+  for (const auto& timeline : this->Timelines)
+  {
+    os << indent.GetNextIndent() << timeline.Label << ": " << timeline.Events.size()
+       << " events" << endl;
+  }
+}
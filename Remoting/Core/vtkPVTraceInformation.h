@@ -0,0 +1,108 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVTraceInformation.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVTraceInformation
+ * @brief   gathers the events recorded by vtkPVTraceRecorder.
+ *
+ * vtkPVTraceInformation gathers the events recorded by vtkPVTraceRecorder on
+ * all processes, one timeline per process, and can write them out in the
+ * Chrome trace event format which can be loaded in `chrome://tracing` or
+ * Perfetto. Timestamps of events gathered from a process group are expressed
+ * in the clock of the root of the group, provided
+ * vtkPVTraceRecorder::SynchronizeClocks() was called. Use `ShiftTimes` to
+ * align timelines gathered from different process groups e.g. client and
+ * servers.
+ */
+
+#ifndef vtkPVTraceInformation_h
+#define vtkPVTraceInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkPVTraceRecorder.h"    // for vtkPVTraceRecorder::EventRecord
+#include "vtkRemotingCoreModule.h" //needed for exports
+
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+class VTKREMOTINGCORE_EXPORT vtkPVTraceInformation : public vtkPVInformation
+{
+public:
+  static vtkPVTraceInformation* New();
+  vtkTypeMacro(vtkPVTraceInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Collects the events recorded on this process. The object is ignored.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object. Timelines of the other object are
+   * appended to the ones of this object.
+   */
+  void AddInformation(vtkPVInformation*) override;
+
+  //@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  //@}
+
+  //@{
+  /**
+   * Access to the timelines, one per process.
+   */
+  int GetNumberOfTimelines() const { return static_cast<int>(this->Timelines.size()); }
+  const char* GetTimelineLabel(int idx) const;
+  const std::vector<vtkPVTraceRecorder::EventRecord>& GetTimelineEvents(int idx) const;
+  //@}
+
+  /**
+   * Time, in microseconds, at which the events were collected on the root
+   * process of the group the information was gathered from.
+   */
+  vtkGetMacro(CollectionTime, vtkTypeInt64);
+
+  /**
+   * Add `offset` microseconds to all timestamps, including CollectionTime.
+   */
+  void ShiftTimes(vtkTypeInt64 offset);
+
+  /**
+   * Write all the timelines to a JSON file in the Chrome trace event format.
+   * Returns false if the file could not be written.
+   */
+  bool WriteChromeTrace(const char* filename);
+
+protected:
+  vtkPVTraceInformation();
+  ~vtkPVTraceInformation() override;
+
+  struct Timeline
+  {
+    std::string Label;
+    std::vector<vtkPVTraceRecorder::EventRecord> Events;
+  };
+  std::vector<Timeline> Timelines;
+  vtkTypeInt64 CollectionTime;
+
+private:
+  vtkPVTraceInformation(const vtkPVTraceInformation&) = delete;
+  void operator=(const vtkPVTraceInformation&) = delete;
+};
+
+#endif
@@ -0,0 +1,147 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestClientServerDispatch.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Replays a recorded stream of property updates, like the one pushed when
+// loading a state, through the interpreter and reports the time spent per
+// message. Also checks that methods are dispatched on both their name and
+// number of arguments.
+
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerInterpreterInitializer.h"
+#include "vtkClientServerStream.h"
+#include "vtkInitializationHelper.h"
+#include "vtkProcessModule.h"
+#include "vtkTimerLog.h"
+
+#include <vector>
+
+#define CHECK(cond)                                                                                \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: Condition FAILED!! : " << #cond << " (line " << __LINE__ << ")" << endl;       \
+    success = false;                                                                               \
+  }
+
+namespace
+{
+// Sets the properties of a sphere source, including methods of its
+// superclasses, in the way vtkSIProxy pushes properties.
+void RecordProperties(vtkClientServerStream& css, vtkClientServerID id, int index)
+{
+  const double center[3] = { 1.0 * index, 2.0, 3.0 };
+  css << vtkClientServerStream::Invoke << id << "SetRadius" << 0.5 + index
+      << vtkClientServerStream::End;
+  css << vtkClientServerStream::Invoke << id << "SetCenter" << center[0] << center[1] << center[2]
+      << vtkClientServerStream::End;
+  css << vtkClientServerStream::Invoke << id << "SetCenter"
+      << vtkClientServerStream::InsertArray(center, 3) << vtkClientServerStream::End;
+  css << vtkClientServerStream::Invoke << id << "SetThetaResolution" << 16
+      << vtkClientServerStream::End;
+  css << vtkClientServerStream::Invoke << id << "SetPhiResolution" << 16
+      << vtkClientServerStream::End;
+  css << vtkClientServerStream::Invoke << id << "SetStartTheta" << 0.0
+      << vtkClientServerStream::End;
+  css << vtkClientServerStream::Invoke << id << "SetEndTheta" << 360.0
+      << vtkClientServerStream::End;
+  css << vtkClientServerStream::Invoke << id << "SetStartPhi" << 0.0
+      << vtkClientServerStream::End;
+  css << vtkClientServerStream::Invoke << id << "SetEndPhi" << 180.0
+      << vtkClientServerStream::End;
+  css << vtkClientServerStream::Invoke << id << "SetLatLongTessellation" << 0
+      << vtkClientServerStream::End;
+  css << vtkClientServerStream::Invoke << id << "SetOutputPointsPrecision" << 1
+      << vtkClientServerStream::End;
+  css << vtkClientServerStream::Invoke << id << "SetReleaseDataFlag" << 0
+      << vtkClientServerStream::End;
+  css << vtkClientServerStream::Invoke << id << "SetAbortExecute" << 0
+      << vtkClientServerStream::End;
+  css << vtkClientServerStream::Invoke << id << "Modified" << vtkClientServerStream::End;
+}
+}
+
+int TestClientServerDispatch(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  bool success = true;
+  vtkClientServerInterpreter* interp =
+    vtkClientServerInterpreterInitializer::GetInitializer()->NewInterpreter();
+
+  // Overloads are selected by their number of arguments.
+  vtkClientServerID id = interp->GetNextAvailableId();
+  vtkClientServerStream css;
+  css << vtkClientServerStream::New << "vtkSphereSource" << id << vtkClientServerStream::End;
+  RecordProperties(css, id, 2);
+  CHECK(interp->ProcessStream(css));
+  css.Reset();
+  css << vtkClientServerStream::Invoke << id << "GetRadius" << vtkClientServerStream::End;
+  double radius = 0.0;
+  CHECK(interp->ProcessStream(css) && interp->GetLastResult().GetArgument(0, 0, &radius) &&
+    radius == 2.5);
+  css.Reset();
+  css << vtkClientServerStream::Invoke << id << "SetRadius" << 1.0 << 2.0
+      << vtkClientServerStream::End;
+  CHECK(!interp->ProcessStream(css));
+  css.Reset();
+  css << vtkClientServerStream::Invoke << id << "NoSuchMethod" << vtkClientServerStream::End;
+  CHECK(!interp->ProcessStream(css));
+  css.Reset();
+  css << vtkClientServerStream::Delete << id << vtkClientServerStream::End;
+  CHECK(interp->ProcessStream(css));
+
+  // Record a state with many proxies and replay it.
+  const int numberOfObjects = 200;
+  const int numberOfReplays = 20;
+  std::vector<vtkClientServerID> ids;
+  for (int cc = 0; cc < numberOfObjects; ++cc)
+  {
+    ids.push_back(interp->GetNextAvailableId());
+  }
+  vtkClientServerStream stateStream;
+  for (int cc = 0; cc < numberOfObjects; ++cc)
+  {
+    stateStream << vtkClientServerStream::New << "vtkSphereSource" << ids[cc]
+                << vtkClientServerStream::End;
+  }
+  for (int cc = 0; cc < numberOfObjects; ++cc)
+  {
+    RecordProperties(stateStream, ids[cc], cc);
+  }
+  vtkClientServerStream deleteStream;
+  for (int cc = 0; cc < numberOfObjects; ++cc)
+  {
+    deleteStream << vtkClientServerStream::Delete << ids[cc] << vtkClientServerStream::End;
+  }
+
+  vtkTimerLog* timer = vtkTimerLog::New();
+  double elapsed = 0.0;
+  for (int replay = 0; replay < numberOfReplays && success; ++replay)
+  {
+    timer->StartTimer();
+    CHECK(interp->ProcessStream(stateStream));
+    timer->StopTimer();
+    elapsed += timer->GetElapsedTime();
+    CHECK(interp->ProcessStream(deleteStream));
+  }
+  timer->Delete();
+
+  const double numberOfMessages =
+    static_cast<double>(stateStream.GetNumberOfMessages()) * numberOfReplays;
+  cout << "Replayed " << numberOfMessages << " messages in " << elapsed << "s, "
+       << (elapsed * 1.0e6 / numberOfMessages) << "us per message." << endl;
+
+  interp->Delete();
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
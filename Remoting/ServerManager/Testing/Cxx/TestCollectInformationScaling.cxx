@@ -0,0 +1,156 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCollectInformationScaling.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Benchmarks vtkPVSessionCore::ReduceInformation, comparing gather-to-root and
+// tree reduction for increasing numbers of ranks. Pass `--iterations N` to
+// control the number of collections timed for each configuration. Also checks
+// that both reductions still collect the information of the other ranks when
+// some of them, including inner nodes of the reduction tree, have none.
+
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVSessionCore.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/CommandLineArguments.hxx>
+
+#include <vector>
+
+namespace
+{
+double TimeReduction(
+  vtkMultiProcessController* controller, vtkDataObject* data, bool tree, int iterations,
+  vtkTypeInt64& numberOfPoints)
+{
+  vtkNew<vtkTimerLog> timer;
+  controller->Barrier();
+  timer->StartTimer();
+  for (int cc = 0; cc < iterations; ++cc)
+  {
+    vtkNew<vtkPVDataInformation> info;
+    info->CopyFromObject(data);
+    vtkPVSessionCore::ReduceInformation(controller, info, tree);
+    numberOfPoints = info->GetNumberOfPoints();
+  }
+  controller->Barrier();
+  timer->StopTimer();
+  return timer->GetElapsedTime() / iterations;
+}
+
+// Reduces the information of all ranks except those with `rank % 4 == 2`,
+// which have no local information, and returns the number of points on the
+// root. With tree reduction, these ranks receive information from rank + 1.
+vtkTypeInt64 ReduceWithMissingInformation(
+  vtkMultiProcessController* controller, vtkDataObject* data, bool tree)
+{
+  vtkSmartPointer<vtkPVDataInformation> info;
+  if (controller->GetLocalProcessId() % 4 != 2)
+  {
+    info = vtkSmartPointer<vtkPVDataInformation>::New();
+    info->CopyFromObject(data);
+  }
+  vtkPVSessionCore::ReduceInformation(controller, info, tree);
+  return info ? info->GetNumberOfPoints() : 0;
+}
+}
+
+int TestCollectInformationScaling(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  int iterations = 10;
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  arg.StoreUnusedArguments(true);
+  arg.AddArgument("--iterations", vtksys::CommandLineArguments::EQUAL_ARGUMENT, &iterations,
+    "Number of collections to time for each rank count.");
+  arg.Parse();
+
+  const int myRank = contr->GetLocalProcessId();
+  const int numRanks = contr->GetNumberOfProcesses();
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  sphere->SetCenter(myRank, 0, 0);
+  sphere->Update();
+  const vtkTypeInt64 pointsPerRank = sphere->GetOutput()->GetNumberOfPoints();
+
+  // powers of two, plus the full set of ranks.
+  std::vector<int> sizes;
+  for (int size = 2; size < numRanks; size *= 2)
+  {
+    sizes.push_back(size);
+  }
+  sizes.push_back(numRanks);
+
+  int success = 1;
+  for (int size : sizes)
+  {
+    // Ranks beyond `size` form their own group and just wait.
+    vtkSmartPointer<vtkMultiProcessController> subController;
+    subController.TakeReference(contr->PartitionController(myRank < size ? 0 : 1, myRank));
+    if (myRank < size)
+    {
+      vtkTypeInt64 gatherPoints = 0, treePoints = 0;
+      const double gatherTime =
+        TimeReduction(subController, sphere->GetOutput(), false, iterations, gatherPoints);
+      const double treeTime =
+        TimeReduction(subController, sphere->GetOutput(), true, iterations, treePoints);
+      const vtkTypeInt64 gatherMissingPoints =
+        ReduceWithMissingInformation(subController, sphere->GetOutput(), false);
+      const vtkTypeInt64 treeMissingPoints =
+        ReduceWithMissingInformation(subController, sphere->GetOutput(), true);
+      if (myRank == 0)
+      {
+        cout << "ranks: " << size << " gather-to-root: " << gatherTime
+             << " s tree-reduction: " << treeTime << " s" << endl;
+        if (gatherPoints != pointsPerRank * size || treePoints != gatherPoints)
+        {
+          vtkLogF(ERROR, "mismatched results: %lld (gather) vs %lld (tree), expected %lld",
+            static_cast<long long>(gatherPoints), static_cast<long long>(treePoints),
+            static_cast<long long>(pointsPerRank * size));
+          success = 0;
+        }
+        const vtkTypeInt64 expectedMissingPoints = pointsPerRank * (size - (size + 1) / 4);
+        if (gatherMissingPoints != expectedMissingPoints ||
+          treeMissingPoints != expectedMissingPoints)
+        {
+          vtkLogF(ERROR,
+            "mismatched results with missing information: %lld (gather) vs %lld (tree), "
+            "expected %lld",
+            static_cast<long long>(gatherMissingPoints),
+            static_cast<long long>(treeMissingPoints),
+            static_cast<long long>(expectedMissingPoints));
+          success = 0;
+        }
+      }
+    }
+    contr->Barrier();
+  }
+
+  int all_success;
+  contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return all_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,106 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestProxyDefinitionCache.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVProxyDefinitionIterator.h"
+#include "vtkPVXMLElement.h"
+#include "vtkProcessModule.h"
+#include "vtkSIProxyDefinitionManager.h"
+
+#include <vtksys/Directory.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <string>
+
+#define CHECK(cond)                                                                                \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: Condition FAILED!! : " << #cond << " (line " << __LINE__ << ")" << endl;       \
+    success = false;                                                                               \
+  }
+
+namespace
+{
+unsigned long CountFiles(const std::string& dirname)
+{
+  vtksys::Directory dir;
+  if (!dir.Load(dirname))
+  {
+    return 0;
+  }
+  unsigned long count = 0;
+  for (unsigned long cc = 0; cc < dir.GetNumberOfFiles(); ++cc)
+  {
+    const std::string fname = dir.GetFile(cc);
+    count += (fname != "." && fname != "..") ? 1 : 0;
+  }
+  return count;
+}
+
+bool SameDefinition(vtkPVXMLElement* expected, vtkPVXMLElement* actual)
+{
+  return expected == nullptr ? actual == nullptr : expected->Equals(actual);
+}
+}
+
+int TestProxyDefinitionCache(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  bool success = true;
+  {
+    const std::string cacheDir =
+      vtksys::SystemTools::GetCurrentWorkingDirectory() + "/TestProxyDefinitionCache";
+    vtksys::SystemTools::RemoveADirectory(cacheDir);
+
+    // Without a cache, definitions are parsed and flattened on demand.
+    vtkSIProxyDefinitionManager::SetCacheDirectory(nullptr);
+    vtkNew<vtkSIProxyDefinitionManager> reference;
+
+    // The first manager using the cache parses the XML and creates the cache
+    // files, the second one loads its definitions from them.
+    vtkSIProxyDefinitionManager::SetCacheDirectory(cacheDir.c_str());
+    vtkNew<vtkSIProxyDefinitionManager> parsed;
+    CHECK(CountFiles(cacheDir) > 0);
+    vtkNew<vtkSIProxyDefinitionManager> cached;
+
+    int count = 0;
+    vtkPVProxyDefinitionIterator* iter =
+      reference->NewIterator(vtkSIProxyDefinitionManager::CORE_DEFINITIONS);
+    for (iter->GoToFirstItem(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      const char* group = iter->GetGroupName();
+      const char* name = iter->GetProxyName();
+      CHECK(cached->HasDefinition(group, name));
+      CHECK(SameDefinition(iter->GetProxyDefinition(), parsed->GetProxyDefinition(group, name)));
+      CHECK(SameDefinition(iter->GetProxyDefinition(), cached->GetProxyDefinition(group, name)));
+
+      vtkPVXMLElement* collapsed =
+        reference->GetCollapsedProxyDefinition(group, name, nullptr, false);
+      CHECK(SameDefinition(
+        collapsed, parsed->GetCollapsedProxyDefinition(group, name, nullptr, false)));
+      CHECK(SameDefinition(
+        collapsed, cached->GetCollapsedProxyDefinition(group, name, nullptr, false)));
+      ++count;
+    }
+    iter->Delete();
+    CHECK(count > 0);
+
+    vtkSIProxyDefinitionManager::SetCacheDirectory(nullptr);
+    vtksys::SystemTools::RemoveADirectory(cacheDir);
+  }
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,158 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestProxyStateUpdates.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the state of a proxy stays in sync with its properties when
+// UpdateVTKObjects() only rewrites the modified entries, that a single
+// UpdatePropertiesEvent is fired per update and reports the time spent per
+// update.
+
+#include "vtkCommand.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkProcessModule.h"
+#include "vtkSMMessage.h"
+#include "vtkSMProperty.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+class vtkUpdatePropertiesObserver : public vtkCommand
+{
+public:
+  static vtkUpdatePropertiesObserver* New() { return new vtkUpdatePropertiesObserver(); }
+
+  void Execute(vtkObject*, unsigned long, void* calldata) override
+  {
+    ++this->NumberOfEvents;
+    this->Names.clear();
+    for (const char** names = reinterpret_cast<const char**>(calldata); names && *names; ++names)
+    {
+      this->Names.push_back(*names);
+    }
+  }
+
+  int NumberOfEvents = 0;
+  std::vector<std::string> Names;
+};
+
+// Compares the numeric property entries in the state of the proxy with the
+// current values of the properties.
+bool CheckState(vtkSMProxy* proxy)
+{
+  const vtkSMMessage* state = proxy->GetFullState();
+  for (int cc = 0; cc < state->ExtensionSize(ProxyState::property); ++cc)
+  {
+    const ProxyState_Property& entry = state->GetExtension(ProxyState::property, cc);
+    vtkSMProperty* property = proxy->GetProperty(entry.name().c_str());
+    if (!property)
+    {
+      cerr << "ERROR: state has an entry for unknown property " << entry.name() << endl;
+      return false;
+    }
+
+    const Variant& value = entry.value();
+    vtkSMPropertyHelper helper(property);
+    bool same = true;
+    if (value.type() == Variant::FLOAT64)
+    {
+      same = static_cast<unsigned int>(value.float64_size()) == helper.GetNumberOfElements();
+      for (int i = 0; same && i < value.float64_size(); ++i)
+      {
+        same = value.float64(i) == helper.GetAsDouble(i);
+      }
+    }
+    else if (value.type() == Variant::INT)
+    {
+      same = static_cast<unsigned int>(value.integer_size()) == helper.GetNumberOfElements();
+      for (int i = 0; same && i < value.integer_size(); ++i)
+      {
+        same = value.integer(i) == helper.GetAsInt(i);
+      }
+    }
+    if (!same)
+    {
+      cerr << "ERROR: state out of date for " << entry.name() << endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestProxyStateUpdates(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  bool success = true;
+  {
+    vtkNew<vtkSMSession> session;
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+    vtkSmartPointer<vtkSMSourceProxy> sphere;
+    sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+    sphere->UpdateVTKObjects();
+
+    vtkNew<vtkUpdatePropertiesObserver> observer;
+    sphere->AddObserver(vtkSMProxy::UpdatePropertiesEvent, observer);
+
+    vtkSMPropertyHelper(sphere, "Radius").Set(2.5);
+    vtkSMPropertyHelper(sphere, "ThetaResolution").Set(32);
+    sphere->UpdateVTKObjects();
+    if (observer->NumberOfEvents != 1 || observer->Names.size() != 2)
+    {
+      cerr << "ERROR: expected one UpdatePropertiesEvent for 2 properties, got "
+           << observer->NumberOfEvents << " event(s) for " << observer->Names.size()
+           << " properties." << endl;
+      success = false;
+    }
+    success &= CheckState(sphere);
+
+    // Nothing modified, nothing fired.
+    sphere->UpdateVTKObjects();
+    if (observer->NumberOfEvents != 1)
+    {
+      cerr << "ERROR: UpdatePropertiesEvent fired without modified properties." << endl;
+      success = false;
+    }
+
+    // Single property pushes keep the state in sync too.
+    vtkSMPropertyHelper(sphere, "PhiResolution").Set(24);
+    sphere->UpdateProperty("PhiResolution");
+    success &= CheckState(sphere);
+
+    const int numberOfUpdates = 10000;
+    vtkNew<vtkTimerLog> timer;
+    timer->StartTimer();
+    for (int cc = 0; cc < numberOfUpdates; ++cc)
+    {
+      vtkSMPropertyHelper(sphere, "Radius").Set(1.0 + cc);
+      sphere->UpdateVTKObjects();
+    }
+    timer->StopTimer();
+    success &= CheckState(sphere);
+    cout << numberOfUpdates << " updates in " << timer->GetElapsedTime() << "s, "
+         << (timer->GetElapsedTime() * 1.0e6 / numberOfUpdates) << "us per update." << endl;
+  }
+
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
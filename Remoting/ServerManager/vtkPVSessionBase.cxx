@@ -142,6 +142,14 @@ void vtkPVSessionBase::PushState(vtkSMMessage* msg)
   this->DeActivate();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionBase::PushStates(const std::vector<vtkSMMessage*>& msgs)
+{
+  this->Activate();
+  this->SessionCore->PushStates(msgs);
+  this->DeActivate();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionBase::PullState(vtkSMMessage* msg)
 {
@@ -28,6 +28,8 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMMessageMinimal.h"            // needed for vtkSMMessage
 
+#include <vector> // for std::vector
+
 class vtkClientServerStream;
 class vtkCollection;
 class vtkSIObject;
@@ -88,6 +90,12 @@ public:
    */
   virtual void PushState(vtkSMMessage* msg);
 
+  /**
+   * Push a batch of state messages, in order. Satellites receive the messages
+   * in a single broadcast.
+   */
+  virtual void PushStates(const std::vector<vtkSMMessage*>& msgs);
+
   /**
    * Pull the state message.
    */
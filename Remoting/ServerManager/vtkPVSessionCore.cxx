@@ -40,8 +40,10 @@
 
 #include <assert.h>
 #include <set>
+#include <vector>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #define LOG(x)                                                                                     \
   if (this->LogStream)                                                                             \
@@ -62,6 +64,10 @@ void RMICallback(
       sessioncore->PushStateSatelliteCallback();
       break;
 
+    case vtkPVSessionCore::PUSH_STATE_BATCH:
+      sessioncore->PushStatesSatelliteCallback();
+      break;
+
     case vtkPVSessionCore::GATHER_INFORMATION:
       sessioncore->GatherInformationStatelliteCallback();
       break;
@@ -255,6 +261,8 @@ vtkPVSessionCore::vtkPVSessionCore()
   this->Interpreter = vtkClientServerInterpreterInitializer::GetInitializer()->NewInterpreter();
   this->MPIMToNSocketConnection = NULL;
   this->SymmetricMPIMode = false;
+  this->CollectInformationMode = vtkPVSessionCore::AUTOMATIC;
+  this->TreeReductionThreshold = 64;
 
   vtkPVSessionCoreInterpreterHelper* helper = vtkPVSessionCoreInterpreterHelper::New();
   helper->SetCore(this);
@@ -526,10 +534,98 @@ void vtkPVSessionCore::PushStateSatelliteCallback()
   delete[] raw_data;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionCore::PushStates(const std::vector<vtkSMMessage*>& messages)
+{
+  // This can only be called on the root node.
+  assert(this->ParallelController == NULL || this->ParallelController->GetLocalProcessId() == 0 ||
+    this->SymmetricMPIMode);
+
+  if (this->ParallelController && this->ParallelController->GetNumberOfProcesses() > 1 &&
+    this->ParallelController->GetLocalProcessId() == 0 && !this->SymmetricMPIMode)
+  {
+    // Same logic as PushState(), only the messages for the satellites are
+    // serialized back to back and sent with one RMI and two broadcasts.
+    std::vector<vtkIdType> sizes;
+    for (vtkSMMessage* message : messages)
+    {
+      if ((message->location() & vtkProcessModule::SERVERS) != 0)
+      {
+        sizes.push_back(static_cast<vtkIdType>(message->ByteSizeLong()));
+      }
+    }
+    if (!sizes.empty())
+    {
+      vtkIdType byte_size = 0;
+      for (vtkIdType size : sizes)
+      {
+        byte_size += size;
+      }
+      std::vector<unsigned char> raw_data(byte_size + 1);
+      unsigned char* cursor = &raw_data[0];
+      for (vtkSMMessage* message : messages)
+      {
+        if ((message->location() & vtkProcessModule::SERVERS) != 0)
+        {
+          const int size = static_cast<int>(message->ByteSizeLong());
+          message->SerializeToArray(cursor, size);
+          cursor += size;
+        }
+      }
+
+      unsigned char type = PUSH_STATE_BATCH;
+      this->ParallelController->TriggerRMIOnAllChildren(&type, 1, ROOT_SATELLITE_RMI_TAG);
+
+      vtkIdType header[2] = { static_cast<vtkIdType>(sizes.size()), byte_size };
+      this->ParallelController->Broadcast(header, 2, 0);
+      this->ParallelController->Broadcast(&sizes[0], header[0], 0);
+      this->ParallelController->Broadcast(&raw_data[0], byte_size, 0);
+    }
+  }
+
+  for (vtkSMMessage* message : messages)
+  {
+    this->PushStateInternal(message);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSessionCore::PushStatesSatelliteCallback()
+{
+  vtkIdType header[2] = { 0, 0 };
+  this->ParallelController->Broadcast(header, 2, 0);
+
+  std::vector<vtkIdType> sizes(header[0]);
+  if (header[0] > 0)
+  {
+    this->ParallelController->Broadcast(&sizes[0], header[0], 0);
+  }
+
+  std::vector<unsigned char> raw_data(header[1] + 1);
+  this->ParallelController->Broadcast(&raw_data[0], header[1], 0);
+
+  const unsigned char* cursor = &raw_data[0];
+  for (vtkIdType size : sizes)
+  {
+    vtkSMMessage message;
+    if (!message.ParseFromArray(cursor, static_cast<int>(size)))
+    {
+      vtkErrorMacro("Failed to parse protobuf message.");
+    }
+    else
+    {
+      this->PushStateInternal(&message);
+    }
+    cursor += size;
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionCore::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CollectInformationMode: " << this->CollectInformationMode << endl;
+  os << indent << "TreeReductionThreshold: " << this->TreeReductionThreshold << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -847,7 +943,8 @@ bool vtkPVSessionCore::GatherInformation(
     this->ParallelController->TriggerRMIOnAllChildren(&type, 1, ROOT_SATELLITE_RMI_TAG);
 
     vtkMultiProcessStream stream;
-    stream << information->GetClassName() << globalid;
+    stream << information->GetClassName() << globalid
+           << static_cast<int>(this->UseTreeReduction(information));
 
     // serialize information parameters so all processes have the same ivars.
     information->CopyParametersToStream(stream);
@@ -855,7 +952,7 @@ bool vtkPVSessionCore::GatherInformation(
     this->ParallelController->Broadcast(stream, 0);
   }
 
-  return this->CollectInformation(information);
+  return this->CollectInformation(information, this->UseTreeReduction(information));
 }
 
 //----------------------------------------------------------------------------
@@ -866,7 +963,8 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
 
   std::string classname;
   vtkTypeUInt32 globalid;
-  stream >> classname >> globalid;
+  int useTreeReduction;
+  stream >> classname >> globalid >> useTreeReduction;
 
   vtkSmartPointer<vtkObjectBase> o;
   o.TakeReference(vtkClientServerStreamInstantiator::CreateInstance(classname.c_str()));
@@ -875,13 +973,13 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
   {
     info->CopyParametersFromStream(stream);
     this->GatherInformationInternal(info, globalid);
-    this->CollectInformation(info);
+    this->CollectInformation(info, useTreeReduction != 0);
   }
   else
   {
     vtkErrorMacro("Could not gather information on Satellite.");
     // let the parent know, otherwise root will hang.
-    this->CollectInformation(NULL);
+    this->CollectInformation(NULL, useTreeReduction != 0);
   }
 }
 
@@ -895,21 +993,136 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
     }                                                                                              \
   }
 
-bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
+//----------------------------------------------------------------------------
+bool vtkPVSessionCore::UseTreeReduction(vtkPVInformation* info)
 {
-  // Sanity checks
-  assert("pre: NULL PV information!" && (info != NULL));
+  if (!info->GetSupportsTreeReduction())
+  {
+    return false;
+  }
+  switch (this->CollectInformationMode)
+  {
+    case vtkPVSessionCore::TREE_REDUCTION:
+      return true;
+    case vtkPVSessionCore::AUTOMATIC:
+      return this->ParallelController &&
+        this->ParallelController->GetNumberOfProcesses() >= this->TreeReductionThreshold;
+    default:
+      return false;
+  }
+}
 
-  // STEP 0: temporary variables
-  int rank = this->ParallelController->GetLocalProcessId();
-  int nranks = this->ParallelController->GetNumberOfProcesses();
+//----------------------------------------------------------------------------
+bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info, bool useTreeReduction)
+{
+  return vtkPVSessionCore::ReduceInformation(this->ParallelController, info, useTreeReduction);
+}
 
-  if (nranks == 1)
+//----------------------------------------------------------------------------
+namespace
+{
+// Binomial tree reduction to rank 0. At step k, ranks with bit k set send
+// their partial result to (rank - 2^k) and are done; other ranks receive from
+// (rank + 2^k), if it exists, and merge. Each rank thus merges children in
+// increasing rank order, so the root sees ranks merged in order.
+//
+// A partial result is sent as a number of serialized information objects
+// followed by each of them. A rank without local information cannot merge
+// what it receives: it forwards its children's information unchanged instead.
+bool vtkPVSessionCoreTreeReduce(
+  vtkMultiProcessController* controller, vtkPVInformation* info, int tag)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int nranks = controller->GetNumberOfProcesses();
+
+  // information received from children, kept only when `info` is NULL.
+  std::vector<std::vector<unsigned char> > pending;
+  for (int mask = 1; mask < nranks; mask <<= 1)
+  {
+    if ((rank & mask) != 0)
+    {
+      // send partial result to parent. When `info` is not NULL, the children's
+      // information has been merged into it and `pending` is empty.
+      if (info)
+      {
+        vtkClientServerStream stream;
+        info->CopyToStream(&stream);
+        const unsigned char* data;
+        size_t length;
+        stream.GetData(&data, &length);
+        pending.emplace_back(data, data + length);
+      }
+      vtkIdType count = static_cast<vtkIdType>(pending.size());
+      controller->Send(&count, 1, rank - mask, tag);
+      for (const auto& buffer : pending)
+      {
+        vtkIdType length = static_cast<vtkIdType>(buffer.size());
+        controller->Send(&length, 1, rank - mask, tag);
+        if (length > 0)
+        {
+          controller->Send(buffer.data(), length, rank - mask, tag);
+        }
+      }
+      return true;
+    }
+
+    const int child = rank + mask;
+    if (child < nranks)
+    {
+      vtkIdType count = 0;
+      controller->Receive(&count, 1, child, tag);
+      for (vtkIdType cc = 0; cc < count; ++cc)
+      {
+        vtkIdType length = 0;
+        controller->Receive(&length, 1, child, tag);
+        std::vector<unsigned char> buffer(length);
+        if (length > 0)
+        {
+          controller->Receive(buffer.data(), length, child, tag);
+        }
+        if (!info)
+        {
+          pending.push_back(std::move(buffer));
+        }
+        else if (length > 0)
+        {
+          vtkClientServerStream rcvStream;
+          rcvStream.SetData(buffer.data(), buffer.size());
+          vtkSmartPointer<vtkPVInformation> tempInfo;
+          tempInfo.TakeReference(info->NewInstance());
+          tempInfo->CopyFromStream(&rcvStream);
+          info->AddInformation(tempInfo);
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVSessionCore::ReduceInformation(
+  vtkMultiProcessController* controller, vtkPVInformation* info, bool useTreeReduction)
+{
+  if (controller == NULL || controller->GetNumberOfProcesses() == 1)
   {
     /* short-circuit */
     return true;
   }
 
+  if (useTreeReduction)
+  {
+    return vtkPVSessionCoreTreeReduce(controller, info, ROOT_SATELLITE_INFO_TAG);
+  }
+
+  // Sanity checks
+  assert("pre: NULL PV information on root!" &&
+    (info != NULL || controller->GetLocalProcessId() != 0));
+
+  // STEP 0: temporary variables
+  int rank = controller->GetLocalProcessId();
+  int nranks = controller->GetNumberOfProcesses();
+
   vtkIdType* rcvcounts = NULL;     /* significant only at rank 0 */
   vtkIdType* offSet = NULL;        /* significant only at rank 0 */
   int rbufsize = 0;                /* significant only at rank 0 */
@@ -922,9 +1135,13 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
     offSet = new vtkIdType[nranks];
   } // END if rank == 0
 
-  // STEP 2: Serialize the vtkPVInformation object
+  // STEP 2: Serialize the vtkPVInformation object. A satellite that failed to
+  // gather information sends an empty buffer.
   vtkClientServerStream stream;
-  info->CopyToStream(&stream);
+  if (info)
+  {
+    info->CopyToStream(&stream);
+  }
 
   const unsigned char* data;
   size_t length;
@@ -932,10 +1149,10 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
   // Get pointer to the raw stream data. Note, this is a shallow copy, no
   // need to delete the data.
   stream.GetData(&data, &length);
-  vtkIdType local_length = static_cast<vtkIdType>(length);
+  vtkIdType local_length = info ? static_cast<vtkIdType>(length) : 0;
 
   // STEP 3: Get number of bytes that each process will send
-  this->ParallelController->Gather(&local_length, rcvcounts, 1, 0);
+  controller->Gather(&local_length, rcvcounts, 1, 0);
 
   // STEP 4: Allocate temporary arrays at rank 0
   if (rank == 0)
@@ -957,7 +1174,7 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
   } // END if rank==0
 
   // STEP 5: GatherV all data from satellites
-  this->ParallelController->GatherV(data, rcvbuffer, local_length, rcvcounts, offSet, 0);
+  controller->GatherV(data, rcvbuffer, local_length, rcvcounts, offSet, 0);
 
   // STEP 6: Deserialize data from other ranks at rank 0 and add them to
   // the information object associated with rank 0.
@@ -966,6 +1183,10 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
     vtkClientServerStream rcvStream;
     for (int i = 1; i < nranks; ++i)
     {
+      if (rcvcounts[i] == 0)
+      {
+        continue;
+      }
       rcvStream.SetData(&rcvbuffer[offSet[i]], rcvcounts[i]);
       vtkPVInformation* tempInfo = info->NewInstance();
       tempInfo->CopyFromStream(&rcvStream);
@@ -985,7 +1206,7 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
   assert("post: rcvbuffer should be NULL" && (rcvbuffer == NULL));
 
   // STEP 8: Barrier synchronization
-  this->ParallelController->Barrier();
+  controller->Barrier();
   return true;
 }
 
@@ -30,6 +30,8 @@
 #include "vtkSMMessageMinimal.h"            // needed for vtkSMMessage.
 #include "vtkWeakPointer.h"                 // needed for vtkMultiProcessController
 
+#include <vector> // for std::vector
+
 class vtkClientServerInterpreter;
 class vtkClientServerStream;
 class vtkCollection;
@@ -66,6 +68,12 @@ public:
    */
   virtual void PushState(vtkSMMessage* message);
 
+  /**
+   * Push a batch of state messages, in order. The messages that need to reach
+   * the MPI satellites are forwarded to them in a single broadcast.
+   */
+  virtual void PushStates(const std::vector<vtkSMMessage*>& messages);
+
   /**
    * Pull the state message from the local SI object instances.
    */
@@ -127,6 +135,42 @@ public:
   virtual bool GatherInformation(
     vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid);
 
+  enum CollectInformationModes
+  {
+    GATHER_TO_ROOT = 0,
+    TREE_REDUCTION = 1,
+    AUTOMATIC = 2
+  };
+
+  //@{
+  /**
+   * Select how information gathered on MPI satellites is collected on the
+   * root. GATHER_TO_ROOT gathers the serialized information from all ranks to
+   * the root which then merges them one by one. TREE_REDUCTION uses a
+   * binomial tree in which intermediate ranks merge partial results, so that
+   * the root only merges log(P) objects. AUTOMATIC (default) uses
+   * TREE_REDUCTION when the number of processes is at least
+   * TreeReductionThreshold. Information objects that do not support tree
+   * reduction (see vtkPVInformation::GetSupportsTreeReduction) are always
+   * gathered to the root. Only relevant on the root node; the mode used is
+   * forwarded to the satellites.
+   */
+  vtkSetClampMacro(CollectInformationMode, int, GATHER_TO_ROOT, AUTOMATIC);
+  vtkGetMacro(CollectInformationMode, int);
+  vtkSetClampMacro(TreeReductionThreshold, int, 2, VTK_INT_MAX);
+  vtkGetMacro(TreeReductionThreshold, int);
+  //@}
+
+  /**
+   * Collects `info` from all ranks of `controller` on rank 0, using either a
+   * gather to root or a tree reduction. Must be called on all ranks. On ranks
+   * other than the root, `info` may be nullptr to indicate failure to gather
+   * information locally. This is the implementation used when gathering
+   * information from satellites; it is exposed mainly for benchmarking.
+   */
+  static bool ReduceInformation(
+    vtkMultiProcessController* controller, vtkPVInformation* info, bool useTreeReduction);
+
   /**
    * Returns the number of processes. This simply calls the
    * GetNumberOfProcesses() on this->ParallelController
@@ -167,9 +211,11 @@ public:
     GATHER_INFORMATION = 15,
     REGISTER_SI = 16,
     UNREGISTER_SI = 17,
+    PUSH_STATE_BATCH = 18,
   };
   // Methods used to managed MPI satellite
   void PushStateSatelliteCallback();
+  void PushStatesSatelliteCallback();
   void ExecuteStreamSatelliteCallback();
   void GatherInformationStatelliteCallback();
   void RegisterSIObjectSatelliteCallback();
@@ -213,7 +259,13 @@ protected:
   /**
    * Gather information across MPI satellites.
    */
-  bool CollectInformation(vtkPVInformation*);
+  bool CollectInformation(vtkPVInformation*, bool useTreeReduction);
+
+  /**
+   * Returns true if the tree reduction should be used to collect `info`
+   * given the current CollectInformationMode.
+   */
+  bool UseTreeReduction(vtkPVInformation* info);
 
   /**
    * Increment reference count of a local vtkSIObject.
@@ -242,6 +294,8 @@ protected:
   vtkWeakPointer<vtkMultiProcessController> ParallelController;
   vtkClientServerInterpreter* Interpreter;
   vtkMPIMToNSocketConnection* MPIMToNSocketConnection;
+  int CollectInformationMode;
+  int TreeReductionThreshold;
 
 private:
   vtkPVSessionCore(const vtkPVSessionCore&) = delete;
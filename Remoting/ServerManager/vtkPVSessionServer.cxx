@@ -27,6 +27,7 @@
 #include "vtkPVInformation.h"
 #include "vtkPVServerOptions.h"
 #include "vtkPVSessionCore.h"
+#include "vtkPVTraceRecorder.h"
 #include "vtkProcessModule.h"
 #include "vtkReservedRemoteObjectIds.h"
 #include "vtkSIProxy.h"
@@ -524,6 +525,36 @@ int vtkPVSessionServer::GetConnectID()
   return options->GetConnectID();
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Name used for the timeline events recorded for each client-server message.
+const char* GetMessageTypeName(int type)
+{
+  switch (type)
+  {
+    case vtkPVSessionServer::PUSH:
+      return "push";
+    case vtkPVSessionServer::PUSH_BATCH:
+      return "push batch";
+    case vtkPVSessionServer::PULL:
+      return "pull";
+    case vtkPVSessionServer::EXECUTE_STREAM:
+      return "execute stream";
+    case vtkPVSessionServer::GATHER_INFORMATION:
+      return "gather information";
+    case vtkPVSessionServer::REGISTER_SI:
+      return "register";
+    case vtkPVSessionServer::UNREGISTER_SI:
+      return "unregister";
+    case vtkPVSessionServer::LAST_RESULT:
+      return "last result";
+    default:
+      return "unknown";
+  }
+}
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_length)
 {
@@ -531,6 +562,7 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
   stream.SetRawData(reinterpret_cast<const unsigned char*>(message), message_length);
   int type;
   stream >> type;
+  vtkPVTraceScope("rmi", GetMessageTypeName(type));
   switch (type)
   {
     case vtkPVSessionServer::PUSH:
@@ -556,6 +588,37 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
     }
     break;
 
+    case vtkPVSessionServer::PUSH_BATCH:
+    {
+      int count = 0;
+      stream >> count;
+      std::vector<vtkSMMessage> messages(count);
+      std::vector<vtkSMMessage*> toPush;
+      toPush.reserve(count);
+      for (int cc = 0; cc < count; ++cc)
+      {
+        std::string string;
+        stream >> string;
+        messages[cc].ParseFromString(string);
+
+        // Do we skip the processing ?
+        if (!this->Internal->StoreShareOnly(&messages[cc]))
+        {
+          toPush.push_back(&messages[cc]);
+        }
+      }
+
+      // Apply the whole batch, in order, at once so that the satellites get
+      // it in a single broadcast.
+      this->PushStates(toPush);
+
+      for (int cc = 0; cc < count; ++cc)
+      {
+        this->NotifyOtherClients(&messages[cc]);
+      }
+    }
+    break;
+
     case vtkPVSessionServer::PULL:
     {
       std::string string;
@@ -35,13 +35,26 @@
 #include "vtkTimerLog.h"
 
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <map>
+#include <memory>
+#include <random>
 #include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include <vtksys/RegularExpression.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
@@ -50,6 +63,327 @@ typedef vtkSmartPointer<vtkPVXMLElement> XMLElement;
 typedef std::map<std::string, XMLElement> StrToXmlMap;
 typedef std::map<std::string, StrToXmlMap> StrToStrToXmlMap;
 
+namespace
+{
+std::string vtkSIProxyDefinitionCacheDirectory;
+bool vtkSIProxyDefinitionCacheDirectoryInitialized = false;
+
+// Cache files start with this magic number, written in the native byte
+// order, followed by the format version.
+const vtkTypeUInt32 vtkSIProxyDefinitionCacheMagic = 0x43585650;
+const vtkTypeUInt32 vtkSIProxyDefinitionCacheFormat = 1;
+const vtkTypeUInt64 vtkSIProxyDefinitionHashBasis = 14695981039346656037ull;
+
+//----------------------------------------------------------------------------
+// FNV-1a, used to key cache files by the XML they were created from.
+vtkTypeUInt64 vtkSIProxyDefinitionHash(
+  const void* data, size_t length, vtkTypeUInt64 hash = vtkSIProxyDefinitionHashBasis)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t cc = 0; cc < length; ++cc)
+  {
+    hash = (hash ^ bytes[cc]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkSIProxyDefinitionCacheFileName(const char* prefix, vtkTypeUInt64 key)
+{
+  char name[64];
+  snprintf(name, sizeof(name), "%s-%016llx.bin", prefix, static_cast<unsigned long long>(key));
+  return vtkSIProxyDefinitionCacheDirectory + "/" + name;
+}
+
+//----------------------------------------------------------------------------
+// Cache files are written once by the first partition and read by all the
+// others.
+bool vtkSIProxyDefinitionCanWriteCache()
+{
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  return pm == nullptr || pm->GetPartitionId() == 0;
+}
+
+//----------------------------------------------------------------------------
+// A read-only cache file, memory-mapped when the platform allows it so that
+// processes running on the same node share its pages.
+class vtkSIProxyDefinitionCacheFile
+{
+public:
+  ~vtkSIProxyDefinitionCacheFile()
+  {
+#ifndef _WIN32
+    if (this->Mapped)
+    {
+      munmap(const_cast<char*>(this->Data), this->Size);
+    }
+#endif
+  }
+
+  const char* GetData() const { return this->Data; }
+  size_t GetSize() const { return this->Size; }
+
+  static std::shared_ptr<vtkSIProxyDefinitionCacheFile> Open(const std::string& filename)
+  {
+    std::shared_ptr<vtkSIProxyDefinitionCacheFile> file(new vtkSIProxyDefinitionCacheFile());
+#ifndef _WIN32
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+    {
+      return nullptr;
+    }
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      return nullptr;
+    }
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data != MAP_FAILED)
+    {
+      file->Data = static_cast<const char*>(data);
+      file->Size = static_cast<size_t>(st.st_size);
+      file->Mapped = true;
+      return file;
+    }
+#endif
+    FILE* fp = fopen(filename.c_str(), "rb");
+    if (!fp)
+    {
+      return nullptr;
+    }
+    char chunk[65536];
+    size_t count;
+    while ((count = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+    {
+      file->Buffer.insert(file->Buffer.end(), chunk, chunk + count);
+    }
+    fclose(fp);
+    if (file->Buffer.empty())
+    {
+      return nullptr;
+    }
+    file->Data = file->Buffer.data();
+    file->Size = file->Buffer.size();
+    return file;
+  }
+
+private:
+  vtkSIProxyDefinitionCacheFile() = default;
+  vtkSIProxyDefinitionCacheFile(const vtkSIProxyDefinitionCacheFile&) = delete;
+  void operator=(const vtkSIProxyDefinitionCacheFile&) = delete;
+
+  const char* Data = nullptr;
+  size_t Size = 0;
+  bool Mapped = false;
+  std::vector<char> Buffer;
+};
+
+//----------------------------------------------------------------------------
+// A definition stored in a cache file. It is only decoded when looked up.
+struct vtkSIProxyDefinitionCacheEntry
+{
+  std::shared_ptr<vtkSIProxyDefinitionCacheFile> File;
+  size_t Offset;
+  size_t Length;
+
+  XMLElement Decode() const
+  {
+    XMLElement element;
+    element.TakeReference(
+      vtkPVXMLElement::NewFromBinary(this->File->GetData() + this->Offset, this->Length));
+    if (!element)
+    {
+      vtkGenericWarningMacro("Invalid proxy definition in cache, ignoring it.");
+    }
+    return element;
+  }
+};
+typedef std::map<std::string, vtkSIProxyDefinitionCacheEntry> StrToCacheEntryMap;
+typedef std::map<std::string, StrToCacheEntryMap> StrToStrToCacheEntryMap;
+
+//----------------------------------------------------------------------------
+// Layout of a cache file:
+//   magic, format version (uint32), key (uint64), ParaView version (string)
+//   number of definitions (uint32)
+//   for each definition: group, name (strings), is extension (uint32),
+//     offset in the payload, length (uint64)
+//   payload length (uint64), payload
+// Strings are stored as a uint32 length followed by the characters.
+struct vtkSIProxyDefinitionCacheIndexEntry
+{
+  std::string Group;
+  std::string Name;
+  bool Extension;
+  size_t Offset;
+  size_t Length;
+};
+
+class vtkSIProxyDefinitionCacheWriter
+{
+public:
+  void Add(const std::string& group, const std::string& name, vtkPVXMLElement* element)
+  {
+    vtkSIProxyDefinitionCacheIndexEntry entry;
+    entry.Group = group;
+    entry.Name = name;
+    entry.Extension = element->GetName() && strcmp(element->GetName(), "Extension") == 0;
+    entry.Offset = this->Payload.size();
+    element->AppendBinary(this->Payload);
+    entry.Length = this->Payload.size() - entry.Offset;
+    this->Entries.push_back(entry);
+  }
+
+  // The file is written under a temporary name and renamed, so that readers
+  // never see a partial file.
+  bool Write(const std::string& filename, vtkTypeUInt64 key)
+  {
+    std::vector<char> header;
+    this->Append(header, vtkSIProxyDefinitionCacheMagic);
+    this->Append(header, vtkSIProxyDefinitionCacheFormat);
+    this->Append(header, key);
+    this->Append(header, std::string(PARAVIEW_VERSION_FULL));
+    this->Append(header, static_cast<vtkTypeUInt32>(this->Entries.size()));
+    for (const auto& entry : this->Entries)
+    {
+      this->Append(header, entry.Group);
+      this->Append(header, entry.Name);
+      this->Append(header, static_cast<vtkTypeUInt32>(entry.Extension ? 1 : 0));
+      this->Append(header, static_cast<vtkTypeUInt64>(entry.Offset));
+      this->Append(header, static_cast<vtkTypeUInt64>(entry.Length));
+    }
+    this->Append(header, static_cast<vtkTypeUInt64>(this->Payload.size()));
+
+    std::random_device device;
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%08x.tmp", static_cast<unsigned int>(device()));
+    const std::string tmpname = filename + suffix;
+    FILE* fp = fopen(tmpname.c_str(), "wb");
+    if (!fp)
+    {
+      return false;
+    }
+    bool success = fwrite(header.data(), 1, header.size(), fp) == header.size() &&
+      fwrite(this->Payload.data(), 1, this->Payload.size(), fp) == this->Payload.size();
+    success = (fclose(fp) == 0) && success;
+    if (!success || rename(tmpname.c_str(), filename.c_str()) != 0)
+    {
+      remove(tmpname.c_str());
+      return false;
+    }
+    return true;
+  }
+
+private:
+  template <typename T>
+  void Append(std::vector<char>& buffer, T value)
+  {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+  void Append(std::vector<char>& buffer, const std::string& str)
+  {
+    this->Append(buffer, static_cast<vtkTypeUInt32>(str.size()));
+    buffer.insert(buffer.end(), str.begin(), str.end());
+  }
+
+  std::vector<vtkSIProxyDefinitionCacheIndexEntry> Entries;
+  std::vector<char> Payload;
+};
+
+//----------------------------------------------------------------------------
+class vtkSIProxyDefinitionCacheReader
+{
+public:
+  vtkSIProxyDefinitionCacheReader(const vtkSIProxyDefinitionCacheFile& file)
+    : Data(file.GetData())
+    , Size(file.GetSize())
+    , Position(0)
+  {
+  }
+
+  // Reads the index of the file. Returns false if the file is not a valid
+  // cache for `key`.
+  bool ReadIndex(vtkTypeUInt64 key, std::vector<vtkSIProxyDefinitionCacheIndexEntry>& entries)
+  {
+    vtkTypeUInt32 magic, format, count;
+    vtkTypeUInt64 fileKey, payloadLength;
+    std::string version;
+    if (!this->Read(magic) || magic != vtkSIProxyDefinitionCacheMagic || !this->Read(format) ||
+      format != vtkSIProxyDefinitionCacheFormat || !this->Read(fileKey) || fileKey != key ||
+      !this->Read(version) || version != PARAVIEW_VERSION_FULL || !this->Read(count))
+    {
+      return false;
+    }
+    entries.resize(count);
+    for (auto& entry : entries)
+    {
+      vtkTypeUInt32 extension;
+      vtkTypeUInt64 offset, length;
+      if (!this->Read(entry.Group) || !this->Read(entry.Name) || !this->Read(extension) ||
+        !this->Read(offset) || !this->Read(length))
+      {
+        return false;
+      }
+      entry.Extension = extension != 0;
+      entry.Offset = static_cast<size_t>(offset);
+      entry.Length = static_cast<size_t>(length);
+    }
+    if (!this->Read(payloadLength) || this->Size - this->Position != payloadLength)
+    {
+      return false;
+    }
+    for (auto& entry : entries)
+    {
+      if (entry.Offset > payloadLength || entry.Length > payloadLength - entry.Offset)
+      {
+        return false;
+      }
+      entry.Offset += this->Position;
+    }
+    return true;
+  }
+
+private:
+  template <typename T>
+  bool Read(T& value)
+  {
+    if (this->Size - this->Position < sizeof(T))
+    {
+      return false;
+    }
+    memcpy(&value, this->Data + this->Position, sizeof(T));
+    this->Position += sizeof(T);
+    return true;
+  }
+  bool Read(std::string& str)
+  {
+    vtkTypeUInt32 length;
+    if (!this->Read(length) || this->Size - this->Position < length)
+    {
+      return false;
+    }
+    str.assign(this->Data + this->Position, length);
+    this->Position += length;
+    return true;
+  }
+
+  const char* Data;
+  size_t Size;
+  size_t Position;
+};
+
+//----------------------------------------------------------------------------
+vtkPVXMLElement* vtkSIProxyDefinitionFindConfiguration(vtkPVXMLElement* root)
+{
+  if (root && (!root->GetName() || strcmp(root->GetName(), "ServerManagerConfiguration") != 0))
+  {
+    return root->FindNestedElementByName("ServerManagerConfiguration");
+  }
+  return root;
+}
+}
+
 class vtkSIProxyDefinitionManager::vtkInternals
 {
 public:
@@ -59,9 +393,16 @@ public:
   StrToStrToXmlMap CoreDefinitions;
   // Keep track of custom definition
   StrToStrToXmlMap CustomsDefinitions;
+  // ServerManager definitions loaded from a cache file and not decoded yet.
+  // A definition is either in CoreDefinitions or in CachedDefinitions.
+  StrToStrToCacheEntryMap CachedDefinitions;
+  // Identifies the configuration XML loaded so far, to key the cache of
+  // the flattened definitions. 0 when unknown.
+  vtkTypeUInt64 ConfigurationKey;
   //-------------------------------------------------------------------------
   vtkInternals()
     : EnableXMLProxyDefinitionUpdate(true)
+    , ConfigurationKey(vtkSIProxyDefinitionHashBasis)
   {
   }
   //-------------------------------------------------------------------------
@@ -69,11 +410,84 @@ public:
   {
     this->CoreDefinitions.clear();
     this->CustomsDefinitions.clear();
+    this->CachedDefinitions.clear();
+    this->ConfigurationKey = vtkSIProxyDefinitionHashBasis;
+  }
+  //-------------------------------------------------------------------------
+  void UpdateConfigurationKey(vtkTypeUInt64 key)
+  {
+    if (this->ConfigurationKey != 0 && key != 0)
+    {
+      this->ConfigurationKey = vtkSIProxyDefinitionHash(&key, sizeof(key), this->ConfigurationKey);
+    }
+    else
+    {
+      this->ConfigurationKey = 0;
+    }
+  }
+  //-------------------------------------------------------------------------
+  const vtkSIProxyDefinitionCacheEntry* GetCachedDefinition(
+    const char* groupName, const char* proxyName)
+  {
+    if (groupName && proxyName)
+    {
+      StrToStrToCacheEntryMap::const_iterator it = this->CachedDefinitions.find(groupName);
+      if (it != this->CachedDefinitions.end())
+      {
+        StrToCacheEntryMap::const_iterator it2 = it->second.find(proxyName);
+        if (it2 != it->second.end())
+        {
+          return &it2->second;
+        }
+      }
+    }
+    return NULL;
+  }
+  //-------------------------------------------------------------------------
+  void RemoveCachedDefinition(const char* groupName, const char* proxyName)
+  {
+    StrToStrToCacheEntryMap::iterator it = this->CachedDefinitions.find(groupName);
+    if (it != this->CachedDefinitions.end())
+    {
+      it->second.erase(proxyName);
+    }
+  }
+  //-------------------------------------------------------------------------
+  // Moves a definition from CachedDefinitions to CoreDefinitions.
+  void DecodeCachedDefinition(const char* groupName, const char* proxyName)
+  {
+    const vtkSIProxyDefinitionCacheEntry* entry = this->GetCachedDefinition(groupName, proxyName);
+    if (entry)
+    {
+      XMLElement element = entry->Decode();
+      this->RemoveCachedDefinition(groupName, proxyName);
+      if (element)
+      {
+        this->CoreDefinitions[groupName][proxyName] = element;
+      }
+    }
+  }
+  //-------------------------------------------------------------------------
+  void DecodeCachedDefinitions()
+  {
+    for (const auto& group : this->CachedDefinitions)
+    {
+      for (const auto& proxy : group.second)
+      {
+        XMLElement element = proxy.second.Decode();
+        if (element)
+        {
+          this->CoreDefinitions[group.first][proxy.first] = element;
+        }
+      }
+    }
+    this->CachedDefinitions.clear();
   }
   //-------------------------------------------------------------------------
   bool HasCoreDefinition(const char* groupName, const char* proxyName)
   {
-    return this->GetProxyElement(this->CoreDefinitions, groupName, proxyName) != NULL;
+    return this->GetProxyElement(this->CoreDefinitions, groupName, proxyName) != NULL ||
+      this->GetCachedDefinition(groupName, proxyName) != NULL;
   }
   //-------------------------------------------------------------------------
   bool HasCustomDefinition(const char* groupName, const char* proxyName)
@@ -87,6 +501,7 @@ public:
     if (groupName)
     {
       nbProxy += static_cast<unsigned int>(this->CoreDefinitions[groupName].size());
+      nbProxy += static_cast<unsigned int>(this->CachedDefinitions[groupName].size());
       nbProxy += static_cast<unsigned int>(this->CustomsDefinitions[groupName].size());
     }
     return nbProxy;
@@ -97,6 +512,7 @@ public:
     vtkPVXMLElement* elementToReturn = NULL;
 
     // Search in ServerManager definitions
+    this->DecodeCachedDefinition(groupName, proxyName);
     elementToReturn = this->GetProxyElement(this->CoreDefinitions, groupName, proxyName);
 
     // If not found yet, search in customs ones...
@@ -448,6 +864,7 @@ vtkStandardNewMacro(vtkSIProxyDefinitionManager) vtkStandardNewMacro(vtkInternal
 
     this->HandlePlugin(plugin);
   }
+  this->UpdateCollapsedDefinitionsCache();
 
   // Register with the plugin tracker, so that when new plugins are loaded,
   // we parse the XML if provided and automatically add it to the proxy
@@ -478,6 +895,7 @@ void vtkSIProxyDefinitionManager::AddElement(
   if (element->GetName() && strcmp(element->GetName(), "Extension") == 0)
   {
     // This is an extension for an existing definition.
+    this->Internals->DecodeCachedDefinition(groupName, proxyName);
     vtkPVXMLElement* coreElem =
       this->Internals->GetProxyElement(this->Internals->CoreDefinitions, groupName, proxyName);
     if (coreElem)
@@ -498,6 +916,7 @@ void vtkSIProxyDefinitionManager::AddElement(
   else
   {
     // Just referenced it
+    this->Internals->RemoveCachedDefinition(groupName, proxyName);
     this->Internals->CoreDefinitions[groupName][proxyName] = element;
     updated = true;
   }
@@ -765,17 +1184,190 @@ bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(const char* xml
 bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(
   const char* xmlContent, bool attachHints)
 {
+  // The cache key covers everything the cached definitions depend on.
+  vtkTypeUInt64 key = 0;
+  if (xmlContent && *vtkSIProxyDefinitionManager::GetCacheDirectory())
+  {
+    const char hintsFlag = attachHints ? 1 : 0;
+    key = vtkSIProxyDefinitionHash(xmlContent, strlen(xmlContent));
+    key = vtkSIProxyDefinitionHash(&hintsFlag, 1, key);
+    if (this->LoadConfigurationXMLCache(key))
+    {
+      this->Internals->UpdateConfigurationKey(key);
+      return true;
+    }
+  }
+
   vtkNew<vtkPVXMLParser> parser;
-  return (parser->Parse(xmlContent) != 0) &&
-    this->LoadConfigurationXML(parser->GetRootElement(), attachHints);
+  if (parser->Parse(xmlContent) == 0)
+  {
+    return false;
+  }
+  vtkPVXMLElement* root = vtkSIProxyDefinitionFindConfiguration(parser->GetRootElement());
+  if (key != 0 && root)
+  {
+    // Cache the definitions as they are before being registered, since
+    // extensions modify the definitions they extend.
+    if (attachHints)
+    {
+      this->AttachShowInMenuHintsToProxyFromProxyGroups(root);
+      attachHints = false;
+    }
+    this->SaveConfigurationXMLCache(key, root);
+  }
+  this->Internals->UpdateConfigurationKey(key);
+  return this->LoadConfigurationXML(root, attachHints);
 }
 
 //---------------------------------------------------------------------------
 bool vtkSIProxyDefinitionManager::LoadConfigurationXML(vtkPVXMLElement* root)
 {
+  // The content of the XML is not known, flattened definitions can no
+  // longer be cached.
+  this->Internals->UpdateConfigurationKey(0);
   return this->LoadConfigurationXML(root, false);
 }
 
+//---------------------------------------------------------------------------
+bool vtkSIProxyDefinitionManager::LoadConfigurationXMLCache(vtkTypeUInt64 key)
+{
+  std::shared_ptr<vtkSIProxyDefinitionCacheFile> file = vtkSIProxyDefinitionCacheFile::Open(
+    vtkSIProxyDefinitionCacheFileName("pvdefinitions", key));
+  std::vector<vtkSIProxyDefinitionCacheIndexEntry> entries;
+  if (!file || !vtkSIProxyDefinitionCacheReader(*file).ReadIndex(key, entries))
+  {
+    return false;
+  }
+
+  // Same as LoadConfigurationXML(), except that definitions are decoded on
+  // first lookup.
+  for (const auto& entry : entries)
+  {
+    vtkSIProxyDefinitionCacheEntry cacheEntry = { file, entry.Offset, entry.Length };
+    if (entry.Extension)
+    {
+      XMLElement extension = cacheEntry.Decode();
+      if (extension)
+      {
+        this->AddElement(entry.Group.c_str(), entry.Name.c_str(), extension);
+      }
+      continue;
+    }
+
+    StrToStrToXmlMap::iterator group = this->Internals->CoreDefinitions.find(entry.Group);
+    if (group != this->Internals->CoreDefinitions.end())
+    {
+      group->second.erase(entry.Name);
+    }
+    this->Internals->CachedDefinitions[entry.Group][entry.Name] = cacheEntry;
+
+    RegisteredDefinitionInformation info(entry.Group.c_str(), entry.Name.c_str(), false);
+    this->InvokeEvent(vtkCommand::RegisterEvent, &info);
+  }
+  this->InvokeEvent(vtkSIProxyDefinitionManager::ProxyDefinitionsUpdated);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::SaveConfigurationXMLCache(
+  vtkTypeUInt64 key, vtkPVXMLElement* root)
+{
+  if (!vtkSIProxyDefinitionCanWriteCache() ||
+    !vtksys::SystemTools::MakeDirectory(vtkSIProxyDefinitionCacheDirectory))
+  {
+    return;
+  }
+
+  // Same traversal as LoadConfigurationXML().
+  vtkSIProxyDefinitionCacheWriter writer;
+  for (unsigned int i = 0; i < root->GetNumberOfNestedElements(); ++i)
+  {
+    vtkPVXMLElement* group = root->GetNestedElement(i);
+    std::string groupName = group->GetAttributeOrEmpty("name");
+    for (unsigned int cc = 0; cc < group->GetNumberOfNestedElements(); ++cc)
+    {
+      vtkPVXMLElement* proxy = group->GetNestedElement(cc);
+      std::string proxyName = proxy->GetAttributeOrEmpty("name");
+      if (!proxyName.empty())
+      {
+        writer.Add(groupName, proxyName, proxy);
+      }
+    }
+  }
+  writer.Write(vtkSIProxyDefinitionCacheFileName("pvdefinitions", key), key);
+}
+
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::UpdateCollapsedDefinitionsCache()
+{
+  const vtkTypeUInt64 key = this->Internals->ConfigurationKey;
+  if (key == 0 || !this->Internals->EnableXMLProxyDefinitionUpdate ||
+    !*vtkSIProxyDefinitionManager::GetCacheDirectory())
+  {
+    return;
+  }
+
+  this->InternalsFlatten->Clear();
+  std::shared_ptr<vtkSIProxyDefinitionCacheFile> file = vtkSIProxyDefinitionCacheFile::Open(
+    vtkSIProxyDefinitionCacheFileName("pvdefinitions-collapsed", key));
+  std::vector<vtkSIProxyDefinitionCacheIndexEntry> entries;
+  if (file && vtkSIProxyDefinitionCacheReader(*file).ReadIndex(key, entries))
+  {
+    for (const auto& entry : entries)
+    {
+      vtkSIProxyDefinitionCacheEntry cacheEntry = { file, entry.Offset, entry.Length };
+      this->InternalsFlatten->CachedDefinitions[entry.Group][entry.Name] = cacheEntry;
+    }
+    return;
+  }
+
+  if (!vtkSIProxyDefinitionCanWriteCache() ||
+    !vtksys::SystemTools::MakeDirectory(vtkSIProxyDefinitionCacheDirectory))
+  {
+    return;
+  }
+
+  // Flatten all the definitions that inherit from others, skipping those
+  // whose base definitions are not available.
+  vtkTimerLog::MarkStartEvent("vtkSIProxyDefinitionManager Collapse Definitions");
+  this->Internals->DecodeCachedDefinitions();
+  vtkSIProxyDefinitionCacheWriter writer;
+  for (const auto& group : this->Internals->CoreDefinitions)
+  {
+    for (const auto& proxy : group.second)
+    {
+      XMLElement collapsed;
+      collapsed.TakeReference(this->NewCollapsedProxyDefinition(proxy.second, false));
+      if (collapsed)
+      {
+        writer.Add(group.first, proxy.first, collapsed);
+        this->InternalsFlatten->CoreDefinitions[group.first][proxy.first] = collapsed;
+      }
+    }
+  }
+  writer.Write(vtkSIProxyDefinitionCacheFileName("pvdefinitions-collapsed", key), key);
+  vtkTimerLog::MarkEndEvent("vtkSIProxyDefinitionManager Collapse Definitions");
+}
+
+//---------------------------------------------------------------------------
+void vtkSIProxyDefinitionManager::SetCacheDirectory(const char* dirname)
+{
+  vtkSIProxyDefinitionCacheDirectory = dirname ? dirname : "";
+  vtkSIProxyDefinitionCacheDirectoryInitialized = true;
+}
+
+//---------------------------------------------------------------------------
+const char* vtkSIProxyDefinitionManager::GetCacheDirectory()
+{
+  if (!vtkSIProxyDefinitionCacheDirectoryInitialized)
+  {
+    const char* dirname = getenv("PV_PROXY_DEFINITION_CACHE");
+    vtkSIProxyDefinitionCacheDirectory = dirname ? dirname : "";
+    vtkSIProxyDefinitionCacheDirectoryInitialized = true;
+  }
+  return vtkSIProxyDefinitionCacheDirectory.c_str();
+}
+
 //---------------------------------------------------------------------------
 bool vtkSIProxyDefinitionManager::LoadConfigurationXML(vtkPVXMLElement* root, bool attachHints)
 {
@@ -841,6 +1433,8 @@ vtkPVProxyDefinitionIterator* vtkSIProxyDefinitionManager::NewSingleGroupIterato
 // vtkSIProxyDefinitionManager::CUSTOM_DEFINITIONS = 2
 vtkPVProxyDefinitionIterator* vtkSIProxyDefinitionManager::NewIterator(int scope)
 {
+  // The iterator walks the maps directly.
+  this->Internals->DecodeCachedDefinitions();
   vtkInternalDefinitionIterator* iterator = vtkInternalDefinitionIterator::New();
   switch (scope)
   {
@@ -861,6 +1455,7 @@ vtkPVProxyDefinitionIterator* vtkSIProxyDefinitionManager::NewIterator(int scope
 void vtkSIProxyDefinitionManager::InvalidateCollapsedDefinition()
 {
   this->InternalsFlatten->CoreDefinitions.clear();
+  this->InternalsFlatten->CachedDefinitions.clear();
 }
 //---------------------------------------------------------------------------
 vtkPVXMLElement* vtkSIProxyDefinitionManager::ExtractSubProxy(
@@ -915,60 +1510,79 @@ vtkPVXMLElement* vtkSIProxyDefinitionManager::GetCollapsedProxyDefinition(
   // Look for parent hierarchy
   if (originalDefinition)
   {
-    vtkPVXMLElement* realDefinition = originalDefinition;
-    std::string base_group = originalDefinition->GetAttributeOrEmpty("base_proxygroup");
-    std::string base_name = originalDefinition->GetAttributeOrEmpty("base_proxyname");
+    XMLElement newElement;
+    newElement.TakeReference(this->NewCollapsedProxyDefinition(originalDefinition, true));
+    if (newElement)
+    {
+      // Register it in the cache
+      this->InternalsFlatten->CoreDefinitions[group][name] = newElement;
+      return this->ExtractSubProxy(newElement.GetPointer(), subProxyName);
+    }
+  }
+
+  // Could be either the original definition or a NULL pointer if not found
+  return this->ExtractSubProxy(originalDefinition, subProxyName);
+}
+
+//---------------------------------------------------------------------------
+vtkPVXMLElement* vtkSIProxyDefinitionManager::NewCollapsedProxyDefinition(
+  vtkPVXMLElement* definition, bool abortOnMissingBase)
+{
+  std::string base_group = definition->GetAttributeOrEmpty("base_proxygroup");
+  std::string base_name = definition->GetAttributeOrEmpty("base_proxyname");
+  if (base_group.empty() || base_name.empty())
+  {
+    return NULL;
+  }
 
+  std::vector<vtkPVXMLElement*> classHierarchy;
+  vtkPVXMLElement* originalDefinition = definition;
+  while (originalDefinition)
+  {
+    classHierarchy.push_back(originalDefinition);
     if (!base_group.empty() && !base_name.empty())
     {
-      std::vector<vtkPVXMLElement*> classHierarchy;
-      while (originalDefinition)
+      originalDefinition =
+        this->GetProxyDefinition(base_group.c_str(), base_name.c_str(), abortOnMissingBase);
+      if (!originalDefinition)
       {
-        classHierarchy.push_back(originalDefinition);
-        if (!base_group.empty() && !base_name.empty())
-        {
-          originalDefinition =
-            this->GetProxyDefinition(base_group.c_str(), base_name.c_str(), throwError);
-          if (!originalDefinition)
-          {
-            vtkErrorMacro("Failed to locate base proxy definition ("
-              << base_group.c_str() << ", " << base_name.c_str()
-              << "). Aborting for debugging purposes.");
-            abort();
-          }
-          base_group = originalDefinition->GetAttributeOrEmpty("base_proxygroup");
-          base_name = originalDefinition->GetAttributeOrEmpty("base_proxyname");
-        }
-        else
+        if (!abortOnMissingBase)
         {
-          originalDefinition = 0;
+          return NULL;
         }
+        vtkErrorMacro("Failed to locate base proxy definition ("
+          << base_group.c_str() << ", " << base_name.c_str()
+          << "). Aborting for debugging purposes.");
+        abort();
       }
-
-      // Build the flattened version of it
-      vtkNew<vtkPVXMLElement> newElement;
-      while (classHierarchy.size() > 0)
-      {
-        vtkPVXMLElement* currentElement = classHierarchy.back();
-        classHierarchy.pop_back();
-        this->MergeProxyDefinition(currentElement, newElement.GetPointer());
-      }
-      realDefinition->CopyAttributesTo(newElement.GetPointer());
-
-      // Remove parent declaration
-      newElement->RemoveAttribute("base_proxygroup");
-      newElement->RemoveAttribute("base_proxyname");
-
-      // Register it in the cache
-      this->InternalsFlatten->CoreDefinitions[group][name] = newElement.GetPointer();
-
-      return this->ExtractSubProxy(newElement.GetPointer(), subProxyName);
+      base_group = originalDefinition->GetAttributeOrEmpty("base_proxygroup");
+      base_name = originalDefinition->GetAttributeOrEmpty("base_proxyname");
+    }
+    else
+    {
+      originalDefinition = 0;
     }
   }
 
-  // Could be either the original definition or a NULL pointer if not found
-  return this->ExtractSubProxy(originalDefinition, subProxyName);
+  // Build the flattened version of it. Copies are merged since merging
+  // moves overridden elements out of the merged definition, which must stay
+  // intact to be flattened again later.
+  vtkPVXMLElement* newElement = vtkPVXMLElement::New();
+  while (classHierarchy.size() > 0)
+  {
+    vtkNew<vtkPVXMLElement> currentElement;
+    classHierarchy.back()->CopyTo(currentElement.GetPointer());
+    classHierarchy.pop_back();
+    this->MergeProxyDefinition(currentElement.GetPointer(), newElement);
+  }
+  definition->CopyAttributesTo(newElement);
+
+  // Remove parent declaration
+  newElement->RemoveAttribute("base_proxygroup");
+  newElement->RemoveAttribute("base_proxyname");
+  return newElement;
 }
+
 //---------------------------------------------------------------------------
 void vtkSIProxyDefinitionManager::MergeProxyDefinition(
   vtkPVXMLElement* element, vtkPVXMLElement* elementToFill)
@@ -1020,12 +1634,13 @@ void vtkSIProxyDefinitionManager::MergeProxyDefinition(
     std::string name = mapIter->first;
     if (propertiesSrc.find(name) != propertiesSrc.end())
     {
+      // Properties exposed from a sub-proxy are overridden if the sub-proxy
+      // definition is.
+      vtkPVXMLElement* parent = propertiesSrc[name]->GetParent();
+      vtkPVXMLElement* grandParent = parent ? parent->GetParent() : NULL;
+      vtkPVXMLElement* subProxy = grandParent ? grandParent->FindNestedElementByName("Proxy") : NULL;
       if (!propertiesSrc[name]->GetAttribute("override") &&
-        !propertiesSrc[name]
-           ->GetParent()
-           ->GetParent()
-           ->FindNestedElementByName("Proxy")
-           ->GetAttribute("override"))
+        !(subProxy && subProxy->GetAttribute("override")))
       {
         vtkWarningMacro(<< "Find conflict between 2 property name. (" << name.c_str() << ")");
         return;
@@ -1119,6 +1734,7 @@ void vtkSIProxyDefinitionManager::Push(vtkSMMessage* msg)
   // proxy definitions on the client side when a server's definitions are
   // loaded. Ideally, we save all proxies that are "client" only. We will do
   // that when we convert this class to use pugixml.
+  this->Internals->DecodeCachedDefinitions();
   const auto animationWriters = this->Internals->CoreDefinitions["animation_writers"];
   const auto screenshotWriters = this->Internals->CoreDefinitions["screenshot_writers"];
 
@@ -1126,6 +1742,9 @@ void vtkSIProxyDefinitionManager::Push(vtkSMMessage* msg)
   // Init and local vars
   this->Internals->Clear();
   this->InternalsFlatten->Clear();
+  // Definitions now come from the server, flattened definitions are not
+  // cached.
+  this->Internals->ConfigurationKey = 0;
   vtkNew<vtkPVXMLParser> parser;
 
   // Fill the definition with the content of the state
@@ -1176,6 +1795,7 @@ void vtkSIProxyDefinitionManager::Push(vtkSMMessage* msg)
 void vtkSIProxyDefinitionManager::OnPluginLoaded(vtkObject*, unsigned long, void* calldata)
 {
   this->HandlePlugin(reinterpret_cast<vtkPVPlugin*>(calldata));
+  this->UpdateCollapsedDefinitionsCache();
 }
 
 //---------------------------------------------------------------------------
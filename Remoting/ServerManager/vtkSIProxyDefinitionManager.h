@@ -37,6 +37,15 @@
  * \li \c vtkCommand::UnRegisterEvent - Fired when a proxy definition is
  * removed. Since this class only support removing custom proxies, this event is
  * fired only when a custom proxy is removed.
+ *
+ * When a cache directory is set (see SetCacheDirectory()), each
+ * server-manager configuration XML is only parsed once: the definitions it
+ * provides are saved in a binary cache file keyed by the XML content, which
+ * is memory-mapped by the following processes. Definitions loaded from the
+ * cache are only decoded when first looked up. The flattened definitions
+ * (see GetCollapsedProxyDefinition()) are cached the same way, keyed by the
+ * whole set of configuration XML loaded. Plugins have their own cache files,
+ * so loading a plugin does not invalidate the core ones.
 */
 
 #ifndef vtkSIProxyDefinitionManager_h
@@ -157,6 +166,17 @@ public:
   bool LoadConfigurationXMLFromString(const char* xmlContent);
   //@}
 
+  //@{
+  /**
+   * Directory where binary caches of the definitions are stored. Only the
+   * first partition writes cache files, all processes read them. Defaults to
+   * the value of the PV_PROXY_DEFINITION_CACHE environment variable. An
+   * empty or null directory disables the cache.
+   */
+  static void SetCacheDirectory(const char* dirname);
+  static const char* GetCacheDirectory();
+  //@}
+
   enum Events
   {
     ProxyDefinitionsUpdated = 2000,
@@ -270,6 +290,32 @@ protected:
   bool LoadConfigurationXMLFromString(const char* xmlContent, bool attachShowInMenuHints);
   //@}
 
+  //@{
+  /**
+   * Binary cache of the definitions of a configuration XML, see
+   * SetCacheDirectory(). LoadConfigurationXMLCache() returns false if there
+   * is no valid cache for the given key.
+   */
+  bool LoadConfigurationXMLCache(vtkTypeUInt64 key);
+  void SaveConfigurationXMLCache(vtkTypeUInt64 key, vtkPVXMLElement* root);
+  //@}
+
+  /**
+   * Loads the cache of the flattened definitions for the configuration XML
+   * loaded so far, or creates it if it does not exist yet.
+   */
+  void UpdateCollapsedDefinitionsCache();
+
+  /**
+   * Builds the flattened version of a definition that inherits from other
+   * definitions. Returns nullptr if the definition does not inherit from
+   * another one. If a base definition cannot be found, aborts when
+   * `abortOnMissingBase` is true, returns nullptr otherwise. The caller must
+   * release the reference to the returned element.
+   */
+  vtkPVXMLElement* NewCollapsedProxyDefinition(
+    vtkPVXMLElement* definition, bool abortOnMissingBase);
+
   //@{
   /**
    * Callback called when a plugin is loaded.
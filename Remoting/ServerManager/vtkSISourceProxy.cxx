@@ -27,6 +27,7 @@
 #include "vtkPVCompositeDataPipeline.h"
 #include "vtkPVLogger.h"
 #include "vtkPVPostFilter.h"
+#include "vtkPVTraceRecorder.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPolyData.h"
 #include "vtkProcessModule.h"
@@ -57,6 +58,7 @@ vtkSISourceProxy::vtkSISourceProxy()
   this->Internals = new vtkInternals();
   this->PortsCreated = false;
   this->StartEventCounter = 0;
+  this->TraceStartTime = -1;
   this->DisablePipelineExecution = false;
 }
 
@@ -304,6 +306,8 @@ void vtkSISourceProxy::MarkStartEvent()
 
     vtkVLogStartScopeF(PARAVIEW_LOG_EXECUTION_VERBOSITY(), vtkLogIdentifier(this), "%s: execute",
       this->GetLogNameOrDefault());
+
+    this->TraceStartTime = vtkPVTraceRecorder::GetEnabled() ? vtkPVTraceRecorder::GetTime() : -1;
   }
 }
 
@@ -312,6 +316,13 @@ void vtkSISourceProxy::MarkEndEvent()
 {
   if (--this->StartEventCounter == 0)
   {
+    if (this->TraceStartTime >= 0)
+    {
+      vtkPVTraceRecorder::RecordEvent("pipeline", this->GetLogNameOrDefault(),
+        this->TraceStartTime, vtkPVTraceRecorder::GetTime());
+      this->TraceStartTime = -1;
+    }
+
     vtkLogEndScope(vtkLogIdentifier(this));
 
     std::ostringstream filterName;
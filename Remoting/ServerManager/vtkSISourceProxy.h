@@ -122,6 +122,7 @@ private:
   vtkInternals* Internals;
   bool PortsCreated;
   int StartEventCounter;
+  vtkTypeInt64 TraceStartTime;
 };
 
 #endif
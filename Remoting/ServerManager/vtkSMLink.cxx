@@ -20,6 +20,7 @@
 #include "vtkSMMessage.h"
 #include "vtkSMProperty.h"
 #include "vtkSMProxy.h"
+#include "vtkSMSession.h"
 
 #include <list>
 
@@ -63,6 +64,15 @@ public:
       {
         this->Link->UpdateProperty(caller, reinterpret_cast<char*>(pname));
       }
+      else if (event == vtkSMProxy::UpdatePropertiesEvent)
+      {
+        // Push all the linked properties together.
+        vtkSMSession::vtkScopedStateTransaction transaction(caller->GetSession());
+        for (const char** names = reinterpret_cast<const char**>(pname); names && *names; ++names)
+        {
+          this->Link->UpdateProperty(caller, *names);
+        }
+      }
     }
     this->InProgress = false;
   }
@@ -101,6 +111,7 @@ void vtkSMLink::ObserveProxyUpdates(vtkSMProxy* proxy)
   proxy->AddObserver(vtkCommand::PropertyModifiedEvent, this->Observer);
   proxy->AddObserver(vtkCommand::UpdateEvent, this->Observer);
   proxy->AddObserver(vtkCommand::UpdatePropertyEvent, this->Observer);
+  proxy->AddObserver(vtkSMProxy::UpdatePropertiesEvent, this->Observer);
 }
 
 //-----------------------------------------------------------------------------
@@ -140,7 +140,8 @@ private:
   {                                                                                                \
     return true;                                                                                   \
   }                                                                                                \
-  vtkPrepareForUnregisteringScopedObj __tmp(arg, this->Internals->ProxiesBeingUnRegistered);
+  vtkPrepareForUnregisteringScopedObj __tmp(arg, this->Internals->ProxiesBeingUnRegistered);       \
+  vtkSMSession::vtkScopedStateTransaction __transaction(arg->GetSession());
 
 vtkObjectFactoryNewMacro(vtkSMParaViewPipelineController);
 //----------------------------------------------------------------------------
@@ -286,6 +287,9 @@ bool vtkSMParaViewPipelineController::InitializeSession(vtkSMSession* session)
 {
   assert(session != NULL);
 
+  // Send all the state pushed while setting up the session in one go.
+  vtkSMSession::vtkScopedStateTransaction transaction(session);
+
   vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
   assert(pxm);
 
@@ -503,6 +507,7 @@ bool vtkSMParaViewPipelineController::RegisterPipelineProxy(
   }
 
   SM_SCOPED_TRACE(RegisterPipelineProxy).arg("proxy", proxy);
+  vtkSMSession::vtkScopedStateTransaction transaction(proxy->GetSession());
 
   // Register proxies created for proxy list domains.
   this->RegisterProxiesForProxyListDomains(proxy);
@@ -595,6 +600,7 @@ bool vtkSMParaViewPipelineController::RegisterViewProxy(vtkSMProxy* proxy, const
   }
 
   SM_SCOPED_TRACE(RegisterViewProxy).arg("proxy", proxy);
+  vtkSMSession::vtkScopedStateTransaction transaction(proxy->GetSession());
 
   // Register proxies created for proxy list domains.
   this->RegisterProxiesForProxyListDomains(proxy);
@@ -732,6 +738,8 @@ bool vtkSMParaViewPipelineController::RegisterRepresentationProxy(vtkSMProxy* pr
     return false;
   }
 
+  vtkSMSession::vtkScopedStateTransaction transaction(proxy->GetSession());
+
   // Register proxies created for proxy list domains.
   this->RegisterProxiesForProxyListDomains(proxy);
 
@@ -1056,6 +1064,8 @@ bool vtkSMParaViewPipelineController::PostInitializeProxy(vtkSMProxy* proxy)
     return false;
   }
 
+  vtkSMSession::vtkScopedStateTransaction transaction(proxy->GetSession());
+
   assert(titer != this->Internals->InitializationTimeStamps.end());
 
   vtkTimeStamp ts = titer->second;
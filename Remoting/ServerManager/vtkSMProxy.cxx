@@ -394,31 +394,16 @@ bool vtkSMProxy::UpdateProperty(const char* name, int force)
   it->second.ModifiedFlag = 0;
 
   vtkSMMessage message;
+  it->second.Property->WriteTo(&message);
 
   // Make sure the local state is updated as well
-  if (this->State)
+  const int index = it->second.StateIndex;
+  if (this->State && index >= 0 && index < this->State->ExtensionSize(ProxyState::property))
   {
-    vtkSMMessage oldState;
-    oldState.CopyFrom(*this->State);
-    this->State->ClearExtension(ProxyState::property);
-    int nbProps = oldState.ExtensionSize(ProxyState::property);
-    for (int cc = 0; cc < nbProps; cc++)
-    {
-      const ProxyState_Property* oldProperty = &oldState.GetExtension(ProxyState::property, cc);
-
-      if (oldProperty->name() == it->second.Property->GetXMLName())
-      {
-        it->second.Property->WriteTo(this->State);
-      }
-      else
-      {
-        ProxyState_Property* newProperty = this->State->AddExtension(ProxyState::property);
-        newProperty->CopyFrom(oldState.GetExtension(ProxyState::property, cc));
-      }
-    }
+    this->State->MutableExtension(ProxyState::property, index)
+      ->CopyFrom(message.GetExtension(ProxyState::property, 0));
   }
 
-  it->second.Property->WriteTo(&message);
   this->PushState(&message);
 
   // Fire event to let everyone know that a property has been updated.
@@ -643,78 +628,57 @@ void vtkSMProxy::UpdateVTKObjects()
   {
     this->InUpdateVTKObjects = 1;
 
-    // Save previous property values and clear the State properties
-    vtkSMMessage oldState;
-    oldState.CopyFrom(*this->State);
-    this->State->ClearExtension(ProxyState::property);
-
-    // iterate over all properties and push modified ones.
+    // iterate over all properties and push modified ones. The state entries
+    // of the pushed properties are rewritten in place, the others are left
+    // untouched.
     vtkSMMessage message;
+    std::vector<std::string> updated;
+    const int stateSize = this->State->ExtensionSize(ProxyState::property);
     vtkSMProxyInternals::PropertyInfoMap::iterator iter;
-    int cc = 0;
     for (iter = this->Internals->Properties.begin(); iter != this->Internals->Properties.end();
          ++iter)
     {
       vtkSMProperty* property = iter->second.Property;
-      if (property && !property->GetInformationOnly())
+      if (!property || property->GetInformationOnly() || !iter->second.ModifiedFlag)
       {
-        if (property->GetIsInternal() || property->IsStateIgnored() ||
-          strcmp(property->GetClassName(), "vtkSMProperty") == 0)
-        {
-          // Push only modified properties
-          if (iter->second.ModifiedFlag)
-          {
-            // Write to message because vtkSMProperty do not have state
-            property->WriteTo(&message);
-
-            // the property is no longer dirty.
-            iter->second.ModifiedFlag = 0;
-
-            // Fire event to let everyone know that a property has been updated.
-            // This is currently used by vtkSMLink. Need to see if we can avoid this
-            // as firing these events ain't inexpensive.
-            this->InvokeEvent(
-              vtkCommand::UpdatePropertyEvent, const_cast<char*>(iter->first.c_str()));
-          }
-        }
-        else
-        {
-          // Push only modified properties
-          if (iter->second.ModifiedFlag)
-          {
-            // Write to state
-            property->WriteTo(this->State);
-
-            // the property is no longer dirty.
-            iter->second.ModifiedFlag = 0;
+        continue;
+      }
 
-            // Write to Push message
-            ProxyState_Property* prop = message.AddExtension(ProxyState::property);
-            prop->CopyFrom(this->State->GetExtension(ProxyState::property, cc));
+      // Write to Push message
+      property->WriteTo(&message);
 
-            // Fire event to let everyone know that a property has been updated.
-            // This is currently used by vtkSMLink. Need to see if we can avoid this
-            // as firing these events ain't inexpensive.
-            this->InvokeEvent(
-              vtkCommand::UpdatePropertyEvent, const_cast<char*>(iter->first.c_str()));
-          }
-          else
-          {
-            // Just copy the previous old value to the state
-            ProxyState_Property* prop = this->State->AddExtension(ProxyState::property);
-            prop->CopyFrom(oldState.GetExtension(ProxyState::property, cc));
-          }
+      // the property is no longer dirty.
+      iter->second.ModifiedFlag = 0;
 
-          // One more property
-          ++cc;
-        }
+      // vtkSMProperty and internal properties do not have state.
+      const int index = iter->second.StateIndex;
+      if (index >= 0 && index < stateSize)
+      {
+        const int last = message.ExtensionSize(ProxyState::property) - 1;
+        this->State->MutableExtension(ProxyState::property, index)
+          ->CopyFrom(message.GetExtension(ProxyState::property, last));
       }
+      updated.push_back(iter->first);
     }
     this->InUpdateVTKObjects = 0;
     this->PropertiesModified = false;
 
     // Send the message
     this->PushState(&message);
+
+    // Let everyone know, with a single event, which properties have been
+    // updated. This is used by vtkSMLink.
+    if (!updated.empty())
+    {
+      std::vector<const char*> names;
+      names.reserve(updated.size() + 1);
+      for (const std::string& name : updated)
+      {
+        names.push_back(name.c_str());
+      }
+      names.push_back(nullptr);
+      this->InvokeEvent(vtkSMProxy::UpdatePropertiesEvent, &names[0]);
+    }
   }
 
   vtkSMProxyInternals::ProxyMap::iterator it2 = this->Internals->SubProxies.begin();
@@ -832,13 +796,19 @@ void vtkSMProxy::RebuildStateForProperties()
         strcmp(property->GetClassName(), "vtkSMProperty") == 0)
       {
         // No state for vtkSMProperty
+        iter->second.StateIndex = -1;
       }
       else
       {
         // Write empty property inside state
+        iter->second.StateIndex = this->State->ExtensionSize(ProxyState::property);
         property->WriteTo(this->State);
       }
     }
+    else
+    {
+      iter->second.StateIndex = -1;
+    }
   }
 }
 
@@ -1004,6 +974,7 @@ void vtkSMProxy::AddSubProxy(const char* name, vtkSMProxy* proxy, int override)
 
   proxy->AddObserver(vtkCommand::PropertyModifiedEvent, this->SubProxyObserver);
   proxy->AddObserver(vtkCommand::UpdatePropertyEvent, this->SubProxyObserver);
+  proxy->AddObserver(vtkSMProxy::UpdatePropertiesEvent, this->SubProxyObserver);
 }
 
 //---------------------------------------------------------------------------
@@ -1069,44 +1040,64 @@ void vtkSMProxy::RemoveSubProxy(const char* name)
 void vtkSMProxy::ExecuteSubProxyEvent(vtkSMProxy* subproxy, unsigned long event, void* data)
 {
   if (subproxy &&
-    (event == vtkCommand::PropertyModifiedEvent || event == vtkCommand::UpdatePropertyEvent))
+    (event == vtkCommand::PropertyModifiedEvent || event == vtkCommand::UpdatePropertyEvent ||
+        event == vtkSMProxy::UpdatePropertiesEvent))
   {
     // A Subproxy has been modified.
-    const char* name = reinterpret_cast<const char*>(data);
-    const char* exposed_name = 0;
-    if (name)
+
+    // First determine the name for this subproxy.
+    vtkSMProxyInternals::ProxyMap::iterator proxy_iter = this->Internals->SubProxies.begin();
+    const char* subproxy_name = 0;
+    for (; proxy_iter != this->Internals->SubProxies.end(); ++proxy_iter)
     {
-      // Check if the property from the subproxy was exposed.
-      // If so, we invoke this event with the exposed name.
+      if (proxy_iter->second.GetPointer() == subproxy)
+      {
+        subproxy_name = proxy_iter->first.c_str();
+        break;
+      }
+    }
 
-      // First determine the name for this subproxy.
-      vtkSMProxyInternals::ProxyMap::iterator proxy_iter = this->Internals->SubProxies.begin();
-      const char* subproxy_name = 0;
-      for (; proxy_iter != this->Internals->SubProxies.end(); ++proxy_iter)
+    // Check if a property from the subproxy was exposed. If so, we invoke
+    // the event with the exposed name.
+    auto getExposedName = [this, subproxy_name](const char* name) -> const char* {
+      if (!name || !subproxy_name)
       {
-        if (proxy_iter->second.GetPointer() == subproxy)
+        return 0;
+      }
+      vtkSMProxyInternals::ExposedPropertyInfoMap::iterator iter =
+        this->Internals->ExposedProperties.begin();
+      for (; iter != this->Internals->ExposedProperties.end(); ++iter)
+      {
+        if (iter->second.SubProxyName == subproxy_name && iter->second.PropertyName == name)
         {
-          subproxy_name = proxy_iter->first.c_str();
-          break;
+          // This property is indeed exposed. Set the corrrect exposed name.
+          return iter->first.c_str();
         }
       }
-      if (subproxy_name)
+      return 0;
+    };
+
+    if (event == vtkSMProxy::UpdatePropertiesEvent)
+    {
+      // UpdatePropertiesEvent is fired only for exposed properties.
+      std::vector<const char*> exposed_names;
+      for (const char** names = reinterpret_cast<const char**>(data); names && *names; ++names)
       {
-        // Now locate the exposed property name.
-        vtkSMProxyInternals::ExposedPropertyInfoMap::iterator iter =
-          this->Internals->ExposedProperties.begin();
-        for (; iter != this->Internals->ExposedProperties.end(); ++iter)
+        if (const char* exposed_name = getExposedName(*names))
         {
-          if (iter->second.SubProxyName == subproxy_name && iter->second.PropertyName == name)
-          {
-            // This property is indeed exposed. Set the corrrect exposed name.
-            exposed_name = iter->first.c_str();
-            break;
-          }
+          exposed_names.push_back(exposed_name);
         }
       }
+      if (!exposed_names.empty())
+      {
+        exposed_names.push_back(nullptr);
+        this->InvokeEvent(vtkSMProxy::UpdatePropertiesEvent, &exposed_names[0]);
+        this->MarkModified(subproxy);
+      }
+      return;
     }
 
+    const char* exposed_name = getExposedName(reinterpret_cast<const char*>(data));
     if (event == vtkCommand::PropertyModifiedEvent)
     {
       // Let the world know that one of the subproxies of this proxy has
@@ -131,6 +131,7 @@
 #define vtkSMProxy_h
 
 #include "vtkClientServerID.h"              // needed for vtkClientServerID
+#include "vtkCommand.h"                     // needed for vtkCommand::UserEvent
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMRemoteObject.h"
 
@@ -227,9 +228,21 @@ public:
    * Update the VTK object on the server by pushing the values of
    * all modified properties (un-modified properties are ignored).
    * If the object has not been created, it will be created first.
+   * Fires UpdatePropertiesEvent once for all the pushed properties.
    */
   virtual void UpdateVTKObjects();
 
+  enum
+  {
+    /**
+     * Fired by UpdateVTKObjects() once the modified properties have been
+     * pushed. The call data is a null-terminated array of the names (const
+     * char*) of the pushed properties. UpdateProperty() fires
+     * vtkCommand::UpdatePropertyEvent with the name of the property instead.
+     */
+    UpdatePropertiesEvent = vtkCommand::UserEvent + 92
+  };
+
   /**
    * Recreate the VTK object for this proxy. This is a convenient mechanism
    * to create a new VTK object with the same state as an existing one in its
@@ -933,7 +946,9 @@ protected:
   * for the properties order to have changed, then this method must be called
   * after the changes have happened so that vtkSMProxy can rebuild this->State.
   * Currently, this is only relevant for vtkSMSelfGeneratingSourceProxy and
-  * similar that add new properties at run time.
+  * similar that add new properties at run time. It also assigns each property
+  * its index in the state, which lets UpdateVTKObjects() and UpdateProperty()
+  * rewrite only the entries of the properties being pushed.
   */
   void RebuildStateForProperties();
 
@@ -36,6 +36,8 @@
 // * DoUpdate : should the property be updated (pushed) during UpdateVTKObjects
 // * ObserverTag : the tag returned by AddObserver(). Used to remove the
 // observer.
+// * StateIndex : index of the property in the proxy state or -1 if the
+// property is not part of the state.
 struct vtkSMProxyInternals
 {
   struct PropertyInfo
@@ -44,10 +46,12 @@ struct vtkSMProxyInternals
     {
       this->ModifiedFlag = 0;
       this->ObserverTag = 0;
+      this->StateIndex = -1;
     };
     vtkSmartPointer<vtkSMProperty> Property;
     int ModifiedFlag;
     unsigned int ObserverTag;
+    int StateIndex;
   };
   // Note that the name of the property is the map key. That is the
   // only place where name is stored
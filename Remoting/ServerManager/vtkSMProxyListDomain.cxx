@@ -105,6 +105,8 @@ public:
               input->AddObserver(vtkCommand::UncheckedPropertyModifiedEvent, observer));
             this->ObserverIds.push_back(
               parent->AddObserver(vtkCommand::UpdatePropertyEvent, observer));
+            this->ObserverIds.push_back(
+              parent->AddObserver(vtkSMProxy::UpdatePropertiesEvent, observer));
             observer->FastDelete();
             output->Copy(input);
           }
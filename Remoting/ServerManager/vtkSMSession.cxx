@@ -44,6 +44,25 @@
 // STATICS
 vtkSmartPointer<vtkProcessModuleAutoMPI> vtkSMSession::AutoMPI =
   vtkSmartPointer<vtkProcessModuleAutoMPI>::New();
+//----------------------------------------------------------------------------
+vtkSMSession::vtkScopedStateTransaction::vtkScopedStateTransaction(vtkSMSession* session)
+  : Session(session)
+{
+  if (this->Session)
+  {
+    this->Session->BeginStateTransaction();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSMSession::vtkScopedStateTransaction::~vtkScopedStateTransaction()
+{
+  if (this->Session)
+  {
+    this->Session->CommitStateTransaction();
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSMSession);
 //----------------------------------------------------------------------------
@@ -121,6 +121,48 @@ public:
   vtkGetObjectMacro(StateLocator, vtkSMStateLocator);
   //@}
 
+  //---------------------------------------------------------------------------
+  // State transaction API.
+  //---------------------------------------------------------------------------
+
+  //@{
+  /**
+   * Begin/commit a state transaction. While a transaction is open, sessions
+   * that talk to remote processes are free to hold the state messages pushed
+   * with PushState() and send them together when the outermost transaction is
+   * committed. Messages are always delivered in the order in which they were
+   * pushed and any pending message is sent before a call that needs a reply
+   * from the server. Transactions can be nested. The implementation provided
+   * here does nothing since builtin sessions process messages immediately.
+   * Prefer vtkScopedStateTransaction over calling these directly.
+   */
+  virtual void BeginStateTransaction() {}
+  virtual void CommitStateTransaction() {}
+  //@}
+
+  /**
+   * Helper class designed to call session->BeginStateTransaction() in
+   * constructor and session->CommitStateTransaction() in destructor.
+   * @code
+   * {
+   *    vtkSMSession::vtkScopedStateTransaction transaction(session);
+   *    ...
+   * }
+   * @endcode
+   */
+  class VTKREMOTINGSERVERMANAGER_EXPORT vtkScopedStateTransaction
+  {
+    vtkSMSession* Session;
+
+  public:
+    vtkScopedStateTransaction(vtkSMSession* session);
+    ~vtkScopedStateTransaction();
+
+  private:
+    vtkScopedStateTransaction(const vtkScopedStateTransaction&) = delete;
+    void operator=(const vtkScopedStateTransaction&) = delete;
+  };
+
   //---------------------------------------------------------------------------
   // Superclass Implementations
   //---------------------------------------------------------------------------
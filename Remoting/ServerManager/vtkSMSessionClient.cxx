@@ -92,6 +92,7 @@ vtkSMSessionClient::vtkSMSessionClient()
   // Default value
   this->NoMoreDelete = false;
   this->NotBusy = 0;
+  this->StateTransactionDepth = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -125,6 +126,9 @@ vtkSMSessionClient::~vtkSMSessionClient()
 //----------------------------------------------------------------------------
 vtkMultiProcessController* vtkSMSessionClient::GetController(ServerFlags processType)
 {
+  // Callers talk to the server(s) directly using the controller so they must
+  // not overtake state messages held by an open transaction.
+  this->FlushPendingState();
   switch (processType)
   {
     case CLIENT:
@@ -447,6 +451,7 @@ bool vtkSMSessionClient::IsMPIInitialized(vtkTypeUInt32 servers)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::CloseSession()
 {
+  this->FlushPendingState();
   if (this->DataServerController)
   {
     this->DataServerController->TriggerRMIOnAllChildren(vtkPVSessionServer::CLOSE_SESSION);
@@ -465,6 +470,7 @@ void vtkSMSessionClient::CloseSession()
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PreDisconnection()
 {
+  this->FlushPendingState();
   this->NoMoreDelete = true;
 }
 
@@ -512,15 +518,10 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   }
   if (num_controllers > 0)
   {
-    vtkMultiProcessStream stream;
-    stream << static_cast<int>(vtkPVSessionServer::PUSH);
-    stream << message->SerializeAsString();
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
+    const std::string serialized = message->SerializeAsString();
     for (int cc = 0; cc < num_controllers; cc++)
     {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      this->SendPushMessage(controllers[cc], serialized);
     }
   }
 
@@ -552,13 +553,7 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
         msg.set_share_only(true);
         msg.set_client_id(this->ServerInformation->GetClientId());
 
-        vtkMultiProcessStream stream;
-        stream << static_cast<int>(vtkPVSessionServer::PUSH);
-        stream << msg.SerializeAsString();
-        std::vector<unsigned char> raw_message;
-        stream.GetRawData(raw_message);
-        this->DataServerController->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        this->SendPushMessage(this->DataServerController, msg.SerializeAsString());
       }
       else if (!remoteObject)
       {
@@ -580,9 +575,100 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::SendPushMessage(
+  vtkMultiProcessController* controller, const std::string& message)
+{
+  if (this->StateTransactionDepth > 0)
+  {
+    if (controller == this->DataServerController)
+    {
+      this->PendingDataServerStates.push_back(message);
+    }
+    else
+    {
+      this->PendingRenderServerStates.push_back(message);
+    }
+    return;
+  }
+
+  vtkMultiProcessStream stream;
+  stream << static_cast<int>(vtkPVSessionServer::PUSH);
+  stream << message;
+  std::vector<unsigned char> raw_message;
+  stream.GetRawData(raw_message);
+  controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
+    vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::BeginStateTransaction()
+{
+  this->StateTransactionDepth++;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::CommitStateTransaction()
+{
+  if (this->StateTransactionDepth <= 0)
+  {
+    vtkWarningMacro("CommitStateTransaction() called without a matching BeginStateTransaction().");
+    return;
+  }
+  if (--this->StateTransactionDepth == 0)
+  {
+    this->FlushPendingState();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::FlushPendingState()
+{
+  vtkMultiProcessController* controllers[2] = { this->DataServerController,
+    this->RenderServerController };
+  std::vector<std::string>* pending[2] = { &this->PendingDataServerStates,
+    &this->PendingRenderServerStates };
+  for (int cc = 0; cc < 2; cc++)
+  {
+    if (pending[cc]->empty())
+    {
+      continue;
+    }
+
+    // Swap the queue out so that a re-entrant flush, e.g. from a connection
+    // error handler, does not send the messages twice.
+    std::vector<std::string> messages;
+    messages.swap(*pending[cc]);
+    if (controllers[cc] == NULL)
+    {
+      continue;
+    }
+
+    vtkMultiProcessStream stream;
+    if (messages.size() == 1)
+    {
+      stream << static_cast<int>(vtkPVSessionServer::PUSH) << messages[0];
+    }
+    else
+    {
+      stream << static_cast<int>(vtkPVSessionServer::PUSH_BATCH)
+             << static_cast<int>(messages.size());
+      for (size_t i = 0; i < messages.size(); ++i)
+      {
+        stream << messages[i];
+      }
+    }
+    std::vector<unsigned char> raw_message;
+    stream.GetRawData(raw_message);
+    controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
+      static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PullState(vtkSMMessage* message)
 {
+  this->FlushPendingState();
   this->StartBusyWork();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
@@ -639,6 +725,7 @@ void vtkSMSessionClient::ExecuteStream(
     return;
   }
 
+  this->FlushPendingState();
   location = this->GetRealLocation(location);
 
   vtkMultiProcessController* controllers[2] = { NULL, NULL };
@@ -682,6 +769,7 @@ void vtkSMSessionClient::ExecuteStream(
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 location)
 {
+  this->FlushPendingState();
   this->StartBusyWork();
   location = this->GetRealLocation(location);
 
@@ -730,6 +818,7 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
 bool vtkSMSessionClient::GatherInformation(
   vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
 {
+  this->FlushPendingState();
   this->StartBusyWork();
   if (this->RenderServerController == NULL)
   {
@@ -829,6 +918,7 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  this->FlushPendingState();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
@@ -870,6 +960,7 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  this->FlushPendingState();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
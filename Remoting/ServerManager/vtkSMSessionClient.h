@@ -26,6 +26,9 @@
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMSession.h"
 
+#include <string> // for std::string
+#include <vector> // for std::vector
+
 class vtkMultiProcessController;
 class vtkPVServerInformation;
 class vtkSMCollaborationManager;
@@ -108,6 +111,22 @@ public:
   const vtkClientServerStream& GetLastResult(vtkTypeUInt32 location) override;
   //@}
 
+  //@{
+  /**
+   * Overridden to hold the state messages pushed to the server(s) while a
+   * transaction is open and to send them as a single batch per server when
+   * the outermost transaction is committed.
+   */
+  void BeginStateTransaction() override;
+  void CommitStateTransaction() override;
+  //@}
+
+  /**
+   * Sends the state messages held by an open transaction, if any. This is
+   * called before every request that needs the server(s) to be up-to-date.
+   */
+  void FlushPendingState();
+
   //@{
   /**
    * When Connect() is waiting for a server to connect back to the client (in
@@ -277,7 +296,15 @@ private:
   vtkSMSessionClient(const vtkSMSessionClient&) = delete;
   void operator=(const vtkSMSessionClient&) = delete;
 
+  /**
+   * Queue or send a serialized PUSH message to the given controller.
+   */
+  void SendPushMessage(vtkMultiProcessController* controller, const std::string& message);
+
   int NotBusy;
+  int StateTransactionDepth;
+  std::vector<std::string> PendingDataServerStates;
+  std::vector<std::string> PendingRenderServerStates;
   vtkTypeUInt32 LastGlobalID;
   vtkTypeUInt32 LastGlobalIDAvailable;
 };
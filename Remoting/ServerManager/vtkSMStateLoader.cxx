@@ -530,6 +530,10 @@ int vtkSMStateLoader::LoadState(vtkPVXMLElement* elem, bool keepOriginalId)
     return 0;
   }
 
+  // Proxies created from the state push a lot of small messages, send them to
+  // the server(s) as a single batch.
+  vtkSMSession::vtkScopedStateTransaction transaction(this->GetSession());
+
   this->ProxyLocator->SetDeserializer(this);
   int ret = this->LoadStateInternal(elem);
   this->ProxyLocator->SetDeserializer(0);
@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkSMTraceRecorderHelper.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMTraceRecorderHelper.h"
+
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVTraceInformation.h"
+#include "vtkPVTraceRecorder.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+vtkSmartPointer<vtkSMProxy> NewTraceRecorderProxy(vtkSMSession* session)
+{
+  vtkSmartPointer<vtkSMProxy> proxy;
+  vtkSMSessionProxyManager* pxm = session ? session->GetSessionProxyManager() : nullptr;
+  if (pxm)
+  {
+    proxy.TakeReference(pxm->NewProxy("misc", "TraceRecorder"));
+  }
+  return proxy;
+}
+}
+
+vtkStandardNewMacro(vtkSMTraceRecorderHelper);
+//----------------------------------------------------------------------------
+vtkSMTraceRecorderHelper::vtkSMTraceRecorderHelper()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkSMTraceRecorderHelper::~vtkSMTraceRecorderHelper()
+{
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMTraceRecorderHelper::SetEnabled(vtkSMSession* session, bool enabled)
+{
+  vtkSmartPointer<vtkSMProxy> proxy = NewTraceRecorderProxy(session);
+  if (!proxy)
+  {
+    vtkGenericWarningMacro("Failed to create the 'TraceRecorder' proxy.");
+    return false;
+  }
+
+  if (enabled)
+  {
+    proxy->InvokeCommand("SynchronizeClocks");
+  }
+  vtkSMPropertyHelper(proxy, "Enable").Set(enabled ? 1 : 0);
+  proxy->UpdateVTKObjects();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMTraceRecorderHelper::ResetEvents(vtkSMSession* session)
+{
+  vtkSmartPointer<vtkSMProxy> proxy = NewTraceRecorderProxy(session);
+  if (!proxy)
+  {
+    vtkGenericWarningMacro("Failed to create the 'TraceRecorder' proxy.");
+    return false;
+  }
+  proxy->InvokeCommand("ResetEvents");
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMTraceRecorderHelper::WriteChromeTrace(vtkSMSession* session, const char* filename)
+{
+  if (!session || !filename)
+  {
+    return false;
+  }
+
+  vtkNew<vtkPVTraceInformation> info;
+  if (!session->IsA("vtkSMSessionClient"))
+  {
+    // builtin or batch: all ranks share the clock of the root rank.
+    session->GatherInformation(vtkPVSession::CLIENT_AND_SERVERS, info, 0);
+    return info->WriteChromeTrace(filename);
+  }
+
+  info->CopyFromObject(nullptr);
+
+  const bool separateRenderServer = session->GetController(vtkPVSession::DATA_SERVER_ROOT) !=
+    session->GetController(vtkPVSession::RENDER_SERVER_ROOT);
+  const vtkTypeUInt32 locations[2] = { vtkPVSession::DATA_SERVER, vtkPVSession::RENDER_SERVER };
+  for (int cc = 0; cc < (separateRenderServer ? 2 : 1); ++cc)
+  {
+    vtkNew<vtkPVTraceInformation> serverInfo;
+    const vtkTypeInt64 sent = vtkPVTraceRecorder::GetTime();
+    session->GatherInformation(locations[cc], serverInfo, 0);
+    const vtkTypeInt64 received = vtkPVTraceRecorder::GetTime();
+
+    // move the server timelines to the client clock.
+    serverInfo->ShiftTimes((sent + received) / 2 - serverInfo->GetCollectionTime());
+    info->AddInformation(serverInfo);
+  }
+  return info->WriteChromeTrace(filename);
+}
+
+//----------------------------------------------------------------------------
+void vtkSMTraceRecorderHelper::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
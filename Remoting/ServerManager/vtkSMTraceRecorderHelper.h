@@ -0,0 +1,76 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkSMTraceRecorderHelper.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSMTraceRecorderHelper
+ * @brief   records and saves timelines of events on all processes.
+ *
+ * vtkSMTraceRecorderHelper provides helper methods to control
+ * vtkPVTraceRecorder on the client and on all the server ranks of a session
+ * and to save the recorded events to a single Chrome trace file.
+ *
+ * Events gathered from each server process group are aligned on the client
+ * clock using the time the group reported while the information was being
+ * gathered, assuming it was reported halfway through the request.
+ *
+ * @code{cpp}
+ * vtkSMTraceRecorderHelper::SetEnabled(session, true);
+ * ...
+ * vtkSMTraceRecorderHelper::WriteChromeTrace(session, "paraview.trace.json");
+ * @endcode
+ */
+
+#ifndef vtkSMTraceRecorderHelper_h
+#define vtkSMTraceRecorderHelper_h
+
+#include "vtkObject.h"
+#include "vtkRemotingServerManagerModule.h" //needed for exports
+
+class vtkSMSession;
+
+class VTKREMOTINGSERVERMANAGER_EXPORT vtkSMTraceRecorderHelper : public vtkObject
+{
+public:
+  static vtkSMTraceRecorderHelper* New();
+  vtkTypeMacro(vtkSMTraceRecorderHelper, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Enable/disable recording on all processes of the session. When enabling,
+   * the clocks of the ranks of each process group are synchronized too.
+   * Returns false if the session does not provide the "TraceRecorder" proxy.
+   */
+  static bool SetEnabled(vtkSMSession* session, bool enabled);
+
+  /**
+   * Discard the events recorded on all processes of the session.
+   */
+  static bool ResetEvents(vtkSMSession* session);
+
+  /**
+   * Gather the events recorded on all processes of the session and write
+   * them to `filename` in the Chrome trace event format.
+   */
+  static bool WriteChromeTrace(vtkSMSession* session, const char* filename);
+
+protected:
+  vtkSMTraceRecorderHelper();
+  ~vtkSMTraceRecorderHelper() override;
+
+private:
+  vtkSMTraceRecorderHelper(const vtkSMTraceRecorderHelper&) = delete;
+  void operator=(const vtkSMTraceRecorderHelper&) = delete;
+};
+
+#endif
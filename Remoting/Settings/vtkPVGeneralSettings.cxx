@@ -26,6 +26,7 @@
 #endif
 
 #if VTK_MODULE_ENABLE_ParaView_RemotingViews
+#include "vtkPVDataDeliveryManager.h"
 #include "vtkPVXYChartView.h"
 #include "vtkSMChartSeriesSelectionDomain.h"
 #include "vtkSMParaViewPipelineControllerWithRendering.h"
@@ -33,6 +34,7 @@
 #endif
 
 #include <cassert>
+#include <string>
 
 vtkSmartPointer<vtkPVGeneralSettings> vtkPVGeneralSettings::Instance;
 
@@ -166,8 +168,36 @@ void vtkPVGeneralSettings::SetAnimationGeometryCacheLimit(unsigned long val)
   if (this->AnimationGeometryCacheLimit != val)
   {
     this->AnimationGeometryCacheLimit = val;
+#if VTK_MODULE_ENABLE_ParaView_RemotingViews
+    vtkPVDataDeliveryManager::SetCacheMemoryLimit(val);
+#endif
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetAnimationGeometryCacheSpillDirectory(const char* dirname)
+{
+#if VTK_MODULE_ENABLE_ParaView_RemotingViews
+  const std::string value = dirname ? dirname : "";
+  if (value != vtkPVDataDeliveryManager::GetCacheSpillDirectory())
+  {
+    vtkPVDataDeliveryManager::SetCacheSpillDirectory(value.c_str());
     this->Modified();
   }
+#else
+  (void)dirname;
+#endif
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVGeneralSettings::GetAnimationGeometryCacheSpillDirectory()
+{
+#if VTK_MODULE_ENABLE_ParaView_RemotingViews
+  return vtkPVDataDeliveryManager::GetCacheSpillDirectory();
+#else
+  return "";
+#endif
 }
 
 //----------------------------------------------------------------------------
@@ -284,6 +314,8 @@ void vtkPVGeneralSettings::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ScalarBarMode: " << this->ScalarBarMode << "\n";
   os << indent << "CacheGeometryForAnimation: " << this->CacheGeometryForAnimation << "\n";
   os << indent << "AnimationGeometryCacheLimit: " << this->AnimationGeometryCacheLimit << "\n";
+  os << indent << "AnimationGeometryCacheSpillDirectory: "
+     << this->GetAnimationGeometryCacheSpillDirectory() << "\n";
   os << indent << "PropertiesPanelMode: " << this->PropertiesPanelMode << "\n";
   os << indent << "LockPanels: " << this->LockPanels << "\n";
 }
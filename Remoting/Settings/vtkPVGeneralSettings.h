@@ -146,12 +146,21 @@ public:
 
   //@{
   /**
-   * Set the animation cache limit in KBs.
+   * Set the animation cache limit in KBs. 0 means no limit.
    */
   void SetAnimationGeometryCacheLimit(unsigned long val);
   vtkGetMacro(AnimationGeometryCacheLimit, unsigned long);
   //@}
 
+  //@{
+  /**
+   * Set the local directory where geometry evicted from the animation cache
+   * is saved. Empty means evicted geometry is discarded.
+   */
+  void SetAnimationGeometryCacheSpillDirectory(const char* dirname);
+  const char* GetAnimationGeometryCacheSpillDirectory();
+  //@}
+
   //@{
   /**
    * Set the precision of the animation time toolbar.
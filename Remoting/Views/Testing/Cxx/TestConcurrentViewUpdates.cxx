@@ -0,0 +1,240 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestConcurrentViewUpdates.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks vtkPVView::SetEnableConcurrentUpdates(): with two independent
+// sources and two filters sharing a source, every upstream algorithm executes
+// exactly once per render and the outputs are the same as when the pipelines
+// are updated sequentially. When Python is available, a programmable filter
+// is added downstream of one of the sources: that pipeline must be updated on
+// the calling thread.
+
+#include "vtkAlgorithm.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVView.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#define CHECK(cond)                                                                                \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: Condition FAILED!! : " << #cond << " (line " << __LINE__ << ")" << endl;       \
+    success = false;                                                                               \
+  }
+
+namespace
+{
+// Counts the executions of an algorithm, possibly on several threads, and
+// records whether it executed on another thread than the one creating the
+// counter.
+class ExecutionCounter
+{
+public:
+  void OnStart(vtkObject*, unsigned long, void*)
+  {
+    ++this->Count;
+    if (std::this_thread::get_id() != this->Caller)
+    {
+      this->OtherThread = true;
+    }
+  }
+  std::atomic<int> Count{ 0 };
+  std::atomic<bool> OtherThread{ false };
+  const std::thread::id Caller = std::this_thread::get_id();
+};
+
+vtkSmartPointer<vtkSMSourceProxy> CreatePipelineProxy(vtkSMParaViewPipelineController* controller,
+  vtkSMSessionProxyManager* pxm, const char* xmlgroup, const char* xmlname,
+  vtkSMProxy* input = nullptr)
+{
+  vtkSmartPointer<vtkSMSourceProxy> proxy;
+  proxy.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy(xmlgroup, xmlname)));
+  controller->PreInitializeProxy(proxy);
+  if (input != nullptr)
+  {
+    vtkSMPropertyHelper(proxy, "Input").Set(input);
+  }
+  controller->PostInitializeProxy(proxy);
+  proxy->UpdateVTKObjects();
+  controller->RegisterPipelineProxy(proxy);
+  return proxy;
+}
+
+// Returns true if both outputs have the same points, cells and point data.
+bool SameOutput(vtkPointSet* a, vtkPointSet* b)
+{
+  if (a->GetNumberOfPoints() == 0 || a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  std::vector<vtkDataArray*> arraysA(1, a->GetPoints()->GetData());
+  std::vector<vtkDataArray*> arraysB(1, b->GetPoints()->GetData());
+  for (int cc = 0; cc < a->GetPointData()->GetNumberOfArrays(); ++cc)
+  {
+    arraysA.push_back(a->GetPointData()->GetArray(cc));
+    arraysB.push_back(b->GetPointData()->GetArray(cc));
+  }
+  for (size_t cc = 0; cc < arraysA.size(); ++cc)
+  {
+    vtkDataArray* arrayA = arraysA[cc];
+    vtkDataArray* arrayB = arraysB[cc];
+    if (!arrayA || !arrayB || arrayA->GetDataType() != arrayB->GetDataType() ||
+      arrayA->GetNumberOfValues() != arrayB->GetNumberOfValues() ||
+      memcmp(arrayA->GetVoidPointer(0), arrayB->GetVoidPointer(0),
+        static_cast<size_t>(arrayA->GetNumberOfValues()) * arrayA->GetDataTypeSize()) != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Renders the pipelines with or without concurrent updates, after modifying
+// the sources, and returns the outputs of the shown proxies.
+std::vector<vtkSmartPointer<vtkPointSet> > Render(
+  vtkSMSession* session, bool concurrent, bool& success)
+{
+  vtkPVView::SetEnableConcurrentUpdates(concurrent);
+
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+  vtkSmartPointer<vtkSMRenderViewProxy> view;
+  view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(pxm->NewProxy("views", "RenderView")));
+  controller->InitializeProxy(view);
+  view->UpdateVTKObjects();
+  controller->RegisterViewProxy(view);
+
+  // two independent sources, and two filters sharing a third one.
+  std::vector<vtkSmartPointer<vtkSMSourceProxy> > proxies;
+  proxies.push_back(CreatePipelineProxy(controller, pxm, "sources", "SphereSource"));
+  proxies.push_back(CreatePipelineProxy(controller, pxm, "sources", "ConeSource"));
+  proxies.push_back(CreatePipelineProxy(controller, pxm, "sources", "SphereSource"));
+  proxies.push_back(CreatePipelineProxy(controller, pxm, "filters", "ShrinkFilter", proxies[2]));
+  proxies.push_back(CreatePipelineProxy(controller, pxm, "filters", "ElevationFilter", proxies[2]));
+  std::vector<size_t> shown = { 0, 1, 3, 4 };
+  const bool python = pxm->HasDefinition("filters", "ProgrammableFilter");
+  if (python)
+  {
+    proxies.push_back(
+      CreatePipelineProxy(controller, pxm, "filters", "ProgrammableFilter", proxies[1]));
+    vtkSMPropertyHelper(proxies[5], "Script")
+      .Set("self.GetOutput().ShallowCopy(self.GetInput())");
+    proxies[5]->UpdateVTKObjects();
+    shown.push_back(5);
+  }
+  for (size_t idx : shown)
+  {
+    controller->Show(proxies[idx], 0, view);
+  }
+  view->StillRender();
+
+  // showing the proxies may have updated them already: modify the sources so
+  // that the next render updates all of them.
+  vtkSMPropertyHelper(proxies[0], "ThetaResolution").Set(32);
+  vtkSMPropertyHelper(proxies[1], "Resolution").Set(32);
+  vtkSMPropertyHelper(proxies[2], "PhiResolution").Set(32);
+  std::vector<ExecutionCounter> counters(proxies.size());
+  for (size_t cc = 0; cc < proxies.size(); ++cc)
+  {
+    proxies[cc]->UpdateVTKObjects();
+    vtkObject::SafeDownCast(proxies[cc]->GetClientSideObject())
+      ->AddObserver(vtkCommand::StartEvent, &counters[cc], &ExecutionCounter::OnStart);
+  }
+  view->StillRender();
+
+  // every upstream algorithm, including the shared source, executes once.
+  for (size_t cc = 0; cc < proxies.size(); ++cc)
+  {
+    CHECK(counters[cc].Count == 1);
+  }
+  // and the pipeline with a Python algorithm on the calling thread.
+  if (python)
+  {
+    CHECK(!counters[1].OtherThread && !counters[5].OtherThread);
+  }
+
+  std::vector<vtkSmartPointer<vtkPointSet> > outputs;
+  for (size_t idx : shown)
+  {
+    vtkAlgorithm* algorithm = vtkAlgorithm::SafeDownCast(proxies[idx]->GetClientSideObject());
+    vtkPointSet* output = vtkPointSet::SafeDownCast(algorithm->GetOutputDataObject(0));
+    CHECK(output != nullptr);
+    if (output)
+    {
+      vtkSmartPointer<vtkPointSet> copy;
+      copy.TakeReference(output->NewInstance());
+      copy->DeepCopy(output);
+      outputs.push_back(copy);
+    }
+  }
+
+  for (auto& proxy : proxies)
+  {
+    vtkObject::SafeDownCast(proxy->GetClientSideObject())->RemoveObservers(vtkCommand::StartEvent);
+  }
+  for (auto iter = proxies.rbegin(); iter != proxies.rend(); ++iter)
+  {
+    controller->UnRegisterProxy(*iter);
+  }
+  controller->UnRegisterProxy(view);
+  return outputs;
+}
+}
+
+int TestConcurrentViewUpdates(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestConcurrentViewUpdates");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  bool success = true;
+  {
+    vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+    vtkNew<vtkSMSession> session;
+    vtkProcessModule::GetProcessModule()->RegisterSession(session.Get());
+    controller->InitializeSession(session.Get());
+
+    const bool enabled = vtkPVView::GetEnableConcurrentUpdates();
+    auto expected = Render(session, false, success);
+    auto actual = Render(session, true, success);
+    vtkPVView::SetEnableConcurrentUpdates(enabled);
+
+    // updating the pipelines concurrently does not change their outputs.
+    CHECK(expected.size() >= 4 && expected.size() == actual.size());
+    for (size_t cc = 0; success && cc < expected.size(); ++cc)
+    {
+      CHECK(SameOutput(expected[cc], actual[cc]));
+    }
+
+    vtkProcessModule::GetProcessModule()->UnRegisterSession(session.Get());
+  }
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,144 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestDeltaFrameTiles.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the changed tiles of a frame, as packed by the server, turn the
+// previous frame into the new one once unpacked by the client.
+
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVClientServerSynchronizedRenderers.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstring>
+#include <set>
+#include <vector>
+
+#define CHECK(cond)                                                                                \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: Condition FAILED!! : " << #cond << " (line " << __LINE__ << ")" << endl;       \
+    success = false;                                                                               \
+  }
+
+// Exposes the tile helpers used for delta frames.
+class vtkTestDeltaFrameRenderers : public vtkPVClientServerSynchronizedRenderers
+{
+public:
+  static vtkTestDeltaFrameRenderers* New();
+  vtkTypeMacro(vtkTestDeltaFrameRenderers, vtkPVClientServerSynchronizedRenderers);
+
+  using vtkPVClientServerSynchronizedRenderers::ComputeChangedTiles;
+  using vtkPVClientServerSynchronizedRenderers::GetTilesSize;
+  using vtkPVClientServerSynchronizedRenderers::PackTiles;
+  using vtkPVClientServerSynchronizedRenderers::UnpackTiles;
+
+  vtkUnsignedCharArray* GetDeltaBuffer() { return this->DeltaBuffer; }
+};
+vtkStandardNewMacro(vtkTestDeltaFrameRenderers);
+
+namespace
+{
+const int Width = 100;
+const int Height = 70;
+const int TileSize = 16;
+
+void SetPixel(vtkUnsignedCharArray* image, int x, int y, unsigned char value)
+{
+  for (int comp = 0; comp < image->GetNumberOfComponents(); ++comp)
+  {
+    image->SetTypedComponent(static_cast<vtkIdType>(y) * Width + x, comp, value);
+  }
+}
+
+bool SameImage(vtkUnsignedCharArray* a, vtkUnsignedCharArray* b)
+{
+  return a->GetNumberOfTuples() == b->GetNumberOfTuples() &&
+    a->GetNumberOfComponents() == b->GetNumberOfComponents() &&
+    memcmp(a->GetPointer(0), b->GetPointer(0),
+      static_cast<size_t>(a->GetNumberOfTuples()) * a->GetNumberOfComponents()) == 0;
+}
+}
+
+int TestDeltaFrameTiles(int, char* [])
+{
+  bool success = true;
+
+  vtkNew<vtkUnsignedCharArray> first;
+  first->SetNumberOfComponents(4);
+  first->SetNumberOfTuples(Width * Height);
+  for (vtkIdType cc = 0; cc < first->GetNumberOfValues(); ++cc)
+  {
+    first->SetValue(cc, static_cast<unsigned char>((cc * 7) % 251));
+  }
+
+  // the second frame changes one pixel in an interior tile and one in the
+  // partial tile at the bottom-right corner.
+  vtkNew<vtkUnsignedCharArray> second;
+  second->DeepCopy(first);
+  SetPixel(second, 20, 20, 0);
+  SetPixel(second, Width - 1, Height - 1, 255);
+  const int tilesX = (Width + TileSize - 1) / TileSize;
+  const std::set<int> expectedTiles = { (20 / TileSize) * tilesX + 20 / TileSize,
+    ((Height - 1) / TileSize) * tilesX + (Width - 1) / TileSize };
+
+  vtkNew<vtkTestDeltaFrameRenderers> renderers;
+  renderers->SetDeltaTileSize(TileSize);
+  renderers->SetKeyFrameInterval(10);
+
+  // the first frame is always a keyframe.
+  std::vector<int> tiles;
+  CHECK(!renderers->ComputeChangedTiles(first, Width, Height, tiles));
+  CHECK(tiles.empty());
+
+  // the second frame only sends the changed tiles.
+  CHECK(renderers->ComputeChangedTiles(second, Width, Height, tiles));
+  CHECK(std::set<int>(tiles.begin(), tiles.end()) == expectedTiles);
+  vtkUnsignedCharArray* packed = renderers->GetDeltaBuffer();
+  CHECK(packed->GetNumberOfTuples() ==
+    vtkTestDeltaFrameRenderers::GetTilesSize(tiles, TileSize, Width, Height));
+
+  // the client applies them to its copy of the first frame.
+  vtkNew<vtkUnsignedCharArray> received;
+  received->DeepCopy(first);
+  vtkTestDeltaFrameRenderers::UnpackTiles(packed, tiles, TileSize, Width, Height, received);
+  CHECK(SameImage(received, second));
+
+  // an unchanged frame sends no tiles.
+  CHECK(renderers->ComputeChangedTiles(second, Width, Height, tiles));
+  CHECK(tiles.empty());
+
+  // packing and unpacking every tile copies the whole image.
+  std::vector<int> allTiles;
+  for (int cc = 0; cc < tilesX * ((Height + TileSize - 1) / TileSize); ++cc)
+  {
+    allTiles.push_back(cc);
+  }
+  vtkNew<vtkUnsignedCharArray> allPacked;
+  allPacked->SetNumberOfComponents(4);
+  allPacked->SetNumberOfTuples(
+    vtkTestDeltaFrameRenderers::GetTilesSize(allTiles, TileSize, Width, Height));
+  CHECK(allPacked->GetNumberOfTuples() == Width * Height);
+  vtkTestDeltaFrameRenderers::PackTiles(second, allTiles, TileSize, Width, Height, allPacked);
+  received->DeepCopy(first);
+  vtkTestDeltaFrameRenderers::UnpackTiles(allPacked, allTiles, TileSize, Width, Height, received);
+  CHECK(SameImage(received, second));
+
+  // a size change forces a keyframe.
+  vtkNew<vtkUnsignedCharArray> smaller;
+  smaller->SetNumberOfComponents(4);
+  smaller->SetNumberOfTuples((Width / 2) * Height);
+  CHECK(!renderers->ComputeChangedTiles(smaller, Width / 2, Height, tiles));
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
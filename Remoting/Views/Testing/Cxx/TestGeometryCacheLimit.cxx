@@ -0,0 +1,153 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestGeometryCacheLimit.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVDataDeliveryManager.h"
+#include "vtkPVView.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <vtksys/Directory.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <string>
+
+#define CHECK(cond)                                                                                \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: Condition FAILED!! : " << #cond << " (line " << __LINE__ << ")" << endl;       \
+    success = false;                                                                               \
+  }
+
+namespace
+{
+unsigned long CountFiles(const std::string& dirname)
+{
+  vtksys::Directory dir;
+  if (!dir.Load(dirname))
+  {
+    return 0;
+  }
+  unsigned long count = 0;
+  for (unsigned long cc = 0; cc < dir.GetNumberOfFiles(); ++cc)
+  {
+    const std::string fname = dir.GetFile(cc);
+    count += (fname != "." && fname != "..") ? 1 : 0;
+  }
+  return count;
+}
+
+// Shows the sphere for the given cache key, the way the animation scene does
+// when playing with geometry caching enabled.
+void ShowKey(vtkSMProxy* view, vtkSMProxy* sphere, int key)
+{
+  vtkSMPropertyHelper(view, "CacheKey").Set(static_cast<double>(key));
+  view->UpdateVTKObjects();
+  vtkSMPropertyHelper(sphere, "Radius").Set(1.0 + key);
+  sphere->UpdateVTKObjects();
+  vtkSMRenderViewProxy::SafeDownCast(view)->StillRender();
+}
+}
+
+int TestGeometryCacheLimit(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestGeometryCacheLimit");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  bool success = true;
+  {
+    vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+    vtkNew<vtkSMSession> session;
+    vtkProcessModule::GetProcessModule()->RegisterSession(session.Get());
+    controller->InitializeSession(session.Get());
+
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+    vtkSmartPointer<vtkSMProxy> view;
+    view.TakeReference(pxm->NewProxy("views", "RenderView"));
+    controller->InitializeProxy(view);
+    view->UpdateVTKObjects();
+    controller->RegisterViewProxy(view);
+
+    vtkSmartPointer<vtkSMSourceProxy> sphere;
+    sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+    controller->InitializeProxy(sphere);
+    vtkSMPropertyHelper(sphere, "ThetaResolution").Set(64);
+    vtkSMPropertyHelper(sphere, "PhiResolution").Set(64);
+    sphere->UpdateVTKObjects();
+    controller->RegisterPipelineProxy(sphere);
+    controller->Show(sphere, 0, view);
+
+    vtkSMPropertyHelper(view, "UseCache").Set(1);
+    view->UpdateVTKObjects();
+
+    vtkPVDataDeliveryManager* dmgr =
+      vtkPVView::SafeDownCast(view->GetClientSideObject())->GetDeliveryManager();
+
+    // Without a limit, all keys are kept in memory.
+    for (int key = 0; key < 4; ++key)
+    {
+      ShowKey(view, sphere, key);
+    }
+    const vtkTypeUInt64 unlimitedSize = dmgr->GetCacheMemorySize();
+    CHECK(unlimitedSize > 0);
+    const vtkTypeUInt64 keySize = unlimitedSize / 4;
+
+    // With a limit and a spill directory, older keys are saved to disk.
+    const std::string spillDir =
+      vtksys::SystemTools::GetCurrentWorkingDirectory() + "/TestGeometryCacheLimit-spill";
+    vtksys::SystemTools::RemoveADirectory(spillDir);
+    vtksys::SystemTools::MakeDirectory(spillDir);
+    vtkPVDataDeliveryManager::SetCacheSpillDirectory(spillDir.c_str());
+    vtkPVDataDeliveryManager::SetCacheMemoryLimit(2 * keySize);
+    for (int key = 4; key < 8; ++key)
+    {
+      ShowKey(view, sphere, key);
+      CHECK(dmgr->GetCacheMemorySize() <= 3 * keySize);
+    }
+    CHECK(CountFiles(spillDir) > 0);
+
+    // Going back to a spilled key loads it back rather than re-executing.
+    ShowKey(view, sphere, 0);
+    CHECK(dmgr->GetCacheMemorySize() <= 3 * keySize);
+
+    // Without a spill directory, evicted keys are simply released.
+    vtkPVDataDeliveryManager::SetCacheSpillDirectory(nullptr);
+    for (int key = 8; key < 12; ++key)
+    {
+      ShowKey(view, sphere, key);
+      CHECK(dmgr->GetCacheMemorySize() <= 3 * keySize);
+    }
+
+    vtkPVDataDeliveryManager::SetCacheMemoryLimit(0);
+    controller->UnRegisterProxy(sphere);
+    controller->UnRegisterProxy(view);
+    sphere = nullptr;
+    view = nullptr;
+    vtkProcessModule::GetProcessModule()->UnRegisterSession(session.Get());
+
+    // Releasing the cache removes all spill files.
+    CHECK(CountFiles(spillDir) == 0);
+    vtksys::SystemTools::RemoveADirectory(spillDir);
+  }
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
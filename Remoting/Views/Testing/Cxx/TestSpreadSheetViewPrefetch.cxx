@@ -0,0 +1,158 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestSpreadSheetViewPrefetch.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the block cache of vtkSpreadSheetView: the least recently used block
+// is the one evicted, and PrefetchNextBlock() fetches the visible blocks and
+// then the ones ahead of the scroll direction.
+
+#include "vtkCommand.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineController.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSMViewProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpreadSheetView.h"
+#include "vtkVariant.h"
+
+#include <vector>
+
+#define CHECK(cond)                                                                                \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: Condition FAILED!! : " << #cond << " (line " << __LINE__ << ")" << endl;       \
+    success = false;                                                                               \
+  }
+
+namespace
+{
+const vtkIdType BlockSize = 100;
+
+// Records the blocks fetched by the view, i.e. the cache misses.
+class FetchRecorder
+{
+public:
+  void OnFetch(vtkObject*, unsigned long, void* calldata)
+  {
+    this->Blocks.push_back(*reinterpret_cast<vtkIdType*>(calldata));
+  }
+  std::vector<vtkIdType> Blocks;
+};
+
+// Returns the blocks fetched while accessing a row of each of `blocks`.
+std::vector<vtkIdType> Access(
+  vtkSpreadSheetView* view, FetchRecorder& recorder, const std::vector<vtkIdType>& blocks)
+{
+  recorder.Blocks.clear();
+  for (vtkIdType block : blocks)
+  {
+    view->GetValue(block * BlockSize, 0);
+  }
+  return recorder.Blocks;
+}
+
+// Returns the blocks fetched by PrefetchNextBlock() until there is nothing
+// left to fetch.
+std::vector<vtkIdType> Prefetch(vtkSpreadSheetView* view, FetchRecorder& recorder)
+{
+  recorder.Blocks.clear();
+  for (int cc = 0; cc < 100 && view->PrefetchNextBlock(); ++cc)
+  {
+  }
+  return recorder.Blocks;
+}
+}
+
+int TestSpreadSheetViewPrefetch(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestSpreadSheetViewPrefetch");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  bool success = true;
+  {
+    vtkNew<vtkSMParaViewPipelineController> controller;
+    vtkNew<vtkSMSession> session;
+    vtkProcessModule::GetProcessModule()->RegisterSession(session.Get());
+    controller->InitializeSession(session.Get());
+
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+    vtkSmartPointer<vtkSMViewProxy> view;
+    view.TakeReference(vtkSMViewProxy::SafeDownCast(pxm->NewProxy("views", "SpreadSheetView")));
+    controller->InitializeProxy(view);
+    vtkSMPropertyHelper(view, "BlockSize").Set(BlockSize);
+    view->UpdateVTKObjects();
+    controller->RegisterViewProxy(view);
+
+    vtkSmartPointer<vtkSMSourceProxy> sphere;
+    sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+    controller->InitializeProxy(sphere);
+    vtkSMPropertyHelper(sphere, "ThetaResolution").Set(64);
+    vtkSMPropertyHelper(sphere, "PhiResolution").Set(64);
+    sphere->UpdateVTKObjects();
+    controller->RegisterPipelineProxy(sphere);
+    controller->Show(sphere, 0, view);
+    view->StillRender();
+
+    vtkSpreadSheetView* ssview = vtkSpreadSheetView::SafeDownCast(view->GetClientSideObject());
+    // 64x64 sphere points: 40 blocks.
+    CHECK(ssview->GetNumberOfRows() > 39 * BlockSize);
+    FetchRecorder recorder;
+    ssview->AddObserver(vtkCommand::UpdateEvent, &recorder, &FetchRecorder::OnFetch);
+
+    // without a viewport the cache holds 10 blocks. Using block 0 again makes
+    // block 1 the least recently used one, evicted when adding block 10.
+    std::vector<vtkIdType> expected = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    CHECK(Access(ssview, recorder, expected) == expected);
+    CHECK(Access(ssview, recorder, { 0 }).empty());
+    expected = { 10 };
+    CHECK(Access(ssview, recorder, { 10 }) == expected);
+    CHECK(Access(ssview, recorder, { 0, 2, 10 }).empty());
+    expected = { 1 };
+    CHECK(Access(ssview, recorder, { 1 }) == expected);
+
+    // scrolling down 500 rows per second: the visible blocks come first, then
+    // the ones below, up to MaximumNumberOfPrefetchedBlocks.
+    ssview->SetPrefetchLookAhead(1.0);
+    ssview->SetMaximumNumberOfPrefetchedBlocks(4);
+    ssview->SetViewport(20 * BlockSize, 21 * BlockSize + 50, 500.0);
+    expected = { 20, 21, 22, 23, 24, 25 };
+    CHECK(Prefetch(ssview, recorder) == expected);
+
+    // scrolling up slowly: one block above, then the one below the viewport,
+    // which is already cached. The visible blocks were not evicted.
+    ssview->SetViewport(20 * BlockSize, 21 * BlockSize + 50, -50.0);
+    expected = { 19 };
+    CHECK(Prefetch(ssview, recorder) == expected);
+    CHECK(Access(ssview, recorder, { 20, 21 }).empty());
+
+    // at the end of the data, there is nothing to fetch past the last block.
+    const vtkIdType lastBlock = (ssview->GetNumberOfRows() - 1) / BlockSize;
+    ssview->SetViewport((lastBlock - 1) * BlockSize, lastBlock * BlockSize, 0.0);
+    expected = { lastBlock - 1, lastBlock, lastBlock - 2 };
+    CHECK(Prefetch(ssview, recorder) == expected);
+
+    controller->UnRegisterProxy(sphere);
+    controller->UnRegisterProxy(view);
+    sphere = nullptr;
+    view = nullptr;
+    vtkProcessModule::GetProcessModule()->UnRegisterSession(session.Get());
+  }
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
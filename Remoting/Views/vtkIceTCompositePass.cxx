@@ -31,6 +31,7 @@
 #include "vtkOpenGLRenderWindow.h"
 #include "vtkOpenGLState.h"
 #include "vtkPVLogger.h"
+#include "vtkPVTraceRecorder.h"
 #include "vtkPartitionOrderingInterface.h"
 #include "vtkPixelBufferObject.h"
 #include "vtkRenderState.h"
@@ -363,6 +364,7 @@ void vtkIceTCompositePass::CleanupContext(const vtkRenderState*)
 void vtkIceTCompositePass::Render(const vtkRenderState* render_state)
 {
   vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: Render", vtkLogIdentifier(this));
+  vtkPVTraceScope("compositing", "IceT composite");
   vtkOpenGLRenderUtilities::MarkDebugEvent("vtkIceTCompositePass::Render Start");
   this->IceTContext->SetController(this->Controller);
   if (!this->IceTContext->IsValid())
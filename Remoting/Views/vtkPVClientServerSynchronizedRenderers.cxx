@@ -15,19 +15,25 @@
 =========================================================================*/
 #include "vtkPVClientServerSynchronizedRenderers.h"
 
+#include "vtkCompositeMultiProcessController.h"
 #include "vtkLZ4Compressor.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLRenderer.h"
 #include "vtkPVConfig.h"
+#include "vtkPVLogger.h"
+#include "vtkPVTraceRecorder.h"
 #include "vtkSquirtCompressor.h"
+#include "vtkTimerLog.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
 #include "vtkNvPipeCompressor.h"
 #endif
 
+#include <algorithm>
 #include <assert.h>
+#include <cstring>
 #include <sstream>
 
 vtkStandardNewMacro(vtkPVClientServerSynchronizedRenderers);
@@ -37,6 +43,13 @@ vtkPVClientServerSynchronizedRenderers::vtkPVClientServerSynchronizedRenderers()
   : Compressor(NULL)
   , LossLessCompression(true)
   , NVPipeSupport(false)
+  , DeltaTileSize(0)
+  , KeyFrameInterval(30)
+  , LastCompressTime(0.0)
+  , LastDecompressTime(0.0)
+  , FramesSinceKeyFrame(0)
+  , LastFrameClientId(0)
+  , LastFrameLossLess(false)
 {
   this->ConfigureCompressor("vtkLZ4Compressor 0 3");
 }
@@ -56,25 +69,87 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
 
   vtkRawImage& rawImage = this->Image;
 
-  int header[4];
-  this->ParallelController->Receive(header, 4, 1, 0x023430);
-  if (header[0] > 0)
+  int header[7];
+  this->ParallelController->Receive(header, 7, 1, 0x023430);
+  if (header[0] <= 0)
+  {
+    return;
+  }
+
+  const int width = header[1];
+  const int height = header[2];
+  const int numComps = header[3];
+  const int tileSize = header[5];
+  const int numTiles = header[6];
+  this->LastCompressTime = header[4] * 1e-6;
+  this->LastDecompressTime = 0.0;
+  rawImage.Resize(width, height, numComps);
+
+  // delta frames update only the changed tiles of the last frame.
+  std::vector<int> tiles(numTiles);
+  vtkUnsignedCharArray* target = rawImage.GetRawPtr();
+  if (tileSize > 0)
+  {
+    if (numTiles > 0)
+    {
+      this->ParallelController->Receive(&tiles[0], numTiles, 1, 0x023430);
+    }
+    const int maxTile = ((width + tileSize - 1) / tileSize) * ((height + tileSize - 1) / tileSize);
+    tiles.erase(std::remove_if(tiles.begin(), tiles.end(),
+                  [maxTile](int tile) { return tile < 0 || tile >= maxTile; }),
+      tiles.end());
+    target = this->DeltaBuffer.Get();
+    target->SetNumberOfComponents(numComps);
+    target->SetNumberOfTuples(
+      vtkPVClientServerSynchronizedRenderers::GetTilesSize(tiles, tileSize, width, height));
+  }
+
+  vtkIdType received = 0;
+  if (tileSize == 0 || numTiles > 0)
   {
-    rawImage.Resize(header[1], header[2], header[3]);
     if (this->Compressor)
     {
       vtkUnsignedCharArray* data = vtkUnsignedCharArray::New();
       this->ParallelController->Receive(data, 1, 0x023430);
-      this->Compressor->SetImageResolution(header[1], header[2]);
-      this->Decompress(data, rawImage.GetRawPtr());
+      received = data->GetNumberOfTuples() * data->GetNumberOfComponents();
+      this->Compressor->SetImageResolution(
+        tileSize > 0 ? static_cast<int>(target->GetNumberOfTuples()) : width,
+        tileSize > 0 ? 1 : height);
+      this->Decompress(data, target);
       data->Delete();
     }
     else
     {
-      this->ParallelController->Receive(rawImage.GetRawPtr(), 1, 0x023430);
+      this->ParallelController->Receive(target, 1, 0x023430);
+      received = target->GetNumberOfTuples() * target->GetNumberOfComponents();
     }
-    rawImage.MarkValid();
   }
+
+  vtkUnsignedCharArray* lastFrame = this->LastFrame.Get();
+  if (tileSize == 0)
+  {
+    lastFrame->DeepCopy(rawImage.GetRawPtr());
+  }
+  else if (lastFrame->GetNumberOfComponents() != numComps ||
+    lastFrame->GetNumberOfTuples() != static_cast<vtkIdType>(width) * height)
+  {
+    vtkErrorMacro("Received a delta frame without a matching reference frame.");
+    return;
+  }
+  else
+  {
+    vtkPVClientServerSynchronizedRenderers::UnpackTiles(
+      this->DeltaBuffer, tiles, tileSize, width, height, lastFrame);
+    memcpy(rawImage.GetRawPtr()->GetPointer(0), lastFrame->GetPointer(0),
+      lastFrame->GetNumberOfTuples() * numComps);
+  }
+  rawImage.MarkValid();
+
+  vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+    "%s: image %dx%d, %s (%d tiles), %lld bytes, compress %.3f ms, decompress %.3f ms",
+    this->Compressor ? this->Compressor->GetClassName() : "(none)", width, height,
+    tileSize > 0 ? "delta" : "keyframe", numTiles, static_cast<long long>(received),
+    this->LastCompressTime * 1000.0, this->LastDecompressTime * 1000.0);
 }
 
 //----------------------------------------------------------------------------
@@ -85,25 +160,189 @@ void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
 
   vtkRawImage& rawImage = this->CaptureRenderedImage();
 
-  int header[4];
+  int header[7];
   header[0] = rawImage.IsValid() ? 1 : 0;
   header[1] = rawImage.GetWidth();
   header[2] = rawImage.GetHeight();
   header[3] = rawImage.IsValid() ? rawImage.GetRawPtr()->GetNumberOfComponents() : 0;
+  header[4] = 0;
+  header[5] = 0;
+  header[6] = 0;
+
+  vtkUnsignedCharArray* data = nullptr;
+  std::vector<int> tiles;
+  if (rawImage.IsValid())
+  {
+    data = rawImage.GetRawPtr();
+    if (this->ComputeChangedTiles(data, header[1], header[2], tiles))
+    {
+      header[5] = this->DeltaTileSize;
+      header[6] = static_cast<int>(tiles.size());
+      data = tiles.empty() ? nullptr : this->DeltaBuffer.Get();
+    }
+
+    // compress first so that the client can report the compression time
+    // (in microseconds) along with its decompression time.
+    if (data && this->Compressor)
+    {
+      this->Compressor->SetImageResolution(
+        header[5] > 0 ? static_cast<int>(data->GetNumberOfTuples()) : header[1],
+        header[5] > 0 ? 1 : header[2]);
+      data = this->Compress(data);
+      header[4] = static_cast<int>(this->LastCompressTime * 1e6);
+    }
+  }
 
   // send the image to the client.
-  this->ParallelController->Send(header, 4, 1, 0x023430);
+  this->ParallelController->Send(header, 7, 1, 0x023430);
+  if (!tiles.empty())
+  {
+    this->ParallelController->Send(&tiles[0], header[6], 1, 0x023430);
+  }
+  if (data)
+  {
+    this->ParallelController->Send(data, 1, 0x023430);
+  }
+}
 
-  if (rawImage.IsValid())
+//----------------------------------------------------------------------------
+bool vtkPVClientServerSynchronizedRenderers::ComputeChangedTiles(
+  vtkUnsignedCharArray* image, int width, int height, std::vector<int>& tiles)
+{
+  tiles.clear();
+  vtkUnsignedCharArray* lastFrame = this->LastFrame.Get();
+  const int numComps = image->GetNumberOfComponents();
+  const int tileSize = this->DeltaTileSize;
+
+  // frames sent to different clients in collaboration mode are not related.
+  int clientId = 0;
+  if (auto composite = vtkCompositeMultiProcessController::SafeDownCast(this->ParallelController))
   {
-    if (this->Compressor)
+    clientId = composite->GetActiveControllerID();
+  }
+
+  // Send a keyframe when the client may not have an up-to-date reference: the
+  // size or client changed, the previous frame was lossy while this one must
+  // be exact, or KeyFrameInterval frames were sent since the last keyframe.
+  bool keyframe = tileSize <= 0 || lastFrame->GetNumberOfComponents() != numComps ||
+    lastFrame->GetNumberOfTuples() != static_cast<vtkIdType>(width) * height ||
+    clientId != this->LastFrameClientId ||
+    (this->LossLessCompression && !this->LastFrameLossLess) ||
+    this->FramesSinceKeyFrame + 1 >= this->KeyFrameInterval ||
+    (this->Compressor && this->Compressor->IsA("vtkNvPipeCompressor"));
+
+  if (!keyframe)
+  {
+    const unsigned char* current = image->GetPointer(0);
+    const unsigned char* previous = lastFrame->GetPointer(0);
+    const int tilesX = (width + tileSize - 1) / tileSize;
+    const int tilesY = (height + tileSize - 1) / tileSize;
+    for (int cc = 0; cc < tilesX * tilesY; ++cc)
     {
-      this->Compressor->SetImageResolution(header[1], header[2]);
-      this->ParallelController->Send(this->Compress(rawImage.GetRawPtr()), 1, 0x023430);
+      int bounds[4];
+      vtkPVClientServerSynchronizedRenderers::GetTileBounds(cc, tileSize, width, height, bounds);
+      const size_t rowSize = static_cast<size_t>(bounds[1] - bounds[0]) * numComps;
+      for (int y = bounds[2]; y < bounds[3]; ++y)
+      {
+        const vtkIdType offset = (static_cast<vtkIdType>(y) * width + bounds[0]) * numComps;
+        if (memcmp(current + offset, previous + offset, rowSize) != 0)
+        {
+          tiles.push_back(cc);
+          break;
+        }
+      }
     }
-    else
+
+    // past half the image, a keyframe compresses better than scattered tiles.
+    keyframe = 2 * vtkPVClientServerSynchronizedRenderers::GetTilesSize(
+                     tiles, tileSize, width, height) >
+      static_cast<vtkIdType>(width) * height;
+  }
+
+  this->LastFrameClientId = clientId;
+  this->LastFrameLossLess = this->LossLessCompression;
+  if (keyframe)
+  {
+    tiles.clear();
+    lastFrame->DeepCopy(image);
+    this->FramesSinceKeyFrame = 0;
+    return false;
+  }
+
+  this->DeltaBuffer->SetNumberOfComponents(numComps);
+  this->DeltaBuffer->SetNumberOfTuples(
+    vtkPVClientServerSynchronizedRenderers::GetTilesSize(tiles, tileSize, width, height));
+  vtkPVClientServerSynchronizedRenderers::PackTiles(
+    image, tiles, tileSize, width, height, this->DeltaBuffer);
+  vtkPVClientServerSynchronizedRenderers::UnpackTiles(
+    this->DeltaBuffer, tiles, tileSize, width, height, lastFrame);
+  ++this->FramesSinceKeyFrame;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::GetTileBounds(
+  int index, int tileSize, int width, int height, int bounds[4])
+{
+  const int tilesX = (width + tileSize - 1) / tileSize;
+  bounds[0] = (index % tilesX) * tileSize;
+  bounds[1] = std::min(bounds[0] + tileSize, width);
+  bounds[2] = (index / tilesX) * tileSize;
+  bounds[3] = std::min(bounds[2] + tileSize, height);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVClientServerSynchronizedRenderers::GetTilesSize(
+  const std::vector<int>& tiles, int tileSize, int width, int height)
+{
+  vtkIdType numPixels = 0;
+  for (int tile : tiles)
+  {
+    int bounds[4];
+    vtkPVClientServerSynchronizedRenderers::GetTileBounds(tile, tileSize, width, height, bounds);
+    numPixels += static_cast<vtkIdType>(bounds[1] - bounds[0]) * (bounds[3] - bounds[2]);
+  }
+  return numPixels;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::PackTiles(vtkUnsignedCharArray* image,
+  const std::vector<int>& tiles, int tileSize, int width, int height,
+  vtkUnsignedCharArray* packed)
+{
+  const int numComps = image->GetNumberOfComponents();
+  const unsigned char* in = image->GetPointer(0);
+  unsigned char* out = packed->GetPointer(0);
+  for (int tile : tiles)
+  {
+    int bounds[4];
+    vtkPVClientServerSynchronizedRenderers::GetTileBounds(tile, tileSize, width, height, bounds);
+    const size_t rowSize = static_cast<size_t>(bounds[1] - bounds[0]) * numComps;
+    for (int y = bounds[2]; y < bounds[3]; ++y)
+    {
+      memcpy(out, in + (static_cast<vtkIdType>(y) * width + bounds[0]) * numComps, rowSize);
+      out += rowSize;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::UnpackTiles(vtkUnsignedCharArray* packed,
+  const std::vector<int>& tiles, int tileSize, int width, int height,
+  vtkUnsignedCharArray* image)
+{
+  const int numComps = image->GetNumberOfComponents();
+  const unsigned char* in = packed->GetPointer(0);
+  unsigned char* out = image->GetPointer(0);
+  for (int tile : tiles)
+  {
+    int bounds[4];
+    vtkPVClientServerSynchronizedRenderers::GetTileBounds(tile, tileSize, width, height, bounds);
+    const size_t rowSize = static_cast<size_t>(bounds[1] - bounds[0]) * numComps;
+    for (int y = bounds[2]; y < bounds[3]; ++y)
     {
-      this->ParallelController->Send(rawImage.GetRawPtr(), 1, 0x023430);
+      memcpy(out + (static_cast<vtkIdType>(y) * width + bounds[0]) * numComps, in, rowSize);
+      in += rowSize;
     }
   }
 }
@@ -113,9 +352,13 @@ vtkUnsignedCharArray* vtkPVClientServerSynchronizedRenderers::Compress(vtkUnsign
 {
   if (this->Compressor)
   {
+    vtkPVTraceScope("compression", "compress image");
     this->Compressor->SetLossLessMode(this->LossLessCompression);
     this->Compressor->SetInput(data);
-    if (this->Compressor->Compress() == 0)
+    const double start = vtkTimerLog::GetUniversalTime();
+    const int status = this->Compressor->Compress();
+    this->LastCompressTime = vtkTimerLog::GetUniversalTime() - start;
+    if (status == 0)
     {
       vtkErrorMacro("Image compression failed!");
       return data;
@@ -132,10 +375,14 @@ void vtkPVClientServerSynchronizedRenderers::Decompress(
 {
   if (this->Compressor)
   {
+    vtkPVTraceScope("compression", "decompress image");
     this->Compressor->SetLossLessMode(this->LossLessCompression);
     this->Compressor->SetInput(data);
     this->Compressor->SetOutput(outputBuffer);
-    if (this->Compressor->Decompress() == 0)
+    const double start = vtkTimerLog::GetUniversalTime();
+    const int status = this->Compressor->Decompress();
+    this->LastDecompressTime = vtkTimerLog::GetUniversalTime() - start;
+    if (status == 0)
     {
       vtkErrorMacro("Image de-compression failed!");
     }
@@ -217,4 +464,9 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
 void vtkPVClientServerSynchronizedRenderers::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "LossLessCompression: " << this->LossLessCompression << endl;
+  os << indent << "DeltaTileSize: " << this->DeltaTileSize << endl;
+  os << indent << "KeyFrameInterval: " << this->KeyFrameInterval << endl;
+  os << indent << "LastCompressTime: " << this->LastCompressTime << endl;
+  os << indent << "LastDecompressTime: " << this->LastDecompressTime << endl;
 }
@@ -19,14 +19,29 @@
  * vtkPVClientServerSynchronizedRenderers is similar to
  * vtkClientServerSynchronizedRenderers except that it optionally uses image
  * compressors to compress the image before transmitting.
+ *
+ * The time spent compressing the image on the server is sent to the client
+ * with the image, so that the client can report both compression and
+ * decompression times for every frame (see GetLastCompressTime and
+ * GetLastDecompressTime, also logged with PARAVIEW_LOG_RENDERING_VERBOSITY()).
+ *
+ * When DeltaTileSize is set, the server compares each frame with the last
+ * frame it sent, in square tiles of that size, and only sends the tiles that
+ * changed (through the compressor, when one is set). The client applies them
+ * to its copy of the last frame. A full frame (keyframe) is sent every
+ * KeyFrameInterval frames, when the image size changes, when most of the
+ * image changed, and for loss-less frames following lossy ones.
 */
 
 #ifndef vtkPVClientServerSynchronizedRenderers_h
 #define vtkPVClientServerSynchronizedRenderers_h
 
+#include "vtkNew.h"                 // needed for vtkNew
 #include "vtkRemotingViewsModule.h" //needed for exports
 #include "vtkSynchronizedRenderers.h"
 
+#include <vector> // needed for std::vector
+
 class vtkImageCompressor;
 class vtkUnsignedCharArray;
 
@@ -59,6 +74,33 @@ public:
    */
   virtual void ConfigureCompressor(const char* stream);
 
+  //@{
+  /**
+   * Size, in pixels, of the tiles compared to send delta frames. 0 (default)
+   * disables delta frames. Only the server's value matters.
+   */
+  vtkSetClampMacro(DeltaTileSize, int, 0, 1024);
+  vtkGetMacro(DeltaTileSize, int);
+  //@}
+
+  //@{
+  /**
+   * Maximum number of frames between keyframes, when DeltaTileSize is set.
+   * Default is 30.
+   */
+  vtkSetClampMacro(KeyFrameInterval, int, 1, VTK_INT_MAX);
+  vtkGetMacro(KeyFrameInterval, int);
+  //@}
+
+  //@{
+  /**
+   * Time, in seconds, spent compressing and decompressing the last image.
+   * On the client, LastCompressTime is the time reported by the server.
+   */
+  vtkGetMacro(LastCompressTime, double);
+  vtkGetMacro(LastDecompressTime, double);
+  //@}
+
 protected:
   vtkPVClientServerSynchronizedRenderers();
   ~vtkPVClientServerSynchronizedRenderers() override;
@@ -77,9 +119,42 @@ protected:
   void MasterEndRender() override;
   void SlaveEndRender() override;
 
+  /**
+   * Compares `image` with LastFrame and fills `tiles` with the indices of the
+   * tiles that changed, packed in DeltaBuffer. Returns false if a keyframe
+   * must be sent instead. Updates LastFrame in both cases.
+   */
+  bool ComputeChangedTiles(
+    vtkUnsignedCharArray* image, int width, int height, std::vector<int>& tiles);
+
+  //@{
+  /**
+   * Helpers to copy tiles, in the order given, between an image and a
+   * contiguous buffer. Tiles are numbered in row-major order.
+   */
+  static void GetTileBounds(int index, int tileSize, int width, int height, int bounds[4]);
+  static vtkIdType GetTilesSize(
+    const std::vector<int>& tiles, int tileSize, int width, int height);
+  static void PackTiles(vtkUnsignedCharArray* image, const std::vector<int>& tiles, int tileSize,
+    int width, int height, vtkUnsignedCharArray* packed);
+  static void UnpackTiles(vtkUnsignedCharArray* packed, const std::vector<int>& tiles,
+    int tileSize, int width, int height, vtkUnsignedCharArray* image);
+  //@}
+
   vtkImageCompressor* Compressor;
   bool LossLessCompression;
   bool NVPipeSupport;
+  int DeltaTileSize;
+  int KeyFrameInterval;
+  double LastCompressTime;
+  double LastDecompressTime;
+
+  // Last frame sent (server) or received (client), used for delta frames.
+  vtkNew<vtkUnsignedCharArray> LastFrame;
+  vtkNew<vtkUnsignedCharArray> DeltaBuffer;
+  int FramesSinceKeyFrame;
+  int LastFrameClientId;
+  bool LastFrameLossLess;
 
 private:
   vtkPVClientServerSynchronizedRenderers(const vtkPVClientServerSynchronizedRenderers&) = delete;
@@ -19,12 +19,90 @@
 #include "vtkInformation.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVDataObjectMarshaller.h"
 #include "vtkPVDataRepresentation.h"
 #include "vtkPVLogger.h"
+#include "vtkPVTraceRecorder.h"
 #include "vtkPVView.h"
 #include "vtkSmartPointer.h"
 #include "vtkWeakPointer.h"
 
+#include <vtksys/FStream.hxx>
+
+#include <atomic>
+#include <iterator>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+vtkTypeUInt64 vtkPVDataDeliveryManagerCacheMemoryLimit = 0;
+std::string vtkPVDataDeliveryManagerCacheSpillDirectory;
+}
+
+//----------------------------------------------------------------------------
+std::shared_ptr<vtkPVDataDeliveryManager::vtkInternals::vtkSpillFile>
+vtkPVDataDeliveryManager::vtkInternals::WriteSpillFile(vtkDataObject* data)
+{
+  vtkPVDataObjectMarshaller::GatherList list;
+  if (vtkPVDataDeliveryManagerCacheSpillDirectory.empty() ||
+    !vtkPVDataObjectMarshaller::Marshal(data, list))
+  {
+    return nullptr;
+  }
+
+  static std::atomic<vtkTypeUInt64> counter(0);
+  std::ostringstream fname;
+  fname << vtkPVDataDeliveryManagerCacheSpillDirectory << "/paraview-geometry-cache-" << getpid()
+        << "-" << counter++ << ".vtkn";
+
+  auto spillFile = std::make_shared<vtkSpillFile>();
+  spillFile->FileName = fname.str();
+
+  vtksys::ofstream ofp(spillFile->FileName.c_str(), ios::out | ios::binary);
+  for (size_t cc = 0; ofp && cc < list.GetNumberOfSegments(); ++cc)
+  {
+    ofp.write(list.GetSegmentPointer(cc), list.GetSegmentLength(cc));
+  }
+  ofp.close();
+  if (!ofp)
+  {
+    vtkLogF(WARNING, "Failed to write geometry cache file '%s'.", spillFile->FileName.c_str());
+    return nullptr;
+  }
+  return spillFile;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkPVDataDeliveryManager::vtkInternals::ReadSpillFile(
+  const std::string& fileName)
+{
+  vtksys::ifstream ifp(fileName.c_str(), ios::in | ios::binary);
+  if (!ifp)
+  {
+    return nullptr;
+  }
+  ifp.seekg(0, ios::end);
+  const std::streamoff length = ifp.tellg();
+  ifp.seekg(0, ios::beg);
+  if (length <= 0)
+  {
+    return nullptr;
+  }
+  std::vector<char> buffer(static_cast<size_t>(length));
+  if (!ifp.read(buffer.data(), length))
+  {
+    return nullptr;
+  }
+  return vtkPVDataObjectMarshaller::Unmarshal(buffer.data(), static_cast<vtkIdType>(length));
+}
+
 //*****************************************************************************
 //----------------------------------------------------------------------------
 vtkPVDataDeliveryManager::vtkPVDataDeliveryManager()
@@ -110,8 +188,7 @@ void vtkPVDataDeliveryManager::SetPiece(vtkPVDataRepresentation* repr, vtkDataOb
   if (item)
   {
     const auto cacheKey = this->GetCacheKey(repr);
-    if (item->GetDataObject(cacheKey) == nullptr ||
-      repr->GetPipelineDataTime() > item->GetTimeStamp())
+    if (!item->HasDataObject(cacheKey) || repr->GetPipelineDataTime() > item->GetTimeStamp())
     {
       vtkLogF(
         TRACE, "SetDataObject %s (key=%g) : %p", repr->GetLogName().c_str(), cacheKey, (void*)data);
@@ -151,7 +228,7 @@ bool vtkPVDataDeliveryManager::HasPiece(vtkPVDataRepresentation* repr, bool low_
   vtkInternals::vtkItem* item =
     this->Internals->GetItem(repr, low_res, port, /*create_if_needed=*/false);
   const auto cacheKey = this->GetCacheKey(repr);
-  const bool val = item ? (item->GetDataObject(cacheKey) != nullptr) : false;
+  const bool val = item ? item->HasDataObject(cacheKey) : false;
 
   vtkLogF(TRACE, "HasPiece %s (key=%g) : %d", repr->GetLogName().c_str(), cacheKey, val);
   return val;
@@ -261,6 +338,7 @@ void vtkPVDataDeliveryManager::Deliver(int low_res, unsigned int size, unsigned
       }
       vtkVLogScopeF(
         PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "move-data: %s", repr->GetLogName().c_str());
+      vtkPVTraceScope("data-movement", repr->GetLogName().c_str());
       this->MoveData(repr, low_res != 0, port);
     }
   }
@@ -297,6 +375,153 @@ void vtkPVDataDeliveryManager::ClearCache(vtkPVDataRepresentation* repr)
   this->Internals->ClearCache(repr);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::SetCacheMemoryLimit(vtkTypeUInt64 kbytes)
+{
+  vtkPVDataDeliveryManagerCacheMemoryLimit = kbytes;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheMemoryLimit()
+{
+  return vtkPVDataDeliveryManagerCacheMemoryLimit;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::SetCacheSpillDirectory(const char* dirname)
+{
+  vtkPVDataDeliveryManagerCacheSpillDirectory = dirname ? dirname : "";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVDataDeliveryManager::GetCacheSpillDirectory()
+{
+  return vtkPVDataDeliveryManagerCacheSpillDirectory.c_str();
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheMemorySize()
+{
+  vtkTypeUInt64 size = 0;
+  for (const auto& ipair : this->Internals->ItemsMap)
+  {
+    size += ipair.second.first.GetCachedMemorySize();
+    size += ipair.second.second.GetCachedMemorySize();
+  }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::MarkCacheKeyUsed(double cacheKey)
+{
+  auto& internals = (*this->Internals);
+  if (!internals.CacheKeyUses.empty())
+  {
+    auto last = std::max_element(internals.CacheKeyUses.begin(), internals.CacheKeyUses.end(),
+      [](const std::pair<const double, vtkTypeUInt64>& a,
+        const std::pair<const double, vtkTypeUInt64>& b) { return a.second < b.second; });
+    if (cacheKey != last->first)
+    {
+      internals.CacheKeyDirection = cacheKey > last->first ? 1 : -1;
+    }
+  }
+  internals.CacheKeyUses[cacheKey] = ++internals.CacheKeyUseCounter;
+
+  const vtkTypeUInt64 limit = vtkPVDataDeliveryManager::GetCacheMemoryLimit();
+  const vtkTypeUInt64 used = this->GetCacheMemorySize();
+  if (limit == 0 || used <= limit)
+  {
+    return 0;
+  }
+
+  // Count how many of the least recently used keys need to go to get back
+  // under the limit. Data a representation is currently showing cannot be
+  // evicted and does not count.
+  vtkTypeUInt64 excess = used - limit;
+  vtkTypeUInt64 count = 0;
+  for (double key : internals.GetEvictionCandidates())
+  {
+    ++count;
+    vtkTypeUInt64 freed = 0;
+    for (const auto& ipair : internals.ItemsMap)
+    {
+      if (!internals.IsInUse(ipair.first.first, key, this))
+      {
+        freed += ipair.second.first.GetCachedMemorySize(key);
+        freed += ipair.second.second.GetCachedMemorySize(key);
+      }
+    }
+    if (freed >= excess)
+    {
+      break;
+    }
+    excess -= freed;
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::EvictCacheKeys(vtkTypeUInt64 count)
+{
+  auto& internals = (*this->Internals);
+  const std::vector<double> candidates = internals.GetEvictionCandidates();
+  const bool spill = !vtkPVDataDeliveryManagerCacheSpillDirectory.empty();
+  for (size_t cc = 0; cc < candidates.size() && cc < count; ++cc)
+  {
+    const double key = candidates[cc];
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "%s cached data (key=%g)",
+      (spill ? "spill" : "evict"), key);
+    bool used = false;
+    for (auto& ipair : internals.ItemsMap)
+    {
+      if (!internals.IsInUse(ipair.first.first, key, this))
+      {
+        ipair.second.first.Evict(key, spill);
+        ipair.second.second.Evict(key, spill);
+      }
+      used = used || ipair.second.first.HasCacheKey(key) || ipair.second.second.HasCacheKey(key);
+    }
+    if (!used)
+    {
+      internals.CacheKeyUses.erase(key);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::PrefetchCacheKeys(double cacheKey)
+{
+  auto& internals = (*this->Internals);
+  if (internals.CacheKeyDirection == 0 || vtkPVDataDeliveryManagerCacheSpillDirectory.empty())
+  {
+    return;
+  }
+
+  // The next key along the playback direction.
+  auto& uses = internals.CacheKeyUses;
+  auto next = uses.end();
+  if (internals.CacheKeyDirection > 0)
+  {
+    next = uses.upper_bound(cacheKey);
+  }
+  else
+  {
+    auto iter = uses.lower_bound(cacheKey);
+    if (iter != uses.begin())
+    {
+      next = std::prev(iter);
+    }
+  }
+  if (next != uses.end())
+  {
+    for (auto& ipair : internals.ItemsMap)
+    {
+      ipair.second.first.Prefetch(next->first);
+      ipair.second.second.Prefetch(next->first);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::PrintSelf(ostream& os, vtkIndent indent)
 {
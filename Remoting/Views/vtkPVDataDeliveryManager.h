@@ -108,6 +108,49 @@ public:
    */
   void ClearCache(vtkPVDataRepresentation* repr);
 
+  //@{
+  /**
+   * Memory limit, in kilobytes, for the data cached by delivery managers of
+   * this process when caching geometry for animation playback. When exceeded,
+   * data for the least recently shown cache keys is evicted. 0 (default) means
+   * no limit. Must be the same on all processes.
+   */
+  static void SetCacheMemoryLimit(vtkTypeUInt64 kbytes);
+  static vtkTypeUInt64 GetCacheMemoryLimit();
+  //@}
+
+  //@{
+  /**
+   * Local scratch directory for evicted data. When set, evicted data objects
+   * are saved to this directory, and loaded back instead of being regenerated
+   * when their cache key is shown again. Data for the next cache key along
+   * the playback direction is loaded ahead of time, in the background. Empty
+   * (default) disables spilling: evicted data is simply released.
+   */
+  static void SetCacheSpillDirectory(const char* dirname);
+  static const char* GetCacheSpillDirectory();
+  //@}
+
+  /**
+   * Returns the memory, in kilobytes, held in memory for all cached data.
+   */
+  vtkTypeUInt64 GetCacheMemorySize();
+
+  //@{
+  /**
+   * Used by vtkPVView to keep the cache within its memory limit.
+   * MarkCacheKeyUsed() records that the view is now showing `cacheKey` and
+   * returns how many of the least recently used cache keys need to be
+   * evicted on this process. EvictCacheKeys() must then be called with the
+   * same count on all processes (e.g. the maximum over all processes), so
+   * that HasPiece() remains consistent across ranks. PrefetchCacheKeys()
+   * starts loading spilled data for the key following `cacheKey`.
+   */
+  vtkTypeUInt64 MarkCacheKeyUsed(double cacheKey);
+  void EvictCacheKeys(vtkTypeUInt64 count);
+  void PrefetchCacheKeys(double cacheKey);
+  //@}
+
   //@{
   /**
    * Provides access to the producer port for the geometry of a registered
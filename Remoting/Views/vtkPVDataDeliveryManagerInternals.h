@@ -27,12 +27,19 @@
 #include "vtkSmartPointer.h"
 #include "vtkWeakPointer.h"
 
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
 #include <cassert>
+#include <future>
 #include <map>
+#include <memory>
 #include <numeric>
 #include <queue>
 #include <sstream>
+#include <string>
 #include <utility>
+#include <vector>
 
 class vtkPVDataDeliveryManager::vtkInternals
 {
@@ -62,6 +69,23 @@ class vtkPVDataDeliveryManager::vtkInternals
   }
 
 public:
+  // A file holding a data object evicted from the cache. The file is removed
+  // when the last reference to it goes away.
+  struct vtkSpillFile
+  {
+    std::string FileName;
+    ~vtkSpillFile() { vtksys::SystemTools::RemoveFile(this->FileName); }
+  };
+
+  //@{
+  /**
+   * Helpers to save/load evicted data objects, using the native marshalling
+   * format (see vtkPVDataObjectMarshaller). ReadSpillFile() is thread safe.
+   */
+  static std::shared_ptr<vtkSpillFile> WriteSpillFile(vtkDataObject* data);
+  static vtkSmartPointer<vtkDataObject> ReadSpillFile(const std::string& fileName);
+  //@}
+
   struct vtkRepresentedData
   {
     // Data object produced by the representation.
@@ -76,6 +100,16 @@ public:
 
     // Arbitrary meta-data container.
     vtkSmartPointer<vtkInformation> Information;
+
+    // Copy of DataObject on disk, if it was ever evicted. When DataObject is
+    // nullptr, the data is only available from this file.
+    std::shared_ptr<vtkSpillFile> SpillFile;
+
+    // Pending background load of SpillFile. Declared after SpillFile so that
+    // the load is waited upon before the file gets removed.
+    std::shared_future<vtkSmartPointer<vtkDataObject> > Prefetch;
+
+    bool IsSpilled() const { return this->DataObject == nullptr && this->SpillFile != nullptr; }
   };
 
   class vtkItem
@@ -108,6 +142,10 @@ public:
       }
 
       store.DeliveredDataObjects.clear();
+      // releasing Prefetch waits for a pending load, which must be done
+      // before the spill file gets removed.
+      store.Prefetch = decltype(store.Prefetch)();
+      store.SpillFile = nullptr;
       store.ActualMemorySize = data ? data->GetActualMemorySize() : 0;
       // This method gets called when data is entirely changed. That means that any
       // data we may have delivered or redistributed would also be obsolete.
@@ -172,10 +210,117 @@ public:
       return this->Producer.GetPointer();
     }
 
-    vtkDataObject* GetDataObject(double cacheKey) const
+    bool HasDataObject(double cacheKey) const
+    {
+      auto iter = this->Data.find(cacheKey);
+      return iter != this->Data.end() &&
+        (iter->second.DataObject != nullptr || iter->second.IsSpilled());
+    }
+
+    // Returns the data object for the key, loading it back from its spill
+    // file if it was evicted.
+    vtkDataObject* GetDataObject(double cacheKey)
+    {
+      auto iter = this->Data.find(cacheKey);
+      if (iter == this->Data.end())
+      {
+        return nullptr;
+      }
+      auto& store = iter->second;
+      if (store.IsSpilled())
+      {
+        store.DataObject = store.Prefetch.valid()
+          ? store.Prefetch.get()
+          : vtkInternals::ReadSpillFile(store.SpillFile->FileName);
+        store.Prefetch = decltype(store.Prefetch)();
+        if (store.DataObject == nullptr)
+        {
+          vtkLogF(ERROR, "Failed to load cached data from '%s'.",
+            store.SpillFile->FileName.c_str());
+          store.SpillFile = nullptr;
+        }
+      }
+      return store.DataObject.GetPointer();
+    }
+
+    // Returns the memory, in kilobytes, held by the data cached for the key.
+    vtkTypeUInt64 GetCachedMemorySize(double cacheKey) const
+    {
+      auto iter = this->Data.find(cacheKey);
+      if (iter == this->Data.end())
+      {
+        return 0;
+      }
+      const auto& store = iter->second;
+      vtkTypeUInt64 size = store.DataObject ? store.DataObject->GetActualMemorySize() : 0;
+      for (const auto& dpair : store.DeliveredDataObjects)
+      {
+        if (dpair.second != nullptr && dpair.second != store.DataObject)
+        {
+          size += dpair.second->GetActualMemorySize();
+        }
+      }
+      return size;
+    }
+
+    vtkTypeUInt64 GetCachedMemorySize() const
+    {
+      vtkTypeUInt64 size = 0;
+      for (const auto& dpair : this->Data)
+      {
+        size += this->GetCachedMemorySize(dpair.first);
+      }
+      return size;
+    }
+
+    bool HasCacheKey(double cacheKey) const { return this->Data.find(cacheKey) != this->Data.end(); }
+
+    // Releases the memory held for the key. Delivered data is always dropped,
+    // so that it gets delivered again the next time the key is used. If
+    // `spill` is true, the data object is saved to a spill file first (if it
+    // has not been already), otherwise the entry is dropped altogether.
+    void Evict(double cacheKey, bool spill)
     {
       auto iter = this->Data.find(cacheKey);
-      return iter != this->Data.end() ? iter->second.DataObject.GetPointer() : nullptr;
+      if (iter == this->Data.end())
+      {
+        return;
+      }
+      auto& store = iter->second;
+      store.DeliveredDataObjects.clear();
+      if (!spill)
+      {
+        this->Data.erase(iter);
+        return;
+      }
+      if (store.DataObject == nullptr)
+      {
+        return;
+      }
+      if (store.SpillFile == nullptr)
+      {
+        store.SpillFile = vtkInternals::WriteSpillFile(store.DataObject);
+        if (store.SpillFile == nullptr)
+        {
+          // keep the data in memory rather than making it unavailable on this
+          // rank only.
+          return;
+        }
+      }
+      store.DataObject = nullptr;
+    }
+
+    // Starts loading the data for the key from its spill file in the
+    // background, if needed.
+    void Prefetch(double cacheKey)
+    {
+      auto iter = this->Data.find(cacheKey);
+      if (iter != this->Data.end() && iter->second.IsSpilled() && !iter->second.Prefetch.valid())
+      {
+        iter->second.Prefetch = std::async(std::launch::async, &vtkInternals::ReadSpillFile,
+          iter->second.SpillFile->FileName)
+                                  .share();
+      }
     }
 
     vtkMTimeType GetTimeStamp(double cacheKey) const
@@ -260,7 +405,7 @@ public:
       assert(repr != nullptr);
       const double cacheKey = dmgr->GetCacheKey(repr);
 
-      if (use_second_if_available && iter->second.second.GetDataObject(cacheKey))
+      if (use_second_if_available && iter->second.second.HasDataObject(cacheKey))
       {
         size += iter->second.second.GetActualMemorySize(cacheKey);
       }
@@ -292,8 +437,42 @@ public:
     }
   }
 
+  // Returns true if the representation is currently showing the data cached
+  // under `cacheKey`. Such data is never evicted.
+  bool IsInUse(unsigned int id, double cacheKey, vtkPVDataDeliveryManager* dmgr)
+  {
+    auto riter = this->RepresentationsMap.find(id);
+    return riter != this->RepresentationsMap.end() && riter->second != nullptr &&
+      dmgr->GetCacheKey(riter->second) == cacheKey;
+  }
+
+  // Returns the cache keys, least recently used first, excluding the most
+  // recent one.
+  std::vector<double> GetEvictionCandidates() const
+  {
+    std::vector<std::pair<vtkTypeUInt64, double> > uses;
+    for (const auto& kpair : this->CacheKeyUses)
+    {
+      uses.push_back(std::make_pair(kpair.second, kpair.first));
+    }
+    std::sort(uses.begin(), uses.end());
+    std::vector<double> keys;
+    for (size_t cc = 0; cc + 1 < uses.size(); ++cc)
+    {
+      keys.push_back(uses[cc].second);
+    }
+    return keys;
+  }
+
   ItemsMapType ItemsMap;
   RepresentationsMapType RepresentationsMap;
+
+  // Last use of each cache key shown by the view, as a counter value.
+  std::map<double, vtkTypeUInt64> CacheKeyUses;
+  vtkTypeUInt64 CacheKeyUseCounter{ 0 };
+
+  // Playback direction inferred from the last two cache keys: -1, 0 or 1.
+  int CacheKeyDirection{ 0 };
 };
 
 #endif // __WRAP__
@@ -281,6 +281,15 @@ public:
    */
   void ConfigureCompressor(const char* configuration);
 
+  /**
+   * Passes the tile size used to send only the changed parts of interactive
+   * frames to the client-server synchronizer, if any. 0 disables delta frames.
+   * See vtkPVClientServerSynchronizedRenderers::SetDeltaTileSize() for
+   * details.
+   * \note CallOnAllProcesses
+   */
+  void SetImageDeltaTileSize(int size);
+
   /**
    * Resets the clipping range. One does not need to call this directly ever. It
    * is called periodically by the vtkRenderer to reset the camera range.
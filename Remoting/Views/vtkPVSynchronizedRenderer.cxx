@@ -334,6 +334,21 @@ void vtkPVSynchronizedRenderer::SetNVPipeSupport(bool enable)
   cssync->SetNVPipeSupport(enable);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSynchronizedRenderer::SetImageDeltaTileSize(int size)
+{
+  vtkPVClientServerSynchronizedRenderers* cssync =
+    vtkPVClientServerSynchronizedRenderers::SafeDownCast(this->CSSynchronizer);
+  if (cssync)
+  {
+    cssync->SetDeltaTileSize(size);
+  }
+  else
+  {
+    vtkDebugMacro("Not in client-server mode.");
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSynchronizedRenderer::SetupPasses()
 {
@@ -152,6 +152,13 @@ public:
    */
   void SetNVPipeSupport(bool);
 
+  /**
+   * Passes the tile size used for delta frames to the client-server
+   * synchronizer, if any.
+   * See vtkPVClientServerSynchronizedRenderers::SetDeltaTileSize() for details.
+   */
+  void SetImageDeltaTileSize(int);
+
   //@{
   /**
    * State flags to turn on specialized treatment for ray tracing.
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkPVView.h"
 
+#include "vtkAlgorithmOutput.h"
 #include "vtkBoundingBox.h"
 #include "vtkCommunicator.h"
 #include "vtkGenericOpenGLRenderWindow.h"
@@ -25,6 +26,7 @@
 #include "vtkMPIMoveData.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLState.h"
 #include "vtkPVDataDeliveryManager.h"
@@ -32,6 +34,7 @@
 #include "vtkPVLogger.h"
 #include "vtkPVOptions.h"
 #include "vtkPVProcessWindow.h"
+#include "vtkPVProgressHandler.h"
 #include "vtkPVRenderingCapabilitiesInformation.h"
 #include "vtkPVServerInformation.h"
 #include "vtkPVSession.h"
@@ -39,15 +42,27 @@
 #include "vtkProcessModule.h"
 #include "vtkRenderWindow.h"
 #include "vtkRendererCollection.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTimerLog.h"
 #include "vtkViewLayout.h"
 
 #include <cassert>
 #include <map>
+#include <numeric>
 #include <sstream>
+#include <vector>
 
 namespace
 {
+// Returns true if `algo` calls into the Python interpreter when it executes.
+bool vtkPVViewIsPythonAlgorithm(vtkAlgorithm* algo)
+{
+  // checked by name since this module does not depend on Python.
+  return algo->IsA("vtkPythonAlgorithm") || algo->IsA("vtkPythonProgrammableFilter") ||
+    algo->IsA("vtkPythonCalculator") || algo->IsA("vtkPythonAnnotationFilter");
+}
+
 class vtkOffscreenOpenGLRenderWindow : public vtkGenericOpenGLRenderWindow
 {
 public:
@@ -167,6 +182,20 @@ bool vtkPVView::GetEnableStreaming()
   return vtkPVView::EnableStreaming;
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVView::EnableConcurrentUpdates = false;
+//----------------------------------------------------------------------------
+void vtkPVView::SetEnableConcurrentUpdates(bool val)
+{
+  vtkPVView::EnableConcurrentUpdates = val;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVView::GetEnableConcurrentUpdates()
+{
+  return vtkPVView::EnableConcurrentUpdates;
+}
+
 //----------------------------------------------------------------------------
 bool vtkPVView::UseGenericOpenGLRenderWindow = false;
 //----------------------------------------------------------------------------
@@ -199,6 +228,10 @@ vtkPVView::vtkPVView(bool create_render_window)
   if (auto options = pm->GetOptions())
   {
     vtkPVView::SetEnableStreaming(options->GetEnableStreaming() != 0);
+    if (options->GetEnableConcurrentUpdates())
+    {
+      vtkPVView::SetEnableConcurrentUpdates(true);
+    }
   }
 
   vtkStreamingStatusMacro("View Streaming  Status: " << vtkPVView::GetEnableStreaming());
@@ -468,11 +501,30 @@ void vtkPVView::Update()
     }
   }
 
+  if (vtkPVView::GetEnableConcurrentUpdates())
+  {
+    this->UpdateUpstreamPipelinesConcurrently();
+  }
+
   vtkTimerLog::MarkStartEvent("vtkPVView::Update");
   const int count = this->CallProcessViewRequest(
     vtkPVView::REQUEST_UPDATE(), this->RequestInformation, this->ReplyInformationVector);
   vtkTimerLog::MarkEndEvent("vtkPVView::Update");
 
+  // When caching geometry for animation playback, keep the cache within its
+  // memory limit. The number of cache keys to evict is agreed upon by all
+  // processes so that the cached data remains consistent across ranks.
+  if (this->UseCache && this->DeliveryManager)
+  {
+    vtkTypeUInt64 evictCount = this->DeliveryManager->MarkCacheKeyUsed(this->CacheKey);
+    if (vtkPVDataDeliveryManager::GetCacheMemoryLimit() > 0)
+    {
+      this->AllReduce(evictCount, evictCount, vtkCommunicator::MAX_OP);
+      this->DeliveryManager->EvictCacheKeys(evictCount);
+    }
+    this->DeliveryManager->PrefetchCacheKeys(this->CacheKey);
+  }
+
   // exchange information about representations that are time-dependent.
   // this goes from data-server-root to client and render-server.
   if (count)
@@ -483,6 +535,182 @@ void vtkPVView::Update()
   this->UpdateTimeStamp.Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVView::UpdateUpstreamPipelinesConcurrently()
+{
+  // With more than one rank, upstream algorithms may use collective
+  // communication and must execute in the same order on every rank. When
+  // caching for animation playback, representations may not need their input.
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  if (this->UseCache || (controller && controller->GetNumberOfProcesses() > 1))
+  {
+    return;
+  }
+
+  // One task per input connection of each visible representation that needs
+  // an update.
+  struct UpdateTask
+  {
+    vtkPVDataRepresentation* Representation;
+    vtkAlgorithmOutput* Input;
+  };
+  std::vector<UpdateTask> tasks;
+  const int num_reprs = this->GetNumberOfRepresentations();
+  for (int cc = 0; cc < num_reprs; cc++)
+  {
+    auto pvrepr = vtkPVDataRepresentation::SafeDownCast(this->GetRepresentation(cc));
+    if (!pvrepr || !pvrepr->GetVisibility() || pvrepr->GetForceUseCache() ||
+      !pvrepr->GetNeedsUpdate())
+    {
+      continue;
+    }
+    for (int port = 0; port < pvrepr->GetNumberOfInputPorts(); ++port)
+    {
+      for (int conn = 0; conn < pvrepr->GetNumberOfInputConnections(port); ++conn)
+      {
+        vtkAlgorithmOutput* input = pvrepr->GetInputConnection(port, conn);
+        if (input && input->GetProducer())
+        {
+          tasks.push_back(UpdateTask{ pvrepr, input });
+        }
+      }
+    }
+  }
+  if (tasks.size() < 2)
+  {
+    return;
+  }
+
+  // Group tasks whose upstream pipelines share an algorithm; each group is
+  // updated sequentially, in representation order, so that shared filters
+  // never execute on two threads at once.
+  std::vector<size_t> parents(tasks.size());
+  std::iota(parents.begin(), parents.end(), 0);
+  auto find = [&parents](size_t idx) {
+    while (parents[idx] != idx)
+    {
+      idx = parents[idx] = parents[parents[idx]];
+    }
+    return idx;
+  };
+
+  std::map<vtkAlgorithm*, size_t> owners;
+  std::vector<bool> usesPython(tasks.size(), false);
+  for (size_t cc = 0; cc < tasks.size(); ++cc)
+  {
+    std::vector<vtkAlgorithm*> stack(1, tasks[cc].Input->GetProducer());
+    while (!stack.empty())
+    {
+      vtkAlgorithm* algo = stack.back();
+      stack.pop_back();
+      auto iter = owners.find(algo);
+      if (iter != owners.end())
+      {
+        // either already visited for this task or shared with another task.
+        parents[find(iter->second)] = find(cc);
+        continue;
+      }
+      owners[algo] = cc;
+      usesPython[cc] = usesPython[cc] || vtkPVViewIsPythonAlgorithm(algo);
+      for (int port = 0; port < algo->GetNumberOfInputPorts(); ++port)
+      {
+        for (int conn = 0; conn < algo->GetNumberOfInputConnections(port); ++conn)
+        {
+          vtkAlgorithmOutput* input = algo->GetInputConnection(port, conn);
+          if (input && input->GetProducer())
+          {
+            stack.push_back(input->GetProducer());
+          }
+        }
+      }
+    }
+  }
+
+  std::map<size_t, std::vector<size_t> > groupsMap;
+  for (size_t cc = 0; cc < tasks.size(); ++cc)
+  {
+    groupsMap[find(cc)].push_back(cc);
+  }
+  if (groupsMap.size() < 2)
+  {
+    return;
+  }
+  // Groups with a Python algorithm are updated on this thread: the calling
+  // thread may hold the GIL (e.g. in pvpython) and the interpreter must not
+  // be used without it.
+  std::vector<std::vector<size_t> > groups;
+  std::vector<std::vector<size_t> > pythonGroups;
+  for (auto& pair : groupsMap)
+  {
+    bool python = false;
+    for (size_t idx : pair.second)
+    {
+      python = python || usesPython[idx];
+    }
+    (python ? pythonGroups : groups).push_back(std::move(pair.second));
+  }
+
+  // Same request as vtkPVDataRepresentation::RequestUpdateExtent() so that the
+  // representation update that follows finds its input up to date.
+  auto updateGroup = [&tasks](const std::vector<size_t>& group) {
+    for (size_t idx : group)
+    {
+      const UpdateTask& task = tasks[idx];
+      vtkAlgorithm* producer = task.Input->GetProducer();
+      const int port = task.Input->GetIndex();
+      vtkNew<vtkInformationVector> requests;
+      requests->SetNumberOfInformationObjects(producer->GetNumberOfOutputPorts());
+      vtkInformation* info = requests->GetInformationObject(port);
+      info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), 0);
+      info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), 1);
+      info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(), 0);
+      info->Set(vtkStreamingDemandDrivenPipeline::EXACT_EXTENT(), 1);
+      if (task.Representation->GetUpdateTimeValid())
+      {
+        info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(),
+          task.Representation->GetUpdateTime());
+      }
+      producer->Update(port, requests);
+    }
+  };
+
+  for (const auto& group : pythonGroups)
+  {
+    updateGroup(group);
+  }
+  if (groups.size() < 2)
+  {
+    // left to the sequential representation update.
+    return;
+  }
+
+  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+    "%s: update %d independent upstream pipelines concurrently", this->GetLogName().c_str(),
+    static_cast<int>(groups.size()));
+
+  // vtkTimerLog is not thread-safe.
+  const int logging = vtkTimerLog::GetLogging();
+  vtkTimerLog::LoggingOff();
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(groups.size()), 1,
+    [&groups, &updateGroup](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType group = begin; group < end; ++group)
+      {
+        updateGroup(groups[group]);
+      }
+    });
+
+  vtkTimerLog::SetLogging(logging);
+
+  // forward the messages reported by the pipelines updated on other threads.
+  vtkPVProgressHandler* progressHandler =
+    this->Session ? this->Session->GetProgressHandler() : nullptr;
+  if (progressHandler)
+  {
+    progressHandler->FlushPendingMessages();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVView::SynchronizeRepresentationTemporalPipelineStates()
 {
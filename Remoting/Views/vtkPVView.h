@@ -50,6 +50,25 @@ public:
   static void SetEnableStreaming(bool);
   static bool GetEnableStreaming();
 
+  //@{
+  /**
+   * When enabled, `Update` first updates the pipelines upstream of the
+   * representations that need an update concurrently, provided they do not
+   * share any algorithm. Representations fed by a shared upstream algorithm
+   * are updated sequentially, in order, as before. The representations
+   * themselves are still updated sequentially afterwards. This is only done
+   * when running on a single process and is off by default since not every
+   * reader or filter is thread-safe (e.g. HDF5-based readers). Pipelines
+   * with a Python algorithm are always updated on the calling thread. Since
+   * vtkTimerLog is not thread-safe, its logging is turned off for the whole
+   * process while the pipelines are updated concurrently: timer events from
+   * other threads are dropped during that time. It is initialized from
+   * `vtkPVOptions::GetEnableConcurrentUpdates`.
+   */
+  static void SetEnableConcurrentUpdates(bool);
+  static bool GetEnableConcurrentUpdates();
+  //@}
+
   //@{
   /**
    * Set the position on this view in the multiview configuration.
@@ -384,9 +403,16 @@ private:
    */
   void SynchronizeRepresentationTemporalPipelineStates();
 
+  /**
+   * Called in Update() when `EnableConcurrentUpdates` is set to update the
+   * independent pipelines upstream of the representations concurrently.
+   */
+  void UpdateUpstreamPipelinesConcurrently();
+
   vtkRenderWindow* RenderWindow;
   bool ViewTimeValid;
   static bool EnableStreaming;
+  static bool EnableConcurrentUpdates;
   vtkWeakPointer<vtkPVSession> Session;
   std::string LogName;
 
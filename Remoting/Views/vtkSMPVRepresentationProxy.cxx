@@ -85,11 +85,23 @@ void vtkSMPVRepresentationProxy::CreateVTKObjects()
   // this->InvalidateDataInformation() is called.
   this->AddObserver(
     vtkCommand::UpdatePropertyEvent, this, &vtkSMPVRepresentationProxy::OnPropertyUpdated);
+  this->AddObserver(
+    vtkSMProxy::UpdatePropertiesEvent, this, &vtkSMPVRepresentationProxy::OnPropertyUpdated);
 }
 
 //----------------------------------------------------------------------------
-void vtkSMPVRepresentationProxy::OnPropertyUpdated(vtkObject*, unsigned long, void* calldata)
+void vtkSMPVRepresentationProxy::OnPropertyUpdated(
+  vtkObject*, unsigned long event, void* calldata)
 {
+  if (event == vtkSMProxy::UpdatePropertiesEvent)
+  {
+    for (const char** names = reinterpret_cast<const char**>(calldata); names && *names; ++names)
+    {
+      this->OnPropertyUpdated(this, vtkCommand::UpdatePropertyEvent, const_cast<char*>(*names));
+    }
+    return;
+  }
+
   const char* pname = reinterpret_cast<const char*>(calldata);
   if (pname && strcmp(pname, "Representation") == 0)
   {
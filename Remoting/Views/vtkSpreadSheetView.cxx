@@ -42,10 +42,13 @@
 #include "vtkVariant.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <list>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 namespace
 {
@@ -204,20 +207,26 @@ class vtkSpreadSheetView::vtkInternals
     return 0;
   }
 
+  // Blocks ordered from the most to the least recently used one, so that the
+  // block to evict is always the last one.
+  typedef std::list<vtkIdType> RecentlyUsedType;
+  RecentlyUsedType RecentlyUsedBlocks;
+
   class CacheInfo
   {
   public:
     vtkSmartPointer<vtkTable> Dataobject;
-    vtkTimeStamp RecentUseTime;
+    RecentlyUsedType::iterator RecentUse;
   };
 
-  typedef std::map<vtkIdType, CacheInfo> CacheType;
+  typedef std::unordered_map<vtkIdType, CacheInfo> CacheType;
   CacheType CachedBlocks;
 
 public:
   void ClearCache()
   {
     this->CachedBlocks.clear();
+    this->RecentlyUsedBlocks.clear();
     this->ColumnMetaData.clear();
     this->ColumnIndexMap.clear();
   }
@@ -256,34 +265,37 @@ public:
     CacheType::iterator iter = this->CachedBlocks.find(blockId);
     if (iter != this->CachedBlocks.end())
     {
-      iter->second.RecentUseTime.Modified();
+      this->RecentlyUsedBlocks.splice(
+        this->RecentlyUsedBlocks.begin(), this->RecentlyUsedBlocks, iter->second.RecentUse);
       this->MostRecentlyAccessedBlock = blockId;
       return iter->second.Dataobject.GetPointer();
     }
     return NULL;
   }
 
+  /**
+   * Returns true if the block is cached, without marking it as used.
+   */
+  bool IsCached(vtkIdType blockId) const
+  {
+    return this->CachedBlocks.find(blockId) != this->CachedBlocks.end();
+  }
+
   void AddToCache(vtkIdType blockId, vtkTable* data, vtkIdType max)
   {
     CacheType::iterator iter = this->CachedBlocks.find(blockId);
     if (iter != this->CachedBlocks.end())
     {
+      this->RecentlyUsedBlocks.erase(iter->second.RecentUse);
       this->CachedBlocks.erase(iter);
     }
 
-    if (static_cast<vtkIdType>(this->CachedBlocks.size()) == max)
+    // remove least-recent-used blocks.
+    while (!this->RecentlyUsedBlocks.empty() &&
+      static_cast<vtkIdType>(this->CachedBlocks.size()) >= max)
     {
-      // remove least-recent-used block.
-      iter = this->CachedBlocks.begin();
-      CacheType::iterator iterToRemove = this->CachedBlocks.begin();
-      for (; iter != this->CachedBlocks.end(); ++iter)
-      {
-        if (iterToRemove->second.RecentUseTime > iter->second.RecentUseTime)
-        {
-          iterToRemove = iter;
-        }
-      }
-      this->CachedBlocks.erase(iterToRemove);
+      this->CachedBlocks.erase(this->RecentlyUsedBlocks.back());
+      this->RecentlyUsedBlocks.pop_back();
     }
 
     CacheInfo info;
@@ -306,7 +318,8 @@ public:
     }
     info.Dataobject = clone;
     clone->FastDelete();
-    info.RecentUseTime.Modified();
+    this->RecentlyUsedBlocks.push_front(blockId);
+    info.RecentUse = this->RecentlyUsedBlocks.begin();
     this->CachedBlocks[blockId] = info;
     this->MostRecentlyAccessedBlock = blockId;
 
@@ -340,6 +353,8 @@ public:
   }
 
   vtkIdType MostRecentlyAccessedBlock;
+  vtkIdType ViewportRows[2];
+  double ScrollVelocity;
   vtkWeakPointer<vtkSpreadSheetRepresentation> ActiveRepresentation;
   vtkCommand* Observer;
 
@@ -444,6 +459,10 @@ vtkSpreadSheetView::vtkSpreadSheetView()
 
   this->Internals = new vtkInternals();
   this->Internals->MostRecentlyAccessedBlock = -1;
+  this->Internals->ViewportRows[0] = this->Internals->ViewportRows[1] = -1;
+  this->Internals->ScrollVelocity = 0.0;
+  this->PrefetchLookAhead = 1.0;
+  this->MaximumNumberOfPrefetchedBlocks = 4;
 
   this->Internals->Observer =
     vtkMakeMemberFunctionCommand(*this, &vtkSpreadSheetView::OnRepresentationUpdated);
@@ -688,12 +707,94 @@ vtkTable* vtkSpreadSheetView::FetchBlock(vtkIdType blockindex)
   if (!block)
   {
     block = this->FetchBlockCallback(blockindex);
-    this->Internals->AddToCache(blockindex, block, 10);
+    this->Internals->AddToCache(blockindex, block, this->GetCacheCapacity());
     this->InvokeEvent(vtkCommand::UpdateEvent, &blockindex);
   }
   return block;
 }
 
+//----------------------------------------------------------------------------
+void vtkSpreadSheetView::SetViewport(vtkIdType firstRow, vtkIdType lastRow, double rowsPerSecond)
+{
+  auto& internals = *this->Internals;
+  internals.ViewportRows[0] = std::min(firstRow, lastRow);
+  internals.ViewportRows[1] = std::max(firstRow, lastRow);
+  internals.ScrollVelocity = rowsPerSecond;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSpreadSheetView::GetViewportBlocks(vtkIdType& first, vtkIdType& last)
+{
+  const auto& internals = *this->Internals;
+  if (this->NumberOfRows <= 0 || internals.ViewportRows[0] < 0)
+  {
+    return false;
+  }
+  const vtkIdType blockSize = this->TableStreamer->GetBlockSize();
+  const vtkIdType lastBlock = (this->NumberOfRows - 1) / blockSize;
+  first = std::min(internals.ViewportRows[0] / blockSize, lastBlock);
+  last = std::min(internals.ViewportRows[1] / blockSize, lastBlock);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkSpreadSheetView::GetCacheCapacity()
+{
+  // the cache must be able to hold the visible blocks together with the
+  // prefetched ones, otherwise prefetching would evict the blocks being shown.
+  vtkIdType first, last;
+  if (!this->GetViewportBlocks(first, last))
+  {
+    return 10;
+  }
+  return std::max<vtkIdType>(10, last - first + 2 + this->MaximumNumberOfPrefetchedBlocks);
+}
+
+//----------------------------------------------------------------------------
+bool vtkSpreadSheetView::PrefetchNextBlock()
+{
+  auto& internals = *this->Internals;
+  vtkIdType first, last;
+  if (!internals.ActiveRepresentation || !this->GetViewportBlocks(first, last))
+  {
+    return false;
+  }
+
+  const vtkIdType blockSize = this->TableStreamer->GetBlockSize();
+  const vtkIdType lastBlock = (this->NumberOfRows - 1) / blockSize;
+  const double velocity = internals.ScrollVelocity;
+
+  // visible blocks come first, then the blocks the viewport will reach within
+  // PrefetchLookAhead seconds at the current velocity, nearest first, and
+  // finally the block on the other side of the viewport.
+  std::vector<vtkIdType> candidates;
+  for (vtkIdType cc = first; cc <= last; ++cc)
+  {
+    candidates.push_back(cc);
+  }
+  const vtkIdType budget = this->MaximumNumberOfPrefetchedBlocks;
+  const vtkIdType ahead = std::min(budget,
+    1 + static_cast<vtkIdType>(std::abs(velocity) * this->PrefetchLookAhead / blockSize));
+  for (vtkIdType cc = 1; cc <= ahead; ++cc)
+  {
+    candidates.push_back(velocity < 0 ? first - cc : last + cc);
+  }
+  if (ahead < budget)
+  {
+    candidates.push_back(velocity < 0 ? last + 1 : first - 1);
+  }
+
+  for (auto blockindex : candidates)
+  {
+    if (blockindex >= 0 && blockindex <= lastBlock && !internals.IsCached(blockindex))
+    {
+      this->FetchBlock(blockindex);
+      return true;
+    }
+  }
+  return false;
+}
+
 //----------------------------------------------------------------------------
 vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex)
 {
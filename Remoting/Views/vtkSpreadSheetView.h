@@ -185,6 +185,45 @@ public:
    */
   virtual bool IsDataValid(vtkIdType row, vtkIdType col);
 
+  /**
+   * Set the range of rows currently shown and the speed, in rows per second,
+   * at which the user scrolls through them (negative when scrolling towards
+   * the first row). This is used by PrefetchNextBlock() to pick the blocks to
+   * fetch ahead of the viewport.
+   * \note CallOnClient
+   */
+  void SetViewport(vtkIdType firstRow, vtkIdType lastRow, double rowsPerSecond);
+
+  /**
+   * Fetches one block that is shown or that is likely to be shown soon given
+   * the viewport and scroll velocity, if it is not already cached. Returns
+   * false if there was nothing left to fetch. This is meant to be called one
+   * block at a time when the client is idle, so that cached blocks keep being
+   * shown in between fetches.
+   * \note CallOnClient
+   */
+  virtual bool PrefetchNextBlock();
+
+  //@{
+  /**
+   * Get/Set how far ahead, in seconds of scrolling at the velocity passed to
+   * SetViewport(), PrefetchNextBlock() looks for blocks to fetch. 1 by default.
+   * \note CallOnClient
+   */
+  vtkSetClampMacro(PrefetchLookAhead, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(PrefetchLookAhead, double);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the maximum number of blocks outside the viewport that
+   * PrefetchNextBlock() fetches. 4 by default.
+   * \note CallOnClient
+   */
+  vtkSetClampMacro(MaximumNumberOfPrefetchedBlocks, int, 0, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfPrefetchedBlocks, int);
+  //@}
+
   //***************************************************************************
   // Forwarded to vtkSortedTableStreamer.
   /**
@@ -236,6 +275,17 @@ protected:
 
   virtual vtkTable* FetchBlock(vtkIdType blockindex);
 
+  /**
+   * Returns the range of blocks covered by the viewport set with
+   * SetViewport(). Returns false if no viewport was set or there are no rows.
+   */
+  bool GetViewportBlocks(vtkIdType& first, vtkIdType& last);
+
+  /**
+   * Returns the number of blocks to keep in the cache.
+   */
+  vtkIdType GetCacheCapacity();
+
   bool ShowExtractedSelection;
   bool GenerateCellConnectivity;
   vtkSortedTableStreamer* TableStreamer;
@@ -243,6 +293,8 @@ protected:
   vtkReductionFilter* ReductionFilter;
   vtkClientServerMoveData* DeliveryFilter;
   vtkIdType NumberOfRows;
+  double PrefetchLookAhead;
+  int MaximumNumberOfPrefetchedBlocks;
 
   unsigned long CRMICallbackTag;
   unsigned long PRMICallbackTag;
@@ -414,6 +414,47 @@ void get_args(FILE* fp, int i)
 int managableArguments(FunctionInfo* curFunction);
 int notWrappable(FunctionInfo* curFunction);
 
+/* the key the generated code dispatches on, this must match
+   vtkClientServerInterpreter::GetMethodHash() */
+static unsigned int method_hash(const char* name, int numberOfArguments)
+{
+  const unsigned char* cp;
+  unsigned int hash = 2166136261u;
+  for (cp = (const unsigned char*)name; *cp; cp++)
+  {
+    hash = ((hash ^ *cp) * 16777619u) & 0xffffffffu;
+  }
+  hash = ((hash ^ (unsigned int)numberOfArguments) * 16777619u) & 0xffffffffu;
+  return hash;
+}
+
+/* a wrapped method, with its dispatch key */
+typedef struct
+{
+  FunctionInfo* Function;
+  unsigned int Hash;
+  int Order;
+} DispatchInfo;
+
+/* sort by key, keeping the declaration order of overloads */
+static int dispatchCmp(const void* info1, const void* info2)
+{
+  const DispatchInfo* a = (const DispatchInfo*)info1;
+  const DispatchInfo* b = (const DispatchInfo*)info2;
+  if (a->Hash != b->Hash)
+  {
+    return a->Hash < b->Hash ? -1 : 1;
+  }
+  return a->Order - b->Order;
+}
+
+/* true if outputFunction() generates code for the function */
+static int is_dispatched(ClassInfo* data, FunctionInfo* func)
+{
+  return !notWrappable(func) && managableArguments(func) && strcmp(data->Name, func->Name) &&
+    strcmp(data->Name, func->Name + 1);
+}
+
 void outputFunction(FILE* fp, ClassInfo* data)
 {
   int i;
@@ -1214,6 +1255,8 @@ int main(int argc, char* argv[])
   size_t nspos;
   FILE* fp;
   NewClassInfo* classData;
+  DispatchInfo* dispatch;
+  int numberOfDispatched;
   int i, j;
 
   /* pre-define a macro to identify the language */
@@ -1414,12 +1457,47 @@ int main(int argc, char* argv[])
 
   /*fprintf(fp,"  vtkClientServerStream resultStream;\n");*/
 
-  /* insert function handling code here */
+  /* insert function handling code here, methods are selected with a switch
+     on a hash of their name and number of arguments, the name is still
+     compared in each case in case of collisions */
+  dispatch = (DispatchInfo*)malloc(sizeof(DispatchInfo) * (data->NumberOfFunctions + 1));
+  numberOfDispatched = 0;
   for (i = 0; i < data->NumberOfFunctions; i++)
   {
-    currentFunction = data->Functions[i];
-    outputFunction(fp, data);
+    if (is_dispatched(data, data->Functions[i]))
+    {
+      dispatch[numberOfDispatched].Function = data->Functions[i];
+      dispatch[numberOfDispatched].Hash =
+        method_hash(data->Functions[i]->Name, data->Functions[i]->NumberOfArguments + 2);
+      dispatch[numberOfDispatched].Order = i;
+      numberOfDispatched++;
+    }
+  }
+  qsort(dispatch, numberOfDispatched, sizeof(DispatchInfo), dispatchCmp);
+  if (numberOfDispatched > 0)
+  {
+    fprintf(fp, "  switch (vtkClientServerInterpreter::GetMethodHash(method, "
+                "msg.GetNumberOfArguments(0)))\n"
+                "  {\n");
+    for (i = 0; i < numberOfDispatched; i++)
+    {
+      if (i == 0 || dispatch[i].Hash != dispatch[i - 1].Hash)
+      {
+        if (i > 0)
+        {
+          fprintf(fp, "  break;\n");
+        }
+        fprintf(fp, "  case 0x%08xu:\n", dispatch[i].Hash);
+      }
+      currentFunction = dispatch[i].Function;
+      outputFunction(fp, data);
+    }
+    fprintf(fp, "  break;\n"
+                "  default:\n"
+                "  break;\n"
+                "  }\n");
   }
+  free(dispatch);
 
   /* try superclasses */
   for (i = 0; i < data->NumberOfSuperClasses; i++)
@@ -0,0 +1,193 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestAMRDualSMP.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkPVAMRDualContour and vtkPVAMRDualClip, which process blocks
+// concurrently, produce a valid dual-grid output that is identical whether
+// they run on one thread or on all of them.
+
+#include "vtkAlgorithm.h"
+#include "vtkBoundingBox.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataSet.h"
+#include "vtkDummyController.h"
+#include "vtkIdList.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkPVAMRDualClip.h"
+#include "vtkPVAMRDualContour.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpyPlotReader.h"
+#include "vtkTestUtilities.h"
+
+#include <vector>
+
+#define CHECK(cond)                                                                                \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: Condition FAILED!! : " << #cond << " (line " << __LINE__ << ")" << endl;       \
+    success = false;                                                                               \
+  }
+
+namespace
+{
+std::vector<vtkSmartPointer<vtkDataSet> > GetLeaves(vtkDataObject* data)
+{
+  std::vector<vtkSmartPointer<vtkDataSet> > leaves;
+  vtkCompositeDataSet* composite = vtkCompositeDataSet::SafeDownCast(data);
+  if (composite == nullptr)
+  {
+    return leaves;
+  }
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(composite->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+    {
+      leaves.push_back(ds);
+    }
+  }
+  return leaves;
+}
+
+// Returns a copy of the output of `algorithm` computed with `numThreads`
+// threads (0 for the default).
+vtkSmartPointer<vtkDataObject> Execute(vtkAlgorithm* algorithm, int numThreads)
+{
+  vtkSMPTools::Initialize(numThreads);
+  algorithm->Modified();
+  algorithm->Update();
+  vtkSmartPointer<vtkDataObject> output;
+  output.TakeReference(algorithm->GetOutputDataObject(0)->NewInstance());
+  output->DeepCopy(algorithm->GetOutputDataObject(0));
+  return output;
+}
+
+bool CheckOutput(const char* name, vtkAlgorithm* algorithm, const vtkBoundingBox& inputBounds)
+{
+  bool success = true;
+  auto serial = GetLeaves(Execute(algorithm, 1));
+  auto parallel = GetLeaves(Execute(algorithm, 0));
+
+  // the dual grid connects cell centers: the output must lie within the
+  // input and only reference its own points.
+  vtkIdType numCells = 0;
+  vtkNew<vtkIdList> ids;
+  for (vtkDataSet* ds : serial)
+  {
+    numCells += ds->GetNumberOfCells();
+    if (ds->GetNumberOfPoints() > 0)
+    {
+      double bounds[6];
+      ds->GetBounds(bounds);
+      CHECK(inputBounds.ContainsPoint(bounds[0], bounds[2], bounds[4]));
+      CHECK(inputBounds.ContainsPoint(bounds[1], bounds[3], bounds[5]));
+    }
+    for (vtkIdType cellId = 0; cellId < ds->GetNumberOfCells(); ++cellId)
+    {
+      ds->GetCellPoints(cellId, ids);
+      for (vtkIdType cc = 0; cc < ids->GetNumberOfIds(); ++cc)
+      {
+        CHECK(ids->GetId(cc) >= 0 && ids->GetId(cc) < ds->GetNumberOfPoints());
+      }
+    }
+  }
+  CHECK(numCells > 0);
+
+  // processing blocks concurrently must not change the output.
+  CHECK(serial.size() == parallel.size());
+  for (size_t block = 0; success && block < serial.size(); ++block)
+  {
+    vtkDataSet* expected = serial[block];
+    vtkDataSet* actual = parallel[block];
+    CHECK(expected->GetNumberOfPoints() == actual->GetNumberOfPoints());
+    CHECK(expected->GetNumberOfCells() == actual->GetNumberOfCells());
+    for (vtkIdType ptId = 0; success && ptId < expected->GetNumberOfPoints(); ++ptId)
+    {
+      double p0[3], p1[3];
+      expected->GetPoint(ptId, p0);
+      actual->GetPoint(ptId, p1);
+      CHECK(p0[0] == p1[0] && p0[1] == p1[1] && p0[2] == p1[2]);
+    }
+    vtkNew<vtkIdList> actualIds;
+    for (vtkIdType cellId = 0; success && cellId < expected->GetNumberOfCells(); ++cellId)
+    {
+      CHECK(expected->GetCellType(cellId) == actual->GetCellType(cellId));
+      expected->GetCellPoints(cellId, ids);
+      actual->GetCellPoints(cellId, actualIds);
+      CHECK(ids->GetNumberOfIds() == actualIds->GetNumberOfIds());
+      for (vtkIdType cc = 0; success && cc < ids->GetNumberOfIds(); ++cc)
+      {
+        CHECK(ids->GetId(cc) == actualIds->GetId(cc));
+      }
+    }
+  }
+  if (!success)
+  {
+    cerr << "ERROR: unexpected " << name << " output." << endl;
+  }
+  return success;
+}
+}
+
+int TestAMRDualSMP(int argc, char* argv[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  char* fname = vtkTestUtilities::ExpandDataFileName(
+    argc, argv, "Testing/Data/SPCTH/Dave_Karelitz_Small/spcth.0");
+  vtkNew<vtkSpyPlotReader> reader;
+  reader->SetFileName(fname);
+  reader->SetGlobalController(controller);
+  reader->MergeXYZComponentsOn();
+  reader->DownConvertVolumeFractionOn();
+  reader->DistributeFilesOn();
+  reader->SetCellArrayStatus("Material volume fraction - 2", 1);
+  reader->Update();
+  delete[] fname;
+
+  vtkBoundingBox inputBounds;
+  for (vtkDataSet* block : GetLeaves(reader->GetOutputDataObject(0)))
+  {
+    double bounds[6];
+    block->GetBounds(bounds);
+    inputBounds.AddBounds(bounds);
+  }
+
+  bool success = true;
+  vtkNew<vtkPVAMRDualContour> contour;
+  contour->SetInputData(reader->GetOutputDataObject(0));
+  contour->SetVolumeFractionSurfaceValue(0.1);
+  contour->SetEnableMergePoints(1);
+  contour->SetEnableDegenerateCells(1);
+  contour->SetEnableMultiProcessCommunication(1);
+  contour->AddInputCellArrayToProcess("Material volume fraction - 2");
+  success &= CheckOutput("vtkPVAMRDualContour", contour, inputBounds);
+
+  vtkNew<vtkPVAMRDualClip> clip;
+  clip->SetInputData(reader->GetOutputDataObject(0));
+  clip->SetVolumeFractionSurfaceValue(0.1);
+  clip->SetEnableMergePoints(1);
+  clip->SetEnableDegenerateCells(1);
+  clip->SetEnableMultiProcessCommunication(1);
+  clip->AddInputCellArrayToProcess("Material volume fraction - 2");
+  success &= CheckOutput("vtkPVAMRDualClip", clip, inputBounds);
+
+  vtkSMPTools::Initialize(0);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -41,11 +41,16 @@
 #include "vtkMultiPieceDataSet.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
+#include <algorithm>
 #include <ctime>
 #include <math.h>
 
@@ -70,6 +75,20 @@ vtkCxxSetObjectMacro(vtkAMRDualClip, Controller, vtkMultiProcessController);
 
 #include "vtkAMRDualClipTables.cxx"
 
+// Blocks are processed concurrently, each one into its own output.  Points
+// created by a block are numbered locally until the block is merged into the
+// filter output.  Locators store these local ids as -(id + 2) so they can be
+// told apart from output point ids shared by neighbors that were already
+// merged (>= 0) and from empty entries (-1).
+static inline vtkIdType vtkAMRDualClipEncodeLocalId(vtkIdType localId)
+{
+  return -localId - 2;
+}
+static inline vtkIdType vtkAMRDualClipResolvePointId(vtkIdType pointId, vtkIdType pointOffset)
+{
+  return (pointId < -1) ? pointOffset - pointId - 2 : pointId;
+}
+
 //============================================================================
 // Used separately for each block.
 // Has two locators  one for dual points (AMR cells), and one
@@ -122,8 +141,11 @@ public:
   // Used to share point ids between block locators.
   void SharePointIdsWithNeighbor(vtkAMRDualClipLocator* neighborLocator, int rx, int ry, int rz);
 
-  void ShareBlockLocatorWithNeighbor(
-    vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor);
+  // Description:
+  // Local point ids of the block are converted to output point ids by
+  // adding pointOffset.
+  void ShareBlockLocatorWithNeighbor(vtkAMRDualGridHelperBlock* block,
+    vtkAMRDualGridHelperBlock* neighbor, vtkIdType pointOffset);
 
   // The level mask could be a separate object, but it is used
   // by the locator to position points.
@@ -862,7 +884,7 @@ void vtkAMRDualClipLocator::SharePointIdsWithNeighbor(
 // Move the points on boundaries to neighbor locator so there will
 // not be duplicate coincident points between blocks.
 void vtkAMRDualClipLocator::ShareBlockLocatorWithNeighbor(
-  vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor)
+  vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor, vtkIdType pointOffset)
 {
   vtkAMRDualClipLocator* blockLocator = vtkAMRDualClipGetBlockLocator(block);
   vtkAMRDualClipLocator* neighborLocator = vtkAMRDualClipGetBlockLocator(neighbor);
@@ -987,22 +1009,22 @@ void vtkAMRDualClipLocator::ShareBlockLocatorWithNeighbor(
         }
         outOffsetX = outOffsetY + xOut;
 
-        pointId = blockLocator->XEdges[inOffsetX];
+        pointId = vtkAMRDualClipResolvePointId(blockLocator->XEdges[inOffsetX], pointOffset);
         if (pointId >= 0)
         {
           neighborLocator->XEdges[outOffsetX] = pointId;
         }
-        pointId = blockLocator->YEdges[inOffsetX];
+        pointId = vtkAMRDualClipResolvePointId(blockLocator->YEdges[inOffsetX], pointOffset);
         if (pointId >= 0)
         {
           neighborLocator->YEdges[outOffsetX] = pointId;
         }
-        pointId = blockLocator->ZEdges[inOffsetX];
+        pointId = vtkAMRDualClipResolvePointId(blockLocator->ZEdges[inOffsetX], pointOffset);
         if (pointId >= 0)
         {
           neighborLocator->ZEdges[outOffsetX] = pointId;
         }
-        pointId = blockLocator->Corners[inOffsetX];
+        pointId = vtkAMRDualClipResolvePointId(blockLocator->Corners[inOffsetX], pointOffset);
         if (pointId >= 0)
         {
           neighborLocator->Corners[outOffsetX] = pointId;
@@ -1016,6 +1038,163 @@ void vtkAMRDualClipLocator::ShareBlockLocatorWithNeighbor(
   }
 }
 
+//============================================================================
+// Output of a single block.  Points and attributes are numbered locally,
+// cells reference either local ids (encoded) or output ids of points shared
+// by neighbors.
+class vtkAMRDualClipBlockOutput
+{
+public:
+  vtkAMRDualClipBlockOutput(vtkAMRDualGridHelperBlock* block, int blockId)
+    : Block(block)
+    , BlockId(blockId)
+    , Locator(nullptr)
+    , PointOffset(0)
+  {
+  }
+
+  void Allocate(vtkCellData* attributes)
+  {
+    this->Mesh = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    this->Points = vtkSmartPointer<vtkPoints>::New();
+    this->Mesh->SetPoints(this->Points);
+    if (attributes)
+    {
+      this->Mesh->GetPointData()->CopyAllocate(attributes, 1024);
+    }
+    this->LevelMask = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  }
+
+  vtkAMRDualGridHelperBlock* Block;
+  int BlockId;
+  vtkAMRDualClipLocator* Locator;
+  vtkSmartPointer<vtkUnstructuredGrid> Mesh;
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkUnsignedCharArray> LevelMask;
+  // Point ids of the tetrahedra, 4 per cell.
+  std::vector<vtkIdType> Cells;
+  // Id of the first point of the block in the filter output.
+  vtkIdType PointOffset;
+};
+
+//----------------------------------------------------------------------------
+// Clips blocks concurrently.  When points are not merged between blocks,
+// each thread reuses one locator for all the blocks it processes.
+class vtkAMRDualClipBlockFunctor
+{
+public:
+  vtkAMRDualClipBlockFunctor(vtkAMRDualClip* self,
+    const std::vector<vtkAMRDualClipBlockOutput*>& outputs, const char* arrayName,
+    vtkCellData* attributes)
+    : Self(self)
+    , Outputs(outputs)
+    , ArrayName(arrayName)
+    , Attributes(attributes)
+  {
+  }
+
+  ~vtkAMRDualClipBlockFunctor()
+  {
+    for (auto iter = this->Locator.begin(); iter != this->Locator.end(); ++iter)
+    {
+      delete *iter;
+    }
+  }
+
+  void Initialize() { this->Locator.Local() = nullptr; }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      vtkAMRDualClipBlockOutput* output = this->Outputs[cc];
+      output->Allocate(this->Attributes);
+      if (!this->Self->EnableMergePoints)
+      {
+        vtkAMRDualClipLocator*& locator = this->Locator.Local();
+        if (locator == nullptr)
+        {
+          locator = new vtkAMRDualClipLocator;
+        }
+        output->Locator = locator;
+        this->Self->ProcessBlock(output, this->ArrayName);
+        output->Locator = nullptr;
+      }
+      else
+      {
+        this->Self->ProcessBlock(output, this->ArrayName);
+      }
+    }
+  }
+
+  void Reduce() {}
+
+private:
+  vtkAMRDualClip* Self;
+  const std::vector<vtkAMRDualClipBlockOutput*>& Outputs;
+  const char* ArrayName;
+  vtkCellData* Attributes;
+  vtkSMPThreadLocal<vtkAMRDualClipLocator*> Locator;
+};
+
+//----------------------------------------------------------------------------
+// Creates the locators of the given blocks and, if an array name is given,
+// computes the center region of their level mask.  Each block appears once,
+// so this can be done concurrently.
+class vtkAMRDualClipAllocateLocators
+{
+public:
+  vtkAMRDualClipAllocateLocators(const std::vector<vtkAMRDualGridHelperBlock*>& blocks,
+    const char* arrayName, double isoValue, int decimate)
+    : Blocks(blocks)
+    , ArrayName(arrayName)
+    , IsoValue(isoValue)
+    , Decimate(decimate)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      vtkAMRDualGridHelperBlock* block = this->Blocks[cc];
+      vtkAMRDualClipLocator* locator = vtkAMRDualClipGetBlockLocator(block);
+      if (locator == nullptr || this->ArrayName == nullptr)
+      {
+        continue;
+      }
+      vtkDataArray* scalars = block->Image->GetCellData()->GetArray(this->ArrayName);
+      if (scalars)
+      {
+        locator->ComputeLevelMask(scalars, this->IsoValue, this->Decimate);
+      }
+    }
+  }
+
+private:
+  const std::vector<vtkAMRDualGridHelperBlock*>& Blocks;
+  const char* ArrayName;
+  double IsoValue;
+  int Decimate;
+};
+
+//----------------------------------------------------------------------------
+// Cell attributes of the first block of the input.  Output point attributes
+// are allocated to match them.
+static vtkCellData* vtkAMRDualClipGetInputCellData(vtkNonOverlappingAMR* hbdsInput)
+{
+  vtkCompositeDataIterator* iter = hbdsInput->NewIterator();
+  iter->InitTraversal();
+  vtkCellData* cellData = nullptr;
+  if (!iter->IsDoneWithTraversal())
+  {
+    vtkUniformGrid* uGrid = vtkUniformGrid::SafeDownCast(iter->GetCurrentDataObject());
+    cellData = uGrid ? uGrid->GetCellData() : nullptr;
+  }
+  iter->Delete();
+  return cellData;
+}
+
 //============================================================================
 //----------------------------------------------------------------------------
 // Description:
@@ -1040,18 +1219,11 @@ vtkAMRDualClip::vtkAMRDualClip()
   this->LevelMaskPointArray = 0;
   this->BlockIdCellArray = 0;
   this->Helper = 0;
-
-  this->BlockLocator = 0;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualClip::~vtkAMRDualClip()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = 0;
-  }
   this->SetController(NULL);
 }
 
@@ -1207,14 +1379,50 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
   int numBlocks;
   int blockId;
 
-  // Add each block.
+  // Blocks of a pass are processed concurrently.  Without point merging,
+  // blocks are independent and a single pass is enough.  Otherwise blocks
+  // hand their level masks and point ids to unprocessed neighbors of the
+  // same or higher levels, so levels are processed in order, and each level
+  // is split in 8 passes by the parity of the grid index so that no two
+  // blocks of a pass are neighbors.
+  int numPasses = this->EnableMergePoints ? 8 * numLevels : 1;
+  std::vector<std::vector<vtkAMRDualClipBlockOutput*> > passes(numPasses);
   for (int level = 0; level < numLevels; ++level)
   {
     numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
     for (blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      int pass = 0;
+      if (this->EnableMergePoints)
+      {
+        pass = 8 * level + (block->GridIndex[0] & 1) + ((block->GridIndex[1] & 1) << 1) +
+          ((block->GridIndex[2] & 1) << 2);
+      }
+      passes[pass].push_back(new vtkAMRDualClipBlockOutput(block, blockId));
+    }
+  }
+
+  vtkCellData* attributes = vtkAMRDualClipGetInputCellData(hbdsInput);
+  for (int pass = 0; pass < numPasses; ++pass)
+  {
+    std::vector<vtkAMRDualClipBlockOutput*>& outputs = passes[pass];
+    if (this->EnableMergePoints)
+    {
+      this->PrepareLevelMasks(outputs);
+    }
+    this->ProcessBlocks(outputs, arrayNameToProcess, attributes);
+    for (size_t ii = 0; ii < outputs.size(); ++ii)
+    {
+      this->MergeBlockOutput(outputs[ii]);
+    }
+    if (this->EnableMergePoints)
+    {
+      this->ShareBlockLocatorsWithNeighbors(outputs);
+    }
+    for (size_t ii = 0; ii < outputs.size(); ++ii)
+    {
+      delete outputs[ii];
     }
   }
 
@@ -1256,7 +1464,131 @@ void vtkDualGridContourCastCornerValues(T* ptr, vtkIdType offsets[8], double val
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualClip::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block)
+void vtkAMRDualClip::ProcessBlocks(const std::vector<vtkAMRDualClipBlockOutput*>& outputs,
+  const char* arrayNameToProcess, vtkCellData* attributes)
+{
+  vtkAMRDualClipBlockFunctor functor(this, outputs, arrayNameToProcess, attributes);
+  // Blocks are large enough to be scheduled one at a time.
+  vtkSMPTools::For(0, static_cast<vtkIdType>(outputs.size()), 1, functor);
+}
+
+//----------------------------------------------------------------------------
+// Level masks of the blocks of a pass are initialized from the masks of
+// their unprocessed lower level neighbors.  Those are computed here, once
+// per neighbor, so that blocks of the pass only write their own locator.
+void vtkAMRDualClip::PrepareLevelMasks(const std::vector<vtkAMRDualClipBlockOutput*>& outputs)
+{
+  std::vector<vtkAMRDualGridHelperBlock*> blocks;
+  for (size_t ii = 0; ii < outputs.size(); ++ii)
+  {
+    vtkAMRDualGridHelperBlock* block = outputs[ii]->Block;
+    if (block->Image)
+    {
+      blocks.push_back(block);
+      this->GetUnprocessedLowerNeighbors(block, blocks);
+    }
+  }
+  std::sort(blocks.begin(), blocks.end());
+  blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+  vtkAMRDualClipAllocateLocators allocator(
+    blocks, this->Helper->GetArrayName(), this->IsoValue, this->EnableInternalDecimation);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), 1, allocator);
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClip::MergeBlockOutput(vtkAMRDualClipBlockOutput* output)
+{
+  output->PointOffset = this->Points->GetNumberOfPoints();
+  if (output->Mesh == nullptr)
+  {
+    return;
+  }
+
+  vtkIdType numPoints = output->Points->GetNumberOfPoints();
+  if (numPoints > 0)
+  {
+    this->Points->GetData()->InsertTuples(
+      output->PointOffset, numPoints, 0, output->Points->GetData());
+    this->Points->Modified();
+    this->LevelMaskPointArray->InsertTuples(
+      output->PointOffset, numPoints, 0, output->LevelMask);
+    // The output point data holds the level mask in addition to the arrays
+    // allocated from the input attributes, in the same order as the block.
+    vtkPointData* inPD = output->Mesh->GetPointData();
+    vtkPointData* outPD = this->Mesh->GetPointData();
+    int inArray = 0;
+    for (int ii = 0; ii < outPD->GetNumberOfArrays() && inArray < inPD->GetNumberOfArrays(); ++ii)
+    {
+      vtkAbstractArray* outArray = outPD->GetAbstractArray(ii);
+      if (outArray == this->LevelMaskPointArray)
+      {
+        continue;
+      }
+      outArray->InsertTuples(
+        output->PointOffset, numPoints, 0, inPD->GetAbstractArray(inArray++));
+    }
+  }
+
+  vtkIdType* cellPtr = output->Cells.data();
+  vtkIdType* cellEnd = cellPtr + output->Cells.size();
+  for (; cellPtr < cellEnd; cellPtr += 4)
+  {
+    for (int ii = 0; ii < 4; ++ii)
+    {
+      cellPtr[ii] = vtkAMRDualClipResolvePointId(cellPtr[ii], output->PointOffset);
+    }
+    this->Cells->InsertNextCell(4, cellPtr);
+    this->BlockIdCellArray->InsertNextValue(output->BlockId);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClip::ShareBlockLocatorsWithNeighbors(
+  const std::vector<vtkAMRDualClipBlockOutput*>& outputs)
+{
+  // Initializing the locators of the neighbors is the expensive part of
+  // sharing, so it is done concurrently first.
+  std::vector<vtkAMRDualGridHelperBlock*> neighbors;
+  for (size_t ii = 0; ii < outputs.size(); ++ii)
+  {
+    if (outputs[ii]->Locator)
+    {
+      this->GetUnprocessedNeighbors(outputs[ii]->Block, neighbors);
+    }
+  }
+  std::sort(neighbors.begin(), neighbors.end());
+  neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+  vtkAMRDualClipAllocateLocators allocator(neighbors, nullptr, this->IsoValue, 0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(neighbors.size()), 1, allocator);
+
+  for (size_t ii = 0; ii < outputs.size(); ++ii)
+  {
+    vtkAMRDualClipBlockOutput* output = outputs[ii];
+    if (output->Locator == nullptr)
+    {
+      continue;
+    }
+    vtkAMRDualGridHelperBlock* block = output->Block;
+    this->ShareLevelMask(block);
+    // Copy point ids into neighbor locators.
+    this->ShareBlockLocatorWithNeighbors(output);
+    // We are done.  We no longer need the locator for this block.
+    delete output->Locator;
+    output->Locator = nullptr;
+    block->UserData = 0;
+    // Lets use this unused flag (owner of center region/block) to indicate
+    // that the block is already processes.
+    // This will keep neighbors from recreating the locator.
+    // Another option would be to create the locator object for
+    // all blocks but do not allocate until needed.  Then the existence of the locator
+    // would tell whether the block was processed.
+    block->RegionBits[1][1][1] = 0;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClip::GetUnprocessedNeighbors(
+  vtkAMRDualGridHelperBlock* block, std::vector<vtkAMRDualGridHelperBlock*>& neighbors)
 {
   vtkAMRDualGridHelperBlock* neighbor;
   // Blocks are processed low level to high so, we only need to share
@@ -1292,8 +1624,7 @@ void vtkAMRDualClip::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* b
             // The unused center flag is used as a flag to indicate
             if (neighbor && neighbor->Image && neighbor->RegionBits[1][1][1])
             {
-              vtkAMRDualClipLocator* blockLocator = vtkAMRDualClipGetBlockLocator(block);
-              blockLocator->ShareBlockLocatorWithNeighbor(block, neighbor);
+              neighbors.push_back(neighbor);
             }
           }
         }
@@ -1303,28 +1634,15 @@ void vtkAMRDualClip::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* b
 }
 
 //----------------------------------------------------------------------------
-// This is called before we start processing a block to make sure
-// the locator is initialized in center and ghost regions.
-void vtkAMRDualClip::InitializeLevelMask(vtkAMRDualGridHelperBlock* block)
+// We need to check for neighbors in lower or equal
+// to our level.  When blocks from different levels share a border
+// the high level block always owns the shared region.
+// This can be vastly simpler.  Since neighbor is always a lower (or equal)
+// level, each face/edge/corner has at most one neighbor.
+void vtkAMRDualClip::GetUnprocessedLowerNeighbors(
+  vtkAMRDualGridHelperBlock* block, std::vector<vtkAMRDualGridHelperBlock*>& neighbors)
 {
-  vtkImageData* image = block->Image;
-  if (image == 0)
-  { // Remote blocks are only to setup local block bit flags.
-    return;
-  }
-  vtkDataArray* volumeFractionArray = image->GetCellData()->GetArray(this->Helper->GetArrayName());
-
-  vtkAMRDualClipLocator* locator = vtkAMRDualClipGetBlockLocator(block);
-  locator->ComputeLevelMask(volumeFractionArray, this->IsoValue, this->EnableInternalDecimation);
-
   vtkAMRDualGridHelperBlock* neighbor;
-  vtkAMRDualClipLocator* neighborLocator;
-
-  // We need to check for neighbors in lower or equal
-  // to our level.  When blocks from different levels share a border
-  // the high level block always owns the shared region.
-  // This can be vastly simpler.  Since neighbor is always a lower (or equal)
-  // level, each face/edge/corner has at most one neighbor.
   int xMid, yMid, zMid;
   int xMin, xMax, yMin, yMax, zMin, zMax;
 
@@ -1350,28 +1668,55 @@ void vtkAMRDualClip::InitializeLevelMask(vtkAMRDualGridHelperBlock* block)
         {
           if ((ix << levelDiff) != xMid || (iy << levelDiff) != yMid || (iz << levelDiff) != zMid)
           {
-            // I could further prune and only copy to regions I own.
             neighbor = this->Helper->GetBlock(level, ix, iy, iz);
             // If the neighbor was already processed, then its level mask
             // was copied to this block already.
-            if (neighbor && neighbor->RegionBits[1][1][1] != 0)
+            if (neighbor && neighbor->Image && neighbor->RegionBits[1][1][1] != 0)
             {
-              neighborLocator = vtkAMRDualClipGetBlockLocator(neighbor);
-              image = neighbor->Image;
-              if (image)
-              {
-                //                volumeFractionArray = this->GetInputArrayToProcess(0, image);
-                volumeFractionArray = image->GetCellData()->GetArray(this->Helper->GetArrayName());
-                neighborLocator->ComputeLevelMask(
-                  volumeFractionArray, this->IsoValue, this->EnableInternalDecimation);
-                locator->CopyNeighborLevelMask(block, neighbor);
-              }
+              neighbors.push_back(neighbor);
             }
           }
         }
       }
     }
   }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClip::ShareBlockLocatorWithNeighbors(vtkAMRDualClipBlockOutput* output)
+{
+  std::vector<vtkAMRDualGridHelperBlock*> neighbors;
+  this->GetUnprocessedNeighbors(output->Block, neighbors);
+  for (size_t ii = 0; ii < neighbors.size(); ++ii)
+  {
+    output->Locator->ShareBlockLocatorWithNeighbor(
+      output->Block, neighbors[ii], output->PointOffset);
+  }
+}
+
+//----------------------------------------------------------------------------
+// This is called before we start processing a block to make sure
+// the locator is initialized in center and ghost regions.
+void vtkAMRDualClip::InitializeLevelMask(vtkAMRDualGridHelperBlock* block)
+{
+  vtkImageData* image = block->Image;
+  if (image == 0)
+  { // Remote blocks are only to setup local block bit flags.
+    return;
+  }
+  vtkDataArray* volumeFractionArray = image->GetCellData()->GetArray(this->Helper->GetArrayName());
+
+  vtkAMRDualClipLocator* locator = vtkAMRDualClipGetBlockLocator(block);
+  locator->ComputeLevelMask(volumeFractionArray, this->IsoValue, this->EnableInternalDecimation);
+
+  // The level masks of the neighbors were computed by PrepareLevelMasks.
+  std::vector<vtkAMRDualGridHelperBlock*> neighbors;
+  this->GetUnprocessedLowerNeighbors(block, neighbors);
+  for (size_t ii = 0; ii < neighbors.size(); ++ii)
+  {
+    // I could further prune and only copy to regions I own.
+    locator->CopyNeighborLevelMask(block, neighbors[ii]);
+  }
 
   // Take care of boundary faces which have not been set.
   // Just reflect values over face normal
@@ -1406,58 +1751,23 @@ void vtkAMRDualClip::InitializeLevelMask(vtkAMRDualGridHelperBlock* block)
 // level mask with neighbors before we delete the locator.
 void vtkAMRDualClip::ShareLevelMask(vtkAMRDualGridHelperBlock* block)
 {
-  vtkAMRDualGridHelperBlock* neighbor;
-  vtkAMRDualClipLocator* neighborLocator;
-  int numLevels = this->Helper->GetNumberOfLevels();
-
-  // We need to check for neighbors in higher or equal
-  // to our level.  When blocks from different levels share a border
+  // When blocks from different levels share a border
   // the high level block always owns the shared region.
-  int xMid, yMid, zMid;
-  int xMin, xMax, yMin, yMax, zMin, zMax;
-
-  for (int level = block->Level; level < numLevels; ++level)
+  std::vector<vtkAMRDualGridHelperBlock*> neighbors;
+  this->GetUnprocessedNeighbors(block, neighbors);
+  for (size_t ii = 0; ii < neighbors.size(); ++ii)
   {
-    // Neighborhood.
-    int levelDiff = level - block->Level;
-    xMid = block->GridIndex[0];
-    xMin = (xMid << levelDiff) - 1;
-    xMax = (xMid + 1) << levelDiff;
-    yMid = block->GridIndex[1];
-    yMin = (yMid << levelDiff) - 1;
-    yMax = (yMid + 1) << levelDiff;
-    zMid = block->GridIndex[2];
-    zMin = (zMid << levelDiff) - 1;
-    zMax = (zMid + 1) << levelDiff;
-
-    for (int iz = zMin; iz <= zMax; ++iz)
-    {
-      for (int iy = yMin; iy <= yMax; ++iy)
-      {
-        for (int ix = xMin; ix <= xMax; ++ix)
-        {
-          if ((ix >> levelDiff) != xMid || (iy >> levelDiff) != yMid || (iz >> levelDiff) != zMid)
-          {
-            // I could further prune and only copy to regions owned by neighbor.
-            neighbor = this->Helper->GetBlock(level, ix, iy, iz);
-            // If the neighbor was already processed, then its level mask
-            // was copied to this block already.
-            if (neighbor && neighbor->Image && neighbor->RegionBits[1][1][1] != 0)
-            {
-              neighborLocator = vtkAMRDualClipGetBlockLocator(neighbor);
-              neighborLocator->CopyNeighborLevelMask(neighbor, block);
-            }
-          }
-        }
-      }
-    }
+    // I could further prune and only copy to regions owned by neighbor.
+    vtkAMRDualClipLocator* neighborLocator = vtkAMRDualClipGetBlockLocator(neighbors[ii]);
+    neighborLocator->CopyNeighborLevelMask(neighbors[ii], block);
   }
 }
 
 //----------------------------------------------------------------------------
 void vtkAMRDualClip::ProcessBlock(
-  vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
+  vtkAMRDualClipBlockOutput* output, const char* arrayNameToProcess)
 {
+  vtkAMRDualGridHelperBlock* block = output->Block;
   vtkImageData* image = block->Image;
   if (image == 0)
   { // Remote blocks are only to setup local block bit flags.
@@ -1489,17 +1799,13 @@ void vtkAMRDualClip::ProcessBlock(
   if (this->EnableMergePoints)
   {
     this->InitializeLevelMask(block);
-    this->BlockLocator = vtkAMRDualClipGetBlockLocator(block);
+    output->Locator = vtkAMRDualClipGetBlockLocator(block);
   }
   else
-  { // Shared locator.
-    if (this->BlockLocator == 0)
-    {
-      this->BlockLocator = new vtkAMRDualClipLocator;
-    }
-    this->BlockLocator->Initialize(
+  { // Locator shared by the blocks processed in this thread.
+    output->Locator->Initialize(
       extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    // this->BlockLocator->CopyRegionLevelDifferences(block);
+    // output->Locator->CopyRegionLevelDifferences(block);
   }
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
@@ -1575,7 +1881,7 @@ void vtkAMRDualClip::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + yInc + zInc;
           cornerOffsets[7] = xOffset + 1 + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(block, output, x, y, z, cornerOffsets, volumeFractionArray);
         }
         xOffset += 1; // xInc
       }
@@ -1584,30 +1890,16 @@ void vtkAMRDualClip::ProcessBlock(
     zOffset += zInc;
   }
 
-  if (this->EnableMergePoints)
-  {
-    this->ShareLevelMask(block);
-    // Copy point ids into neighbor locators.
-    this->ShareBlockLocatorWithNeighbors(block);
-    // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = 0;
-    block->UserData = 0;
-    // Lets use this unused flag (owner of center region/block) to indicate
-    // that the block is already processes.
-    // This will keep neighbors from recreating the locator.
-    // Another option would be to create the locator object for
-    // all blocks but do not allocate until needed.  Then the existence of the locator
-    // would tell whether the block was processed.
-    block->RegionBits[1][1][1] = 0;
-  }
+  // Level masks and point ids are shared with the neighbors once the block
+  // is merged, see ShareBlockLocatorsWithNeighbors.
 }
 
 //----------------------------------------------------------------------------
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
-void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block,
+  vtkAMRDualClipBlockOutput* output, int x, int y, int z, vtkIdType cornerOffsets[8],
+  vtkDataArray* volumeFractionArray)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1835,8 +2127,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
       // convert from VTK corner ids to bit (x,y,z) corner ids.
       if (casePtId < 8)
       { // Corner (internal point)
-        ptIdPtr = this->BlockLocator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
-        levelMaskValue = this->BlockLocator->GetLevelMaskValue(
+        ptIdPtr = output->Locator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
+        levelMaskValue = output->Locator->GetLevelMaskValue(
           x + ((casePtId & 1) ? 1 : 0), y + ((casePtId & 2) ? 1 : 0), z + ((casePtId & 4) ? 1 : 0));
         if (levelMaskValue == 0)
         { // bug !!!!! trying to figure out what is going on.
@@ -1888,7 +2180,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           pt[0] = origin[0] + spacing[0] * (double)(1 << levelDiff) * ((double)(px) + dx);
           pt[1] = origin[1] + spacing[1] * (double)(1 << levelDiff) * ((double)(py) + dy);
           pt[2] = origin[2] + spacing[2] * (double)(1 << levelDiff) * ((double)(pz) + dz);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          vtkIdType localId = output->Points->InsertNextPoint(pt);
+          *ptIdPtr = vtkAMRDualClipEncodeLocalId(localId);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1902,14 +2195,14 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Averaging could be a pre processing step but we would have to modify input attributes
           // .......
           vtkIdType offset = cornerOffsets[casePtId];
-          this->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, *ptIdPtr);
+          output->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, localId);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          output->LevelMask->InsertNextValue(levelMaskValue);
         }
       }
       else
       { // Edge (clipped cell, point on iso surface)
-        ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, casePtId - 8);
+        ptIdPtr = output->Locator->GetEdgePointer(x, y, z, casePtId - 8);
         if (*ptIdPtr == -1)
         {
           int edge = casePtId - 8;
@@ -1926,7 +2219,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
             cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
           pt[2] =
             cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          vtkIdType localId = output->Points->InsertNextPoint(pt);
+          *ptIdPtr = vtkAMRDualClipEncodeLocalId(localId);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1936,10 +2230,10 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Find the offsets of the two attributes to interpolate
           vtkIdType offset0 = cornerOffsets[pt1Idx >> 2];
           vtkIdType offset1 = cornerOffsets[pt2Idx >> 2];
-          this->Mesh->GetPointData()->InterpolateEdge(
-            block->Image->GetCellData(), *ptIdPtr, offset0, offset1, k);
+          output->Mesh->GetPointData()->InterpolateEdge(
+            block->Image->GetCellData(), localId, offset0, offset1, k);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          output->LevelMask->InsertNextValue(levelMaskValue);
         }
       }
       pointIds[ii] = *ptIdPtr;
@@ -1947,8 +2241,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[0] != pointIds[3] &&
       pointIds[1] != pointIds[2] && pointIds[1] != pointIds[3] && pointIds[2] != pointIds[3])
     {
-      this->Cells->InsertNextCell(4, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      output->Cells.insert(output->Cells.end(), pointIds, pointIds + 4);
     }
   }
 }
@@ -21,6 +21,12 @@
  * transitions are handled correctly, and second is that internal
  * cells are decimated.  I use a variation of degenerate points/cells
  * used for level transitions.
+ *
+ * Blocks are clipped concurrently using vtkSMPTools, each one into its own
+ * output which is then appended to the filter output.  When points are
+ * merged, lower levels are still processed before higher levels, and
+ * neighboring blocks of a level are never processed at the same time, so that
+ * point ids and level masks can be shared across block boundaries.
 */
 
 #ifndef vtkAMRDualClip_h
@@ -28,6 +34,7 @@
 
 #include "vtkMultiBlockDataSetAlgorithm.h"
 #include "vtkPVVTKExtensionsAMRModule.h" //needed for exports
+#include <vector>                          // needed for std::vector
 
 class vtkDataSet;
 class vtkImageData;
@@ -47,6 +54,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualClipLocator;
+class vtkAMRDualClipBlockOutput;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualClip : public vtkMultiBlockDataSetAlgorithm
 {
@@ -116,12 +124,48 @@ protected:
   int FillInputPortInformation(int port, vtkInformation* info) override;
   int FillOutputPortInformation(int port, vtkInformation* info) override;
 
-  void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
+  /**
+   * Clips the given blocks concurrently, each one into its own output.
+   */
+  void ProcessBlocks(const std::vector<vtkAMRDualClipBlockOutput*>& outputs,
+    const char* arrayName, vtkCellData* attributes);
+
+  /**
+   * Computes the center of the level masks the given blocks depend on, so
+   * that the blocks can then be processed concurrently.
+   */
+  void PrepareLevelMasks(const std::vector<vtkAMRDualClipBlockOutput*>& outputs);
+
+  /**
+   * Appends the points, attributes and cells of a block to the output mesh.
+   * Point ids local to the block are resolved to output point ids.
+   */
+  void MergeBlockOutput(vtkAMRDualClipBlockOutput* output);
+
+  /**
+   * Copies the level masks and point ids of the blocks, once merged, into
+   * their neighbors that have not been processed yet, then releases the
+   * locators of the blocks.
+   */
+  void ShareBlockLocatorsWithNeighbors(const std::vector<vtkAMRDualClipBlockOutput*>& outputs);
+
+  //@{
+  /**
+   * Neighbors, in the same or higher (resp. lower) levels, that have not
+   * been processed yet.
+   */
+  void GetUnprocessedNeighbors(
+    vtkAMRDualGridHelperBlock* block, std::vector<vtkAMRDualGridHelperBlock*>& neighbors);
+  void GetUnprocessedLowerNeighbors(
+    vtkAMRDualGridHelperBlock* block, std::vector<vtkAMRDualGridHelperBlock*>& neighbors);
+  //@}
+
+  void ShareBlockLocatorWithNeighbors(vtkAMRDualClipBlockOutput* output);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  void ProcessBlock(vtkAMRDualClipBlockOutput* output, const char* arrayName);
 
-  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, vtkAMRDualClipBlockOutput* output, int x,
+    int y, int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
 
   void InitializeLevelMask(vtkAMRDualGridHelperBlock* block);
   void ShareLevelMask(vtkAMRDualGridHelperBlock* block);
@@ -148,9 +192,9 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualClipLocator* BlockLocator;
-
 private:
+  friend class vtkAMRDualClipBlockFunctor;
+
   vtkAMRDualClip(const vtkAMRDualClip&) = delete;
   void operator=(const vtkAMRDualClip&) = delete;
 };
@@ -40,10 +40,15 @@
 #include "vtkMultiPieceDataSet.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
+#include <algorithm>
 #include <ctime>
 #include <math.h>
 
@@ -56,6 +61,20 @@ static int vtkAMRDualIsoEdgeToPointsTable[12][2] = { { 0, 1 }, { 1, 3 }, { 2, 3
 static int vtkAMRDualIsoEdgeToVTKPointsTable[12][2] = { { 0, 1 }, { 1, 2 }, { 3, 2 }, { 0, 3 },
   { 4, 5 }, { 5, 6 }, { 7, 6 }, { 4, 7 }, { 0, 4 }, { 1, 5 }, { 3, 7 }, { 2, 6 } };
 
+// Blocks are processed concurrently, each one into its own output.  Points
+// created by a block are numbered locally until the block is merged into the
+// filter output.  Locators store these local ids as -(id + 2) so they can be
+// told apart from output point ids shared by neighbors that were already
+// merged (>= 0) and from empty entries (-1).
+static inline vtkIdType vtkAMRDualContourEncodeLocalId(vtkIdType localId)
+{
+  return -localId - 2;
+}
+static inline vtkIdType vtkAMRDualContourResolvePointId(vtkIdType pointId, vtkIdType pointOffset)
+{
+  return (pointId < -1) ? pointOffset - pointId - 2 : pointId;
+}
+
 // It is working but we have some missing features.
 // 1: Make a Clip Filter
 // 2: Merge points.
@@ -100,8 +119,11 @@ public:
   void SharePointIdsWithNeighbor(
     vtkAMRDualContourEdgeLocator* neighborLocator, int rx, int ry, int rz);
 
-  void ShareBlockLocatorWithNeighbor(
-    vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor);
+  // Description:
+  // Local point ids of the block are converted to output point ids by
+  // adding pointOffset.
+  void ShareBlockLocatorWithNeighbor(vtkAMRDualGridHelperBlock* block,
+    vtkAMRDualGridHelperBlock* neighbor, vtkIdType pointOffset);
 
 private:
   int DualCellDimensions[3];
@@ -460,7 +482,7 @@ vtkAMRDualContourEdgeLocator* vtkAMRDualContourGetBlockLocator(vtkAMRDualGridHel
 //----------------------------------------------------------------------------
 // This version works with higher level neighbor blocks.
 void vtkAMRDualContourEdgeLocator::ShareBlockLocatorWithNeighbor(
-  vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor)
+  vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor, vtkIdType pointOffset)
 {
   vtkAMRDualContourEdgeLocator* blockLocator = vtkAMRDualContourGetBlockLocator(block);
   vtkAMRDualContourEdgeLocator* neighborLocator = vtkAMRDualContourGetBlockLocator(neighbor);
@@ -579,22 +601,22 @@ void vtkAMRDualContourEdgeLocator::ShareBlockLocatorWithNeighbor(
         }
         outOffsetX = outOffsetY + xOut;
 
-        pointId = blockLocator->XEdges[inOffsetX];
+        pointId = vtkAMRDualContourResolvePointId(blockLocator->XEdges[inOffsetX], pointOffset);
         if (pointId >= 0)
         {
           neighborLocator->XEdges[outOffsetX] = pointId;
         }
-        pointId = blockLocator->YEdges[inOffsetX];
+        pointId = vtkAMRDualContourResolvePointId(blockLocator->YEdges[inOffsetX], pointOffset);
         if (pointId >= 0)
         {
           neighborLocator->YEdges[outOffsetX] = pointId;
         }
-        pointId = blockLocator->ZEdges[inOffsetX];
+        pointId = vtkAMRDualContourResolvePointId(blockLocator->ZEdges[inOffsetX], pointOffset);
         if (pointId >= 0)
         {
           neighborLocator->ZEdges[outOffsetX] = pointId;
         }
-        pointId = blockLocator->Corners[inOffsetX];
+        pointId = vtkAMRDualContourResolvePointId(blockLocator->Corners[inOffsetX], pointOffset);
         if (pointId >= 0)
         {
           neighborLocator->Corners[outOffsetX] = pointId;
@@ -608,6 +630,149 @@ void vtkAMRDualContourEdgeLocator::ShareBlockLocatorWithNeighbor(
   }
 }
 
+//============================================================================
+// Output of a single block.  Points and attributes are numbered locally,
+// faces reference either local ids (encoded) or output ids of points shared
+// by neighbors.
+class vtkAMRDualContourBlockOutput
+{
+public:
+  vtkAMRDualContourBlockOutput(vtkAMRDualGridHelperBlock* block, int blockId)
+    : Block(block)
+    , BlockId(blockId)
+    , Locator(nullptr)
+    , PointOffset(0)
+  {
+  }
+
+  void Allocate(vtkCellData* attributes)
+  {
+    this->Mesh = vtkSmartPointer<vtkPolyData>::New();
+    this->Points = vtkSmartPointer<vtkPoints>::New();
+    this->Mesh->SetPoints(this->Points);
+    if (attributes)
+    {
+      this->Mesh->GetPointData()->CopyAllocate(attributes, 1024);
+    }
+  }
+
+  void InsertNextCell(vtkIdType npts, const vtkIdType* pts)
+  {
+    this->Cells.push_back(npts);
+    this->Cells.insert(this->Cells.end(), pts, pts + npts);
+  }
+
+  vtkAMRDualGridHelperBlock* Block;
+  int BlockId;
+  vtkAMRDualContourEdgeLocator* Locator;
+  vtkSmartPointer<vtkPolyData> Mesh;
+  vtkSmartPointer<vtkPoints> Points;
+  // Faces, in the (npts, ids...) legacy layout.
+  std::vector<vtkIdType> Cells;
+  // Id of the first point of the block in the filter output.
+  vtkIdType PointOffset;
+};
+
+//----------------------------------------------------------------------------
+// Contours blocks concurrently.  When points are not merged between blocks,
+// each thread reuses one locator for all the blocks it processes.
+class vtkAMRDualContourBlockFunctor
+{
+public:
+  vtkAMRDualContourBlockFunctor(vtkAMRDualContour* self,
+    const std::vector<vtkAMRDualContourBlockOutput*>& outputs, const char* arrayName,
+    vtkCellData* attributes)
+    : Self(self)
+    , Outputs(outputs)
+    , ArrayName(arrayName)
+    , Attributes(attributes)
+  {
+  }
+
+  ~vtkAMRDualContourBlockFunctor()
+  {
+    for (auto iter = this->Locator.begin(); iter != this->Locator.end(); ++iter)
+    {
+      delete *iter;
+    }
+  }
+
+  void Initialize() { this->Locator.Local() = nullptr; }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      vtkAMRDualContourBlockOutput* output = this->Outputs[cc];
+      output->Allocate(this->Attributes);
+      if (!this->Self->EnableMergePoints)
+      {
+        vtkAMRDualContourEdgeLocator*& locator = this->Locator.Local();
+        if (locator == nullptr)
+        {
+          locator = new vtkAMRDualContourEdgeLocator;
+        }
+        output->Locator = locator;
+        this->Self->ProcessBlock(output, this->ArrayName);
+        output->Locator = nullptr;
+      }
+      else
+      {
+        this->Self->ProcessBlock(output, this->ArrayName);
+      }
+    }
+  }
+
+  void Reduce() {}
+
+private:
+  vtkAMRDualContour* Self;
+  const std::vector<vtkAMRDualContourBlockOutput*>& Outputs;
+  const char* ArrayName;
+  vtkCellData* Attributes;
+  vtkSMPThreadLocal<vtkAMRDualContourEdgeLocator*> Locator;
+};
+
+//----------------------------------------------------------------------------
+// Creates the locators of neighbor blocks before point ids are shared with
+// them.  Each block appears once, so locators can be initialized concurrently.
+class vtkAMRDualContourAllocateLocators
+{
+public:
+  vtkAMRDualContourAllocateLocators(const std::vector<vtkAMRDualGridHelperBlock*>& blocks)
+    : Blocks(blocks)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      vtkAMRDualContourGetBlockLocator(this->Blocks[cc]);
+    }
+  }
+
+private:
+  const std::vector<vtkAMRDualGridHelperBlock*>& Blocks;
+};
+
+//----------------------------------------------------------------------------
+// Cell attributes of the first block of the input.  Output point attributes
+// are allocated to match them.
+static vtkCellData* vtkAMRDualContourGetInputCellData(vtkNonOverlappingAMR* hbdsInput)
+{
+  vtkCompositeDataIterator* iter = hbdsInput->NewIterator();
+  iter->InitTraversal();
+  vtkCellData* cellData = nullptr;
+  if (!iter->IsDoneWithTraversal())
+  {
+    vtkUniformGrid* uGrid = vtkUniformGrid::SafeDownCast(iter->GetCurrentDataObject());
+    cellData = uGrid ? uGrid->GetCellData() : nullptr;
+  }
+  iter->Delete();
+  return cellData;
+}
+
 //============================================================================
 //----------------------------------------------------------------------------
 // Description:
@@ -633,18 +798,11 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->TemperatureArray = 0;
   this->BlockIdCellArray = 0;
   this->Helper = 0;
-
-  this->BlockLocator = 0;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualContour::~vtkAMRDualContour()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = 0;
-  }
   this->SetController(NULL);
 }
 
@@ -809,14 +967,46 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
   // Loop through blocks
   int numLevels = hbdsInput->GetNumberOfLevels();
 
-  // Add each block.
+  // Blocks of a pass are processed concurrently.  Without point merging,
+  // blocks are independent and a single pass is enough.  Otherwise blocks
+  // hand their point ids to unprocessed neighbors of the same or higher
+  // levels, so levels are processed in order, and each level is split in 8
+  // passes by the parity of the grid index so that no two blocks of a pass
+  // are neighbors.
+  int numPasses = this->EnableMergePoints ? 8 * numLevels : 1;
+  std::vector<std::vector<vtkAMRDualContourBlockOutput*> > passes(numPasses);
   for (int level = 0; level < numLevels; ++level)
   {
     int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
     for (int blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      int pass = 0;
+      if (this->EnableMergePoints)
+      {
+        pass = 8 * level + (block->GridIndex[0] & 1) + ((block->GridIndex[1] & 1) << 1) +
+          ((block->GridIndex[2] & 1) << 2);
+      }
+      passes[pass].push_back(new vtkAMRDualContourBlockOutput(block, blockId));
+    }
+  }
+
+  vtkCellData* attributes = vtkAMRDualContourGetInputCellData(hbdsInput);
+  for (int pass = 0; pass < numPasses; ++pass)
+  {
+    std::vector<vtkAMRDualContourBlockOutput*>& outputs = passes[pass];
+    this->ProcessBlocks(outputs, arrayNameToProcess, attributes);
+    for (size_t ii = 0; ii < outputs.size(); ++ii)
+    {
+      this->MergeBlockOutput(outputs[ii]);
+    }
+    if (this->EnableMergePoints)
+    {
+      this->ShareBlockLocatorsWithNeighbors(outputs);
+    }
+    for (size_t ii = 0; ii < outputs.size(); ++ii)
+    {
+      delete outputs[ii];
     }
   }
 
@@ -837,7 +1027,101 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block)
+void vtkAMRDualContour::ProcessBlocks(const std::vector<vtkAMRDualContourBlockOutput*>& outputs,
+  const char* arrayNameToProcess, vtkCellData* attributes)
+{
+  vtkAMRDualContourBlockFunctor functor(this, outputs, arrayNameToProcess, attributes);
+  // Blocks are large enough to be scheduled one at a time.
+  vtkSMPTools::For(0, static_cast<vtkIdType>(outputs.size()), 1, functor);
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::MergeBlockOutput(vtkAMRDualContourBlockOutput* output)
+{
+  output->PointOffset = this->Points->GetNumberOfPoints();
+  if (output->Mesh == nullptr)
+  {
+    return;
+  }
+
+  vtkIdType numPoints = output->Points->GetNumberOfPoints();
+  if (numPoints > 0)
+  {
+    this->Points->GetData()->InsertTuples(
+      output->PointOffset, numPoints, 0, output->Points->GetData());
+    this->Points->Modified();
+    // Both were allocated from the same input attributes, so arrays match.
+    vtkPointData* inPD = output->Mesh->GetPointData();
+    vtkPointData* outPD = this->Mesh->GetPointData();
+    int numArrays = std::min(inPD->GetNumberOfArrays(), outPD->GetNumberOfArrays());
+    for (int ii = 0; ii < numArrays; ++ii)
+    {
+      outPD->GetAbstractArray(ii)->InsertTuples(
+        output->PointOffset, numPoints, 0, inPD->GetAbstractArray(ii));
+    }
+  }
+
+  vtkIdType* cellPtr = output->Cells.data();
+  vtkIdType* cellEnd = cellPtr + output->Cells.size();
+  while (cellPtr < cellEnd)
+  {
+    vtkIdType npts = *cellPtr++;
+    for (vtkIdType ii = 0; ii < npts; ++ii)
+    {
+      cellPtr[ii] = vtkAMRDualContourResolvePointId(cellPtr[ii], output->PointOffset);
+    }
+    this->Faces->InsertNextCell(npts, cellPtr);
+    this->BlockIdCellArray->InsertNextValue(output->BlockId);
+    cellPtr += npts;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::ShareBlockLocatorsWithNeighbors(
+  const std::vector<vtkAMRDualContourBlockOutput*>& outputs)
+{
+  // Initializing the locators of the neighbors is the expensive part of
+  // sharing, so it is done concurrently first.
+  std::vector<vtkAMRDualGridHelperBlock*> neighbors;
+  for (size_t ii = 0; ii < outputs.size(); ++ii)
+  {
+    if (outputs[ii]->Locator)
+    {
+      this->GetUnprocessedNeighbors(outputs[ii]->Block, neighbors);
+    }
+  }
+  std::sort(neighbors.begin(), neighbors.end());
+  neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+  vtkAMRDualContourAllocateLocators allocator(neighbors);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(neighbors.size()), 1, allocator);
+
+  for (size_t ii = 0; ii < outputs.size(); ++ii)
+  {
+    vtkAMRDualContourBlockOutput* output = outputs[ii];
+    if (output->Locator == nullptr)
+    {
+      continue;
+    }
+    vtkAMRDualGridHelperBlock* block = output->Block;
+    // Copy point ids into neighbor locators.
+    this->ShareBlockLocatorWithNeighbors(output);
+    // We are done.  We no longer need the locator for this block.
+    delete output->Locator;
+    output->Locator = nullptr;
+    block->UserData = 0;
+    // Lets use this unused flag (owner of center region/block) to indicate
+    // that the block is already processes.
+    // This will keep neighbors from recreating the locator.
+    // Another option would be to create the locator object for
+    // all blocks but do not allocate until needed.  Then the existence of the locator
+    // would tell whether the block was processed.
+    block->RegionBits[1][1][1] = 0;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::GetUnprocessedNeighbors(
+  vtkAMRDualGridHelperBlock* block, std::vector<vtkAMRDualGridHelperBlock*>& neighbors)
 {
   vtkAMRDualGridHelperBlock* neighbor;
   // Blocks are processed low level to high so, we only need to share
@@ -873,8 +1157,7 @@ void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock
             // The unused center flag is used as a flag to indicate
             if (neighbor && neighbor->Image && neighbor->RegionBits[1][1][1])
             {
-              vtkAMRDualContourEdgeLocator* blockLocator = vtkAMRDualContourGetBlockLocator(block);
-              blockLocator->ShareBlockLocatorWithNeighbor(block, neighbor);
+              neighbors.push_back(neighbor);
             }
           }
         }
@@ -883,10 +1166,23 @@ void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualContourBlockOutput* output)
+{
+  std::vector<vtkAMRDualGridHelperBlock*> neighbors;
+  this->GetUnprocessedNeighbors(output->Block, neighbors);
+  for (size_t ii = 0; ii < neighbors.size(); ++ii)
+  {
+    output->Locator->ShareBlockLocatorWithNeighbor(
+      output->Block, neighbors[ii], output->PointOffset);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkAMRDualContour::ProcessBlock(
-  vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
+  vtkAMRDualContourBlockOutput* output, const char* arrayNameToProcess)
 {
+  vtkAMRDualGridHelperBlock* block = output->Block;
   vtkImageData* image = block->Image;
   if (image == 0)
   { // Remote blocks are only to setup local block bit flags.
@@ -916,17 +1212,13 @@ void vtkAMRDualContour::ProcessBlock(
   // Input the dimensions of the dual cells with ghosts.
   if (this->EnableMergePoints)
   {
-    this->BlockLocator = vtkAMRDualContourGetBlockLocator(block);
+    output->Locator = vtkAMRDualContourGetBlockLocator(block);
   }
   else
-  { // Shared locator.
-    if (this->BlockLocator == 0)
-    {
-      this->BlockLocator = new vtkAMRDualContourEdgeLocator;
-    }
-    this->BlockLocator->Initialize(
+  { // Locator shared by the blocks processed in this thread.
+    output->Locator->Initialize(
       extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    this->BlockLocator->CopyRegionLevelDifferences(block);
+    output->Locator->CopyRegionLevelDifferences(block);
   }
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
@@ -1007,7 +1299,7 @@ void vtkAMRDualContour::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + 1 + yInc + zInc;
           cornerOffsets[7] = xOffset + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(block, output, x, y, z, cornerOffsets, volumeFractionArray);
         }
         xOffset += 1; // xInc
       }
@@ -1015,23 +1307,8 @@ void vtkAMRDualContour::ProcessBlock(
     }
     zOffset += zInc;
   }
-
-  if (this->EnableMergePoints)
-  {
-    // Copy point ids into neighbor locators.
-    this->ShareBlockLocatorWithNeighbors(block);
-    // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = 0;
-    block->UserData = 0;
-    // Lets use this unused flag (owner of center region/block) to indicate
-    // that the block is already processes.
-    // This will keep neighbors from recreating the locator.
-    // Another option would be to create the locator object for
-    // all blocks but do not allocate until needed.  Then the existence of the locator
-    // would tell whether the block was processed.
-    block->RegionBits[1][1][1] = 0;
-  }
+  // With point merging, the locator is shared with neighbors once the
+  // block is merged (see ShareBlockLocatorsWithNeighbors).
 }
 
 //----------------------------------------------------------------------------
@@ -1091,8 +1368,9 @@ static int vtkAMRDualLegacyIdToBitIdMap[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
 // Corner offsets are absolute (relative to origin / 0).
-void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block,
+  vtkAMRDualContourBlockOutput* output, int x, int y, int z, vtkIdType cornerOffsets[8],
+  vtkDataArray* volumeFractionArray)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1329,7 +1607,7 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
     // Only permanently keep locator for edges shared between two blocks.
     for (int ii = 0; ii < 3; ++ii, ++edge) // insert triangle
     {
-      vtkIdType* ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, *edge);
+      vtkIdType* ptIdPtr = output->Locator->GetEdgePointer(x, y, z, *edge);
 
       if (*ptIdPtr == -1)
       {
@@ -1357,31 +1635,32 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
           cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
         pt[2] =
           cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-        *ptIdPtr = this->Points->InsertNextPoint(pt);
+        vtkIdType localId = output->Points->InsertNextPoint(pt);
+        *ptIdPtr = vtkAMRDualContourEncodeLocalId(localId);
         // Interpolate attributes
         // Find the offsets of the two attributes to interpolate
         vtkIdType offset0 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][0]];
         vtkIdType offset1 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][1]];
-        this->InterpolateAttributes(block->Image, offset0, offset1, k, this->Mesh, *ptIdPtr);
+        this->InterpolateAttributes(block->Image, offset0, offset1, k, output->Mesh, localId);
       }
       edgePointIds[*edge] = pointIds[ii] = *ptIdPtr;
     }
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[1] != pointIds[2])
     {
-      this->Faces->InsertNextCell(3, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      output->InsertNextCell(3, pointIds);
     }
   }
 
   if (this->EnableCapping)
   {
     this->CapCell(x, y, z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints, cornerOffsets,
-      blockId, block->Image);
+      output, block->Image);
   }
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId)
+void vtkAMRDualContour::AddCapPolygon(
+  int ptCount, vtkIdType* pointIds, vtkAMRDualContourBlockOutput* output)
 {
   if (this->TriangulateCap)
   {
@@ -1397,8 +1676,7 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          output->InsertNextCell(3, tri);
         }
       }
       else
@@ -1408,16 +1686,14 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          output->InsertNextCell(3, tri);
         }
         tri[0] = pointIds[high];
         tri[1] = pointIds[high + 1];
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          output->InsertNextCell(3, tri);
         }
       }
       ++low;
@@ -1427,8 +1703,7 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
   else
   {
     // Do not worry about degenerate polygons in this path.
-    this->Faces->InsertNextCell(ptCount, pointIds);
-    this->BlockIdCellArray->InsertNextValue(blockId);
+    output->InsertNextCell(ptCount, pointIds);
   }
 }
 
@@ -1450,8 +1725,8 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
   double cornerPoints[32],
   // The id order is VTK from marching cube cases.  Different than axis ordered "cornerPoints".
   vtkIdType cornerOffsets[8],
-  // For block id array (for debugging).  I should just make this an ivar.
-  int blockId,
+  // Output of the block (points, faces and locator).
+  vtkAMRDualContourBlockOutput* output,
   // For passing attributes to output mesh
   vtkDataSet* inData)
 {
@@ -1472,12 +1747,13 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType localId = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = vtkAMRDualContourEncodeLocalId(localId);
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1487,7 +1763,7 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1508,12 +1784,13 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType localId = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = vtkAMRDualContourEncodeLocalId(localId);
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1523,7 +1800,7 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1545,12 +1822,13 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType localId = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = vtkAMRDualContourEncodeLocalId(localId);
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1560,7 +1838,7 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1582,12 +1860,13 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType localId = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = vtkAMRDualContourEncodeLocalId(localId);
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1597,7 +1876,7 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1618,12 +1897,13 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType localId = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = vtkAMRDualContourEncodeLocalId(localId);
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1633,7 +1913,7 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1655,12 +1935,13 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType localId = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = vtkAMRDualContourEncodeLocalId(localId);
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1670,7 +1951,7 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, output);
       if (*capPtr == -1)
       {
         ++capPtr;
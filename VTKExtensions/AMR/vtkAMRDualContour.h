@@ -21,6 +21,12 @@
  * a particle index as part of the cell data of the output.  It computes
  * the volume of each particle from the volume fraction.
  *
+ * Blocks are contoured concurrently using vtkSMPTools, each one into its own
+ * output which is then appended to the filter output.  When points are
+ * merged, lower levels are still processed before higher levels, and
+ * neighboring blocks of a level are never processed at the same time, so that
+ * point ids can be shared across block boundaries.
+ *
  * This will turn on validation and debug i/o of the filter.
  * \code{.cpp}
  * #define vtkAMRDualContourDEBUG
@@ -54,6 +60,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualContourEdgeLocator;
+class vtkAMRDualContourBlockOutput;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualContour : public vtkMultiBlockDataSetAlgorithm
 {
@@ -152,14 +159,36 @@ protected:
   int FillInputPortInformation(int port, vtkInformation* info) override;
   int FillOutputPortInformation(int port, vtkInformation* info) override;
 
-  void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
+  /**
+   * Contours the given blocks concurrently, each one into its own output.
+   */
+  void ProcessBlocks(const std::vector<vtkAMRDualContourBlockOutput*>& outputs,
+    const char* arrayName, vtkCellData* attributes);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  /**
+   * Appends the points, attributes and faces of a block to the output mesh.
+   * Point ids local to the block are resolved to output point ids.
+   */
+  void MergeBlockOutput(vtkAMRDualContourBlockOutput* output);
 
-  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+  /**
+   * Copies the point ids of the blocks, once merged, into the locators of
+   * their neighbors that have not been processed yet, then releases the
+   * locators of the blocks.
+   */
+  void ShareBlockLocatorsWithNeighbors(const std::vector<vtkAMRDualContourBlockOutput*>& outputs);
 
-  void AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId);
+  void GetUnprocessedNeighbors(
+    vtkAMRDualGridHelperBlock* block, std::vector<vtkAMRDualGridHelperBlock*>& neighbors);
+
+  void ShareBlockLocatorWithNeighbors(vtkAMRDualContourBlockOutput* output);
+
+  void ProcessBlock(vtkAMRDualContourBlockOutput* output, const char* arrayName);
+
+  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, vtkAMRDualContourBlockOutput* output,
+    int x, int y, int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+
+  void AddCapPolygon(int ptCount, vtkIdType* pointIds, vtkAMRDualContourBlockOutput* output);
 
   // This method is getting too many arguments!
   // Capping was an after thought...
@@ -174,8 +203,8 @@ protected:
     double cornerPoints[32],
     // The id order is VTK from marching cube cases.  Different than axis ordered "cornerPoints".
     vtkIdType cornerOffsets[8],
-    // For block id array (for debugging).  I should just make this an ivar.
-    int blockId,
+    // Output of the block (points, faces and locator).
+    vtkAMRDualContourBlockOutput* output,
     // For passing attributes to output mesh
     vtkDataSet* inData);
 
@@ -196,8 +225,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualContourEdgeLocator* BlockLocator;
-
   // Stuff for passing cell attributes to point attributes.
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
   void InterpolateAttributes(vtkDataSet* uGrid, vtkIdType offset0, vtkIdType offset1, double k,
@@ -206,6 +233,8 @@ protected:
   void FinalizeCopyAttributes(vtkDataSet* mesh);
 
 private:
+  friend class vtkAMRDualContourBlockFunctor;
+
   vtkAMRDualContour(const vtkAMRDualContour&) = delete;
   void operator=(const vtkAMRDualContour&) = delete;
 };
@@ -77,6 +77,36 @@ int TestCGNSReaderMeshCaching(int argc, char* argv[])
 
   // Check Mesh Data pointer did not change between loadings
   vtk_assert(da == db);
+  vtk_assert(reader->GetCacheHits() > 0);
+  vtk_assert(vtkCGNSReader::GetCacheMemorySize() > 0);
+
+  // Readers in the same cache group share cached entries
+  reader->SetCacheGroupName("TestCGNSReaderMeshCaching");
+  reader->ResetCacheStatistics();
+  reader->Update();
+  mb = reader->GetOutput();
+  ds = vtkPointSet::SafeDownCast(vtkMultiBlockDataSet::SafeDownCast(mb->GetBlock(0))->GetBlock(0));
+  vtk_assert(ds != nullptr);
+  db = ds->GetPoints()->GetData();
+  vtkNew<vtkCGNSReader> other;
+  other->SetFileName(reader->GetFileName());
+  other->SetCacheGroupName("TestCGNSReaderMeshCaching");
+  other->CacheMeshOn();
+  other->CacheConnectivityOn();
+  other->UpdateInformation();
+  other->EnableAllPointArrays();
+  other->Update();
+  vtk_assert(other->GetCacheMisses() == 0);
+  vtk_assert(other->GetCacheHits() == reader->GetCacheMisses());
+  mb = other->GetOutput();
+  ds = vtkPointSet::SafeDownCast(vtkMultiBlockDataSet::SafeDownCast(mb->GetBlock(0))->GetBlock(0));
+  vtk_assert(ds != nullptr && ds->GetPoints()->GetData() == db);
+
+  // A memory budget too small for any entry empties the cache
+  vtkCGNSReader::SetCacheMemoryLimit(1);
+  vtk_assert(vtkCGNSReader::GetCacheMemorySize() <= 1);
+  vtkCGNSReader::SetCacheMemoryLimit(0);
+
   // Check that caching mesh implies lower loading time
   // vtk_assert(hot_timing < cold_timing);
   cout << "Expected timings: " << hot_timing << " < " << cold_timing << endl;
@@ -0,0 +1,82 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCGNSReaderZoneDistribution.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCGNSReader.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataSet.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#define vtk_assert(x)                                                                              \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "On line " << __LINE__ << " ERROR: Condition FAILED!! : " << #x << endl;               \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+vtkIdType CountCells(vtkMultiBlockDataSet* mb)
+{
+  vtkIdType count = 0;
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(mb->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+    {
+      count += ds->GetNumberOfCells();
+    }
+  }
+  return count;
+}
+}
+
+// Reads the pieces of a dataset one at a time and checks that, whatever the
+// distribution mode, every cell is read exactly once.
+int TestCGNSReaderZoneDistribution(int argc, char* argv[])
+{
+  char* fname = vtkTestUtilities::ExpandDataFileName(argc, argv, "Testing/Data/bc_struct.cgns");
+  vtkNew<vtkCGNSReader> reader;
+  reader->SetFileName(fname);
+  delete[] fname;
+
+  reader->Update();
+  const vtkIdType numCells = CountCells(reader->GetOutput());
+  vtk_assert(numCells > 0);
+
+  const int numPieces = 3;
+  for (int mode = vtkCGNSReader::DISTRIBUTE_BY_ZONE_COUNT;
+       mode <= vtkCGNSReader::DISTRIBUTE_BY_CELL_COUNT; ++mode)
+  {
+    for (int split = 0; split < 2; ++split)
+    {
+      reader->SetZoneDistributionMode(mode);
+      reader->SetSplitStructuredZones(split != 0);
+      vtkIdType total = 0;
+      for (int piece = 0; piece < numPieces; ++piece)
+      {
+        reader->UpdatePiece(piece, numPieces, 0);
+        total += CountCells(reader->GetOutput());
+      }
+      cout << "mode " << mode << ", split " << split << ": " << total << " cells, expected "
+           << numCells << endl;
+      vtk_assert(total == numCells);
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -674,6 +674,12 @@ int readZoneInfo(int cgioNum, double zoneId, CGNSRead::ZoneInformation& zoneInfo
     return 1;
   }
 
+  std::vector<vtkTypeInt64> zsize;
+  if (CGNSRead::readNodeDataAs<vtkTypeInt64>(cgioNum, zoneId, zsize) == CG_OK)
+  {
+    std::copy(zsize.begin(), zsize.begin() + std::min<std::size_t>(zsize.size(), 9), zoneInfo.zsize);
+  }
+
   std::vector<double> zoneChildren;
   getNodeChildrenId(cgioNum, zoneId, zoneChildren);
   for (double zoneChildId : zoneChildren)
@@ -689,6 +695,12 @@ int readZoneInfo(int cgioNum, double zoneId, CGNSRead::ZoneInformation& zoneInfo
           fname.c_str() + std::min(fname.size() + 1, sizeof(zoneInfo.family)), zoneInfo.family);
         zoneInfo.family[32] = 0;
       }
+      else if (strcmp(nodeLabel, "ZoneType_t") == 0)
+      {
+        std::string zoneType;
+        CGNSRead::readNodeStringData(cgioNum, zoneChildId, zoneType);
+        zoneInfo.structured = (zoneType == "Structured");
+      }
       else if (strcmp(nodeLabel, "ZoneBC_t") == 0)
       {
         std::vector<double> zoneBCChildren;
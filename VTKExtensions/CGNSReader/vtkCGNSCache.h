@@ -18,6 +18,10 @@
  *
  *     store an object in a container with its CGNS path key
  *
+ * Entries are kept in least-recently-used order. When the number of entries
+ * or the memory used by the entries exceeds its limit, the least recently
+ * used entries are evicted first. The cache is thread safe so that a single
+ * instance can be shared by several readers.
  *
  * @par Thanks:
  * Thanks to Mickael Philit
@@ -29,39 +33,95 @@
 #include "vtkSmartPointer.h"
 
 #include <iterator>
+#include <list>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 
 namespace CGNSRead
 {
-// No priority and no size limit right now
-
 template <typename CacheDataType>
 class vtkCGNSCache
 {
 public:
   vtkCGNSCache();
 
+  /**
+   * Returns the entry for `query` and marks it as most recently used, or
+   * nullptr if there is no such entry.
+   */
   vtkSmartPointer<CacheDataType> Find(const std::string& query);
 
-  void Insert(const std::string& key, const vtkSmartPointer<CacheDataType>& data);
+  /**
+   * Adds or replaces an entry. `size` is the memory used by `data`, in KiB.
+   * Entries larger than the memory limit are not cached.
+   */
+  void Insert(
+    const std::string& key, const vtkSmartPointer<CacheDataType>& data, unsigned long size = 0);
 
   void ClearCache();
 
+  /**
+   * Removes all entries whose key starts with `prefix`.
+   */
+  void ClearCache(const std::string& prefix);
+
+  //@{
+  /**
+   * Maximum number of entries. Values <= 0 mean no limit (default).
+   */
   void SetCacheSizeLimit(int size);
   int GetCacheSizeLimit();
+  //@}
+
+  //@{
+  /**
+   * Maximum memory used by the entries, in KiB. 0 means no limit (default).
+   */
+  void SetMemoryLimit(unsigned long size);
+  unsigned long GetMemoryLimit();
+  //@}
+
+  /**
+   * Returns the memory used by the entries, in KiB.
+   */
+  unsigned long GetMemorySize();
+
+  //@{
+  /**
+   * Number of Find() calls that returned, or did not return, an entry.
+   */
+  vtkIdType GetNumberOfHits();
+  vtkIdType GetNumberOfMisses();
+  //@}
 
 private:
   vtkCGNSCache(const vtkCGNSCache&) = delete;
   void operator=(const vtkCGNSCache&) = delete;
 
-  typedef std::unordered_map<std::string, vtkSmartPointer<CacheDataType> > CacheMapper;
-  CacheMapper CacheData;
+  struct CacheEntry
+  {
+    std::string Key;
+    vtkSmartPointer<CacheDataType> Data;
+    unsigned long Size;
+  };
+  // Most recently used entries first.
+  typedef std::list<CacheEntry> CacheList;
+  typedef std::unordered_map<std::string, typename CacheList::iterator> CacheMapper;
 
-  typename CacheMapper::iterator LastCacheAccess;
+  void Erase(typename CacheMapper::iterator iter);
+  void Trim();
+
+  CacheList Entries;
+  CacheMapper CacheData;
+  std::mutex Mutex;
 
   int cacheSizeLimit;
+  unsigned long MemoryLimit;
+  unsigned long MemorySize;
+  vtkIdType NumberOfHits;
+  vtkIdType NumberOfMisses;
 };
 
 template <typename CacheDataType>
@@ -69,13 +129,18 @@ vtkCGNSCache<CacheDataType>::vtkCGNSCache()
   : CacheData()
 {
   this->cacheSizeLimit = -1;
-  this->LastCacheAccess = CacheData.end();
+  this->MemoryLimit = 0;
+  this->MemorySize = 0;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
 }
 
 template <typename CacheDataType>
 void vtkCGNSCache<CacheDataType>::SetCacheSizeLimit(int size)
 {
+  std::lock_guard<std::mutex> lock(this->Mutex);
   this->cacheSizeLimit = size;
+  this->Trim();
 }
 
 template <typename CacheDataType>
@@ -84,36 +149,122 @@ int vtkCGNSCache<CacheDataType>::GetCacheSizeLimit()
   return this->cacheSizeLimit;
 }
 
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::SetMemoryLimit(unsigned long size)
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->MemoryLimit = size;
+  this->Trim();
+}
+
+template <typename CacheDataType>
+unsigned long vtkCGNSCache<CacheDataType>::GetMemoryLimit()
+{
+  return this->MemoryLimit;
+}
+
+template <typename CacheDataType>
+unsigned long vtkCGNSCache<CacheDataType>::GetMemorySize()
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  return this->MemorySize;
+}
+
+template <typename CacheDataType>
+vtkIdType vtkCGNSCache<CacheDataType>::GetNumberOfHits()
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  return this->NumberOfHits;
+}
+
+template <typename CacheDataType>
+vtkIdType vtkCGNSCache<CacheDataType>::GetNumberOfMisses()
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  return this->NumberOfMisses;
+}
+
 template <typename CacheDataType>
 vtkSmartPointer<CacheDataType> vtkCGNSCache<CacheDataType>::Find(const std::string& query)
 {
+  std::lock_guard<std::mutex> lock(this->Mutex);
   typename CacheMapper::iterator iter;
   iter = this->CacheData.find(query);
   if (iter == this->CacheData.end())
+  {
+    this->NumberOfMisses++;
     return vtkSmartPointer<CacheDataType>(nullptr);
-  this->LastCacheAccess = iter;
-  return iter->second;
+  }
+  this->NumberOfHits++;
+  // Move the entry to the front of the list: it is now the most recently used
+  this->Entries.splice(this->Entries.begin(), this->Entries, iter->second);
+  return iter->second->Data;
 }
 
 template <typename CacheDataType>
 void vtkCGNSCache<CacheDataType>::Insert(
-  const std::string& key, const vtkSmartPointer<CacheDataType>& data)
+  const std::string& key, const vtkSmartPointer<CacheDataType>& data, unsigned long size)
 {
-
-  if (this->cacheSizeLimit > 0 &&
-    this->CacheData.size() >= static_cast<size_t>(this->cacheSizeLimit))
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  typename CacheMapper::iterator iter = this->CacheData.find(key);
+  if (iter != this->CacheData.end())
   {
-    // Make some room by removing last accessed/inserted item
-    this->CacheData.erase(this->LastCacheAccess);
+    this->Erase(iter);
   }
-  this->CacheData[key] = data;
-  this->LastCacheAccess = this->CacheData.find(key);
+  if (this->MemoryLimit > 0 && size > this->MemoryLimit)
+  {
+    return;
+  }
+
+  this->Entries.push_front(CacheEntry{ key, data, size });
+  this->CacheData[key] = this->Entries.begin();
+  this->MemorySize += size;
+  this->Trim();
 }
 
 template <typename CacheDataType>
 void vtkCGNSCache<CacheDataType>::ClearCache()
 {
+  std::lock_guard<std::mutex> lock(this->Mutex);
   this->CacheData.clear();
+  this->Entries.clear();
+  this->MemorySize = 0;
+}
+
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::ClearCache(const std::string& prefix)
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  for (typename CacheMapper::iterator iter = this->CacheData.begin();
+       iter != this->CacheData.end();)
+  {
+    typename CacheMapper::iterator current = iter++;
+    if (current->first.compare(0, prefix.size(), prefix) == 0)
+    {
+      this->Erase(current);
+    }
+  }
+}
+
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::Erase(typename CacheMapper::iterator iter)
+{
+  this->MemorySize -= iter->second->Size;
+  this->Entries.erase(iter->second);
+  this->CacheData.erase(iter);
+}
+
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::Trim()
+{
+  // Make some room by removing the least recently used items
+  const size_t sizeLimit =
+    this->cacheSizeLimit > 0 ? static_cast<size_t>(this->cacheSizeLimit) : 0;
+  while (!this->Entries.empty() && ((sizeLimit > 0 && this->Entries.size() > sizeLimit) ||
+                                     (this->MemoryLimit > 0 && this->MemorySize > this->MemoryLimit)))
+  {
+    this->Erase(this->CacheData.find(this->Entries.back().Key));
+  }
 }
 }
 #endif // vtkCGNSCache_h
@@ -22,6 +22,7 @@
 #endif
 
 #include "vtkCGNSReader.h"
+#include "vtkCGNSCache.h"          // For caching of mesh and connectivity
 #include "vtkCGNSReaderInternal.h" // For parsing information request
 
 #include "vtkAssume.h"
@@ -492,6 +493,89 @@ public:
     const CGNS_ENUMT(GridLocation_t) locationParam, vtkDataSet* dataset, vtkCGNSReader* self);
 
   static std::string GenerateMeshKey(const char* basename, const char* zonename);
+
+  // Cache for mesh points and connectivities, shared by all readers.
+  static CGNSRead::vtkCGNSCache<vtkObject>& GetCache()
+  {
+    static CGNSRead::vtkCGNSCache<vtkObject> cache;
+    return cache;
+  }
+
+  // Returns the prefix of the keys of the cache entries created by `self`.
+  static std::string GetCacheScope(vtkCGNSReader* self)
+  {
+    std::ostringstream scope;
+    if (self->CacheGroupName && *self->CacheGroupName)
+    {
+      scope << "group:" << self->CacheGroupName;
+    }
+    else
+    {
+      scope << "reader:" << self;
+    }
+    scope << "|";
+    return scope.str();
+  }
+
+  // `kind` is "points" or "connectivity", `path` the /base/zone path.
+  static std::string GetCacheKey(vtkCGNSReader* self, const char* kind, const std::string& path)
+  {
+    return GetCacheScope(self) + kind + ":" + path;
+  }
+
+  // Removes the cache entries that are private to `self`. Entries shared with
+  // a group are left for other readers of the group, the cache evicts them as
+  // needed.
+  static void ReleaseCache(vtkCGNSReader* self, const char* kind = "")
+  {
+    if (!self->CacheGroupName || !*self->CacheGroupName)
+    {
+      GetCache().ClearCache(GetCacheScope(self) + kind);
+    }
+  }
+
+  // A zone, or a slab of a structured zone, to be read by this rank.
+  struct ZonePiece
+  {
+    int Zone;
+    int Piece;
+    int NumberOfPieces;
+  };
+
+  static void DistributeZonesByCellCount(vtkCGNSReader* self, int processNumber,
+    int numProcessors, std::map<int, std::vector<ZonePiece> >& baseToZonePieces);
+
+  // Computes the sub-extent, as 0-based point indices, of the `piece`-th slab
+  // of a structured zone split along its largest index dimension.
+  static void GetZonePieceVOI(
+    const cgsize_t* zsize, int cellDim, int piece, int numberOfPieces, int voi[6])
+  {
+    int axis = 0;
+    for (int n = 0; n < cellDim; ++n)
+    {
+      voi[2 * n] = 0;
+      voi[2 * n + 1] = static_cast<int>(zsize[n] - 1);
+      if (zsize[cellDim + n] > zsize[cellDim + axis])
+      {
+        axis = n;
+      }
+    }
+    const vtkTypeInt64 ncells = zsize[cellDim + axis];
+    voi[2 * axis] = static_cast<int>(ncells * piece / numberOfPieces);
+    voi[2 * axis + 1] = static_cast<int>(ncells * (piece + 1) / numberOfPieces);
+  }
+
+  static void CountCacheLookup(vtkCGNSReader* self, bool hit)
+  {
+    if (hit)
+    {
+      self->CacheHits++;
+    }
+    else
+    {
+      self->CacheMisses++;
+    }
+  }
 };
 
 // Helpers for FlowSolutionxxxPointers
@@ -532,8 +616,6 @@ vtkCGNSReader::vtkCGNSReader()
   : PointDataArraySelection()
   , CellDataArraySelection()
   , Internal(new CGNSRead::vtkCGNSMetaData())
-  , MeshPointsCache()
-  , ConnectivitiesCache()
 {
   this->FileName = NULL;
 
@@ -549,9 +631,14 @@ vtkCGNSReader::vtkCGNSReader()
   this->IgnoreFlowSolutionPointers = false;
   this->UseUnsteadyPattern = false;
   this->DistributeBlocks = true;
+  this->ZoneDistributionMode = DISTRIBUTE_BY_ZONE_COUNT;
+  this->SplitStructuredZones = false;
   this->IgnoreSILChangeEvents = false;
   this->CacheMesh = false;
   this->CacheConnectivity = false;
+  this->CacheGroupName = nullptr;
+  this->CacheHits = 0;
+  this->CacheMisses = 0;
 
   // Setup the selection callback to modify this object when an array
   // selection is changed.
@@ -577,8 +664,8 @@ vtkCGNSReader::vtkCGNSReader()
 vtkCGNSReader::~vtkCGNSReader()
 {
   this->SetFileName(0);
-  this->MeshPointsCache.ClearCache();
-  this->ConnectivitiesCache.ClearCache();
+  vtkPrivate::ReleaseCache(this);
+  delete[] this->CacheGroupName;
 
   this->PointDataArraySelection->RemoveObserver(this->SelectionObserver);
   this->CellDataArraySelection->RemoveObserver(this->SelectionObserver);
@@ -623,6 +710,115 @@ void vtkCGNSReader::SetController(vtkMultiProcessController* c)
 
 //------------------------------------------------------------------------------
 
+void vtkCGNSReader::vtkPrivate::DistributeZonesByCellCount(vtkCGNSReader* self, int processNumber,
+  int numProcessors, std::map<int, std::vector<ZonePiece> >& baseToZonePieces)
+{
+  struct WorkItem
+  {
+    int Base;
+    ZonePiece Piece;
+    vtkTypeInt64 Cost;
+  };
+
+  // Zones without size information still count as one cell so that they get
+  // distributed too.
+  auto zoneCost = [](const CGNSRead::BaseInformation& baseInfo, int zone) {
+    vtkTypeInt64 cost = zone < static_cast<int>(baseInfo.zones.size())
+      ? baseInfo.zones[zone].GetNumberOfCells(baseInfo.cellDim)
+      : 0;
+    return std::max<vtkTypeInt64>(cost, 1);
+  };
+
+  const int numBases = self->Internal->GetNumberOfBaseNodes();
+  vtkTypeInt64 totalCost = 0;
+  for (int bb = 0; bb < numBases; ++bb)
+  {
+    const CGNSRead::BaseInformation& baseInfo = self->Internal->GetBase(bb);
+    for (int zone = 0; zone < baseInfo.nzones; ++zone)
+    {
+      totalCost += zoneCost(baseInfo, zone);
+    }
+  }
+  const vtkTypeInt64 share = (totalCost + numProcessors - 1) / numProcessors;
+
+  std::vector<WorkItem> items;
+  for (int bb = 0; bb < numBases; ++bb)
+  {
+    const CGNSRead::BaseInformation& baseInfo = self->Internal->GetBase(bb);
+    for (int zone = 0; zone < baseInfo.nzones; ++zone)
+    {
+      const vtkTypeInt64 cost = zoneCost(baseInfo, zone);
+      vtkTypeInt64 numberOfPieces = 1;
+      if (self->SplitStructuredZones && cost > share &&
+        zone < static_cast<int>(baseInfo.zones.size()) && baseInfo.zones[zone].structured)
+      {
+        // Each slab must hold at least one cell along the split axis.
+        vtkTypeInt64 maxCells = 1;
+        for (int n = 0; n < baseInfo.cellDim && n < 3; ++n)
+        {
+          maxCells = std::max(maxCells, baseInfo.zones[zone].zsize[baseInfo.cellDim + n]);
+        }
+        numberOfPieces = std::min<vtkTypeInt64>(
+          std::min<vtkTypeInt64>((cost + share - 1) / share, numProcessors), maxCells);
+      }
+      for (int piece = 0; piece < numberOfPieces; ++piece)
+      {
+        WorkItem item = { bb, { zone, piece, static_cast<int>(numberOfPieces) },
+          cost / numberOfPieces };
+        items.push_back(item);
+      }
+    }
+  }
+
+  // Largest first, to the least loaded rank. All ranks compute the same
+  // assignment: ties are broken by zone order and rank.
+  std::stable_sort(items.begin(), items.end(),
+    [](const WorkItem& a, const WorkItem& b) { return a.Cost > b.Cost; });
+
+  std::vector<vtkTypeInt64> loads(numProcessors, 0);
+  std::map<std::pair<int, int>, std::set<int> > splitZoneRanks;
+  for (const WorkItem& item : items)
+  {
+    // Slabs of a zone go to different ranks, so that each rank has at most one
+    // block per zone.
+    std::set<int>* usedRanks = nullptr;
+    if (item.Piece.NumberOfPieces > 1)
+    {
+      usedRanks = &splitZoneRanks[std::make_pair(item.Base, item.Piece.Zone)];
+    }
+
+    int best = -1;
+    for (int rank = 0; rank < numProcessors; ++rank)
+    {
+      if (usedRanks && usedRanks->count(rank) > 0)
+      {
+        continue;
+      }
+      if (best == -1 || loads[rank] < loads[best])
+      {
+        best = rank;
+      }
+    }
+    loads[best] += item.Cost;
+    if (usedRanks)
+    {
+      usedRanks->insert(best);
+    }
+    if (best == processNumber)
+    {
+      baseToZonePieces[item.Base].push_back(item.Piece);
+    }
+  }
+
+  // Read zones in file order.
+  for (auto& iter : baseToZonePieces)
+  {
+    std::sort(iter.second.begin(), iter.second.end(),
+      [](const ZonePiece& a, const ZonePiece& b) { return a.Zone < b.Zone; });
+  }
+}
+
+//----------------------------------------------------------------------------
 std::string vtkCGNSReader::vtkPrivate::GenerateMeshKey(const char* basename, const char* zonename)
 {
   std::ostringstream query;
@@ -1774,9 +1970,10 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
     const char* basename = self->Internal->GetBase(base).name;
     const char* zonename = self->Internal->GetBase(base).zones[zone].name;
     // build a key /basename/zonename
-    keyMesh = vtkPrivate::GenerateMeshKey(basename, zonename);
+    keyMesh =
+      vtkPrivate::GetCacheKey(self, "points", vtkPrivate::GenerateMeshKey(basename, zonename));
 
-    points = self->MeshPointsCache.Find(keyMesh);
+    points = vtkPoints::SafeDownCast(vtkPrivate::GetCache().Find(keyMesh));
     if (points.Get() != nullptr)
     {
       // check storage data type
@@ -1789,6 +1986,7 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
         extent[1 + 2 * n] = zsize[n] - 1;
       }
     }
+    vtkPrivate::CountCacheLookup(self, points.Get() != nullptr);
   }
 
   // Reading points in file since cache was not hit
@@ -1881,7 +2079,7 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
     // Add points to cache
     if (caching)
     {
-      self->MeshPointsCache.Insert(keyMesh, points);
+      vtkPrivate::GetCache().Insert(keyMesh, points.Get(), points->GetActualMemorySize());
     }
   }
 
@@ -1930,8 +2128,8 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
 }
 
 //------------------------------------------------------------------------------
-int vtkCGNSReader::GetCurvilinearZone(
-  int base, int zone, int cellDim, int physicalDim, void* v_zsize, vtkMultiBlockDataSet* mbase)
+int vtkCGNSReader::GetCurvilinearZone(int base, int zone, int cellDim, int physicalDim,
+  void* v_zsize, vtkMultiBlockDataSet* mbase, int piece, int number_of_pieces)
 {
   cgsize_t* zsize = reinterpret_cast<cgsize_t*>(v_zsize);
 
@@ -1939,19 +2137,31 @@ int vtkCGNSReader::GetCurvilinearZone(
   const char* basename = this->Internal->GetBase(base).name;
   const char* zonename = this->Internal->GetBase(base).zones[zone].name;
 
+  int pieceVOI[6] = { 0, 0, 0, 0, 0, 0 };
+  const int* voi = nullptr;
+  if (number_of_pieces > 1)
+  {
+    vtkPrivate::GetZonePieceVOI(zsize, cellDim, piece, number_of_pieces, pieceVOI);
+    voi = pieceVOI;
+  }
+
   vtkSmartPointer<vtkDataObject> zoneDO = sil->ReadGridForZone(basename, zonename)
-    ? vtkPrivate::readCurvilinearZone(base, zone, cellDim, physicalDim, zsize, nullptr, this)
+    ? vtkPrivate::readCurvilinearZone(base, zone, cellDim, physicalDim, zsize, voi, this)
     : vtkSmartPointer<vtkDataObject>();
   mbase->SetBlock(zone, zoneDO.Get());
 
   //----------------------------------------------------------------------------
   // Handle boundary conditions (BC) patches
   //----------------------------------------------------------------------------
-  if (!this->CreateEachSolutionAsBlock && sil->ReadPatchesForBase(basename))
+  // When a zone is split across ranks, its patches are read by the rank
+  // reading the first slab.
+  if (!this->CreateEachSolutionAsBlock && sil->ReadPatchesForBase(basename) && piece == 0)
   {
     vtkNew<vtkMultiBlockDataSet> newZoneMB;
 
     vtkSmartPointer<vtkStructuredGrid> zoneGrid = vtkStructuredGrid::SafeDownCast(zoneDO);
+    // Patches are extracted from the zone grid only when it is complete.
+    vtkSmartPointer<vtkStructuredGrid> sourceGrid = voi == nullptr ? zoneGrid : nullptr;
     newZoneMB->SetBlock(0u, zoneGrid);
     newZoneMB->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "Internal");
     vtkPrivate::AddIsPatchArray(zoneGrid, false);
@@ -1988,8 +2198,8 @@ int vtkCGNSReader::GetCurvilinearZone(
             if (sil->ReadPatch(basename, zonename, binfo.Name))
             {
               const unsigned int idx = patchesMB->GetNumberOfBlocks();
-              vtkSmartPointer<vtkDataSet> ds = zoneGrid
-                ? binfo.CreateDataSet(cellDim, zoneGrid)
+              vtkSmartPointer<vtkDataSet> ds = sourceGrid
+                ? binfo.CreateDataSet(cellDim, sourceGrid)
                 : vtkPrivate::readBCDataSet(binfo, base, zone, cellDim, physicalDim, zsize, this);
               vtkPrivate::AddIsPatchArray(ds, true);
               vtkCGNSReader::vtkPrivate::readBCData(
@@ -2114,9 +2324,10 @@ int vtkCGNSReader::GetUnstructuredZone(
     const char* basename = this->Internal->GetBase(base).name;
     const char* zonename = this->Internal->GetBase(base).zones[zone].name;
     // build a key /basename/zonename
-    keyMesh = vtkPrivate::GenerateMeshKey(basename, zonename);
+    keyMesh =
+      vtkPrivate::GetCacheKey(this, "points", vtkPrivate::GenerateMeshKey(basename, zonename));
 
-    points = this->MeshPointsCache.Find(keyMesh);
+    points = vtkPoints::SafeDownCast(vtkPrivate::GetCache().Find(keyMesh));
     if (points.Get() != nullptr)
     {
       // check storage data type
@@ -2125,6 +2336,7 @@ int vtkCGNSReader::GetUnstructuredZone(
         points = nullptr;
       }
     }
+    vtkPrivate::CountCacheLookup(this, points.Get() != nullptr);
   }
 
   // Reading points from file instead of cache
@@ -2164,7 +2376,7 @@ int vtkCGNSReader::GetUnstructuredZone(
     // Add points to cache
     if (caching)
     {
-      this->MeshPointsCache.Insert(keyMesh, points);
+      vtkPrivate::GetCache().Insert(keyMesh, points.Get(), points->GetActualMemorySize());
     }
   }
 
@@ -2393,24 +2605,29 @@ int vtkCGNSReader::GetUnstructuredZone(
     // build a key /basename/zonename
     std::ostringstream query;
     query << "/" << basename << "/" << zonename << "/core";
-    keyConnect = query.str();
+    keyConnect = vtkPrivate::GetCacheKey(this, "connectivity", query.str());
 
-    ugrid = this->ConnectivitiesCache.Find(keyConnect);
-    if (ugrid.Get() != nullptr)
+    vtkSmartPointer<vtkUnstructuredGrid> cached =
+      vtkUnstructuredGrid::SafeDownCast(vtkPrivate::GetCache().Find(keyConnect));
+    if (cached.Get() != nullptr)
     {
-      if ((ugrid->GetNumberOfCells() != numCoreCells && !hasNGon) ||
-        (ugrid->GetNumberOfCells() != zsize[1] && hasNGon))
+      if ((cached->GetNumberOfCells() != numCoreCells && !hasNGon) ||
+        (cached->GetNumberOfCells() != zsize[1] && hasNGon))
       {
         vtkWarningMacro(<< "Connectivities from the cache have"
                            " a different number of cells from"
                            " those being read, ditching the cache");
-        ugrid = nullptr;
       }
       else
       {
+        // The cached grid may be shared with other readers: only reuse its
+        // structure.
+        ugrid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+        ugrid->CopyStructure(cached);
         ugrid->SetPoints(points.Get());
       }
     }
+    vtkPrivate::CountCacheLookup(this, ugrid.Get() != nullptr);
   }
   if (ugrid.Get() == nullptr)
   {
@@ -2959,7 +3176,12 @@ int vtkCGNSReader::GetUnstructuredZone(
     }
     if (caching)
     {
-      this->ConnectivitiesCache.Insert(keyConnect, ugrid);
+      // Cache the structure only, the points are cached separately.
+      vtkSmartPointer<vtkUnstructuredGrid> structure = vtkSmartPointer<vtkUnstructuredGrid>::New();
+      structure->CopyStructure(ugrid);
+      structure->SetPoints(nullptr);
+      vtkPrivate::GetCache().Insert(
+        keyConnect, structure.Get(), structure->GetActualMemorySize());
     }
   }
   //
@@ -4253,6 +4475,25 @@ int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
   }
   this->IgnoreSILChangeEvents = false;
 
+  // base --> zones (or slabs of zones) to read on this rank
+  std::map<int, std::vector<vtkPrivate::ZonePiece> > baseToZonePieces;
+  if (this->ZoneDistributionMode == DISTRIBUTE_BY_CELL_COUNT && numProcessors > 1)
+  {
+    vtkPrivate::DistributeZonesByCellCount(
+      this, processNumber, numProcessors, baseToZonePieces);
+  }
+  else
+  {
+    for (auto& iter : baseToZoneRange)
+    {
+      for (int zone = iter.second[0]; zone < iter.second[1]; ++zone)
+      {
+        vtkPrivate::ZonePiece zonePiece = { zone, 0, 1 };
+        baseToZonePieces[iter.first].push_back(zonePiece);
+      }
+    }
+  }
+
   vtkMultiBlockDataSet* rootNode = output;
 
   vtkDebugMacro(<< "Start Loading CGNS data");
@@ -4406,10 +4647,9 @@ int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
     // so we don't keep ids for released nodes.
     baseChildId.resize(nz);
 
-    int zonemin = baseToZoneRange[numBase][0];
-    int zonemax = baseToZoneRange[numBase][1];
-    for (int zone = zonemin; zone < zonemax; ++zone)
+    for (const vtkPrivate::ZonePiece& zonePiece : baseToZonePieces[numBase])
     {
+      const int zone = zonePiece.Zone;
       CGNSRead::char_33 zoneName;
       cgsize_t zsize[9];
       CGNS_ENUMT(ZoneType_t) zt = CGNS_ENUMV(ZoneTypeNull);
@@ -4516,7 +4756,8 @@ int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
           break;
         case CGNS_ENUMV(Structured):
         {
-          ier = GetCurvilinearZone(numBase, zone, cellDim, physicalDim, zsize, mbase);
+          ier = GetCurvilinearZone(numBase, zone, cellDim, physicalDim, zsize, mbase,
+            zonePiece.Piece, zonePiece.NumberOfPieces);
           if (ier != CG_OK)
           {
             vtkErrorMacro(<< "Error Reading file");
@@ -4655,6 +4896,14 @@ void vtkCGNSReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "CreateEachSolutionAsBlock: " << this->CreateEachSolutionAsBlock << endl;
   os << indent << "IgnoreFlowSolutionPointers: " << this->IgnoreFlowSolutionPointers << endl;
   os << indent << "DistributeBlocks: " << this->DistributeBlocks << endl;
+  os << indent << "ZoneDistributionMode: " << this->ZoneDistributionMode << endl;
+  os << indent << "SplitStructuredZones: " << this->SplitStructuredZones << endl;
+  os << indent << "CacheMesh: " << this->CacheMesh << endl;
+  os << indent << "CacheConnectivity: " << this->CacheConnectivity << endl;
+  os << indent << "CacheGroupName: " << (this->CacheGroupName ? this->CacheGroupName : "(none)")
+     << endl;
+  os << indent << "CacheHits: " << this->CacheHits << endl;
+  os << indent << "CacheMisses: " << this->CacheMisses << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -5028,7 +5277,7 @@ void vtkCGNSReader::SetCacheMesh(bool enable)
   this->CacheMesh = enable;
   if (!enable)
   {
-    this->MeshPointsCache.ClearCache();
+    vtkPrivate::ReleaseCache(this, "points:");
   }
 }
 
@@ -5038,10 +5287,51 @@ void vtkCGNSReader::SetCacheConnectivity(bool enable)
   this->CacheConnectivity = enable;
   if (!enable)
   {
-    this->ConnectivitiesCache.ClearCache();
+    vtkPrivate::ReleaseCache(this, "connectivity:");
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkCGNSReader::SetCacheGroupName(const char* name)
+{
+  if ((name == nullptr && this->CacheGroupName == nullptr) ||
+    (name && this->CacheGroupName && strcmp(name, this->CacheGroupName) == 0))
+  {
+    return;
+  }
+
+  // Entries private to this reader could no longer be found.
+  vtkPrivate::ReleaseCache(this);
+  delete[] this->CacheGroupName;
+  this->CacheGroupName = name ? vtksys::SystemTools::DuplicateString(name) : nullptr;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCGNSReader::SetCacheMemoryLimit(unsigned long size)
+{
+  vtkPrivate::GetCache().SetMemoryLimit(size);
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkCGNSReader::GetCacheMemoryLimit()
+{
+  return vtkPrivate::GetCache().GetMemoryLimit();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkCGNSReader::GetCacheMemorySize()
+{
+  return vtkPrivate::GetCache().GetMemorySize();
+}
+
+//----------------------------------------------------------------------------
+void vtkCGNSReader::ResetCacheStatistics()
+{
+  this->CacheHits = 0;
+  this->CacheMisses = 0;
+}
+
 //==============================================================================
 // *************** LEGACY API **************************************************
 //------------------------------------------------------------------------------
@@ -35,7 +35,6 @@
 #ifndef vtkCGNSReader_h
 #define vtkCGNSReader_h
 
-#include "vtkCGNSCache.h" // for vtkCGNSCache, caching of mesh and connectivity
 #include "vtkMultiBlockDataSetAlgorithm.h"
 #include "vtkNew.h"                             // for vtkNew.
 #include "vtkPVVTKExtensionsCGNSReaderModule.h" // for export macro
@@ -222,6 +221,36 @@ public:
   vtkGetMacro(DistributeBlocks, bool);
   vtkBooleanMacro(DistributeBlocks, bool);
 
+  enum ZoneDistributionModes
+  {
+    DISTRIBUTE_BY_ZONE_COUNT = 0,
+    DISTRIBUTE_BY_CELL_COUNT = 1
+  };
+
+  //@{
+  /**
+   * Set how zones are distributed across ranks when DistributeBlocks is true.
+   * DISTRIBUTE_BY_ZONE_COUNT (default) gives each rank a contiguous range of
+   * about the same number of zones. DISTRIBUTE_BY_CELL_COUNT balances the
+   * number of cells read by each rank, using the zone sizes from the file
+   * metadata: zones are assigned, largest first, to the least loaded rank.
+   */
+  vtkSetClampMacro(
+    ZoneDistributionMode, int, DISTRIBUTE_BY_ZONE_COUNT, DISTRIBUTE_BY_CELL_COUNT);
+  vtkGetMacro(ZoneDistributionMode, int);
+  //@}
+
+  //@{
+  /**
+   * When distributing zones by cell count, split structured zones that have
+   * more cells than a rank's share into slabs read by different ranks. Each
+   * rank then outputs its slab of the zone. Default is false.
+   */
+  vtkSetMacro(SplitStructuredZones, bool);
+  vtkGetMacro(SplitStructuredZones, bool);
+  vtkBooleanMacro(SplitStructuredZones, bool);
+  //@}
+
   //@{
   /**
    * This reader can cache the mesh points if they are time invariant.
@@ -242,6 +271,44 @@ public:
   vtkGetMacro(CacheConnectivity, bool);
   vtkBooleanMacro(CacheConnectivity, bool);
 
+  //@{
+  /**
+   * Cached mesh points and connectivities are private to this reader by
+   * default (empty name). Readers with the same non-empty CacheGroupName share
+   * them, e.g. readers for time series sharing the same mesh.
+   */
+  void SetCacheGroupName(const char* name);
+  vtkGetStringMacro(CacheGroupName);
+  //@}
+
+  //@{
+  /**
+   * Memory budget, in KiB, of the cache used for mesh points and
+   * connectivities. The cache is shared by all readers in the process; least
+   * recently used entries are evicted once the budget is exceeded.
+   * 0 means no limit (default).
+   */
+  static void SetCacheMemoryLimit(unsigned long size);
+  static unsigned long GetCacheMemoryLimit();
+  //@}
+
+  /**
+   * Returns the memory currently used by cached mesh points and
+   * connectivities, for all readers in the process, in KiB.
+   */
+  static unsigned long GetCacheMemorySize();
+
+  //@{
+  /**
+   * Number of cache lookups for mesh points and connectivities by this reader
+   * that were hits or misses, since the reader was created or
+   * ResetCacheStatistics() was last called.
+   */
+  vtkGetMacro(CacheHits, vtkIdType);
+  vtkGetMacro(CacheMisses, vtkIdType);
+  void ResetCacheStatistics();
+  //@}
+
   //@{
   /**
    * Set/get the communication object used to relay a list of files
@@ -282,8 +349,12 @@ protected:
   static void SelectionModifiedCallback(
     vtkObject* caller, unsigned long eid, void* clientdata, void* calldata);
 
-  int GetCurvilinearZone(
-    int base, int zone, int cell_dim, int phys_dim, void* zsize, vtkMultiBlockDataSet* mbase);
+  /**
+   * Reads a structured zone. When `number_of_pieces` is greater than 1, only
+   * the `piece`-th slab of the zone is read.
+   */
+  int GetCurvilinearZone(int base, int zone, int cell_dim, int phys_dim, void* zsize,
+    vtkMultiBlockDataSet* mbase, int piece = 0, int number_of_pieces = 1);
 
   int GetUnstructuredZone(
     int base, int zone, int cell_dim, int phys_dim, void* zsize, vtkMultiBlockDataSet* mbase);
@@ -301,10 +372,7 @@ private:
   void OnSILStateChanged();
   bool IgnoreSILChangeEvents;
 
-  CGNSRead::vtkCGNSMetaData* Internal;               // Metadata
-  CGNSRead::vtkCGNSCache<vtkPoints> MeshPointsCache; // Cache for the mesh points
-  CGNSRead::vtkCGNSCache<vtkUnstructuredGrid>
-    ConnectivitiesCache; // Cache for the mesh connectivities
+  CGNSRead::vtkCGNSMetaData* Internal; // Metadata
 
   char* FileName; // cgns file name
 #if !defined(VTK_LEGACY_REMOVE)
@@ -316,8 +384,13 @@ private:
   bool IgnoreFlowSolutionPointers;
   bool UseUnsteadyPattern;
   bool DistributeBlocks;
+  int ZoneDistributionMode;
+  bool SplitStructuredZones;
   bool CacheMesh;
   bool CacheConnectivity;
+  char* CacheGroupName;
+  vtkIdType CacheHits;
+  vtkIdType CacheMisses;
 
   // For internal cgio calls (low level IO)
   int cgioNum;      // cgio file reference
@@ -1201,6 +1201,11 @@ static void BroadcastZones(
     {
       stream.Push(zinfo.name, 33);
       stream.Push(zinfo.family, 33);
+      stream << static_cast<int>(zinfo.structured);
+      for (int cc = 0; cc < 9; ++cc)
+      {
+        stream << zinfo.zsize[cc];
+      }
       stream << static_cast<unsigned int>(zinfo.bcs.size());
       for (auto& bcinfo : zinfo.bcs)
       {
@@ -1223,6 +1228,13 @@ static void BroadcastZones(
       stream.Pop(cref, size);
       cref = zinfo.family;
       stream.Pop(cref, size);
+      int structured;
+      stream >> structured;
+      zinfo.structured = (structured != 0);
+      for (int cc = 0; cc < 9; ++cc)
+      {
+        stream >> zinfo.zsize[cc];
+      }
       stream >> count;
       zinfo.bcs.resize(count);
       for (auto& bcinfo : zinfo.bcs)
@@ -29,6 +29,7 @@
 #ifndef vtkCGNSReaderInternal_h
 #define vtkCGNSReaderInternal_h
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <string.h> // for inline strcmp
@@ -185,10 +186,35 @@ public:
   char_33 name;
   char_33 family;
   std::vector<CGNSRead::ZoneBCInformation> bcs;
+  // Zone type and size as stored in the Zone_t node, used to balance zones
+  // across ranks. For structured zones, zsize holds the vertex counts
+  // followed by the cell counts for each index dimension. For unstructured
+  // zones, it holds the vertex and cell counts.
+  bool structured;
+  vtkTypeInt64 zsize[9];
   ZoneInformation()
   {
     this->name[0] = '\0';
     this->family[0] = '\0';
+    this->structured = true;
+    std::fill(this->zsize, this->zsize + 9, 0);
+  }
+
+  /**
+   * Returns the number of cells in the zone, or 0 if unknown.
+   */
+  vtkTypeInt64 GetNumberOfCells(int cellDim) const
+  {
+    if (!this->structured)
+    {
+      return this->zsize[1];
+    }
+    vtkTypeInt64 ncells = 1;
+    for (int n = 0; n < cellDim && n < 3; ++n)
+    {
+      ncells *= this->zsize[cellDim + n];
+    }
+    return cellDim > 0 ? ncells : 0;
   }
 };
 
@@ -46,20 +46,31 @@ int TestFileSequenceParser(int, char* argv[])
   (void)argv;
   vtkNew<vtkFileSequenceParser> seqParser;
 
-  check_group(seqParser.Get(), "foo.1.csv", "foo...csv");
-  check_group(seqParser.Get(), "foo1.csv", "foo..csv");
-  check_group(seqParser.Get(), "alpha99beta88gamma0001.csv", "alpha99beta88gamma..csv");
-  check_group(seqParser.Get(), "foo.csv.1", "foo.csv");
-  check_group(seqParser.Get(), "foo.csv.10.0", "foo.csv.10");
-  check_group(seqParser.Get(), "spcta.10", "spcta");
-  check_group(seqParser.Get(), "spcta1.10", "spcta1");
-  check_group(seqParser.Get(), "Project_01_solution.cgns", "Project_.._solution.cgns");
-  check_group(seqParser.Get(), "prefix-021-suffix.ext", "prefix-..-suffix.ext");
-  check_group(seqParser.Get(), "prefix021suffix.ext", "prefix..suffix.ext");
-  check_group(seqParser.Get(), "plt0001000", "plt..");
+  bool success = true;
+  success &= check_group(seqParser.Get(), "foo.1.csv", "foo...csv");
+  success &= check_group(seqParser.Get(), "foo1.csv", "foo..csv");
+  success &= check_group(seqParser.Get(), "alpha99beta88gamma0001.csv", "alpha99beta88gamma..csv");
+  success &= check_group(seqParser.Get(), "foo.csv.1", "foo.csv");
+  success &= check_group(seqParser.Get(), "foo.csv.10.0", "foo.csv.10");
+  success &= check_group(seqParser.Get(), "spcta.10", "spcta");
+  success &= check_group(seqParser.Get(), "spcta1.10", "spcta1");
+  success &= check_group(seqParser.Get(), "Project_01_solution.cgns", "Project_.._solution.cgns");
+  success &= check_group(seqParser.Get(), "prefix-021-suffix.ext", "prefix-..-suffix.ext");
+  success &= check_group(seqParser.Get(), "prefix021suffix.ext", "prefix..suffix.ext");
+  success &= check_group(seqParser.Get(), "plt0001000", "plt..");
+  success &= check_group(seqParser.Get(), "0010_output.vtk", ".._output.vtk");
+  success &= check_group(seqParser.Get(), "0010output.vtk", "..output.vtk");
+  success &= check_group(seqParser.Get(), "data_15.vtk", "data_..vtk");
+  if (!seqParser->ParseFileSequence("run_007.vtu") || seqParser->GetSequenceIndex() != 7)
+  {
+    cout << "ERROR: wrong sequence index for 'run_007.vtu'" << endl;
+    success = false;
+  }
 
-  check_no_group(seqParser.Get(), "foo.3dm");
-  check_no_group(seqParser.Get(), "foo.2dm");
+  success &= check_no_group(seqParser.Get(), "foo.3dm");
+  success &= check_no_group(seqParser.Get(), "foo.2dm");
+  success &= check_no_group(seqParser.Get(), "0001.vtk");
+  success &= check_no_group(seqParser.Get(), "README");
 
-  return EXIT_SUCCESS;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -16,108 +16,192 @@
 
 #include "vtkObjectFactory.h"
 
-#include <set>
+#include <algorithm>
+#include <cstdlib>
 #include <string>
-#include <vtksys/RegularExpression.hxx>
 #include <vtksys/SystemTools.hxx>
 
-vtkStandardNewMacro(vtkFileSequenceParser);
-//-----------------------------------------------------------------------------
-vtkFileSequenceParser::vtkFileSequenceParser()
-  : // sequence ending with numbers.
-  reg_ex(new vtksys::RegularExpression("^(.*)\\.([0-9.]+)$"))
-  ,
-  // sequence ending with extension.
-  reg_ex2(new vtksys::RegularExpression("^(.*)(\\.|_|-)([0-9.]+)\\.(.*)$"))
-  ,
-  // sequence ending with extension, but with no ". or _" before
-  // the series number.
-  reg_ex3(new vtksys::RegularExpression("^(.*)([a-zA-Z])([0-9.]+)\\.(.*)$"))
-  ,
-  // sequence ending with extension, and starting with series number
-  // followed by ". or _".
-  reg_ex4(new vtksys::RegularExpression("^([0-9.]+)(\\.|_|-)(.*)\\.(.*)$"))
-  ,
-  // sequence ending with extension, and starting with series number,
-  // but not followed by ". or _".
-  reg_ex5(new vtksys::RegularExpression("^([0-9.]+)([a-zA-Z])(.*)\\.(.*)$"))
-
-  ,
-  // fallback: any sequence with a number in the middle (taking the last number
-  // if multiple exist).
-  reg_ex_last(new vtksys::RegularExpression("^(.*[^0-9])([0-9]+)([^0-9]*)$"))
-  , SequenceIndex(-1)
-  , SequenceName(NULL)
+// The patterns below used to be regular expressions. Listing directories with
+// hundreds of thousands of files spent most of its time matching them, so
+// each one is now matched by hand. The regular expression each function is
+// equivalent to is given in its comment, with the same greedy matching.
+namespace
 {
+inline bool IsDigit(char c)
+{
+  return c >= '0' && c <= '9';
 }
 
-//-----------------------------------------------------------------------------
-vtkFileSequenceParser::~vtkFileSequenceParser()
+inline bool IsNumber(char c)
+{
+  return IsDigit(c) || c == '.';
+}
+
+inline bool IsAlpha(char c)
 {
-  delete this->reg_ex;
-  delete this->reg_ex2;
-  delete this->reg_ex3;
-  delete this->reg_ex4;
-  delete this->reg_ex5;
-  delete this->reg_ex_last;
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
 
-  this->SetSequenceName(NULL);
+inline bool IsSeparator(char c)
+{
+  return c == '.' || c == '_' || c == '-';
 }
 
-//-----------------------------------------------------------------------------
-bool vtkFileSequenceParser::ParseFileSequence(const char* file)
+// sequence ending with numbers.
+// ^(.*)\.([0-9.]+)$
+bool MatchNumberAtEnd(const std::string& file, std::string& name, int& index)
 {
-  bool match = false;
-  if (this->reg_ex->find(file))
+  const size_t len = file.size();
+  size_t start = len;
+  while (start > 0 && IsNumber(file[start - 1]))
   {
-    this->SetSequenceName(this->reg_ex->match(1).c_str());
-    this->SequenceIndex = atoi(reg_ex->match(2).c_str());
-    match = true;
+    --start;
   }
-  else if (this->reg_ex2->find(file))
+  // The last '.' of the trailing number that is followed by something.
+  for (size_t pos = len; pos-- > start;)
   {
-    this->SetSequenceName(std::string(this->reg_ex2->match(1) + this->reg_ex2->match(2) + ".." +
-                            this->reg_ex2->match(4))
-                            .c_str());
-    this->SequenceIndex = atoi(reg_ex2->match(3).c_str());
-    match = true;
+    if (file[pos] == '.' && pos + 1 < len)
+    {
+      name = file.substr(0, pos);
+      index = atoi(file.c_str() + pos + 1);
+      return true;
+    }
   }
-  else if (this->reg_ex3->find(file))
+  return false;
+}
+
+// sequence ending with extension.
+// ^(.*)(\.|_|-)([0-9.]+)\.(.*)$ when isSeparator is IsSeparator, or
+// sequence ending with extension, but with no ". or _" before
+// the series number.
+// ^(.*)([a-zA-Z])([0-9.]+)\.(.*)$ when isSeparator is IsAlpha.
+bool MatchNumberBeforeExtension(
+  const std::string& file, bool (*isSeparator)(char), std::string& name, int& index)
+{
+  const size_t len = file.size();
+  for (size_t sep = len; sep-- > 0;)
   {
-    this->SetSequenceName(std::string(this->reg_ex3->match(1) + this->reg_ex3->match(2) + ".." +
-                            this->reg_ex3->match(4))
-                            .c_str());
-    this->SequenceIndex = atoi(reg_ex3->match(3).c_str());
-    match = true;
+    if (!isSeparator(file[sep]))
+    {
+      continue;
+    }
+    size_t end = sep + 1;
+    while (end < len && IsNumber(file[end]))
+    {
+      ++end;
+    }
+    // The number ends at the last '.' of the run, and is not empty.
+    for (size_t dot = end; dot-- > sep + 2;)
+    {
+      if (file[dot] == '.')
+      {
+        name = file.substr(0, sep + 1) + ".." + file.substr(dot + 1);
+        index = atoi(file.c_str() + sep + 1);
+        return true;
+      }
+    }
   }
-  else if (this->reg_ex4->find(file))
+  return false;
+}
+
+// sequence ending with extension, and starting with series number
+// followed by ". or _".
+// ^([0-9.]+)(\.|_|-)(.*)\.(.*)$ when isSeparator is IsSeparator, or
+// sequence ending with extension, and starting with series number,
+// but not followed by ". or _".
+// ^([0-9.]+)([a-zA-Z])(.*)\.(.*)$ when isSeparator is IsAlpha.
+bool MatchNumberAtStart(
+  const std::string& file, bool (*isSeparator)(char), std::string& name, int& index)
+{
+  const size_t len = file.size();
+  size_t end = 0;
+  while (end < len && IsNumber(file[end]))
   {
-    this->SetSequenceName(std::string(".." + this->reg_ex4->match(2) + this->reg_ex4->match(3) +
-                            "." + this->reg_ex4->match(4))
-                            .c_str());
-    this->SequenceIndex = atoi(reg_ex4->match(1).c_str());
-    match = true;
+    ++end;
   }
-  else if (this->reg_ex5->find(file))
+  // The name and the extension are split at the last '.', after the separator.
+  const size_t lastDot = file.rfind('.');
+  if (lastDot == std::string::npos || lastDot == 0)
   {
-    this->SetSequenceName(std::string(".." + this->reg_ex5->match(2) + this->reg_ex5->match(3) +
-                            "." + this->reg_ex5->match(4))
-                            .c_str());
-    this->SequenceIndex = atoi(reg_ex5->match(1).c_str());
-    match = true;
+    return false;
   }
-  else
+  for (size_t sep = std::min(end, lastDot - 1); sep > 0; --sep)
   {
-    std::string fname_wo_ext = vtksys::SystemTools::GetFilenameWithoutExtension(file);
-    std::string ext = vtksys::SystemTools::GetFilenameExtension(file);
-    if (this->reg_ex_last->find(fname_wo_ext))
+    if (isSeparator(file[sep]))
     {
-      this->SetSequenceName(
-        (this->reg_ex_last->match(1) + ".." + this->reg_ex_last->match(3) + ext).c_str());
-      this->SequenceIndex = atoi(reg_ex_last->match(2).c_str());
+      name = ".." + file.substr(sep, lastDot - sep) + "." + file.substr(lastDot + 1);
+      index = atoi(file.c_str());
+      return true;
+    }
+  }
+  return false;
+}
+
+// fallback: any sequence with a number in the middle (taking the last number
+// if multiple exist).
+// ^(.*[^0-9])([0-9]+)([^0-9]*)$
+bool MatchLastNumber(const std::string& file, std::string& name, int& index)
+{
+  size_t end = file.size();
+  while (end > 0 && !IsDigit(file[end - 1]))
+  {
+    --end;
+  }
+  size_t start = end;
+  while (start > 0 && IsDigit(file[start - 1]))
+  {
+    --start;
+  }
+  if (start == end || start == 0)
+  {
+    return false;
+  }
+  name = file.substr(0, start) + ".." + file.substr(end);
+  index = atoi(file.c_str() + start);
+  return true;
+}
+}
+
+vtkStandardNewMacro(vtkFileSequenceParser);
+//-----------------------------------------------------------------------------
+vtkFileSequenceParser::vtkFileSequenceParser()
+  : SequenceIndex(-1)
+  , SequenceName(NULL)
+{
+}
+
+//-----------------------------------------------------------------------------
+vtkFileSequenceParser::~vtkFileSequenceParser()
+{
+  this->SetSequenceName(NULL);
+}
+
+//-----------------------------------------------------------------------------
+bool vtkFileSequenceParser::ParseFileSequence(const char* file)
+{
+  const std::string fname(file);
+  std::string name;
+  int index = -1;
+  bool match = MatchNumberAtEnd(fname, name, index) ||
+    MatchNumberBeforeExtension(fname, IsSeparator, name, index) ||
+    MatchNumberBeforeExtension(fname, IsAlpha, name, index) ||
+    MatchNumberAtStart(fname, IsSeparator, name, index) ||
+    MatchNumberAtStart(fname, IsAlpha, name, index);
+  if (!match)
+  {
+    std::string fname_wo_ext = vtksys::SystemTools::GetFilenameWithoutExtension(fname);
+    std::string ext = vtksys::SystemTools::GetFilenameExtension(fname);
+    if (MatchLastNumber(fname_wo_ext, name, index))
+    {
+      name += ext;
       match = true;
     }
   }
+  if (match)
+  {
+    this->SetSequenceName(name.c_str());
+    this->SequenceIndex = index;
+  }
   return match;
 }
 
@@ -30,11 +30,6 @@
 #include "vtkObject.h"
 #include "vtkPVVTKExtensionsCoreModule.h" //needed for exports
 
-namespace vtksys
-{
-class RegularExpression;
-}
-
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkFileSequenceParser : public vtkObject
 {
 public:
@@ -56,13 +51,6 @@ protected:
   vtkFileSequenceParser();
   ~vtkFileSequenceParser() override;
 
-  vtksys::RegularExpression* reg_ex;
-  vtksys::RegularExpression* reg_ex2;
-  vtksys::RegularExpression* reg_ex3;
-  vtksys::RegularExpression* reg_ex4;
-  vtksys::RegularExpression* reg_ex5;
-  vtksys::RegularExpression* reg_ex_last;
-
   // Used internal so char * allocations are done automatically.
   vtkSetStringMacro(SequenceName);
 
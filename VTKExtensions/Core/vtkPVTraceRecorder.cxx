@@ -0,0 +1,276 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVTraceRecorder.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVTraceRecorder.h"
+
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+// Tag used to exchange timestamps in SynchronizeClocks.
+static const int SYNCHRONIZE_CLOCKS_TAG = 87235;
+static const int SYNCHRONIZE_CLOCKS_ROUNDS = 8;
+
+// `Sequence` is the index of the event stored in the slot plus one, or 0 while
+// the slot is being written, so that readers can detect events overwritten
+// while they were being copied.
+struct EventSlot
+{
+  std::atomic<vtkTypeUInt64> Sequence{ 0 };
+  vtkTypeInt64 Begin;
+  vtkTypeInt64 End;
+  const char* Category;
+  char Name[64];
+};
+
+// Ring buffer written by a single thread. The writer fills the slot at `Head`
+// and then publishes it by incrementing `Head`; readers only ever read `Head`.
+// `Tail` marks the first event kept since the last ResetEvents().
+struct ThreadBuffer
+{
+  ThreadBuffer(int id, size_t size)
+    : Id(id)
+    , Slots(size)
+    , Head(0)
+    , Tail(0)
+  {
+  }
+
+  int Id;
+  std::vector<EventSlot> Slots;
+  std::atomic<vtkTypeUInt64> Head;
+  std::atomic<vtkTypeUInt64> Tail;
+};
+
+struct BufferRegistry
+{
+  std::mutex Mutex;
+  std::vector<std::shared_ptr<ThreadBuffer> > Buffers;
+};
+
+static BufferRegistry& GetRegistry()
+{
+  static BufferRegistry registry;
+  return registry;
+}
+
+static std::atomic<int> Enabled(0);
+static std::atomic<int> BufferSize(65536);
+static std::atomic<vtkTypeInt64> ClockOffset(0);
+
+static ThreadBuffer* GetThreadBuffer()
+{
+  // the registry shares ownership so that events recorded by threads that
+  // are gone can still be gathered.
+  thread_local std::shared_ptr<ThreadBuffer> buffer;
+  if (!buffer)
+  {
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    buffer = std::make_shared<ThreadBuffer>(static_cast<int>(registry.Buffers.size()),
+      static_cast<size_t>(std::max(BufferSize.load(), 1)));
+    registry.Buffers.push_back(buffer);
+  }
+  return buffer.get();
+}
+}
+
+vtkStandardNewMacro(vtkPVTraceRecorder);
+//----------------------------------------------------------------------------
+vtkPVTraceRecorder::vtkPVTraceRecorder()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVTraceRecorder::~vtkPVTraceRecorder()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceRecorder::SetEnabled(int val)
+{
+  Enabled.store(val != 0 ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVTraceRecorder::GetEnabled()
+{
+  return Enabled.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceRecorder::SetBufferSize(int val)
+{
+  BufferSize.store(std::max(val, 1));
+}
+
+//----------------------------------------------------------------------------
+int vtkPVTraceRecorder::GetBufferSize()
+{
+  return BufferSize.load();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceRecorder::ResetEvents()
+{
+  auto& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  for (auto& buffer : registry.Buffers)
+  {
+    buffer->Tail.store(buffer->Head.load(std::memory_order_acquire));
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkPVTraceRecorder::GetTime()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkPVTraceRecorder::GetClockOffset()
+{
+  return ClockOffset.load();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceRecorder::SynchronizeClocks()
+{
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  if (controller == nullptr || controller->GetNumberOfProcesses() <= 1)
+  {
+    ClockOffset.store(0);
+    return;
+  }
+
+  // Ping-pong with the root, one rank at a time. Each rank keeps the estimate
+  // from the round trip that took the least time, assuming that the root's
+  // clock was read halfway through it.
+  const int rank = controller->GetLocalProcessId();
+  const int nranks = controller->GetNumberOfProcesses();
+  if (rank == 0)
+  {
+    for (int other = 1; other < nranks; ++other)
+    {
+      for (int round = 0; round < SYNCHRONIZE_CLOCKS_ROUNDS; ++round)
+      {
+        vtkTypeInt64 ping;
+        controller->Receive(&ping, 1, other, SYNCHRONIZE_CLOCKS_TAG);
+        vtkTypeInt64 now = vtkPVTraceRecorder::GetTime();
+        controller->Send(&now, 1, other, SYNCHRONIZE_CLOCKS_TAG);
+      }
+    }
+    ClockOffset.store(0);
+  }
+  else
+  {
+    vtkTypeInt64 bestRoundTrip = -1;
+    vtkTypeInt64 offset = 0;
+    for (int round = 0; round < SYNCHRONIZE_CLOCKS_ROUNDS; ++round)
+    {
+      vtkTypeInt64 sent = vtkPVTraceRecorder::GetTime();
+      controller->Send(&sent, 1, 0, SYNCHRONIZE_CLOCKS_TAG);
+      vtkTypeInt64 rootTime;
+      controller->Receive(&rootTime, 1, 0, SYNCHRONIZE_CLOCKS_TAG);
+      const vtkTypeInt64 received = vtkPVTraceRecorder::GetTime();
+      if (bestRoundTrip < 0 || received - sent < bestRoundTrip)
+      {
+        bestRoundTrip = received - sent;
+        offset = rootTime - (sent + received) / 2;
+      }
+    }
+    ClockOffset.store(offset);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceRecorder::RecordEvent(
+  const char* category, const char* name, vtkTypeInt64 begin, vtkTypeInt64 end)
+{
+  if (!vtkPVTraceRecorder::GetEnabled())
+  {
+    return;
+  }
+
+  ThreadBuffer* buffer = GetThreadBuffer();
+  const vtkTypeUInt64 head = buffer->Head.load(std::memory_order_relaxed);
+  EventSlot& slot = buffer->Slots[head % buffer->Slots.size()];
+  slot.Sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.Begin = begin;
+  slot.End = end;
+  slot.Category = category ? category : "";
+  strncpy(slot.Name, name ? name : "", sizeof(slot.Name) - 1);
+  slot.Name[sizeof(slot.Name) - 1] = '\0';
+  slot.Sequence.store(head + 1, std::memory_order_release);
+  buffer->Head.store(head + 1, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceRecorder::GetEvents(std::vector<EventRecord>& events)
+{
+  events.clear();
+  const vtkTypeInt64 offset = vtkPVTraceRecorder::GetClockOffset();
+
+  auto& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  for (auto& buffer : registry.Buffers)
+  {
+    const vtkTypeUInt64 capacity = static_cast<vtkTypeUInt64>(buffer->Slots.size());
+    const vtkTypeUInt64 head = buffer->Head.load(std::memory_order_acquire);
+    const vtkTypeUInt64 first =
+      std::max(buffer->Tail.load(), head > capacity ? head - capacity : vtkTypeUInt64(0));
+
+    for (vtkTypeUInt64 idx = first; idx < head; ++idx)
+    {
+      const EventSlot& slot = buffer->Slots[idx % capacity];
+      if (slot.Sequence.load(std::memory_order_acquire) != idx + 1)
+      {
+        continue;
+      }
+      EventRecord record;
+      record.Category = slot.Category;
+      record.Name = std::string(slot.Name, strnlen(slot.Name, sizeof(slot.Name)));
+      record.ThreadId = buffer->Id;
+      record.Begin = slot.Begin + offset;
+      record.Duration = slot.End - slot.Begin;
+
+      // drop the event if the thread overwrote it while it was being copied.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.Sequence.load(std::memory_order_relaxed) == idx + 1)
+      {
+        events.push_back(std::move(record));
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceRecorder::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Enabled: " << vtkPVTraceRecorder::GetEnabled() << endl;
+  os << indent << "BufferSize: " << vtkPVTraceRecorder::GetBufferSize() << endl;
+  os << indent << "ClockOffset: " << vtkPVTraceRecorder::GetClockOffset() << endl;
+}
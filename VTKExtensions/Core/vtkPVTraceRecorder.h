@@ -0,0 +1,188 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVTraceRecorder.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkPVTraceRecorder
+ * @brief records timed events for timeline analysis
+ *
+ * vtkPVTraceRecorder records scoped events, e.g. algorithm execution, data
+ * movement, compositing, image compression or RMI dispatch, with their start
+ * time and duration. Unlike vtkPVLogger, which produces human readable text,
+ * the events are kept in memory so that they can be gathered from all ranks
+ * (see vtkPVTraceInformation) and written out as a timeline to be inspected
+ * with tools such as `chrome://tracing` or Perfetto.
+ *
+ * Events are recorded in a ring buffer per thread. Recording an event does not
+ * take any lock; when a buffer is full, the oldest events are overwritten.
+ * Recording is disabled by default. When disabled, recording an event is a
+ * single check of a flag.
+ *
+ * To record an event for the duration of a scope, use `vtkPVTraceScope` as
+ * follows:
+ *
+ * @code{cpp}
+ * vtkPVTraceScope("data-movement", "gather-to-0");
+ * @endcode
+ *
+ * The category must be a string literal. Categories used by ParaView are
+ * "pipeline", "data-movement", "compositing", "compression" and "rmi".
+ *
+ * Like vtkTimerLog, all the state is static. Instances are only provided so
+ * that the recorder can be controlled on all processes through a proxy.
+ */
+
+#ifndef vtkPVTraceRecorder_h
+#define vtkPVTraceRecorder_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVTraceRecorder : public vtkObject
+{
+public:
+  static vtkPVTraceRecorder* New();
+  vtkTypeMacro(vtkPVTraceRecorder, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Enable/disable recording of events on this process. Disabled by default.
+   */
+  static void SetEnabled(int);
+  static int GetEnabled();
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of events kept per thread. This only affects threads
+   * that have not recorded any event yet. Default is 65536.
+   */
+  static void SetBufferSize(int);
+  static int GetBufferSize();
+  //@}
+
+  /**
+   * Discard all the events recorded so far.
+   */
+  static void ResetEvents();
+
+  /**
+   * Estimate the offset between the clock of this process and the clock of
+   * the root of the global controller. The offset is applied to the
+   * timestamps returned by `GetEvents`, so that events recorded on all ranks
+   * of a process group share the same time base. This must be called on all
+   * ranks of the global controller.
+   */
+  static void SynchronizeClocks();
+
+  /**
+   * Returns the offset, in microseconds, added to the local timestamps to
+   * convert them to the clock of the root rank. Set by `SynchronizeClocks`.
+   */
+  static vtkTypeInt64 GetClockOffset();
+
+  /**
+   * Returns the current time of the local clock, in microseconds. The clock
+   * is monotonic; its origin is arbitrary.
+   */
+  static vtkTypeInt64 GetTime();
+
+  /**
+   * Record an event that started at `begin` and ended at `end`, both obtained
+   * with `GetTime`. `category` must be a string literal, `name` is copied and
+   * truncated if too long. Does nothing if recording is disabled.
+   */
+  static void RecordEvent(
+    const char* category, const char* name, vtkTypeInt64 begin, vtkTypeInt64 end);
+
+  /**
+   * An event gathered by `GetEvents`. Timestamps are in microseconds in the
+   * clock of the root rank.
+   */
+  struct EventRecord
+  {
+    std::string Category;
+    std::string Name;
+    int ThreadId;
+    vtkTypeInt64 Begin;
+    vtkTypeInt64 Duration;
+  };
+
+  /**
+   * Returns the events recorded by all threads of this process since the last
+   * `ResetEvents`, ordered by thread and end time. Events being recorded
+   * concurrently may be missing.
+   */
+  static void GetEvents(std::vector<EventRecord>& events);
+
+  /**
+   * Helper class to record an event for the lifetime of an instance. Prefer
+   * the `vtkPVTraceScope` macro.
+   */
+  class vtkScopedEvent
+  {
+  public:
+    vtkScopedEvent(const char* category, const char* name)
+      : Category(category)
+      , Name(name)
+      , Begin(vtkPVTraceRecorder::GetEnabled() ? vtkPVTraceRecorder::GetTime() : -1)
+    {
+    }
+    ~vtkScopedEvent()
+    {
+      if (this->Begin >= 0)
+      {
+        vtkPVTraceRecorder::RecordEvent(
+          this->Category, this->Name, this->Begin, vtkPVTraceRecorder::GetTime());
+      }
+    }
+
+  private:
+    vtkScopedEvent(const vtkScopedEvent&) = delete;
+    void operator=(const vtkScopedEvent&) = delete;
+
+    const char* Category;
+    const char* Name;
+    vtkTypeInt64 Begin;
+  };
+
+protected:
+  vtkPVTraceRecorder();
+  ~vtkPVTraceRecorder() override;
+
+private:
+  vtkPVTraceRecorder(const vtkPVTraceRecorder&) = delete;
+  void operator=(const vtkPVTraceRecorder&) = delete;
+};
+
+#define vtkPVTraceConcat2(a, b) a##b
+#define vtkPVTraceConcat(a, b) vtkPVTraceConcat2(a, b)
+
+/**
+ * Records an event named `name` in the given category from this point to the
+ * end of the enclosing scope. `name` must remain valid until the end of the
+ * scope.
+ *
+ * @code{cpp}
+ *  vtkPVTraceScope("compositing", "IceT composite");
+ * @endcode
+ */
+#define vtkPVTraceScope(category, name)                                                            \
+  vtkPVTraceRecorder::vtkScopedEvent vtkPVTraceConcat(pv_trace_scope_at_line_, __LINE__)(          \
+    category, name)
+
+#endif
@@ -21,6 +21,8 @@
 vtkStandardNewMacro(vtkPVXMLElement);
 
 #include <ctype.h>
+#include <cstring>
+#include <functional>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -786,3 +788,182 @@ void vtkPVXMLElement::RemoveAttribute(const char* name)
 }
 
 //----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------
+namespace
+{
+// Strings are stored as a 32-bit length followed by the characters. The
+// maximum length denotes a null string.
+const vtkTypeUInt32 vtkPVXMLNullString = 0xffffffff;
+
+void vtkPVXMLAppendUInt32(std::vector<char>& buffer, vtkTypeUInt32 value)
+{
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+void vtkPVXMLAppendString(std::vector<char>& buffer, const char* str, size_t length)
+{
+  if (!str)
+  {
+    vtkPVXMLAppendUInt32(buffer, vtkPVXMLNullString);
+    return;
+  }
+  vtkPVXMLAppendUInt32(buffer, static_cast<vtkTypeUInt32>(length));
+  buffer.insert(buffer.end(), str, str + length);
+}
+
+void vtkPVXMLAppendString(std::vector<char>& buffer, const std::string& str)
+{
+  vtkPVXMLAppendString(buffer, str.c_str(), str.size());
+}
+
+void vtkPVXMLAppendString(std::vector<char>& buffer, const char* str)
+{
+  vtkPVXMLAppendString(buffer, str, str ? strlen(str) : 0);
+}
+
+class vtkPVXMLBinaryReader
+{
+public:
+  vtkPVXMLBinaryReader(const char* data, size_t length)
+    : Current(data)
+    , End(data + length)
+  {
+  }
+
+  bool ReadUInt32(vtkTypeUInt32& value)
+  {
+    if (static_cast<size_t>(this->End - this->Current) < sizeof(value))
+    {
+      return false;
+    }
+    memcpy(&value, this->Current, sizeof(value));
+    this->Current += sizeof(value);
+    return true;
+  }
+
+  // `str` points into the buffer and is not null terminated.
+  bool ReadString(const char*& str, vtkTypeUInt32& length)
+  {
+    if (!this->ReadUInt32(length))
+    {
+      return false;
+    }
+    if (length == vtkPVXMLNullString)
+    {
+      str = nullptr;
+      length = 0;
+      return true;
+    }
+    if (static_cast<size_t>(this->End - this->Current) < length)
+    {
+      return false;
+    }
+    str = this->Current;
+    this->Current += length;
+    return true;
+  }
+
+  bool ReadString(std::string& str)
+  {
+    const char* data;
+    vtkTypeUInt32 length;
+    if (!this->ReadString(data, length))
+    {
+      return false;
+    }
+    str.assign(data ? data : "", length);
+    return true;
+  }
+
+private:
+  const char* Current;
+  const char* End;
+};
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLElement::AppendBinary(std::vector<char>& buffer)
+{
+  vtkPVXMLAppendString(buffer, this->Name);
+  vtkPVXMLAppendString(buffer, this->Id);
+  vtkPVXMLAppendUInt32(buffer, static_cast<vtkTypeUInt32>(this->Internal->AttributeNames.size()));
+  for (size_t cc = 0; cc < this->Internal->AttributeNames.size(); ++cc)
+  {
+    vtkPVXMLAppendString(buffer, this->Internal->AttributeNames[cc]);
+    vtkPVXMLAppendString(buffer, this->Internal->AttributeValues[cc]);
+  }
+  vtkPVXMLAppendString(buffer, this->Internal->CharacterData);
+  vtkPVXMLAppendUInt32(buffer, static_cast<vtkTypeUInt32>(this->Internal->NestedElements.size()));
+  for (auto& nested : this->Internal->NestedElements)
+  {
+    nested->AppendBinary(buffer);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkPVXMLElement* vtkPVXMLElement::NewFromBinary(const char* data, size_t length)
+{
+  vtkPVXMLBinaryReader reader(data, length);
+
+  // Defined here rather than as a free function to get access to the
+  // methods used by the parser to set the id and character data.
+  std::function<bool(vtkPVXMLElement*)> readElement = [&](vtkPVXMLElement* element) {
+    std::string str, value;
+    if (!reader.ReadString(str))
+    {
+      return false;
+    }
+    element->SetName(str.empty() ? nullptr : str.c_str());
+    if (!reader.ReadString(str))
+    {
+      return false;
+    }
+    element->SetId(str.empty() ? nullptr : str.c_str());
+
+    vtkTypeUInt32 count;
+    if (!reader.ReadUInt32(count))
+    {
+      return false;
+    }
+    element->Internal->AttributeNames.reserve(count);
+    element->Internal->AttributeValues.reserve(count);
+    for (vtkTypeUInt32 cc = 0; cc < count; ++cc)
+    {
+      if (!reader.ReadString(str) || !reader.ReadString(value))
+      {
+        return false;
+      }
+      element->Internal->AttributeNames.push_back(str);
+      element->Internal->AttributeValues.push_back(value);
+    }
+
+    const char* cdata;
+    vtkTypeUInt32 cdataLength;
+    if (!reader.ReadString(cdata, cdataLength) || !reader.ReadUInt32(count))
+    {
+      return false;
+    }
+    element->Internal->CharacterData.assign(cdata ? cdata : "", cdataLength);
+    element->Internal->NestedElements.reserve(count);
+    for (vtkTypeUInt32 cc = 0; cc < count; ++cc)
+    {
+      vtkSmartPointer<vtkPVXMLElement> nested = vtkSmartPointer<vtkPVXMLElement>::New();
+      if (!readElement(nested))
+      {
+        return false;
+      }
+      element->AddNestedElement(nested);
+    }
+    return true;
+  };
+
+  vtkPVXMLElement* element = vtkPVXMLElement::New();
+  if (!readElement(element))
+  {
+    element->Delete();
+    return nullptr;
+  }
+  return element;
+}
@@ -26,6 +26,8 @@
 #include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
 #include "vtkStdString.h"                 // needed for vtkStdString.
 
+#include <vector> // needed for std::vector
+
 class vtkCollection;
 class vtkPVXMLParser;
 
@@ -262,6 +264,20 @@ public:
    */
   void CopyAttributesTo(vtkPVXMLElement* other);
 
+  //@{
+  /**
+   * Compact binary representation of the element and its nested elements,
+   * used to cache parsed XML. AppendBinary() appends the representation of
+   * this element to `buffer`. NewFromBinary() rebuilds an element from a
+   * representation of `length` bytes, or returns nullptr if it is invalid.
+   * The caller must release the reference to the returned element. The
+   * representation uses the native byte order and is not meant to be
+   * exchanged between machines.
+   */
+  void AppendBinary(std::vector<char>& buffer);
+  static vtkPVXMLElement* NewFromBinary(const char* data, size_t length);
+  //@}
+
 protected:
   vtkPVXMLElement();
   ~vtkPVXMLElement() override;
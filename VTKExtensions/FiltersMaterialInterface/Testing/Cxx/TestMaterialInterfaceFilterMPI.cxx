@@ -0,0 +1,169 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestMaterialInterfaceFilterMPI.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkMaterialInterfaceFilter finds the same fragments with
+// vtkMPIController, which exchanges ghost blocks and ghost fragment ids with
+// non-blocking messages and merges the equivalence sets along a tree, as with
+// the blocking path used by other controllers. The blocking path is run on
+// the same processes through a controller forwarding to the MPI communicator.
+
+#include "vtkCommunicator.h"
+#include "vtkDataArray.h"
+#include "vtkMPIController.h"
+#include "vtkMaterialInterfaceFilter.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpyPlotReader.h"
+#include "vtkTestUtilities.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#define CHECK(cond)                                                                                \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: Condition FAILED!! : " << #cond << " (line " << __LINE__ << ")" << endl;       \
+    success = false;                                                                               \
+  }
+
+namespace
+{
+// A controller using the communicator of another one. It is not a
+// vtkMPIController, so vtkMaterialInterfaceFilter uses its blocking path.
+class vtkForwardingController : public vtkMultiProcessController
+{
+public:
+  static vtkForwardingController* New();
+  vtkTypeMacro(vtkForwardingController, vtkMultiProcessController);
+
+  void SetController(vtkMultiProcessController* controller)
+  {
+    this->Communicator = controller->GetCommunicator();
+    this->Communicator->Register(this);
+    this->RMICommunicator = this->Communicator;
+    this->RMICommunicator->Register(this);
+  }
+
+  void Initialize(int*, char***) override {}
+  void Initialize(int*, char***, int) override {}
+  void Finalize() override {}
+  void Finalize(int) override {}
+  void SingleMethodExecute() override {}
+  void MultipleMethodExecute() override {}
+  void CreateOutputWindow() override {}
+  vtkMultiProcessController* CreateSubController(vtkProcessGroup*) override { return nullptr; }
+  vtkMultiProcessController* PartitionController(int, int) override { return nullptr; }
+
+protected:
+  vtkForwardingController() = default;
+  ~vtkForwardingController() override
+  {
+    if (this->Communicator)
+    {
+      this->Communicator->UnRegister(this);
+      this->RMICommunicator->UnRegister(this);
+    }
+  }
+
+private:
+  vtkForwardingController(const vtkForwardingController&) = delete;
+  void operator=(const vtkForwardingController&) = delete;
+};
+vtkStandardNewMacro(vtkForwardingController);
+
+// Sorted fragment volumes of each material, significant on process 0 only.
+std::vector<std::vector<double> > Execute(vtkMultiProcessController* controller,
+  vtkDataObject* input, const char* materialArrayName)
+{
+  // the filter uses the global controller.
+  vtkMultiProcessController::SetGlobalController(controller);
+  vtkNew<vtkMaterialInterfaceFilter> filter;
+  filter->SetInputData(input);
+  filter->SelectMaterialArray(materialArrayName);
+  filter->Update();
+
+  std::vector<std::vector<double> > volumes;
+  vtkMultiBlockDataSet* centers =
+    vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(1));
+  for (unsigned int material = 0; centers && material < centers->GetNumberOfBlocks(); ++material)
+  {
+    volumes.emplace_back();
+    vtkPolyData* fragments = vtkPolyData::SafeDownCast(centers->GetBlock(material));
+    vtkDataArray* volume = fragments ? fragments->GetPointData()->GetArray("Volume") : nullptr;
+    for (vtkIdType cc = 0; volume && cc < volume->GetNumberOfTuples(); ++cc)
+    {
+      volumes.back().push_back(volume->GetTuple1(cc));
+    }
+    std::sort(volumes.back().begin(), volumes.back().end());
+  }
+  return volumes;
+}
+}
+
+int TestMaterialInterfaceFilterMPI(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  const char* materialArrayName = "Material volume fraction - 2";
+  char* fname = vtkTestUtilities::ExpandDataFileName(
+    argc, argv, "Testing/Data/SPCTH/Dave_Karelitz_Small/spcth.0");
+  vtkNew<vtkSpyPlotReader> reader;
+  reader->SetFileName(fname);
+  reader->SetGlobalController(contr);
+  reader->MergeXYZComponentsOn();
+  reader->DownConvertVolumeFractionOn();
+  reader->SetCellArrayStatus(materialArrayName, 1);
+  reader->Update();
+  delete[] fname;
+
+  vtkNew<vtkForwardingController> blocking;
+  blocking->SetController(contr);
+
+  const auto actual = Execute(contr, reader->GetOutputDataObject(0), materialArrayName);
+  const auto expected = Execute(blocking, reader->GetOutputDataObject(0), materialArrayName);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  bool success = true;
+  if (contr->GetLocalProcessId() == 0)
+  {
+    // same number of fragments, and same volume for each of them.
+    CHECK(expected.size() == 1 && actual.size() == expected.size());
+    for (size_t material = 0; success && material < expected.size(); ++material)
+    {
+      CHECK(!expected[material].empty());
+      CHECK(actual[material].size() == expected[material].size());
+      for (size_t cc = 0; success && cc < expected[material].size(); ++cc)
+      {
+        const double tolerance = 1e-6 * std::abs(expected[material][cc]);
+        CHECK(std::abs(actual[material][cc] - expected[material][cc]) <= tolerance);
+      }
+    }
+  }
+
+  int local_success = success ? 1 : 0;
+  int all_success;
+  contr->AllReduce(&local_success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return all_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
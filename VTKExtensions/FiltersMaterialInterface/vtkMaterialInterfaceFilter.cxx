@@ -54,6 +54,7 @@
 #include "vtkMaterialInterfaceToProcMap.h"
 #include "vtkPointAccumulator.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedIntArray.h"
 // IO & IPC
@@ -90,8 +91,68 @@ using std::string;
 #include "vtkPlane.h"
 #include "vtkSphere.h"
 
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+#include "vtkMPIController.h"
+#include "vtksys/SystemTools.hxx"
+#include <list>
+#endif
+
 class InitializeVolumeFractrionArray;
 
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+namespace
+{
+//----------------------------------------------------------------------------
+// A non-blocking message and the buffer it is sent from or received into.
+// Requests are kept in lists so that buffers never move while in flight.
+template <typename T>
+struct vtkMaterialInterfaceCommRequest
+{
+  vtkMPICommunicator::Request Request;
+  std::vector<T> Buffer;
+  int ProcessId;
+};
+
+template <typename T>
+void WaitAll(std::list<vtkMaterialInterfaceCommRequest<T> >& requests)
+{
+  typename std::list<vtkMaterialInterfaceCommRequest<T> >::iterator it;
+  for (it = requests.begin(); it != requests.end(); ++it)
+  {
+    it->Request.Wait();
+  }
+  requests.clear();
+}
+
+// Moves the completed requests of a list to the end of completed.
+// Returns true if any request completed.
+template <typename T>
+bool TestSome(std::list<vtkMaterialInterfaceCommRequest<T> >& requests,
+  std::list<vtkMaterialInterfaceCommRequest<T> >& completed)
+{
+  bool progress = false;
+  typename std::list<vtkMaterialInterfaceCommRequest<T> >::iterator it = requests.begin();
+  while (it != requests.end())
+  {
+    typename std::list<vtkMaterialInterfaceCommRequest<T> >::iterator next = it;
+    ++next;
+    if (it->Request.Test())
+    {
+      completed.splice(completed.end(), requests, it);
+      progress = true;
+    }
+    it = next;
+  }
+  return progress;
+}
+
+int GetExtentSize(const int* ext)
+{
+  return (ext[1] - ext[0] + 1) * (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1);
+}
+}
+#endif
+
 vtkStandardNewMacro(vtkMaterialInterfaceFilter);
 vtkCxxSetObjectMacro(vtkMaterialInterfaceFilter, ClipFunction, vtkImplicitFunction);
 
@@ -497,11 +558,12 @@ public:
   ~vtkMaterialInterfaceFilterBlock();
 
   // For normal (local) blocks.
+  // The volume fraction array is initialized separately, so that
+  // it can be done for all blocks concurrently.
   void Initialize(int blockId, vtkImageData* imageBlock, int level, double globalOrigin[3],
-    double rootSapcing[3], string& volumeFractionArrayName, string& massArrayName,
-    vector<string>& volumeWtdAvgArrayNames, vector<string>& massWtdAvgArrayNames,
-    vector<string>& summedArrayNames, vector<string>& integratedArrayNames,
-    int invertVolumeFraction, vtkMaterialInterfaceFilterHalfSphere* sphere);
+    double rootSapcing[3], string& massArrayName, vector<string>& volumeWtdAvgArrayNames,
+    vector<string>& massWtdAvgArrayNames, vector<string>& summedArrayNames,
+    vector<string>& integratedArrayNames);
 
   void InitializeVolumeFractionArray(int invertVolumeFraction,
     vtkMaterialInterfaceFilterHalfSphere* sphere, vtkDataArray* volumeFractionArray);
@@ -750,11 +812,9 @@ void vtkMaterialInterfaceFilterBlock::InitializeVolumeFractionArray(int invertVo
 //----------------------------------------------------------------------------
 // The argument list is getting long!
 void vtkMaterialInterfaceFilterBlock::Initialize(int blockId, vtkImageData* image, int level,
-  double globalOrigin[3], double rootSpacing[3], string& volumeFractionArrayName,
-  string& massArrayName, vector<string>& volumeWtdAvgArrayNames,
-  vector<string>& massWtdAvgArrayNames, vector<string>& summedArrayNames,
-  vector<string>& integratedArrayNames, int invertVolumeFraction,
-  vtkMaterialInterfaceFilterHalfSphere* sphere)
+  double globalOrigin[3], double rootSpacing[3], string& massArrayName,
+  vector<string>& volumeWtdAvgArrayNames, vector<string>& massWtdAvgArrayNames,
+  vector<string>& summedArrayNames, vector<string>& integratedArrayNames)
 {
   if (this->VolumeFractionArray)
   {
@@ -898,13 +958,6 @@ void vtkMaterialInterfaceFilterBlock::Initialize(int blockId, vtkImageData* imag
     this->HalfEdges[2][ii] = -this->HalfEdges[3][ii];
     this->HalfEdges[4][ii] = -this->HalfEdges[5][ii];
   }
-
-  // get a pointer to the volume fraction data
-  // We can mdify the volume fractin array for clipping.
-  vtkDataArray* volumeFractionArray =
-    this->Image->GetCellData()->GetArray(volumeFractionArrayName.c_str());
-  assert("Could not find volume fraction array." && volumeFractionArray);
-  this->InitializeVolumeFractionArray(invertVolumeFraction, sphere, volumeFractionArray);
 }
 
 //----------------------------------------------------------------------------
@@ -1557,6 +1610,8 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
   this->NumberOfGhostBlocks = 0;
   this->ProcessBlocksTimer = vtkSmartPointer<vtkTimerLog>::New();
   this->ResolveEquivalencesTimer = vtkSmartPointer<vtkTimerLog>::New();
+  this->ShareGhostEquivalencesTimer = vtkSmartPointer<vtkTimerLog>::New();
+  this->MergeEquivalenceSetsTimer = vtkSmartPointer<vtkTimerLog>::New();
 #endif
 
 #ifdef vtkMaterialInterfaceFilterDEBUG
@@ -1808,6 +1863,7 @@ void vtkMaterialInterfaceFilter::DeleteAllBlocks()
     delete block;
   }
   this->GhostBlocks.clear();
+  this->GhostBlockRequests.clear();
 
   // Normal Blocks
   for (ii = 0; ii < this->NumberOfInputBlocks; ++ii)
@@ -1848,8 +1904,6 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
   int level;
   int numLevels = input->GetNumberOfLevels();
   vtkMaterialInterfaceFilterBlock* block;
-  int myProc = this->Controller->GetLocalProcessId();
-  int numProcs = this->Controller->GetNumberOfProcesses();
   vtkMaterialInterfaceFilterHalfSphere* sphere = 0;
 
 #ifdef vtkMaterialInterfaceFilterPROFILE
@@ -1898,6 +1952,7 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
 
   // Initialize each block with the input image
   // and global index coordinate system.
+  vector<vtkDataArray*> volumeFractionArrays(this->NumberOfInputBlocks, nullptr);
   int blockIndex = -1;
   this->Levels.resize(numLevels);
   for (level = 0; level < numLevels; ++level)
@@ -1923,8 +1978,13 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
         // We use it to find neighbors.  We should save pointers
         // directly in neighbor array. We also use it for debugging.
         block->Initialize(blockIndex, image, level, this->GlobalOrigin, this->RootSpacing,
-          materialFractionArrayName, massArrayName, volumeWtdAvgArrayNames, massWtdAvgArrayNames,
-          summedArrayNames, integratedArrayNames, this->InvertVolumeFraction, sphere);
+          massArrayName, volumeWtdAvgArrayNames, massWtdAvgArrayNames, summedArrayNames,
+          integratedArrayNames);
+        // get a pointer to the volume fraction data
+        // We can mdify the volume fractin array for clipping.
+        volumeFractionArrays[blockIndex] =
+          image->GetCellData()->GetArray(materialFractionArrayName.c_str());
+        assert("Could not find volume fraction array." && volumeFractionArrays[blockIndex]);
         // For debugging:
         block->LevelBlockId = levelBlockId;
 
@@ -1969,52 +2029,36 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
     cumulativeExt[5] = cumulativeExt[5] / this->StandardBlockDimensions[2];
 
     // Expand extent to cover all processes.
-    if (myProc > 0)
-    {
-      this->Controller->Send(cumulativeExt, 6, 0, 212130);
-      this->Controller->Receive(cumulativeExt, 6, 0, 212131);
-    }
-    else
-    {
-      int tmp[6];
-      for (int ii = 1; ii < numProcs; ++ii)
-      {
-        this->Controller->Receive(tmp, 6, ii, 212130);
-        if (cumulativeExt[0] > tmp[0])
-        {
-          cumulativeExt[0] = tmp[0];
-        }
-        if (cumulativeExt[1] < tmp[1])
-        {
-          cumulativeExt[1] = tmp[1];
-        }
-        if (cumulativeExt[2] > tmp[2])
-        {
-          cumulativeExt[2] = tmp[2];
-        }
-        if (cumulativeExt[3] < tmp[3])
-        {
-          cumulativeExt[3] = tmp[3];
-        }
-        if (cumulativeExt[4] > tmp[4])
-        {
-          cumulativeExt[4] = tmp[4];
-        }
-        if (cumulativeExt[5] < tmp[5])
-        {
-          cumulativeExt[5] = tmp[5];
-        }
-      }
-      // Redistribute the global grid extent
-      for (int ii = 1; ii < numProcs; ++ii)
-      {
-        this->Controller->Send(cumulativeExt, 6, ii, 212131);
-      }
-    }
+    // Negate the maximums so that a single reduction does it.
+    int tmp[6];
+    cumulativeExt[1] = -cumulativeExt[1];
+    cumulativeExt[3] = -cumulativeExt[3];
+    cumulativeExt[5] = -cumulativeExt[5];
+    this->Controller->AllReduce(cumulativeExt, tmp, 6, vtkCommunicator::MIN_OP);
+    cumulativeExt[0] = tmp[0];
+    cumulativeExt[1] = -tmp[1];
+    cumulativeExt[2] = tmp[2];
+    cumulativeExt[3] = -tmp[3];
+    cumulativeExt[4] = tmp[4];
+    cumulativeExt[5] = -tmp[5];
 
     this->Levels[level]->Initialize(cumulativeExt, level);
     this->Levels[level]->SetStandardBlockDimensions(this->StandardBlockDimensions);
   }
+
+  // Copy (and clip) the volume fractions.  Blocks do not share anything
+  // here so they are processed concurrently.
+  const int invertVolumeFraction = this->InvertVolumeFraction;
+  vtkSMPTools::For(0, this->NumberOfInputBlocks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      if (this->InputBlocks[blockId])
+      {
+        this->InputBlocks[blockId]->InitializeVolumeFractionArray(
+          invertVolumeFraction, sphere, volumeFractionArrays[blockId]);
+      }
+    }
+  });
   delete sphere;
   sphere = 0;
 
@@ -2933,6 +2977,11 @@ void vtkMaterialInterfaceFilter::ComputeAndDistributeGhostBlocks(
   int dataSize;
   vtkMaterialInterfaceFilterBlock* ghostBlock;
 
+  if (this->ExchangeGhostBlocks(numBlocksInProc, blockMetaData, myProc, numProcs))
+  {
+    return;
+  }
+
   // Loop through the other processes.
   int* blockMetaDataPtr = blockMetaData;
   for (int otherProc = 0; otherProc < numProcs; ++otherProc)
@@ -3053,6 +3102,205 @@ void vtkMaterialInterfaceFilter::HandleGhostBlockRequests()
   }
 }
 
+//----------------------------------------------------------------------------
+// Ghost blocks are requested from every process at once and the requests of
+// the other processes are served as they arrive, so that no process waits
+// for its turn as in ComputeAndDistributeGhostBlocks.
+// Messages are:
+// Request count: number of blocks requested from a process.
+// Requests: (block id, required extent) for each block.
+// Ghost blocks: volume fractions of all the requested extents, concatenated.
+bool vtkMaterialInterfaceFilter::ExchangeGhostBlocks(
+  int* numBlocksInProc, int* blockMetaData, int myProc, int numProcs)
+{
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  vtkMPIController* controller = vtkMPIController::SafeDownCast(this->Controller);
+  if (controller == 0)
+  {
+    return false;
+  }
+  typedef std::list<vtkMaterialInterfaceCommRequest<int> > IntRequestList;
+  typedef std::list<vtkMaterialInterfaceCommRequest<unsigned char> > CharRequestList;
+
+  // Compute the ghost blocks we need from every other process.
+  // Ghost blocks are not taken into account by ComputeRequiredGhostExtent
+  // so all of them can be computed before adding any ghost block.
+  std::vector<std::vector<int> > requests(numProcs);
+  std::vector<std::vector<int> > requestLevels(numProcs);
+  std::vector<int> requestCounts(numProcs, 0);
+  std::vector<int> ghostDataSizes(numProcs, 0);
+  int* blockMetaDataPtr = blockMetaData;
+  for (int otherProc = 0; otherProc < numProcs; ++otherProc)
+  {
+    for (int id = 0; id < numBlocksInProc[otherProc]; ++id, blockMetaDataPtr += 7)
+    {
+      // Block meta data is level and base-cell-extent.
+      int ext[6];
+      if (otherProc != myProc &&
+        this->ComputeRequiredGhostExtent(blockMetaDataPtr[0], blockMetaDataPtr + 1, ext))
+      {
+        requests[otherProc].push_back(id);
+        requests[otherProc].insert(requests[otherProc].end(), ext, ext + 6);
+        requestLevels[otherProc].push_back(blockMetaDataPtr[0]);
+        ghostDataSizes[otherProc] += GetExtentSize(ext);
+        ++requestCounts[otherProc];
+      }
+    }
+  }
+
+  // Tell every process how many blocks we need from it.
+  IntRequestList countSends, countReceives;
+  for (int otherProc = 0; otherProc < numProcs; ++otherProc)
+  {
+    if (otherProc == myProc)
+    {
+      continue;
+    }
+    countReceives.push_back(vtkMaterialInterfaceCommRequest<int>());
+    countReceives.back().ProcessId = otherProc;
+    countReceives.back().Buffer.resize(1, 0);
+    controller->NoBlockReceive(
+      &countReceives.back().Buffer[0], 1, otherProc, 708922, countReceives.back().Request);
+    countSends.push_back(vtkMaterialInterfaceCommRequest<int>());
+    countSends.back().ProcessId = otherProc;
+    countSends.back().Buffer.resize(1, requestCounts[otherProc]);
+    controller->NoBlockSend(
+      &countSends.back().Buffer[0], 1, otherProc, 708922, countSends.back().Request);
+  }
+
+  // Send our requests, and get ready to receive the blocks.
+  IntRequestList requestSends;
+  CharRequestList ghostReceives;
+  for (int otherProc = 0; otherProc < numProcs; ++otherProc)
+  {
+    if (requestCounts[otherProc] == 0)
+    {
+      continue;
+    }
+    ghostReceives.push_back(vtkMaterialInterfaceCommRequest<unsigned char>());
+    ghostReceives.back().ProcessId = otherProc;
+    ghostReceives.back().Buffer.resize(ghostDataSizes[otherProc]);
+    controller->NoBlockReceive(&ghostReceives.back().Buffer[0], ghostDataSizes[otherProc],
+      otherProc, 433240, ghostReceives.back().Request);
+    requestSends.push_back(vtkMaterialInterfaceCommRequest<int>());
+    requestSends.back().ProcessId = otherProc;
+    requestSends.back().Buffer = requests[otherProc];
+    controller->NoBlockSend(&requestSends.back().Buffer[0], 7 * requestCounts[otherProc],
+      otherProc, 708923, requestSends.back().Request);
+  }
+
+  // Get ready to receive the requests of the processes that need our blocks.
+  // Counts are the first thing every process sends so this wait is short.
+  this->GhostBlockRequests.clear();
+  this->GhostBlockRequests.resize(numProcs);
+  IntRequestList requestReceives;
+  for (IntRequestList::iterator it = countReceives.begin(); it != countReceives.end(); ++it)
+  {
+    it->Request.Wait();
+    const int count = it->Buffer[0];
+    if (count > 0)
+    {
+      requestReceives.push_back(vtkMaterialInterfaceCommRequest<int>());
+      requestReceives.back().ProcessId = it->ProcessId;
+      requestReceives.back().Buffer.resize(7 * count);
+      controller->NoBlockReceive(&requestReceives.back().Buffer[0], 7 * count, it->ProcessId,
+        708923, requestReceives.back().Request);
+    }
+  }
+  countReceives.clear();
+
+  // Serve requests and make ghost blocks as messages arrive.
+  // Ghost blocks are added in the order of their owner process, like
+  // ComputeAndDistributeGhostBlocks does.
+  CharRequestList ghostSends;
+  IntRequestList receivedRequests;
+  CharRequestList receivedGhosts;
+  std::vector<unsigned char*> ghostData(numProcs, static_cast<unsigned char*>(0));
+  int nextProc = 0;
+  while (!requestReceives.empty() || nextProc < numProcs)
+  {
+    bool progress = TestSome(requestReceives, receivedRequests);
+    for (IntRequestList::iterator it = receivedRequests.begin(); it != receivedRequests.end();
+         ++it)
+    {
+      const int otherProc = it->ProcessId;
+      const std::vector<int>& request = it->Buffer;
+      const int count = static_cast<int>(request.size()) / 7;
+      int dataSize = 0;
+      for (int ii = 0; ii < count; ++ii)
+      {
+        dataSize += GetExtentSize(&request[7 * ii + 1]);
+      }
+      ghostSends.push_back(vtkMaterialInterfaceCommRequest<unsigned char>());
+      ghostSends.back().ProcessId = otherProc;
+      ghostSends.back().Buffer.resize(dataSize, 0);
+      unsigned char* buf = dataSize ? &ghostSends.back().Buffer[0] : 0;
+      for (int ii = 0; ii < count; ++ii)
+      {
+        const int blockId = request[7 * ii];
+        int ext[6];
+        std::copy(request.begin() + 7 * ii + 1, request.begin() + 7 * ii + 7, ext);
+        if (blockId < 0 || blockId >= this->NumberOfInputBlocks || !this->InputBlocks[blockId])
+        {
+          // Unlike with HandleGhostBlockRequests, this does not lock up.
+          vtkErrorMacro("Missing block request.");
+        }
+        else
+        {
+          this->InputBlocks[blockId]->ExtractExtent(buf, ext);
+        }
+        buf += GetExtentSize(ext);
+      }
+      controller->NoBlockSend(dataSize ? &ghostSends.back().Buffer[0] : 0, dataSize, otherProc,
+        433240, ghostSends.back().Request);
+      this->GhostBlockRequests[otherProc] = request;
+    }
+    receivedRequests.clear();
+
+    progress |= TestSome(ghostReceives, receivedGhosts);
+    for (CharRequestList::iterator it = receivedGhosts.begin(); it != receivedGhosts.end(); ++it)
+    {
+      ghostData[it->ProcessId] = &it->Buffer[0];
+    }
+    while (nextProc < numProcs && (requestCounts[nextProc] == 0 || ghostData[nextProc]))
+    {
+      unsigned char* buf = ghostData[nextProc];
+      for (int ii = 0; ii < requestCounts[nextProc]; ++ii)
+      {
+        const int id = requests[nextProc][7 * ii];
+        int* ext = &requests[nextProc][7 * ii + 1];
+        // Make the ghost block and add it to the grid.
+        vtkMaterialInterfaceFilterBlock* ghostBlock = new vtkMaterialInterfaceFilterBlock;
+        ghostBlock->InitializeGhostLayer(buf, ext, requestLevels[nextProc][ii], this->GlobalOrigin,
+          this->RootSpacing, nextProc, id);
+        // Save for deleting.
+        this->GhostBlocks.push_back(ghostBlock);
+        // Add to grid and connect up neighbors.
+        this->AddBlock(ghostBlock, this->GetBlockGhostLevel());
+        buf += GetExtentSize(ext);
+      }
+      ++nextProc;
+    }
+
+    if (!progress && (!requestReceives.empty() || nextProc < numProcs))
+    {
+      vtksys::SystemTools::Delay(1);
+    }
+  }
+
+  WaitAll(countSends);
+  WaitAll(requestSends);
+  WaitAll(ghostSends);
+  return true;
+#else
+  (void)numBlocksInProc;
+  (void)blockMetaData;
+  (void)myProc;
+  (void)numProcs;
+  return false;
+#endif
+}
+
 //----------------------------------------------------------------------------
 // TODO: Try to not get extents supplied by existing overlap.
 // Return 1 if we need this ghost block.  Ext is the part we need.
@@ -3680,61 +3928,46 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
 #ifdef vtkMaterialInterfaceFilterPROFILE
   // Lets profile to see what takes the most time for large number of processes.
-  double initializeTime, shareGhostBlocksTime, processBlocksTime, resolveEquivalencesTime;
-  unsigned long numberOfBlocks, numberOfGhostBlocks;
-  initializeTime = this->InitializeBlocksTimer->GetElapsedTime();
-  shareGhostBlocksTime = this->ShareGhostBlocksTimer->GetElapsedTime();
-  processBlocksTime = this->ProcessBlocksTimer->GetElapsedTime();
-  resolveEquivalencesTime = this->ResolveEquivalencesTimer->GetElapsedTime();
-  numberOfBlocks = this->NumberOfBlocks;
-  numberOfGhostBlocks = this->NumberOfGhostBlocks;
+  // Printing every process does not scale, so we reduce each value
+  // to its minimum, average and maximum over the processes.
+  const int numberOfValues = 8;
+  const char* names[numberOfValues] = { "InitializeTime", "ShareGhostBlocksTime",
+    "ProcessBlocksTime", "ResolveEquivalencesTime", "ShareGhostEquivalencesTime",
+    "MergeEquivalenceSetsTime", "NumberOfBlocks", "NumberOfGhostBlocks" };
+  double values[numberOfValues];
+  values[0] = this->InitializeBlocksTimer->GetElapsedTime();
+  values[1] = this->ShareGhostBlocksTimer->GetElapsedTime();
+  values[2] = this->ProcessBlocksTimer->GetElapsedTime();
+  values[3] = this->ResolveEquivalencesTimer->GetElapsedTime();
+  values[4] = this->ShareGhostEquivalencesTimer->GetElapsedTime();
+  values[5] = this->MergeEquivalenceSetsTimer->GetElapsedTime();
+  values[6] = this->NumberOfBlocks;
+  values[7] = this->NumberOfGhostBlocks;
   if (this->Controller == 0)
   {
-    cout << "InitializeTime: " << initializeTime << endl;
-    cout << "ShareGhostBlocksTime: " << shareGhostBlocksTime << endl;
-    cout << "NumberOfBlocks: " << numberOfBlocks << endl;
-    cout << "NumberOfGhostBlocks: " << numberOfGhostBlocks << endl;
-    cout << "ProcessBlocksTime: " << processBlocksTime << endl;
-    cout << "ResolveEquivalencesTimer: " << resolveEquivalencesTime << endl;
+    for (int ii = 0; ii < numberOfValues; ++ii)
+    {
+      cout << names[ii] << ": " << values[ii] << endl;
+    }
   }
   else
   {
     int numProcs = this->Controller->GetNumberOfProcesses();
+    double minValues[numberOfValues];
+    double maxValues[numberOfValues];
+    double sumValues[numberOfValues];
+    this->Controller->Reduce(values, minValues, numberOfValues, vtkCommunicator::MIN_OP, 0);
+    this->Controller->Reduce(values, maxValues, numberOfValues, vtkCommunicator::MAX_OP, 0);
+    this->Controller->Reduce(values, sumValues, numberOfValues, vtkCommunicator::SUM_OP, 0);
     if (this->Controller->GetLocalProcessId() == 0)
     {
-      cout << "Process 0: \n";
-      cout << "  InitializeTime: " << initializeTime << endl;
-      cout << "  ShareGhostBlocksTime: " << shareGhostBlocksTime << endl;
-      cout << "  NumberOfBlocks: " << numberOfBlocks << endl;
-      cout << "  NumberOfGhostBlocks: " << numberOfGhostBlocks << endl;
-      cout << "  ProcessBlocksTime: " << processBlocksTime << endl;
-      cout << "  ResolveEquivalencesTimer: " << resolveEquivalencesTime << endl;
-      for (int procIdx = 1; procIdx < numProcs; ++procIdx)
+      cout << numProcs << " processes (min/avg/max): \n";
+      for (int ii = 0; ii < numberOfValues; ++ii)
       {
-        this->Controller->Receive(&initializeTime, 1, procIdx, 234908);
-        this->Controller->Receive(&shareGhostBlocksTime, 1, procIdx, 234909);
-        this->Controller->Receive(&processBlocksTime, 1, procIdx, 234910);
-        this->Controller->Receive(&resolveEquivalencesTime, 1, procIdx, 234911);
-        this->Controller->Receive(&numberOfBlocks, 1, procIdx, 234912);
-        this->Controller->Receive(&numberOfGhostBlocks, 1, procIdx, 234913);
-        cout << "Process " << procIdx << ": \n";
-        cout << "  InitializeTime: " << initializeTime << endl;
-        cout << "  ShareGhostBlocksTime: " << shareGhostBlocksTime << endl;
-        cout << "  NumberOfBlocks: " << numberOfBlocks << endl;
-        cout << "  NumberOfGhostBlocks: " << numberOfGhostBlocks << endl;
-        cout << "  ProcessBlocksTime: " << processBlocksTime << endl;
-        cout << "  ResolveEquivalencesTimer: " << resolveEquivalencesTime << endl;
+        cout << "  " << names[ii] << ": " << minValues[ii] << " / " << sumValues[ii] / numProcs
+             << " / " << maxValues[ii] << endl;
       }
     }
-    else
-    {
-      this->Controller->Send(&initializeTime, 1, 0, 234908);
-      this->Controller->Send(&shareGhostBlocksTime, 1, 0, 234909);
-      this->Controller->Send(&processBlocksTime, 1, 0, 234910);
-      this->Controller->Send(&resolveEquivalencesTime, 1, 0, 234911);
-      this->Controller->Send(&numberOfBlocks, 1, 0, 234912);
-      this->Controller->Send(&numberOfGhostBlocks, 1, 0, 234913);
-    }
   }
 #endif
 
@@ -8280,24 +8513,7 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   const int numLocalMembers = set->GetNumberOfMembers();
 
   // Find a mapping between local fragment id and the global fragment ids.
-  if (myProcId == 0)
-  {
-    this->NumberOfRawFragmentsInProcess[0] = numLocalMembers;
-    for (int ii = 1; ii < numProcs; ++ii)
-    {
-      this->Controller->Receive(this->NumberOfRawFragmentsInProcess + ii, 1, ii, 875034);
-    }
-    // Now send the results back to all processes.
-    for (int ii = 1; ii < numProcs; ++ii)
-    {
-      this->Controller->Send(this->NumberOfRawFragmentsInProcess, numProcs, ii, 875035);
-    }
-  }
-  else
-  {
-    this->Controller->Send(&numLocalMembers, 1, 0, 875034);
-    this->Controller->Receive(this->NumberOfRawFragmentsInProcess, numProcs, 0, 875035);
-  }
+  this->Controller->AllGather(&numLocalMembers, this->NumberOfRawFragmentsInProcess, 1);
   // Compute offsets.
   int totalNumberOfIds = 0;
   for (int ii = 0; ii < numProcs; ++ii)
@@ -8335,14 +8551,26 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   // Now add equivalents between processes.
   // Send all the ghost blocks to the process that owns the block.
   // Compare ids and add the equivalences.
+#ifdef vtkMaterialInterfaceFilterPROFILE
+  this->ShareGhostEquivalencesTimer->StartTimer();
+#endif
   this->ShareGhostEquivalences(globalSet, this->LocalToGlobalOffsets);
+#ifdef vtkMaterialInterfaceFilterPROFILE
+  this->ShareGhostEquivalencesTimer->StopTimer();
+#endif
 
   // cerr << "Global after ghost: " << myProcId << endl;
   // globalSet->Print();
 
   // Merge all of the processes global sets.
   // Clean the global set so that the resulting set ids are sequential.
+#ifdef vtkMaterialInterfaceFilterPROFILE
+  this->MergeEquivalenceSetsTimer->StartTimer();
+#endif
   this->MergeGhostEquivalenceSets(globalSet);
+#ifdef vtkMaterialInterfaceFilterPROFILE
+  this->MergeEquivalenceSetsTimer->StopTimer();
+#endif
 
   // cerr << "Global after merge: " << myProcId << endl;
   // globalSet->Print();
@@ -8358,61 +8586,102 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
 }
 
 //----------------------------------------------------------------------------
+// The sets are merged pairwise along a binary tree, so that process 0 merges
+// log2(numProcs) sets instead of all of them, then the resolved set is
+// broadcast.
 void vtkMaterialInterfaceFilter::MergeGhostEquivalenceSets(
   vtkMaterialInterfaceEquivalenceSet* globalSet)
 {
   const int myProcId = this->Controller->GetLocalProcessId();
+  const int numProcs = this->Controller->GetNumberOfProcesses();
   int* buf = globalSet->GetPointer();
   const int numIds = globalSet->GetNumberOfMembers();
 
   // At this point all the sets are global and have the same number of ids.
-  // Send all the sets to process 0 to be merged.
-  if (myProcId > 0)
-  {
-    this->Controller->Send(buf, numIds, 0, 342320);
-    // Now receive the final equivalences.
-    this->Controller->Receive(&this->NumberOfResolvedFragments, 1, 0, 342321);
-    // Domain has numIds,  range has NumberOfResolvedFragments
-    this->Controller->Receive(buf, numIds, 0, 342322);
-    // We have to mark the set as resolved because the set being
-    // received has been resolved.  If we do not do this then
-    // We cannot get the proper set id.  Using the pointer
-    // here is a bad api.  TODO: Fix the API and make "Resolved" private.
-    globalSet->Resolved = 1;
-    return;
-  }
-
-  // Only process 0 from here out.
-
-  int numProcs = this->Controller->GetNumberOfProcesses();
-  int* tmp;
-  tmp = new int[numIds];
-  for (int ii = 1; ii < numProcs; ++ii)
+  // Every id of a set references an equivalent id so the references
+  // of a set are all we need to merge it with another.
+  // The pointers should still be valid.
+  // The array should not resize here.
+  int* tmp = new int[numIds];
+  for (int step = 1; step < numProcs; step *= 2)
   {
-    this->Controller->Receive(tmp, numIds, ii, 342320);
-    // Merge the values.
-    for (int jj = 0; jj < numIds; ++jj)
+    if (myProcId % (2 * step))
+    {
+      this->Controller->Send(buf, numIds, myProcId - step, 342320);
+      break;
+    }
+    if (myProcId + step < numProcs)
     {
-      if (tmp[jj] != jj)
-      { // TODO: Make sure this is efficient.  Avoid n^2.
-        globalSet->AddEquivalence(jj, tmp[jj]);
+      this->Controller->Receive(tmp, numIds, myProcId + step, 342320);
+      // Merge the values.
+      for (int jj = 0; jj < numIds; ++jj)
+      {
+        if (tmp[jj] != jj)
+        { // TODO: Make sure this is efficient.  Avoid n^2.
+          globalSet->AddEquivalence(jj, tmp[jj]);
+        }
       }
     }
   }
   delete[] tmp;
 
-  // Make the set ids sequential.
-  this->NumberOfResolvedFragments = globalSet->ResolveEquivalences();
+  if (myProcId == 0)
+  {
+    // Make the set ids sequential.
+    this->NumberOfResolvedFragments = globalSet->ResolveEquivalences();
+  }
 
-  // The pointers should still be valid.
-  // The array should not resize here.
   // Number of resolved fragemnts will be smaller
   // than TotalNumberOfRawFragments
-  for (int ii = 1; ii < numProcs; ++ii)
+  this->Controller->Broadcast(&this->NumberOfResolvedFragments, 1, 0);
+  // Domain has numIds,  range has NumberOfResolvedFragments
+  this->Controller->Broadcast(buf, numIds, 0);
+  // We have to mark the set as resolved because the set being
+  // received has been resolved.  If we do not do this then
+  // We cannot get the proper set id.  Using the pointer
+  // here is a bad api.  TODO: Fix the API and make "Resolved" private.
+  globalSet->Resolved = 1;
+}
+
+//----------------------------------------------------------------------------
+// Adds the equivalences between the fragments of a local block and the
+// fragment ids another process found in its ghost copy of the block.
+static void AddGhostFragmentEquivalences(vtkMaterialInterfaceEquivalenceSet* globalSet,
+  vtkMaterialInterfaceFilterBlock* block, const int* remoteExt, const int* remoteFragmentIds,
+  int localOffset, int remoteOffset)
+{
+  // Loop through all of the voxels.
+  int* localFragmentIds = block->GetFragmentIdPointer();
+  int localExt[6];
+  int localIncs[3];
+  block->GetCellExtent(localExt);
+  block->GetCellIncrements(localIncs);
+  int *px, *py, *pz;
+  int localId, remoteId;
+  // Find the starting voxel in the local block.
+  pz = localFragmentIds + (remoteExt[0] - localExt[0]) * localIncs[0] +
+    (remoteExt[2] - localExt[2]) * localIncs[1] + (remoteExt[4] - localExt[4]) * localIncs[2];
+  for (int iz = remoteExt[4]; iz <= remoteExt[5]; ++iz)
   {
-    this->Controller->Send(&this->NumberOfResolvedFragments, 1, ii, 342321);
-    // Domain has numIds,  range has NumberOfResolvedFragments
-    this->Controller->Send(buf, numIds, ii, 342322);
+    py = pz;
+    for (int iy = remoteExt[2]; iy <= remoteExt[3]; ++iy)
+    {
+      px = py;
+      for (int ix = remoteExt[0]; ix <= remoteExt[1]; ++ix)
+      {
+        // Convert local fragment ids to global ids.
+        localId = *px;
+        remoteId = *remoteFragmentIds;
+        if (localId >= 0 && remoteId >= 0)
+        {
+          globalSet->AddEquivalence(localId + localOffset, remoteId + remoteOffset);
+        }
+        ++remoteFragmentIds;
+        ++px;
+      }
+      py += localIncs[1];
+    }
+    pz += localIncs[2];
   }
 }
 
@@ -8424,6 +8693,11 @@ void vtkMaterialInterfaceFilter::ShareGhostEquivalences(
   const int myProcId = this->Controller->GetLocalProcessId();
   int sendMsg[8];
 
+  if (this->ExchangeGhostFragmentIds(globalSet, procOffsets))
+  {
+    return;
+  }
+
   // Loop through the other processes.
   for (int otherProc = 0; otherProc < numProcs; ++otherProc)
   {
@@ -8479,7 +8753,6 @@ void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
   int* buf = 0;
   int dataSize;
   int* remoteExt;
-  int localId, remoteId;
   const int myProcId = this->Controller->GetLocalProcessId();
   int localOffset = procOffsets[myProcId];
   int remoteOffset;
@@ -8521,39 +8794,7 @@ void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
       this->Controller->Receive(buf, dataSize, otherProc, 722266);
       // We have our block, and the remote fragmentIds.
       // Now for the equivalences.
-      // Loop through all of the voxels.
-      int* remoteFragmentIds = buf;
-      int* localFragmentIds = block->GetFragmentIdPointer();
-      int localExt[6];
-      int localIncs[3];
-      block->GetCellExtent(localExt);
-      block->GetCellIncrements(localIncs);
-      int *px, *py, *pz;
-      // Find the starting voxel in the local block.
-      pz = localFragmentIds + (remoteExt[0] - localExt[0]) * localIncs[0] +
-        (remoteExt[2] - localExt[2]) * localIncs[1] + (remoteExt[4] - localExt[4]) * localIncs[2];
-      for (int iz = remoteExt[4]; iz <= remoteExt[5]; ++iz)
-      {
-        py = pz;
-        for (int iy = remoteExt[2]; iy <= remoteExt[3]; ++iy)
-        {
-          px = py;
-          for (int ix = remoteExt[0]; ix <= remoteExt[1]; ++ix)
-          {
-            // Convert local fragment ids to global ids.
-            localId = *px;
-            remoteId = *remoteFragmentIds;
-            if (localId >= 0 && remoteId >= 0)
-            {
-              globalSet->AddEquivalence(localId + localOffset, remoteId + remoteOffset);
-            }
-            ++remoteFragmentIds;
-            ++px;
-          }
-          py += localIncs[1];
-        }
-        pz += localIncs[2];
-      }
+      AddGhostFragmentEquivalences(globalSet, block, remoteExt, buf, localOffset, remoteOffset);
     }
   }
   if (buf)
@@ -8562,6 +8803,109 @@ void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
   }
 }
 
+//----------------------------------------------------------------------------
+// Non-blocking version of ShareGhostEquivalences. The fragment ids of all
+// the ghost blocks owned by a process are sent in one message, in the order
+// the blocks were requested by ExchangeGhostBlocks, so that the owner knows
+// what it receives from the requests it served.
+bool vtkMaterialInterfaceFilter::ExchangeGhostFragmentIds(
+  vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffsets)
+{
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  vtkMPIController* controller = vtkMPIController::SafeDownCast(this->Controller);
+  const int numProcs = this->Controller->GetNumberOfProcesses();
+  if (controller == 0 || static_cast<int>(this->GhostBlockRequests.size()) != numProcs)
+  {
+    return false;
+  }
+  typedef std::list<vtkMaterialInterfaceCommRequest<int> > IntRequestList;
+  const int myProcId = this->Controller->GetLocalProcessId();
+
+  // Get ready to receive the fragment ids of the blocks we served.
+  IntRequestList receives;
+  for (int otherProc = 0; otherProc < numProcs; ++otherProc)
+  {
+    const std::vector<int>& request = this->GhostBlockRequests[otherProc];
+    int dataSize = 0;
+    for (size_t ii = 0; ii + 7 <= request.size(); ii += 7)
+    {
+      dataSize += GetExtentSize(&request[ii + 1]);
+    }
+    if (dataSize > 0)
+    {
+      receives.push_back(vtkMaterialInterfaceCommRequest<int>());
+      receives.back().ProcessId = otherProc;
+      receives.back().Buffer.resize(dataSize);
+      controller->NoBlockReceive(
+        &receives.back().Buffer[0], dataSize, otherProc, 722266, receives.back().Request);
+    }
+  }
+
+  // Send the fragment ids of our ghost blocks to their owners.
+  std::vector<std::vector<int> > fragmentIds(numProcs);
+  int num = static_cast<int>(this->GhostBlocks.size());
+  for (int blockId = 0; blockId < num; ++blockId)
+  {
+    vtkMaterialInterfaceFilterBlock* block = this->GhostBlocks[blockId];
+    if (block && block->GetGhostFlag())
+    {
+      int ext[6];
+      block->GetCellExtent(ext);
+      int* ids = block->GetFragmentIdPointer();
+      std::vector<int>& buf = fragmentIds[block->GetOwnerProcessId()];
+      buf.insert(buf.end(), ids, ids + GetExtentSize(ext));
+    }
+  }
+  IntRequestList sends;
+  for (int otherProc = 0; otherProc < numProcs; ++otherProc)
+  {
+    if (otherProc != myProcId && !fragmentIds[otherProc].empty())
+    {
+      sends.push_back(vtkMaterialInterfaceCommRequest<int>());
+      sends.back().ProcessId = otherProc;
+      sends.back().Buffer.swap(fragmentIds[otherProc]);
+      controller->NoBlockSend(&sends.back().Buffer[0],
+        static_cast<int>(sends.back().Buffer.size()), otherProc, 722266, sends.back().Request);
+    }
+  }
+
+  // Add the equivalences as fragment ids arrive.
+  const int localOffset = procOffsets[myProcId];
+  IntRequestList received;
+  while (!receives.empty())
+  {
+    if (!TestSome(receives, received))
+    {
+      vtksys::SystemTools::Delay(1);
+      continue;
+    }
+    for (IntRequestList::iterator it = received.begin(); it != received.end(); ++it)
+    {
+      const std::vector<int>& request = this->GhostBlockRequests[it->ProcessId];
+      const int* remoteFragmentIds = &it->Buffer[0];
+      for (size_t ii = 0; ii + 7 <= request.size(); ii += 7)
+      {
+        const int blockId = request[ii];
+        const int* remoteExt = &request[ii + 1];
+        if (blockId >= 0 && blockId < this->NumberOfInputBlocks && this->InputBlocks[blockId])
+        {
+          AddGhostFragmentEquivalences(globalSet, this->InputBlocks[blockId], remoteExt,
+            remoteFragmentIds, localOffset, procOffsets[it->ProcessId]);
+        }
+        remoteFragmentIds += GetExtentSize(remoteExt);
+      }
+    }
+    received.clear();
+  }
+  WaitAll(sends);
+  return true;
+#else
+  (void)globalSet;
+  (void)procOffsets;
+  return false;
+#endif
+}
+
 //----------------------------------------------------------------------------
 // After the attributes have been resolved copy them in to the
 // fragment data sets. We put each one as a 1 tuple array
@@ -26,10 +26,14 @@
  * #define vtkMaterialInterfaceFilterDEBUG
  * \endcode
  *
- * This will turn on profiling of how long each part of the filter takes
+ * This will turn on profiling of how long each part of the filter takes.
+ * Process 0 reports the minimum, average and maximum time over all processes.
  * \code{.cpp}
  * #define vtkMaterialInterfaceFilterPROFILE
  * \endcode
+ *
+ * When ParaView is built with MPI, ghost blocks and ghost fragment ids are
+ * exchanged with non-blocking point to point communication.
 */
 
 #ifndef vtkMaterialInterfaceFilter_h
@@ -382,6 +386,14 @@ protected:
 
   void ComputeAndDistributeGhostBlocks(
     int* numBlocksInProc, int* blockMetaData, int myProc, int numProcs);
+  // Non-blocking version of ComputeAndDistributeGhostBlocks used with MPI.
+  // Requests are computed up front and sent to every process at once, blocks
+  // requested by other processes are extracted as their requests arrive.
+  // Returns false when the controller does not support non-blocking communication.
+  bool ExchangeGhostBlocks(int* numBlocksInProc, int* blockMetaData, int myProc, int numProcs);
+  // Requests received by ExchangeGhostBlocks, (block id, extent) per requesting
+  // process. ShareGhostEquivalences uses them to know what to receive.
+  std::vector<std::vector<int> > GhostBlockRequests;
 
   vtkMultiProcessController* Controller;
 
@@ -395,6 +407,8 @@ protected:
   void GatherEquivalenceSets(vtkMaterialInterfaceEquivalenceSet* set);
   void ShareGhostEquivalences(vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffsets);
   void ReceiveGhostFragmentIds(vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffset);
+  // Non-blocking version of ShareGhostEquivalences, requires ExchangeGhostBlocks.
+  bool ExchangeGhostFragmentIds(vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffsets);
   void MergeGhostEquivalenceSets(vtkMaterialInterfaceEquivalenceSet* globalSet);
 
   // Sum/finalize attribute's contribution for those
@@ -721,6 +735,8 @@ protected:
   long NumberOfGhostBlocks;
   vtkSmartPointer<vtkTimerLog> ProcessBlocksTimer;
   vtkSmartPointer<vtkTimerLog> ResolveEquivalencesTimer;
+  vtkSmartPointer<vtkTimerLog> ShareGhostEquivalencesTimer;
+  vtkSmartPointer<vtkTimerLog> MergeEquivalenceSetsTimer;
 #endif
 
 private:
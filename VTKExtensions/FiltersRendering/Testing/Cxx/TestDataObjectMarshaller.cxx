@@ -0,0 +1,173 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestDataObjectMarshaller.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVDataObjectMarshaller.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+#define CHECK(cond)                                                                                \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: Condition FAILED!! : " << #cond << " (line " << __LINE__ << ")" << endl;       \
+    return TEST_FAILED;                                                                            \
+  }
+
+namespace
+{
+vtkSmartPointer<vtkDataObject> RoundTrip(vtkDataObject* input)
+{
+  vtkPVDataObjectMarshaller::GatherList list;
+  if (!vtkPVDataObjectMarshaller::Marshal(input, list))
+  {
+    return nullptr;
+  }
+  std::vector<char> buffer(list.GetTotalLength());
+  list.CopyTo(buffer.data());
+  if (!vtkPVDataObjectMarshaller::IsNativeBuffer(buffer.data(), list.GetTotalLength()))
+  {
+    return nullptr;
+  }
+  return vtkPVDataObjectMarshaller::Unmarshal(buffer.data(), list.GetTotalLength());
+}
+
+vtkSmartPointer<vtkPolyData> MakePolyData()
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0, 0, 0);
+  points->InsertNextPoint(1, 0, 0);
+  points->InsertNextPoint(1, 1, 0);
+  points->InsertNextPoint(0, 1, 0);
+
+  vtkNew<vtkCellArray> polys;
+  vtkIdType quad[4] = { 0, 1, 2, 3 };
+  vtkIdType tri[3] = { 0, 1, 2 };
+  polys->InsertNextCell(4, quad);
+  polys->InsertNextCell(3, tri);
+
+  vtkNew<vtkFloatArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    normals->InsertNextTuple3(0, 0, 1);
+  }
+
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->InsertNextValue(10);
+  cellIds->InsertNextValue(20);
+
+  vtkNew<vtkStringArray> label;
+  label->SetName("Label");
+  label->InsertNextValue("marshalled");
+
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(points);
+  pd->SetPolys(polys);
+  pd->GetPointData()->SetNormals(normals);
+  pd->GetCellData()->AddArray(cellIds);
+  pd->GetFieldData()->AddArray(label);
+  return pd;
+}
+}
+
+int TestDataObjectMarshaller(int, char* [])
+{
+  // vtkPolyData
+  vtkSmartPointer<vtkPolyData> pd = MakePolyData();
+  vtkSmartPointer<vtkDataObject> pdResult = RoundTrip(pd);
+  vtkPolyData* pdOut = vtkPolyData::SafeDownCast(pdResult);
+  CHECK(pdOut != nullptr);
+  CHECK(pdOut->GetNumberOfPoints() == 4);
+  CHECK(pdOut->GetNumberOfPolys() == 2);
+  CHECK(pdOut->GetPolys()->GetNumberOfConnectivityIds() == 7);
+  vtkIdType npts;
+  const vtkIdType* pts;
+  pdOut->GetPolys()->GetCellAtId(1, npts, pts);
+  CHECK(npts == 3 && pts[0] == 0 && pts[1] == 1 && pts[2] == 2);
+  CHECK(pdOut->GetPointData()->GetNormals() != nullptr);
+  CHECK(pdOut->GetCellData()->GetArray("CellIds")->GetTuple1(1) == 20);
+  CHECK(vtkStringArray::SafeDownCast(pdOut->GetFieldData()->GetAbstractArray("Label"))
+          ->GetValue(0) == "marshalled");
+
+  // vtkUnstructuredGrid
+  vtkNew<vtkUnstructuredGrid> ug;
+  ug->SetPoints(pd->GetPoints());
+  vtkIdType tet[4] = { 0, 1, 2, 3 };
+  ug->InsertNextCell(VTK_TETRA, 4, tet);
+  vtkSmartPointer<vtkDataObject> ugResult = RoundTrip(ug);
+  vtkUnstructuredGrid* ugOut = vtkUnstructuredGrid::SafeDownCast(ugResult);
+  CHECK(ugOut != nullptr);
+  CHECK(ugOut->GetNumberOfCells() == 1);
+  CHECK(ugOut->GetCellType(0) == VTK_TETRA);
+  ugOut->GetCells()->GetCellAtId(0, npts, pts);
+  CHECK(npts == 4 && pts[0] == 0 && pts[3] == 3);
+
+  // vtkImageData: extents and origin must survive, unlike with the legacy
+  // writer.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(2, 5, 3, 6, 0, 0);
+  image->SetOrigin(1.5, 2.5, 0);
+  image->SetSpacing(0.5, 0.5, 1);
+  image->AllocateScalars(VTK_DOUBLE, 1);
+  vtkSmartPointer<vtkDataObject> imageResult = RoundTrip(image);
+  vtkImageData* imageOut = vtkImageData::SafeDownCast(imageResult);
+  CHECK(imageOut != nullptr);
+  CHECK(imageOut->GetExtent()[0] == 2 && imageOut->GetExtent()[3] == 6);
+  CHECK(imageOut->GetOrigin()[1] == 2.5);
+  CHECK(imageOut->GetPointData()->GetScalars()->GetNumberOfTuples() == 16);
+
+  // vtkMultiBlockDataSet with a null block and block names.
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetNumberOfBlocks(3);
+  mb->SetBlock(0, pd);
+  mb->SetBlock(2, ug);
+  mb->GetMetaData(2u)->Set(vtkCompositeDataSet::NAME(), "grid");
+  vtkSmartPointer<vtkDataObject> mbResult = RoundTrip(mb);
+  vtkMultiBlockDataSet* mbOut = vtkMultiBlockDataSet::SafeDownCast(mbResult);
+  CHECK(mbOut != nullptr);
+  CHECK(mbOut->GetNumberOfBlocks() == 3);
+  CHECK(vtkPolyData::SafeDownCast(mbOut->GetBlock(0)) != nullptr);
+  CHECK(mbOut->GetBlock(1) == nullptr);
+  CHECK(strcmp(mbOut->GetMetaData(2u)->Get(vtkCompositeDataSet::NAME()), "grid") == 0);
+
+  // Corrupt buffers must be rejected.
+  vtkPVDataObjectMarshaller::GatherList list;
+  vtkPVDataObjectMarshaller::Marshal(pd, list);
+  std::vector<char> truncated(list.GetTotalLength());
+  list.CopyTo(truncated.data());
+  CHECK(vtkPVDataObjectMarshaller::Unmarshal(truncated.data(), 20) == nullptr);
+
+  return TEST_SUCCESS;
+}
@@ -48,7 +48,33 @@ public:
 };
 typedef std::map<std::string, Data> MapType;
 
-bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* input)
+// Returns true if the first `numComps` components of each pixel match.
+bool Compare(vtkUnsignedCharArray* a, vtkUnsignedCharArray* b, int numComps)
+{
+  const vtkIdType numPixels = a->GetNumberOfTuples();
+  const int stride = a->GetNumberOfComponents();
+  if (b->GetNumberOfTuples() != numPixels || b->GetNumberOfComponents() != stride)
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < numPixels; ++cc)
+  {
+    for (int comp = 0; comp < numComps; ++comp)
+    {
+      if (a->GetValue(cc * stride + comp) != b->GetValue(cc * stride + comp))
+      {
+        cerr << "ERROR: pixel " << cc << " differs after decompression." << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// When `compareComps` is non-zero, the decompressed image must match the input
+// for that many components.
+bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* input,
+  int compareComps = 0)
 {
   vtkNew<vtkUnsignedCharArray> outputCompressed;
   vtkNew<vtkUnsignedCharArray> outputDeCompressed;
@@ -78,7 +104,7 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
   data.DecompressTime += timer->GetElapsedTime();
   data.CompressedSize =
     outputCompressed->GetNumberOfTuples() * outputCompressed->GetNumberOfComponents();
-  return true;
+  return compareComps == 0 || Compare(input, outputDeCompressed.Get(), compareComps);
 }
 
 int TestImageCompressors(int argc, char* argv[])
@@ -125,10 +151,23 @@ int TestImageCompressors(int argc, char* argv[])
   {
     vtkNew<vtkLZ4Compressor> lz4;
     lz4->SetQuality(0);
-    if (!DoTest(datas["LZ4 (quality: 0)"], lz4.Get(), input))
+    if (!DoTest(datas["LZ4 (quality: 0)"], lz4.Get(), input, input->GetNumberOfComponents()))
+    {
+      return TEST_FAILED;
+    }
+    lz4->SetNumberOfTiles(1);
+    if (!DoTest(datas["LZ4 (quality: 0, tiles: 1)"], lz4.Get(), input,
+          input->GetNumberOfComponents()))
+    {
+      return TEST_FAILED;
+    }
+    lz4->SetNumberOfTiles(7);
+    if (!DoTest(datas["LZ4 (quality: 0, tiles: 7)"], lz4.Get(), input,
+          input->GetNumberOfComponents()))
     {
       return TEST_FAILED;
     }
+    lz4->SetNumberOfTiles(0);
     if (test_lossy)
     {
       lz4->SetQuality(3);
@@ -145,12 +184,24 @@ int TestImageCompressors(int argc, char* argv[])
       }
     }
 
+    // Squirt only keeps 4 bits of opacity, compare colors only.
     vtkNew<vtkSquirtCompressor> squirt;
     squirt->SetSquirtLevel(0);
-    if (!DoTest(datas["SQUIRT (squirt-level: 0)"], squirt.Get(), input))
+    if (!DoTest(datas["SQUIRT (squirt-level: 0)"], squirt.Get(), input, 3))
+    {
+      return TEST_FAILED;
+    }
+    squirt->SetNumberOfTiles(1);
+    if (!DoTest(datas["SQUIRT (squirt-level: 0, tiles: 1)"], squirt.Get(), input, 3))
+    {
+      return TEST_FAILED;
+    }
+    squirt->SetNumberOfTiles(7);
+    if (!DoTest(datas["SQUIRT (squirt-level: 0, tiles: 7)"], squirt.Get(), input, 3))
     {
       return TEST_FAILED;
     }
+    squirt->SetNumberOfTiles(0);
 
     if (test_lossy)
     {
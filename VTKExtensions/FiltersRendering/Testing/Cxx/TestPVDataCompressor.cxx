@@ -0,0 +1,138 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVDataCompressor.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkNew.h"
+#include "vtkPVDataCompressor.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+bool DoTest(vtkPVDataCompressor* compressor, const std::vector<char>& input)
+{
+  std::vector<char> compressed;
+  std::vector<char> decompressed;
+  if (!compressor->Compress(input.data(), static_cast<vtkIdType>(input.size()), compressed))
+  {
+    cerr << "Compress failed for codec " << compressor->GetCodec() << endl;
+    return false;
+  }
+  if (!vtkPVDataCompressor::Decompress(
+        compressed.data(), static_cast<vtkIdType>(compressed.size()), decompressed))
+  {
+    cerr << "Decompress failed for codec " << compressor->GetCodec() << endl;
+    return false;
+  }
+  if (decompressed != input)
+  {
+    cerr << "Round trip mismatch for codec " << compressor->GetCodec() << endl;
+    return false;
+  }
+  cout << compressor->GetCodec() << " (level: " << compressor->GetLevel()
+       << ", shuffle: " << compressor->GetShuffleElementSize() << ") ratio: "
+       << (static_cast<double>(compressed.size()) / input.size()) << endl;
+  return true;
+}
+}
+
+int TestPVDataCompressor(int, char* [])
+{
+  // A few chunks worth of smooth float data, plus a trailing partial element
+  // to exercise the shuffle filter's tail handling.
+  const size_t numValues = 600000;
+  std::vector<char> input(numValues * sizeof(float) + 3);
+  for (size_t cc = 0; cc < numValues; ++cc)
+  {
+    const float value = static_cast<float>(std::sin(cc * 0.001));
+    memcpy(&input[cc * sizeof(float)], &value, sizeof(float));
+  }
+
+  vtkNew<vtkPVDataCompressor> compressor;
+  compressor->SetChunkSize(VTK_ID_MAX);
+  if (compressor->GetChunkSize() != vtkPVDataCompressor::MaximumChunkSize)
+  {
+    cerr << "Chunk size should be clamped to what LZ4 supports." << endl;
+    return TEST_FAILED;
+  }
+  compressor->SetChunkSize(256 * 1024);
+
+  std::vector<char> ignored;
+  if (compressor->Compress(input.data(), static_cast<vtkIdType>(input.size()), ignored))
+  {
+    cerr << "Codec 'none' should not compress." << endl;
+    return TEST_FAILED;
+  }
+
+  for (const auto& codec : vtkPVDataCompressor::GetAvailableCodecs())
+  {
+    compressor->SetCodec(codec.c_str());
+    for (int shuffle : { 0, 4 })
+    {
+      compressor->SetShuffleElementSize(shuffle);
+      for (int level : { 1, 9 })
+      {
+        compressor->SetLevel(level);
+        if (!DoTest(compressor, input))
+        {
+          return TEST_FAILED;
+        }
+      }
+    }
+  }
+
+  // A corrupt header must be rejected before allocating its claimed size:
+  // first the total length, then the length of the first chunk.
+  compressor->SetCodec("lz4");
+  compressor->SetShuffleElementSize(0);
+  std::vector<char> compressed;
+  compressor->Compress(input.data(), static_cast<vtkIdType>(input.size()), compressed);
+  const size_t totalLengthPos = 7 + strlen("lz4");
+  for (size_t offset : { totalLengthPos, totalLengthPos + 16 })
+  {
+    std::vector<char> corrupt = compressed;
+    memset(&corrupt[offset], 0xff, 8);
+    std::vector<char> decompressed;
+    if (vtkPVDataCompressor::Decompress(
+          corrupt.data(), static_cast<vtkIdType>(corrupt.size()), decompressed) ||
+      !decompressed.empty())
+    {
+      cerr << "Corrupt lengths were not rejected." << endl;
+      return TEST_FAILED;
+    }
+  }
+
+  // "auto" on a slow link must pick a real codec; on a very fast one, none.
+  compressor->SetCodec("auto");
+  compressor->RecordTransfer(1000000, 1.0);
+  if (compressor->GetEffectiveCodec(static_cast<vtkIdType>(input.size())) == "none")
+  {
+    cerr << "'auto' did not compress on a 1 MB/s link." << endl;
+    return TEST_FAILED;
+  }
+  vtkNew<vtkPVDataCompressor> fast;
+  fast->SetCodec("auto");
+  fast->RecordTransfer(VTK_ID_MAX / 2, 1e-3);
+  if (fast->GetEffectiveCodec(static_cast<vtkIdType>(input.size())) != "none")
+  {
+    cerr << "'auto' compressed on an extremely fast link." << endl;
+    return TEST_FAILED;
+  }
+  return TEST_SUCCESS;
+}
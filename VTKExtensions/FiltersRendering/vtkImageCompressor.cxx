@@ -17,9 +17,111 @@
 
 #include "vtkCommand.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 #include <string>
+#include <vector>
+
+namespace
+{
+// Tiles smaller than this are not worth the threading overhead.
+const vtkIdType vtkImageCompressorMinimumTileSize = 32 * 1024;
+
+// Pixel range of tile `index` out of `count` for an image of `numPixels`.
+inline void GetTileRange(
+  vtkIdType index, vtkIdType count, vtkIdType numPixels, vtkIdType& begin, vtkIdType& end)
+{
+  begin = numPixels * index / count;
+  end = numPixels * (index + 1) / count;
+}
+
+struct Tile
+{
+  vtkIdType PixelBegin;
+  vtkIdType PixelEnd;
+  vtkIdType BufferOffset;
+  vtkIdType Size;
+};
+
+class CompressTilesFunctor
+{
+public:
+  CompressTilesFunctor(vtkImageCompressor* self, std::vector<Tile>& tiles,
+    const unsigned char* input, int numComps, unsigned char* buffer,
+    vtkIdType (vtkImageCompressor::*compress)(const unsigned char*, vtkIdType, int, unsigned char*))
+    : Self(self)
+    , Tiles(tiles)
+    , Input(input)
+    , NumberOfComponents(numComps)
+    , Buffer(buffer)
+    , Compress(compress)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      Tile& tile = this->Tiles[cc];
+      tile.Size = (this->Self->*this->Compress)(
+        this->Input + tile.PixelBegin * this->NumberOfComponents, tile.PixelEnd - tile.PixelBegin,
+        this->NumberOfComponents, this->Buffer + tile.BufferOffset);
+    }
+  }
+
+private:
+  vtkImageCompressor* Self;
+  std::vector<Tile>& Tiles;
+  const unsigned char* Input;
+  int NumberOfComponents;
+  unsigned char* Buffer;
+  vtkIdType (vtkImageCompressor::*Compress)(
+    const unsigned char*, vtkIdType, int, unsigned char*);
+};
+
+class DecompressTilesFunctor
+{
+public:
+  DecompressTilesFunctor(vtkImageCompressor* self, std::vector<Tile>& tiles,
+    const unsigned char* input, int numComps, unsigned char* output,
+    bool (vtkImageCompressor::*decompress)(
+      const unsigned char*, vtkIdType, unsigned char*, vtkIdType, int))
+    : Self(self)
+    , Tiles(tiles)
+    , Input(input)
+    , NumberOfComponents(numComps)
+    , Output(output)
+    , Decompress(decompress)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      Tile& tile = this->Tiles[cc];
+      const bool status = (this->Self->*this->Decompress)(this->Input + tile.BufferOffset,
+        tile.Size, this->Output + tile.PixelBegin * this->NumberOfComponents,
+        tile.PixelEnd - tile.PixelBegin, this->NumberOfComponents);
+      // flag failures with a negative size.
+      tile.Size = status ? tile.Size : -1;
+    }
+  }
+
+private:
+  vtkImageCompressor* Self;
+  std::vector<Tile>& Tiles;
+  const unsigned char* Input;
+  int NumberOfComponents;
+  unsigned char* Output;
+  bool (vtkImageCompressor::*Decompress)(
+    const unsigned char*, vtkIdType, unsigned char*, vtkIdType, int);
+};
+}
 
 //-----------------------------------------------------------------------------
 vtkCxxSetObjectMacro(vtkImageCompressor, Output, vtkUnsignedCharArray);
@@ -32,6 +134,8 @@ vtkImageCompressor::vtkImageCompressor()
   : Output(0)
   , Input(0)
   , LossLessMode(0)
+  , NumberOfTiles(0)
+  , TileBuffer(vtkUnsignedCharArray::New())
   , Configuration(0)
 {
   // Always allocate output array as a convenience.
@@ -46,6 +150,154 @@ vtkImageCompressor::~vtkImageCompressor()
   this->SetOutput(0);
   this->SetInput(0);
   this->SetConfiguration(NULL);
+  this->TileBuffer->Delete();
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkImageCompressor::GetMaximumCompressedTileSize(
+  vtkIdType numberOfPixels, int numberOfComponents)
+{
+  return numberOfPixels * numberOfComponents;
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkImageCompressor::CompressTile(const unsigned char*, vtkIdType, int, unsigned char*)
+{
+  vtkErrorMacro("Tiled compression is not supported by " << this->GetClassName());
+  return -1;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkImageCompressor::DecompressTile(
+  const unsigned char*, vtkIdType, unsigned char*, vtkIdType, int)
+{
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+int vtkImageCompressor::CompressTiles(vtkUnsignedCharArray* input)
+{
+  input = input ? input : this->Input;
+  if (!(input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+  const int numComps = input->GetNumberOfComponents();
+  vtkIdType numTiles = this->NumberOfTiles;
+  if (numTiles <= 0)
+  {
+    const vtkIdType numThreads = std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads());
+    numTiles = std::min(2 * numThreads, numPixels / vtkImageCompressorMinimumTileSize);
+  }
+  numTiles = std::max<vtkIdType>(1, std::min(numTiles, std::max<vtkIdType>(numPixels, 1)));
+
+  // Compress each tile into its own slot of the scratch buffer.
+  std::vector<Tile> tiles(numTiles);
+  vtkIdType bufferSize = 0;
+  for (vtkIdType cc = 0; cc < numTiles; ++cc)
+  {
+    Tile& tile = tiles[cc];
+    GetTileRange(cc, numTiles, numPixels, tile.PixelBegin, tile.PixelEnd);
+    tile.BufferOffset = bufferSize;
+    tile.Size = -1;
+    bufferSize += this->GetMaximumCompressedTileSize(tile.PixelEnd - tile.PixelBegin, numComps);
+  }
+  this->TileBuffer->SetNumberOfComponents(1);
+  this->TileBuffer->SetNumberOfTuples(bufferSize);
+
+  CompressTilesFunctor functor(this, tiles, input->GetPointer(0), numComps,
+    this->TileBuffer->GetPointer(0), &vtkImageCompressor::CompressTile);
+  vtkSMPTools::For(0, numTiles, 1, functor);
+
+  // Pack the header and the compressed tiles in the output.
+  const vtkIdType headerSize = sizeof(vtkTypeUInt32) * (numTiles + 1);
+  vtkIdType outputSize = headerSize;
+  std::vector<vtkTypeUInt32> header(numTiles + 1);
+  header[0] = static_cast<vtkTypeUInt32>(numTiles);
+  for (vtkIdType cc = 0; cc < numTiles; ++cc)
+  {
+    if (tiles[cc].Size < 0)
+    {
+      return VTK_ERROR;
+    }
+    header[cc + 1] = static_cast<vtkTypeUInt32>(tiles[cc].Size);
+    outputSize += tiles[cc].Size;
+  }
+
+  this->Output->SetNumberOfComponents(1);
+  this->Output->SetNumberOfTuples(outputSize);
+  unsigned char* output = this->Output->GetPointer(0);
+  memcpy(output, header.data(), headerSize);
+  const unsigned char* buffer = this->TileBuffer->GetPointer(0);
+  vtkIdType offset = headerSize;
+  for (const Tile& tile : tiles)
+  {
+    memcpy(output + offset, buffer + tile.BufferOffset, tile.Size);
+    offset += tile.Size;
+  }
+  return VTK_OK;
+}
+
+//-----------------------------------------------------------------------------
+int vtkImageCompressor::DecompressTiles()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  const unsigned char* input = this->Input->GetPointer(0);
+  const vtkIdType inputSize =
+    this->Input->GetNumberOfTuples() * this->Input->GetNumberOfComponents();
+  vtkTypeUInt32 numTiles = 0;
+  if (inputSize < static_cast<vtkIdType>(sizeof(numTiles)))
+  {
+    return VTK_ERROR;
+  }
+  memcpy(&numTiles, input, sizeof(numTiles));
+  const vtkIdType headerSize = sizeof(vtkTypeUInt32) * (static_cast<vtkIdType>(numTiles) + 1);
+  if (numTiles == 0 || headerSize > inputSize)
+  {
+    vtkErrorMacro("Invalid tiled stream.");
+    return VTK_ERROR;
+  }
+
+  const vtkIdType numPixels = this->Output->GetNumberOfTuples();
+  const int numComps = this->Output->GetNumberOfComponents();
+  std::vector<vtkTypeUInt32> sizes(numTiles);
+  memcpy(sizes.data(), input + sizeof(vtkTypeUInt32), sizeof(vtkTypeUInt32) * numTiles);
+  std::vector<Tile> tiles(numTiles);
+  vtkIdType offset = headerSize;
+  for (vtkTypeUInt32 cc = 0; cc < numTiles; ++cc)
+  {
+    Tile& tile = tiles[cc];
+    GetTileRange(cc, numTiles, numPixels, tile.PixelBegin, tile.PixelEnd);
+    tile.BufferOffset = offset;
+    tile.Size = sizes[cc];
+    offset += tile.Size;
+  }
+  if (offset > inputSize)
+  {
+    vtkErrorMacro("Truncated tiled stream.");
+    return VTK_ERROR;
+  }
+
+  DecompressTilesFunctor functor(this, tiles, input, numComps, this->Output->GetPointer(0),
+    &vtkImageCompressor::DecompressTile);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numTiles), 1, functor);
+  for (const Tile& tile : tiles)
+  {
+    if (tile.Size < 0)
+    {
+      vtkErrorMacro("Failed to decompress tile.");
+      return VTK_ERROR;
+    }
+  }
+  return VTK_OK;
 }
 
 //-----------------------------------------------------------------------------
@@ -107,5 +359,6 @@ void vtkImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Input:          " << this->Input << endl
      << indent << "Output:         " << this->Output << endl
-     << indent << "LossLessMode: " << this->LossLessMode << endl;
+     << indent << "LossLessMode: " << this->LossLessMode << endl
+     << indent << "NumberOfTiles: " << this->NumberOfTiles << endl;
 }
@@ -24,6 +24,13 @@
  * the LossLessMode ivar, which is used by the composite manager to force
  * loss less compression during a still render. Additionally compressors
  * must be able to seriealize and restore their setting from a stream.
+ *
+ * Compressors may also implement CompressTile/DecompressTile and use
+ * CompressTiles/DecompressTiles in Compress/Decompress. The image is then
+ * split in tiles of contiguous pixels, which are compressed and decompressed
+ * concurrently. The tiled stream starts with the number of tiles and the
+ * compressed size of each tile (as 32-bit unsigned integers), followed by the
+ * compressed tiles.
 */
 
 #ifndef vtkImageCompressor_h
@@ -57,6 +64,17 @@ public:
   void SetOutput(vtkUnsignedCharArray*);
   //@}
 
+  //@{
+  /**
+   * Number of tiles used by compressors producing a tiled stream. 0 (default)
+   * picks a number based on the image size and the number of threads. This
+   * only affects compression: decompression reads the number of tiles from
+   * the stream.
+   */
+  vtkSetClampMacro(NumberOfTiles, int, 0, 4096);
+  vtkGetMacro(NumberOfTiles, int);
+  //@}
+
   //@{
   /**
    * When set the implementation must use loss-less compression, otherwise
@@ -117,11 +135,45 @@ protected:
   ~vtkImageCompressor() override;
   //@}
 
+  //@{
+  /**
+   * Compress `input` (or Input if nullptr) / decompress Input as a tiled
+   * stream into Output, using CompressTile/DecompressTile on all tiles
+   * concurrently. Return VTK_OK on success, VTK_ERROR otherwise.
+   */
+  int CompressTiles(vtkUnsignedCharArray* input = nullptr);
+  int DecompressTiles();
+  //@}
+
+  /**
+   * Returns the maximum size, in bytes, CompressTile may need for a tile.
+   */
+  virtual vtkIdType GetMaximumCompressedTileSize(vtkIdType numberOfPixels, int numberOfComponents);
+
+  /**
+   * Compress a tile of `numberOfPixels` pixels into `output`, which has room
+   * for GetMaximumCompressedTileSize() bytes. Returns the number of bytes
+   * written, or -1 on error. Called concurrently for different tiles.
+   */
+  virtual vtkIdType CompressTile(const unsigned char* input, vtkIdType numberOfPixels,
+    int numberOfComponents, unsigned char* output);
+
+  /**
+   * Decompress a tile of `inputSize` bytes into exactly `numberOfPixels`
+   * pixels. Returns false on error. Called concurrently for different tiles.
+   */
+  virtual bool DecompressTile(const unsigned char* input, vtkIdType inputSize,
+    unsigned char* output, vtkIdType numberOfPixels, int numberOfComponents);
+
   // This is the array which contains the compressed data.
   vtkUnsignedCharArray* Output;
   vtkUnsignedCharArray* Input;
 
   int LossLessMode;
+  int NumberOfTiles;
+
+  // Scratch space for CompressTiles.
+  vtkUnsignedCharArray* TileBuffer;
 
   vtkSetStringMacro(Configuration);
   char* Configuration;
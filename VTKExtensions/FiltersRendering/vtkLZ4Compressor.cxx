@@ -16,12 +16,40 @@
 
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 
 #include "vtk_lz4.h"
 #include <cassert>
 #include <sstream>
 
+namespace
+{
+class ApplyMask
+{
+public:
+  ApplyMask(const unsigned int* input, unsigned int* output, unsigned int mask)
+    : Input(input)
+    , Output(output)
+    , Mask(mask)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      this->Output[cc] = this->Input[cc] & this->Mask;
+    }
+  }
+
+private:
+  const unsigned int* Input;
+  unsigned int* Output;
+  unsigned int Mask;
+};
+}
+
 vtkStandardNewMacro(vtkLZ4Compressor);
 //----------------------------------------------------------------------------
 vtkLZ4Compressor::vtkLZ4Compressor()
@@ -56,27 +84,18 @@ int vtkLZ4Compressor::Compress()
   memcpy(&compress_mask, &compress_masks[compress_level], 4);
 
   vtkUnsignedCharArray* input = this->Input;
-  int inputSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
-
-  if (this->Quality > 0 && input->GetNumberOfComponents() == 4)
+  if (compress_level > 0 && input->GetNumberOfComponents() == 4)
   {
     this->TemporaryBuffer->SetNumberOfComponents(input->GetNumberOfComponents());
     this->TemporaryBuffer->SetNumberOfTuples(input->GetNumberOfTuples());
-    const unsigned int* in = reinterpret_cast<const unsigned int*>(input->GetPointer(0));
-    unsigned int* out = reinterpret_cast<unsigned int*>(this->TemporaryBuffer->GetPointer(0));
-    for (vtkIdType cc = 0, max = this->Input->GetNumberOfTuples(); cc < max; ++cc)
-    {
-      out[cc] = in[cc] & compress_mask;
-    }
+    ApplyMask functor(reinterpret_cast<const unsigned int*>(input->GetPointer(0)),
+      reinterpret_cast<unsigned int*>(this->TemporaryBuffer->GetPointer(0)), compress_mask);
+    vtkSMPTools::For(0, input->GetNumberOfTuples(), functor);
     input = this->TemporaryBuffer.Get();
   }
 
-  int maxOutputSize = LZ4_compressBound(inputSize);
-  int compressedSize = LZ4_compress_fast(reinterpret_cast<const char*>(input->GetPointer(0)),
-    reinterpret_cast<char*>(this->Output->WritePointer(0, maxOutputSize)), inputSize, maxOutputSize,
-    16);
-  this->Output->SetNumberOfTuples(compressedSize);
-  return compressedSize > 0 ? VTK_OK : VTK_ERROR;
+  // Tiles are compressed independently.
+  return this->CompressTiles(input);
 }
 
 //----------------------------------------------------------------------------
@@ -87,21 +106,46 @@ int vtkLZ4Compressor::Decompress()
     vtkWarningMacro("Cannot decompress, empty input or output detected.");
     return VTK_ERROR;
   }
+  return this->DecompressTiles();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkLZ4Compressor::GetMaximumCompressedTileSize(
+  vtkIdType numberOfPixels, int numberOfComponents)
+{
+  return LZ4_compressBound(static_cast<int>(numberOfPixels * numberOfComponents));
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkLZ4Compressor::CompressTile(const unsigned char* input, vtkIdType numberOfPixels,
+  int numberOfComponents, unsigned char* output)
+{
+  const int inputSize = static_cast<int>(numberOfPixels * numberOfComponents);
+  if (inputSize == 0)
+  {
+    return 0;
+  }
+  const int maxOutputSize = LZ4_compressBound(inputSize);
+  int compressedSize = LZ4_compress_fast(reinterpret_cast<const char*>(input),
+    reinterpret_cast<char*>(output), inputSize, maxOutputSize, 16);
+  return compressedSize > 0 ? compressedSize : -1;
+}
+
+//----------------------------------------------------------------------------
+bool vtkLZ4Compressor::DecompressTile(const unsigned char* input, vtkIdType inputSize,
+  unsigned char* output, vtkIdType numberOfPixels, int numberOfComponents)
+{
+  const int outputSize = static_cast<int>(numberOfPixels * numberOfComponents);
+  if (outputSize == 0)
+  {
+    return inputSize == 0;
+  }
 
-  int maxDecompressedSize =
-    this->Output->GetNumberOfComponents() * this->Output->GetNumberOfTuples();
-  int decompressedSize =
-    LZ4_decompress_safe(reinterpret_cast<const char*>(this->Input->GetPointer(0)),
-      reinterpret_cast<char*>(this->Output->GetPointer(0)), this->Input->GetNumberOfTuples(),
-      maxDecompressedSize);
-
-  //  // We use LZ4_decompress_safe for now since there seems to be some bug
-  //  // in LZ4_decompress_fast which is causing segfaults on Windows.
-  //  int decompressedSize = LZ4_decompress_fast(
-  //    reinterpret_cast<const char*>(this->Input->GetPointer(0)),
-  //    reinterpret_cast<char*>(this->Output->GetPointer(0)),
-  //    maxDecompressedSize);
-  return decompressedSize > 0 ? VTK_OK : VTK_ERROR;
+  // We use LZ4_decompress_safe for now since there seems to be some bug
+  // in LZ4_decompress_fast which is causing segfaults on Windows.
+  int decompressedSize = LZ4_decompress_safe(reinterpret_cast<const char*>(input),
+    reinterpret_cast<char*>(output), static_cast<int>(inputSize), outputSize);
+  return decompressedSize == outputSize;
 }
 
 //-----------------------------------------------------------------------------
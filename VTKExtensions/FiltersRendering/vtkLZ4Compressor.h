@@ -19,6 +19,9 @@
  *
  * vtkLZ4Compressor uses LZ4 for fast lossless compression and decompression on
  * data.
+ *
+ * The image is split in tiles which are compressed and decompressed
+ * concurrently (see vtkImageCompressor::SetNumberOfTiles).
 */
 
 #ifndef vtkLZ4Compressor_h
@@ -71,6 +74,12 @@ protected:
   vtkLZ4Compressor();
   ~vtkLZ4Compressor() override;
 
+  vtkIdType GetMaximumCompressedTileSize(vtkIdType numberOfPixels, int numberOfComponents) override;
+  vtkIdType CompressTile(const unsigned char* input, vtkIdType numberOfPixels,
+    int numberOfComponents, unsigned char* output) override;
+  bool DecompressTile(const unsigned char* input, vtkIdType inputSize, unsigned char* output,
+    vtkIdType numberOfPixels, int numberOfComponents) override;
+
   int Quality;
 
 private:
@@ -33,13 +33,17 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessControllerHelper.h"
+#include "vtkNew.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutlineFilter.h"
 #include "vtkOverlappingAMR.h"
 #include "vtkPVConfig.h"
+#include "vtkPVDataCompressor.h"
+#include "vtkPVDataObjectMarshaller.h"
 #include "vtkPVLogger.h"
 #include "vtkPVSession.h"
+#include "vtkPVTraceRecorder.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkProcessModule.h"
@@ -52,17 +56,44 @@
 #include "vtkToolkits.h"
 #include "vtkUndirectedGraph.h"
 #include "vtkUnstructuredGrid.h"
+#include "vtkWeakPointer.h"
 
 #include "vtk_zlib.h"
+#include <map>
 #include <sstream>
-#include <vector>
-
+#include <string>
 #include <vector>
 
 bool vtkMPIMoveData::UseZLibCompression = false;
+bool vtkMPIMoveData::UseNativeMarshalling = true;
+std::string vtkMPIMoveData::CompressionCodec = "none";
+int vtkMPIMoveData::CompressionLevel = 1;
+int vtkMPIMoveData::CompressionShuffleElementSize = 0;
 
 namespace
 {
+// One compressor per connection so that bandwidth and codec statistics used
+// by the "auto" codec are not mixed between links.
+struct vtkMPIMoveDataConnection
+{
+  vtkWeakPointer<vtkCommunicator> Communicator;
+  vtkSmartPointer<vtkPVDataCompressor> Compressor;
+};
+std::map<vtkCommunicator*, vtkMPIMoveDataConnection> vtkMPIMoveDataConnections;
+
+vtkPVDataCompressor* vtkMPIMoveDataGetCompressor(vtkCommunicator* connection)
+{
+  vtkMPIMoveDataConnection& item = vtkMPIMoveDataConnections[connection];
+  if (item.Compressor == nullptr || (connection != nullptr && item.Communicator == nullptr))
+  {
+    // new connection, or the communicator this entry was created for is gone
+    // and the address has been reused.
+    item.Communicator = connection;
+    item.Compressor = vtkSmartPointer<vtkPVDataCompressor>::New();
+  }
+  return item.Compressor;
+}
+
 bool vtkMPIMoveDataMerge(
   std::vector<vtkSmartPointer<vtkDataObject> >& pieces, vtkDataObject* result)
 {
@@ -191,6 +222,54 @@ bool vtkMPIMoveData::GetUseZLibCompression()
   return vtkMPIMoveData::UseZLibCompression;
 }
 
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetUseNativeMarshalling(bool b)
+{
+  vtkMPIMoveData::UseNativeMarshalling = b;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMPIMoveData::GetUseNativeMarshalling()
+{
+  return vtkMPIMoveData::UseNativeMarshalling;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetCompressionCodec(const char* codec)
+{
+  vtkMPIMoveData::CompressionCodec = codec ? codec : "none";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkMPIMoveData::GetCompressionCodec()
+{
+  return vtkMPIMoveData::CompressionCodec.c_str();
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetCompressionLevel(int level)
+{
+  vtkMPIMoveData::CompressionLevel = level;
+}
+
+//----------------------------------------------------------------------------
+int vtkMPIMoveData::GetCompressionLevel()
+{
+  return vtkMPIMoveData::CompressionLevel;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetCompressionShuffleElementSize(int size)
+{
+  vtkMPIMoveData::CompressionShuffleElementSize = size;
+}
+
+//----------------------------------------------------------------------------
+int vtkMPIMoveData::GetCompressionShuffleElementSize()
+{
+  return vtkMPIMoveData::CompressionShuffleElementSize;
+}
+
 //----------------------------------------------------------------------------
 int vtkMPIMoveData::FillInputPortInformation(int, vtkInformation* info)
 {
@@ -618,6 +697,7 @@ void vtkMPIMoveData::DataServerAllToN(vtkDataObject* input, vtkDataObject* outpu
 
   // Perform the M to N operation.
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "redistribute MxN (M=%d, N=%d)", m, n);
+  vtkPVTraceScope("data-movement", "redistribute MxN");
   vtkAllToNRedistributeCompositePolyData* AllToN = NULL;
   AllToN = vtkAllToNRedistributeCompositePolyData::New();
   AllToN->SetController(controller);
@@ -645,6 +725,7 @@ void vtkMPIMoveData::DataServerGatherAll(vtkDataObject* input, vtkDataObject* ou
   }
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "gather-all");
+  vtkPVTraceScope("data-movement", "gather-all");
 
   int idx;
   auto com = this->Controller->GetCommunicator();
@@ -718,6 +799,7 @@ void vtkMPIMoveData::DataServerGatherToZero(vtkDataObject* input, vtkDataObject*
   vtkTimerLog::MarkStartEvent("Dataserver gathering to 0");
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "gather-to-0");
+  vtkPVTraceScope("data-movement", "gather-to-0");
   int idx;
   int myId = this->Controller->GetLocalProcessId();
   auto com = this->Controller->GetCommunicator();
@@ -792,15 +874,16 @@ void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataObject* output)
   }
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-renderserver");
+  vtkPVTraceScope("data-movement", "send-to-renderserver");
 
   // int fixme;
   // We might be able to eliminate this marshal.
   this->ClearBuffer();
-  this->MarshalDataToBuffer(output);
+  this->MarshalDataToBuffer(output, com);
 
   com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
   com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-  com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
+  this->SendBuffers(com, 23482);
 }
 
 //-----------------------------------------------------------------------------
@@ -815,6 +898,7 @@ void vtkMPIMoveData::RenderServerReceiveFromDataServer(vtkDataObject* output)
   }
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
+  vtkPVTraceScope("data-movement", "receive-from-dataserver");
 
   this->ClearBuffer();
   com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
@@ -853,14 +937,15 @@ void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataObject* data)
     }
 
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-renderserver-root");
+    vtkPVTraceScope("data-movement", "send-to-renderserver-root");
 
     // int fixme;
     // We might be able to eliminate this marshal.
     this->ClearBuffer();
-    this->MarshalDataToBuffer(data);
+    this->MarshalDataToBuffer(data, com);
     com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
     com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
-    com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
+    this->SendBuffers(com, 23482);
     this->ClearBuffer();
   }
 }
@@ -881,6 +966,7 @@ void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataObject* da
     }
 
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver-root");
+    vtkPVTraceScope("data-movement", "receive-from-dataserver-root");
 
     this->ClearBuffer();
     com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
@@ -916,13 +1002,15 @@ void vtkMPIMoveData::DataServerSendToClient(vtkDataObject* output)
   if (myId == 0)
   {
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-client");
+    vtkPVTraceScope("data-movement", "send-to-client");
     vtkTimerLog::MarkStartEvent("Dataserver sending to client");
+    vtkCommunicator* com = this->ClientDataServerSocketController->GetCommunicator();
     this->ClearBuffer();
-    this->MarshalDataToBuffer(output);
+    this->MarshalDataToBuffer(output, com);
     this->ClientDataServerSocketController->Send(&(this->NumberOfBuffers), 1, 1, 23490);
     this->ClientDataServerSocketController->Send(
       this->BufferLengths, this->NumberOfBuffers, 1, 23491);
-    this->ClientDataServerSocketController->Send(this->Buffers, this->BufferTotalLength, 1, 23492);
+    this->SendBuffers(com, 23492);
     this->ClearBuffer();
     vtkTimerLog::MarkEndEvent("Dataserver sending to client");
   }
@@ -940,6 +1028,7 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
   }
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
+  vtkPVTraceScope("data-movement", "receive-from-dataserver");
 
   this->ClearBuffer();
   com->Receive(&(this->NumberOfBuffers), 1, 1, 23490);
@@ -970,6 +1059,7 @@ void vtkMPIMoveData::RenderServerZeroBroadcast(vtkDataObject* data)
   }
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "broadcast");
+  vtkPVTraceScope("data-movement", "broadcast");
   int myId = this->Controller->GetLocalProcessId();
 
   auto com = this->Controller->GetCommunicator();
@@ -1037,7 +1127,19 @@ void vtkMPIMoveData::ClearBuffer()
 }
 
 //-----------------------------------------------------------------------------
-void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
+void vtkMPIMoveData::SendBuffers(vtkCommunicator* com, int tag)
+{
+  // Time the transfer so that the "auto" codec can adapt to the link.
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  com->Send(this->Buffers, this->BufferTotalLength, 1, tag);
+  timer->StopTimer();
+  vtkMPIMoveDataGetCompressor(com)->RecordTransfer(
+    this->BufferTotalLength, timer->GetElapsedTime());
+}
+
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data, vtkCommunicator* connection)
 {
   vtkDataSet* dataSet = vtkDataSet::SafeDownCast(data);
   vtkImageData* imageData = vtkImageData::SafeDownCast(data);
@@ -1050,42 +1152,90 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
     this->NumberOfBuffers = 0;
   }
 
-  // Copy input to isolate reader from the pipeline.
-  vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
-  writer->SetInputData(data);
-  if (imageData)
+  // Raw (uncompressed) marshalled bytes. `rawBuffer` is always allocated with
+  // new[] and ownership is transferred to this->Buffers when no compression
+  // is requested.
+  char* rawBuffer = NULL;
+  vtkIdType rawLength = 0;
+
+  vtkPVDataObjectMarshaller::GatherList gatherList;
+  if (vtkMPIMoveData::UseNativeMarshalling && vtkPVDataObjectMarshaller::CanMarshal(data))
   {
-    // We add the image extents to the header, since the writer doesn't preserve
-    // the extents.
-    int* extent = imageData->GetExtent();
-    double* origin = imageData->GetOrigin();
-    std::ostringstream stream;
-    stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
-           << " " << extent[4] << " " << extent[5];
-    stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
-    writer->SetHeader(stream.str().c_str());
+    vtkTimerLog::MarkStartEvent("Native marshal");
+    vtkPVDataObjectMarshaller::Marshal(data, gatherList);
+    // The gather list references the arrays directly; flatten it in a single
+    // pass since the communicators below need one contiguous buffer.
+    rawLength = gatherList.GetTotalLength();
+    rawBuffer = new char[rawLength];
+    gatherList.CopyTo(rawBuffer);
+    gatherList.Reset();
+    vtkTimerLog::MarkEndEvent("Native marshal");
   }
+  else
+  {
+    // Copy input to isolate reader from the pipeline.
+    vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
+    writer->SetInputData(data);
+    if (imageData)
+    {
+      // We add the image extents to the header, since the writer doesn't preserve
+      // the extents.
+      int* extent = imageData->GetExtent();
+      double* origin = imageData->GetOrigin();
+      std::ostringstream stream;
+      stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
+             << " " << extent[4] << " " << extent[5];
+      stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
+      writer->SetHeader(stream.str().c_str());
+    }
 
-  writer->SetFileTypeToBinary();
-  writer->WriteToOutputStringOn();
-  writer->Write();
+    writer->SetFileTypeToBinary();
+    writer->WriteToOutputStringOn();
+    writer->Write();
+
+    rawLength = writer->GetOutputStringLength();
+    rawBuffer = writer->RegisterAndGetOutputString();
+    writer->Delete();
+    writer = 0;
+  }
 
   char* buffer = NULL;
   vtkIdType buffer_length = 0;
 
-  if (vtkMPIMoveData::UseZLibCompression)
+  // The "auto" codec is only meaningful for point-to-point connections where
+  // we measure the bandwidth. For collectives within a server, don't compress.
+  const std::string& codec = vtkMPIMoveData::CompressionCodec;
+  std::vector<char> compressed;
+  bool useCompressor = false;
+  if (codec != "none" && (codec != "auto" || connection != nullptr))
+  {
+    vtkPVDataCompressor* compressor = vtkMPIMoveDataGetCompressor(connection);
+    compressor->SetCodec(codec.c_str());
+    compressor->SetLevel(vtkMPIMoveData::CompressionLevel);
+    compressor->SetShuffleElementSize(vtkMPIMoveData::CompressionShuffleElementSize);
+    useCompressor = compressor->Compress(rawBuffer, rawLength, compressed);
+  }
+
+  if (useCompressor)
+  {
+    buffer_length = static_cast<vtkIdType>(compressed.size());
+    buffer = new char[buffer_length];
+    memcpy(buffer, compressed.data(), compressed.size());
+    delete[] rawBuffer;
+  }
+  else if (vtkMPIMoveData::UseZLibCompression)
   {
     vtkTimerLog::MarkStartEvent("Zlib compress");
     // Use z-lib compression.
-    uLongf out_size = compressBound(writer->GetOutputStringLength());
+    uLongf out_size = compressBound(rawLength);
     buffer = new char[out_size + 8];
     memcpy(buffer, "zlib0000", 8);
 
     compress2(reinterpret_cast<Bytef*>(buffer + 8), &out_size,
-      reinterpret_cast<const Bytef*>(writer->GetOutputString()), writer->GetOutputStringLength(),
+      reinterpret_cast<const Bytef*>(rawBuffer), rawLength,
       /* compression_level */ Z_DEFAULT_COMPRESSION);
     vtkTimerLog::MarkEndEvent("Zlib compress");
-    int in_size = static_cast<int>(writer->GetOutputStringLength());
+    int in_size = static_cast<int>(rawLength);
     for (int cc = 0; cc < 4; cc++)
     {
       // the first 4 bytes in the header are "zlib" which helps the receiver
@@ -1096,12 +1246,14 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
       in_size = in_size >> 8;
     }
     buffer_length = out_size + 8;
+    delete[] rawBuffer;
   }
   else
   {
-    buffer_length = writer->GetOutputStringLength();
-    buffer = writer->RegisterAndGetOutputString();
+    buffer_length = rawLength;
+    buffer = rawBuffer;
   }
+  rawBuffer = NULL;
 
   // Get string.
   this->NumberOfBuffers = 1;
@@ -1111,9 +1263,6 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   this->BufferOffsets[0] = 0;
   this->Buffers = buffer;
   this->BufferTotalLength = this->BufferLengths[0];
-
-  writer->Delete();
-  writer = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -1134,7 +1283,18 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
     vtkIdType bufferLength = this->BufferLengths[idx];
 
     char* realBuffer = 0;
-    if (bufferLength > 4 && strncmp(bufferArray, "zlib", 4) == 0)
+    std::vector<char> decompressed;
+    if (vtkPVDataCompressor::IsCompressedBuffer(bufferArray, bufferLength))
+    {
+      if (!vtkPVDataCompressor::Decompress(bufferArray, bufferLength, decompressed))
+      {
+        vtkErrorMacro("Failed to decompress received data.");
+        continue;
+      }
+      bufferArray = decompressed.data();
+      bufferLength = static_cast<vtkIdType>(decompressed.size());
+    }
+    else if (bufferLength > 4 && strncmp(bufferArray, "zlib", 4) == 0)
     {
       // sender used zlib compression. Decompress it.
       vtkIdType compressed_length = bufferLength - 8; // remove the zlib header.
@@ -1156,6 +1316,27 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
       bufferLength = uncompressed_length;
     }
 
+    if (vtkPVDataObjectMarshaller::IsNativeBuffer(bufferArray, bufferLength))
+    {
+      vtkTimerLog::MarkStartEvent("Native unmarshal");
+      vtkSmartPointer<vtkDataObject> piece =
+        vtkPVDataObjectMarshaller::Unmarshal(bufferArray, bufferLength);
+      vtkTimerLog::MarkEndEvent("Native unmarshal");
+      if (piece)
+      {
+        // reconstructing data distributted on MPI node, so global ids are valid
+        unsetGlobalIdsAttribute(piece);
+        pieces.push_back(piece);
+      }
+      else
+      {
+        vtkErrorMacro("Failed to reconstruct data from native buffer.");
+      }
+      delete[] realBuffer;
+      realBuffer = 0;
+      continue;
+    }
+
     // Setup a reader.
     vtkDataReader* reader = vtkGenericDataObjectReader::New();
     reader->ReadFromInputStringOn();
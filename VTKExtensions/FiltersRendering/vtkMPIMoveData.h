@@ -29,6 +29,9 @@
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" //needed for exports
 #include "vtkPassInputTypeAlgorithm.h"
 
+#include <string> // for std::string
+
+class vtkCommunicator;
 class vtkMultiProcessController;
 class vtkSocketController;
 class vtkMPIMToNSocketConnection;
@@ -113,6 +116,46 @@ public:
   static bool GetUseZLibCompression();
   //@}
 
+  //@{
+  /**
+   * When set to true (default), datasets supported by
+   * vtkPVDataObjectMarshaller (polydata, unstructured grid, image data,
+   * structured grid and multiblock/multipiece trees of those) are marshalled
+   * by copying their raw array buffers instead of going through the legacy VTK
+   * writer and reader. Other types always use the legacy writer. As with
+   * UseZLibCompression, this only affects the sending processes; the receiver
+   * detects the format of each buffer.
+   */
+  static void SetUseNativeMarshalling(bool b);
+  static bool GetUseNativeMarshalling();
+  //@}
+
+  //@{
+  /**
+   * Codec used to compress data delivered by this class. Can be any codec
+   * registered with vtkPVDataCompressor ("zlib" and "lz4" are always
+   * available), "none" (default) or "auto". With "auto", the codec is chosen
+   * separately for each socket connection (client/data server, data
+   * server/render server) based on the measured bandwidth of that link;
+   * transfers between ranks of the same server are not compressed. When set
+   * to "none", the legacy UseZLibCompression flag is honored. As with
+   * UseZLibCompression, this only affects the sending processes.
+   */
+  static void SetCompressionCodec(const char* codec);
+  static const char* GetCompressionCodec();
+  //@}
+
+  //@{
+  /**
+   * Compression level (1-9) and byte-shuffle element size (0 to disable) used
+   * with CompressionCodec. See vtkPVDataCompressor.
+   */
+  static void SetCompressionLevel(int level);
+  static int GetCompressionLevel();
+  static void SetCompressionShuffleElementSize(int size);
+  static int GetCompressionShuffleElementSize();
+  //@}
+
   /**
    * vtkMPIMoveData doesn't necessarily generate a valid output data on all the
    * involved processes (depending on the MoveMode and Server ivars). This
@@ -172,7 +215,8 @@ protected:
   vtkIdType BufferTotalLength;
 
   void ClearBuffer();
-  void MarshalDataToBuffer(vtkDataObject* data);
+  void MarshalDataToBuffer(vtkDataObject* data, vtkCommunicator* connection = nullptr);
+  void SendBuffers(vtkCommunicator* connection, int tag);
   void ReconstructDataFromBuffer(vtkDataObject* data);
 
   int MoveMode;
@@ -197,6 +241,10 @@ private:
   void operator=(const vtkMPIMoveData&) = delete;
 
   static bool UseZLibCompression;
+  static bool UseNativeMarshalling;
+  static std::string CompressionCodec;
+  static int CompressionLevel;
+  static int CompressionShuffleElementSize;
 };
 
 #endif
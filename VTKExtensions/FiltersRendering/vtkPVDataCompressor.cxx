@@ -0,0 +1,630 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVDataCompressor.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVDataCompressor.h"
+
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVTraceRecorder.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include "vtk_lz4.h"
+#include "vtk_zlib.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+static_assert(vtkPVDataCompressor::MaximumChunkSize == LZ4_MAX_INPUT_SIZE,
+  "MaximumChunkSize must match LZ4_MAX_INPUT_SIZE");
+
+namespace
+{
+const char vtkPVDataCompressorMagic[4] = { 'v', 't', 'k', 'c' };
+const unsigned char vtkPVDataCompressorVersion = 1;
+
+//----------------------------------------------------------------------------
+// Built-in codecs.
+bool ZLibCompress(const char* input, size_t inputLength, int level, std::vector<char>& output)
+{
+  uLongf outSize = compressBound(static_cast<uLong>(inputLength));
+  output.resize(outSize);
+  if (compress2(reinterpret_cast<Bytef*>(output.data()), &outSize,
+        reinterpret_cast<const Bytef*>(input), static_cast<uLong>(inputLength), level) != Z_OK)
+  {
+    return false;
+  }
+  output.resize(outSize);
+  return true;
+}
+
+bool ZLibDecompress(const char* input, size_t inputLength, char* output, size_t outputLength)
+{
+  uLongf destLen = static_cast<uLongf>(outputLength);
+  return uncompress(reinterpret_cast<Bytef*>(output), &destLen,
+           reinterpret_cast<const Bytef*>(input), static_cast<uLong>(inputLength)) == Z_OK &&
+    destLen == outputLength;
+}
+
+bool LZ4Compress(const char* input, size_t inputLength, int level, std::vector<char>& output)
+{
+  // LZ4's acceleration is the inverse of a compression level: 1 is the
+  // default (best ratio for LZ4_compress_fast), larger values are faster.
+  const int acceleration = 10 - level;
+  if (inputLength > static_cast<size_t>(LZ4_MAX_INPUT_SIZE))
+  {
+    return false;
+  }
+  output.resize(LZ4_compressBound(static_cast<int>(inputLength)));
+  const int compressedSize = LZ4_compress_fast(input, output.data(),
+    static_cast<int>(inputLength), static_cast<int>(output.size()), acceleration);
+  if (compressedSize <= 0)
+  {
+    return false;
+  }
+  output.resize(compressedSize);
+  return true;
+}
+
+bool LZ4Decompress(const char* input, size_t inputLength, char* output, size_t outputLength)
+{
+  if (inputLength > static_cast<size_t>(LZ4_compressBound(LZ4_MAX_INPUT_SIZE)) ||
+    outputLength > static_cast<size_t>(LZ4_MAX_INPUT_SIZE))
+  {
+    return false;
+  }
+  return LZ4_decompress_safe(input, output, static_cast<int>(inputLength),
+           static_cast<int>(outputLength)) == static_cast<int>(outputLength);
+}
+
+//----------------------------------------------------------------------------
+struct CodecInfo
+{
+  vtkPVDataCompressor::CompressFunction Compress;
+  vtkPVDataCompressor::DecompressFunction Decompress;
+};
+
+class CodecRegistry
+{
+public:
+  static CodecRegistry& GetInstance()
+  {
+    static CodecRegistry instance;
+    return instance;
+  }
+
+  std::mutex Mutex;
+  std::map<std::string, CodecInfo> Codecs;
+
+private:
+  CodecRegistry()
+  {
+    this->Codecs["zlib"] = CodecInfo{ ZLibCompress, ZLibDecompress };
+    this->Codecs["lz4"] = CodecInfo{ LZ4Compress, LZ4Decompress };
+  }
+};
+
+bool FindCodec(const std::string& name, CodecInfo& info)
+{
+  CodecRegistry& registry = CodecRegistry::GetInstance();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  auto iter = registry.Codecs.find(name);
+  if (iter == registry.Codecs.end())
+  {
+    return false;
+  }
+  info = iter->second;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Byte shuffle filter: for N elements of `size` bytes, byte k of element i
+// moves to position k * N + i. Trailing bytes that do not form a full element
+// are copied as is.
+void Shuffle(const char* input, size_t length, size_t size, char* output)
+{
+  const size_t numElements = length / size;
+  for (size_t k = 0; k < size; ++k)
+  {
+    char* dest = output + k * numElements;
+    const char* src = input + k;
+    for (size_t i = 0; i < numElements; ++i)
+    {
+      dest[i] = src[i * size];
+    }
+  }
+  memcpy(output + numElements * size, input + numElements * size, length - numElements * size);
+}
+
+void Unshuffle(const char* input, size_t length, size_t size, char* output)
+{
+  const size_t numElements = length / size;
+  for (size_t k = 0; k < size; ++k)
+  {
+    const char* src = input + k * numElements;
+    char* dest = output + k;
+    for (size_t i = 0; i < numElements; ++i)
+    {
+      dest[i * size] = src[i];
+    }
+  }
+  memcpy(output + numElements * size, input + numElements * size, length - numElements * size);
+}
+
+//----------------------------------------------------------------------------
+// Little-endian helpers for the chunk table, so buffers can be decoded on any
+// platform.
+void AppendUInt64(std::vector<char>& buffer, vtkTypeUInt64 value)
+{
+  for (int cc = 0; cc < 8; ++cc)
+  {
+    buffer.push_back(static_cast<char>((value >> (8 * cc)) & 0xff));
+  }
+}
+
+vtkTypeUInt64 ReadUInt64(const char* buffer)
+{
+  vtkTypeUInt64 value = 0;
+  for (int cc = 0; cc < 8; ++cc)
+  {
+    value |= static_cast<vtkTypeUInt64>(static_cast<unsigned char>(buffer[cc])) << (8 * cc);
+  }
+  return value;
+}
+
+//----------------------------------------------------------------------------
+struct Chunk
+{
+  const char* Input;
+  size_t InputLength;
+  std::vector<char> Output;
+  bool Success;
+};
+
+class CompressChunks
+{
+public:
+  CompressChunks(std::vector<Chunk>& chunks, const CodecInfo& codec, int level, int shuffle)
+    : Chunks(chunks)
+    , Codec(codec)
+    , Level(level)
+    , ShuffleElementSize(shuffle)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<char> shuffled;
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      Chunk& chunk = this->Chunks[cc];
+      const char* input = chunk.Input;
+      if (this->ShuffleElementSize > 1)
+      {
+        shuffled.resize(chunk.InputLength);
+        Shuffle(chunk.Input, chunk.InputLength, this->ShuffleElementSize, shuffled.data());
+        input = shuffled.data();
+      }
+      chunk.Success = this->Codec.Compress(input, chunk.InputLength, this->Level, chunk.Output);
+    }
+  }
+
+private:
+  std::vector<Chunk>& Chunks;
+  const CodecInfo& Codec;
+  int Level;
+  int ShuffleElementSize;
+};
+
+struct EncodedChunk
+{
+  const char* Input;
+  size_t InputLength;
+  char* Output;
+  size_t OutputLength;
+  bool Success;
+};
+
+class DecompressChunks
+{
+public:
+  DecompressChunks(std::vector<EncodedChunk>& chunks, const CodecInfo& codec, int shuffle)
+    : Chunks(chunks)
+    , Codec(codec)
+    , ShuffleElementSize(shuffle)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<char> shuffled;
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      EncodedChunk& chunk = this->Chunks[cc];
+      if (this->ShuffleElementSize > 1)
+      {
+        shuffled.resize(chunk.OutputLength);
+        chunk.Success = this->Codec.Decompress(
+          chunk.Input, chunk.InputLength, shuffled.data(), chunk.OutputLength);
+        if (chunk.Success)
+        {
+          Unshuffle(shuffled.data(), chunk.OutputLength, this->ShuffleElementSize, chunk.Output);
+        }
+      }
+      else
+      {
+        chunk.Success =
+          this->Codec.Decompress(chunk.Input, chunk.InputLength, chunk.Output, chunk.OutputLength);
+      }
+    }
+  }
+
+private:
+  std::vector<EncodedChunk>& Chunks;
+  const CodecInfo& Codec;
+  int ShuffleElementSize;
+};
+}
+
+//============================================================================
+class vtkPVDataCompressor::vtkInternals
+{
+public:
+  // Measured per-codec performance, used by the "auto" mode. Ratio is
+  // compressed/uncompressed size; Throughput is uncompressed bytes per second.
+  // Initial values are conservative guesses that get replaced by measured
+  // values after the first buffer compressed with each codec.
+  struct CodecStats
+  {
+    double Ratio;
+    double Throughput;
+  };
+  std::map<std::string, CodecStats> Stats;
+
+  vtkInternals()
+  {
+    const double threads = std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads());
+    this->Stats["zlib"] = CodecStats{ 0.35, 50.0e6 * threads };
+    this->Stats["lz4"] = CodecStats{ 0.55, 400.0e6 * threads };
+  }
+
+  CodecStats GetStats(const std::string& codec)
+  {
+    auto iter = this->Stats.find(codec);
+    if (iter == this->Stats.end())
+    {
+      // unknown third-party codec; assume something in between.
+      iter = this->Stats.insert(std::make_pair(codec, CodecStats{ 0.45, 200.0e6 })).first;
+    }
+    return iter->second;
+  }
+
+  void Update(const std::string& codec, vtkIdType inLength, vtkIdType outLength, double seconds)
+  {
+    if (inLength <= 0 || seconds <= 0)
+    {
+      return;
+    }
+    // exponential moving average to smooth out variations between buffers.
+    const double alpha = 0.5;
+    CodecStats stats = this->GetStats(codec);
+    stats.Ratio = alpha * (static_cast<double>(outLength) / inLength) + (1 - alpha) * stats.Ratio;
+    stats.Throughput = alpha * (inLength / seconds) + (1 - alpha) * stats.Throughput;
+    this->Stats[codec] = stats;
+  }
+};
+
+vtkStandardNewMacro(vtkPVDataCompressor);
+constexpr vtkIdType vtkPVDataCompressor::MaximumChunkSize;
+//----------------------------------------------------------------------------
+vtkPVDataCompressor::vtkPVDataCompressor()
+  : Codec(nullptr)
+  , Level(1)
+  , ShuffleElementSize(0)
+  , ChunkSize(4 * 1024 * 1024)
+  , EstimatedBandwidth(0.0)
+  , Internals(new vtkPVDataCompressor::vtkInternals())
+{
+  this->SetCodec("none");
+}
+
+//----------------------------------------------------------------------------
+vtkPVDataCompressor::~vtkPVDataCompressor()
+{
+  this->SetCodec(nullptr);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataCompressor::RegisterCodec(
+  const char* name, CompressFunction compressor, DecompressFunction decompressor)
+{
+  if (name == nullptr || compressor == nullptr || decompressor == nullptr ||
+    strcmp(name, "none") == 0 || strcmp(name, "auto") == 0 || strlen(name) == 0 ||
+    strlen(name) > 255)
+  {
+    vtkGenericWarningMacro("Invalid codec registration.");
+    return false;
+  }
+  CodecRegistry& registry = CodecRegistry::GetInstance();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  registry.Codecs[name] = CodecInfo{ compressor, decompressor };
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataCompressor::UnregisterCodec(const char* name)
+{
+  CodecRegistry& registry = CodecRegistry::GetInstance();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  return name != nullptr && registry.Codecs.erase(name) > 0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataCompressor::HasCodec(const char* name)
+{
+  CodecInfo info;
+  return name != nullptr && FindCodec(name, info);
+}
+
+//----------------------------------------------------------------------------
+std::vector<std::string> vtkPVDataCompressor::GetAvailableCodecs()
+{
+  CodecRegistry& registry = CodecRegistry::GetInstance();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  std::vector<std::string> names;
+  for (const auto& pair : registry.Codecs)
+  {
+    names.push_back(pair.first);
+  }
+  return names;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataCompressor::RecordTransfer(vtkIdType bytes, double seconds)
+{
+  if (bytes <= 0 || seconds <= 0)
+  {
+    return;
+  }
+  const double bandwidth = bytes / seconds;
+  this->EstimatedBandwidth = this->EstimatedBandwidth > 0
+    ? 0.5 * bandwidth + 0.5 * this->EstimatedBandwidth
+    : bandwidth;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPVDataCompressor::GetEffectiveCodec(vtkIdType length)
+{
+  const std::string codec = this->Codec ? this->Codec : "none";
+  if (codec != "auto")
+  {
+    return codec;
+  }
+
+  // Without a bandwidth estimate we don't know anything about the link. Use
+  // the cheapest codec so the first transfer can be measured without risking
+  // a big slowdown on fast links.
+  if (this->EstimatedBandwidth <= 0)
+  {
+    return vtkPVDataCompressor::HasCodec("lz4") ? "lz4" : "none";
+  }
+
+  // Pick the codec minimizing: compress time + transfer time.
+  std::string best = "none";
+  double bestTime = length / this->EstimatedBandwidth;
+  for (const auto& name : vtkPVDataCompressor::GetAvailableCodecs())
+  {
+    auto stats = this->Internals->GetStats(name);
+    const double time =
+      length / stats.Throughput + (length * stats.Ratio) / this->EstimatedBandwidth;
+    if (time < bestTime)
+    {
+      best = name;
+      bestTime = time;
+    }
+  }
+  return best;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataCompressor::Compress(const char* input, vtkIdType length, std::vector<char>& output)
+{
+  vtkPVTraceScope("compression", "compress data");
+  const std::string codecName = this->GetEffectiveCodec(length);
+  CodecInfo codec;
+  if (codecName == "none" || length <= 0)
+  {
+    return false;
+  }
+  if (!FindCodec(codecName, codec))
+  {
+    vtkErrorMacro("Unknown codec '" << codecName.c_str() << "'.");
+    return false;
+  }
+
+  vtkTimerLog::MarkStartEvent("vtkPVDataCompressor::Compress");
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+
+  const vtkIdType numChunks = (length + this->ChunkSize - 1) / this->ChunkSize;
+  std::vector<Chunk> chunks(numChunks);
+  for (vtkIdType cc = 0; cc < numChunks; ++cc)
+  {
+    chunks[cc].Input = input + cc * this->ChunkSize;
+    chunks[cc].InputLength =
+      static_cast<size_t>(std::min(this->ChunkSize, length - cc * this->ChunkSize));
+    chunks[cc].Success = false;
+  }
+
+  CompressChunks functor(chunks, codec, this->Level, this->ShuffleElementSize);
+  vtkSMPTools::For(0, numChunks, 1, functor);
+
+  // Header: magic, version, shuffle size, codec name, total length, chunk
+  // count, then (raw, compressed) length pairs followed by the chunks.
+  output.clear();
+  output.insert(output.end(), vtkPVDataCompressorMagic, vtkPVDataCompressorMagic + 4);
+  output.push_back(static_cast<char>(vtkPVDataCompressorVersion));
+  output.push_back(static_cast<char>(this->ShuffleElementSize > 1 ? this->ShuffleElementSize : 0));
+  output.push_back(static_cast<char>(codecName.size()));
+  output.insert(output.end(), codecName.begin(), codecName.end());
+  AppendUInt64(output, static_cast<vtkTypeUInt64>(length));
+  AppendUInt64(output, static_cast<vtkTypeUInt64>(numChunks));
+  size_t totalSize = output.size() + numChunks * 16;
+  for (const auto& chunk : chunks)
+  {
+    if (!chunk.Success)
+    {
+      vtkTimerLog::MarkEndEvent("vtkPVDataCompressor::Compress");
+      vtkErrorMacro("Codec '" << codecName.c_str() << "' failed to compress buffer.");
+      output.clear();
+      return false;
+    }
+    AppendUInt64(output, static_cast<vtkTypeUInt64>(chunk.InputLength));
+    AppendUInt64(output, static_cast<vtkTypeUInt64>(chunk.Output.size()));
+    totalSize += chunk.Output.size();
+  }
+  output.reserve(totalSize);
+  for (const auto& chunk : chunks)
+  {
+    output.insert(output.end(), chunk.Output.begin(), chunk.Output.end());
+  }
+
+  timer->StopTimer();
+  this->Internals->Update(
+    codecName, length, static_cast<vtkIdType>(output.size()), timer->GetElapsedTime());
+  vtkTimerLog::MarkEndEvent("vtkPVDataCompressor::Compress");
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataCompressor::IsCompressedBuffer(const char* buffer, vtkIdType length)
+{
+  return buffer != nullptr && length >= 7 && memcmp(buffer, vtkPVDataCompressorMagic, 4) == 0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataCompressor::Decompress(
+  const char* input, vtkIdType length, std::vector<char>& output)
+{
+  vtkPVTraceScope("compression", "decompress data");
+  if (!vtkPVDataCompressor::IsCompressedBuffer(input, length))
+  {
+    vtkGenericWarningMacro("Buffer was not produced by vtkPVDataCompressor.");
+    return false;
+  }
+  if (static_cast<unsigned char>(input[4]) != vtkPVDataCompressorVersion)
+  {
+    vtkGenericWarningMacro("Unsupported vtkPVDataCompressor buffer version.");
+    return false;
+  }
+
+  const int shuffle = static_cast<unsigned char>(input[5]);
+  const size_t nameLength = static_cast<unsigned char>(input[6]);
+  size_t pos = 7;
+  if (static_cast<size_t>(length) < pos + nameLength + 16)
+  {
+    vtkGenericWarningMacro("Truncated compressed buffer.");
+    return false;
+  }
+  const std::string codecName(input + pos, nameLength);
+  pos += nameLength;
+  CodecInfo codec;
+  if (!FindCodec(codecName, codec))
+  {
+    vtkGenericWarningMacro("Buffer was compressed with unknown codec '" << codecName.c_str()
+                                                                         << "'.");
+    return false;
+  }
+
+  const vtkTypeUInt64 totalLength = ReadUInt64(input + pos);
+  const vtkTypeUInt64 numChunks = ReadUInt64(input + pos + 8);
+  pos += 16;
+  if (numChunks > (static_cast<vtkTypeUInt64>(length) - pos) / 16)
+  {
+    vtkGenericWarningMacro("Truncated compressed buffer.");
+    return false;
+  }
+
+  // Validate the chunk table before allocating anything: the chunks must lie
+  // within the buffer, be no larger than the largest chunk we write, and add
+  // up to the total length.
+  const size_t tablePos = pos;
+  vtkTypeUInt64 rawSum = 0;
+  vtkTypeUInt64 compressedSum = 0;
+  const vtkTypeUInt64 available =
+    static_cast<vtkTypeUInt64>(length) - tablePos - numChunks * 16;
+  for (vtkTypeUInt64 cc = 0; cc < numChunks; ++cc)
+  {
+    const vtkTypeUInt64 rawLength = ReadUInt64(input + tablePos + cc * 16);
+    const vtkTypeUInt64 compressedLength = ReadUInt64(input + tablePos + cc * 16 + 8);
+    if (rawLength > static_cast<vtkTypeUInt64>(vtkPVDataCompressor::MaximumChunkSize) ||
+      rawSum + rawLength < rawSum || compressedLength > available - compressedSum)
+    {
+      vtkGenericWarningMacro("Corrupt compressed buffer.");
+      return false;
+    }
+    rawSum += rawLength;
+    compressedSum += compressedLength;
+  }
+  if (rawSum != totalLength || totalLength > static_cast<vtkTypeUInt64>(output.max_size()))
+  {
+    vtkGenericWarningMacro("Corrupt compressed buffer.");
+    return false;
+  }
+
+  vtkTimerLog::MarkStartEvent("vtkPVDataCompressor::Decompress");
+  output.resize(static_cast<size_t>(totalLength));
+  std::vector<EncodedChunk> chunks(static_cast<size_t>(numChunks));
+  size_t dataPos = tablePos + static_cast<size_t>(numChunks) * 16;
+  size_t outPos = 0;
+  for (size_t cc = 0; cc < chunks.size(); ++cc)
+  {
+    const size_t rawLength = static_cast<size_t>(ReadUInt64(input + tablePos + cc * 16));
+    const size_t compressedLength =
+      static_cast<size_t>(ReadUInt64(input + tablePos + cc * 16 + 8));
+    chunks[cc] = EncodedChunk{ input + dataPos, compressedLength, output.data() + outPos,
+      rawLength, false };
+    dataPos += compressedLength;
+    outPos += rawLength;
+  }
+
+  DecompressChunks functor(chunks, codec, shuffle);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), 1, functor);
+  vtkTimerLog::MarkEndEvent("vtkPVDataCompressor::Decompress");
+
+  for (const auto& chunk : chunks)
+  {
+    if (!chunk.Success)
+    {
+      vtkGenericWarningMacro("Failed to decompress buffer using codec '" << codecName.c_str()
+                                                                           << "'.");
+      return false;
+    }
+  }
+  return outPos == output.size();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Codec: " << (this->Codec ? this->Codec : "(none)") << endl;
+  os << indent << "Level: " << this->Level << endl;
+  os << indent << "ShuffleElementSize: " << this->ShuffleElementSize << endl;
+  os << indent << "ChunkSize: " << this->ChunkSize << endl;
+  os << indent << "EstimatedBandwidth: " << this->EstimatedBandwidth << endl;
+}
@@ -0,0 +1,183 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVDataCompressor.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVDataCompressor
+ * @brief   chunked, multithreaded compressor for data delivery buffers.
+ *
+ * vtkPVDataCompressor compresses the marshalled buffers exchanged by
+ * vtkMPIMoveData. It is the data-delivery counterpart of vtkImageCompressor:
+ * codecs are looked up by name in a registry ("zlib" and "lz4" are built in,
+ * others can be added with RegisterCodec()). The input is split into
+ * independent chunks which are compressed and decompressed concurrently using
+ * vtkSMPTools.
+ *
+ * An optional byte-shuffle filter can be applied to each chunk before
+ * compression. It transposes the bytes of fixed size elements (typically 4
+ * for float arrays) so that exponents and high-order mantissa bytes end up
+ * next to each other, which improves compression ratios on floating point
+ * data considerably.
+ *
+ * When the codec is set to "auto", the compressor picks the codec that
+ * minimizes the estimated time to compress and transfer the buffer, based on
+ * the bandwidth reported through RecordTransfer() and the compression ratio
+ * and throughput measured for each codec on previous buffers. One instance
+ * should be used per connection, so that estimates are not mixed between
+ * links.
+ *
+ * @sa vtkMPIMoveData, vtkImageCompressor
+ */
+
+#ifndef vtkPVDataCompressor_h
+#define vtkPVDataCompressor_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+
+#include <string> // needed for std::string
+#include <vector> // needed for std::vector
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkPVDataCompressor : public vtkObject
+{
+public:
+  static vtkPVDataCompressor* New();
+  vtkTypeMacro(vtkPVDataCompressor, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Largest supported chunk size, equal to LZ4_MAX_INPUT_SIZE.
+   */
+  static constexpr vtkIdType MaximumChunkSize = 0x7E000000;
+
+  /**
+   * Signature for a codec's compress function. Must compress `inputLength`
+   * bytes from `input` into `output` (resizing it as needed) using the given
+   * level (1-9, higher is smaller/slower). Must be thread safe.
+   */
+  typedef bool (*CompressFunction)(
+    const char* input, size_t inputLength, int level, std::vector<char>& output);
+
+  /**
+   * Signature for a codec's decompress function. `outputLength` is the exact
+   * decompressed size. Must be thread safe.
+   */
+  typedef bool (*DecompressFunction)(
+    const char* input, size_t inputLength, char* output, size_t outputLength);
+
+  //@{
+  /**
+   * Codec registry. Codec names are limited to 255 characters. "none" and
+   * "auto" are reserved. Registering an existing name replaces the codec.
+   */
+  static bool RegisterCodec(
+    const char* name, CompressFunction compressor, DecompressFunction decompressor);
+  static bool UnregisterCodec(const char* name);
+  static bool HasCodec(const char* name);
+  static std::vector<std::string> GetAvailableCodecs();
+  //@}
+
+  //@{
+  /**
+   * Codec to use. One of the registered codec names, "none" or "auto".
+   * Default is "none".
+   */
+  vtkSetStringMacro(Codec);
+  vtkGetStringMacro(Codec);
+  //@}
+
+  //@{
+  /**
+   * Compression level passed to the codec, from 1 (fastest) to 9 (smallest).
+   * Default is 1.
+   */
+  vtkSetClampMacro(Level, int, 1, 9);
+  vtkGetMacro(Level, int);
+  //@}
+
+  //@{
+  /**
+   * Element size, in bytes, for the byte-shuffle filter. Values less than 2
+   * disable the filter. Default is 0.
+   */
+  vtkSetClampMacro(ShuffleElementSize, int, 0, 16);
+  vtkGetMacro(ShuffleElementSize, int);
+  //@}
+
+  //@{
+  /**
+   * Size of the independently compressed chunks. Smaller chunks improve
+   * parallelism at the expense of compression ratio. Default is 4 MiB.
+   * Chunks cannot be larger than what LZ4 accepts as input.
+   */
+  vtkSetClampMacro(ChunkSize, vtkIdType, 64 * 1024, MaximumChunkSize);
+  vtkGetMacro(ChunkSize, vtkIdType);
+  //@}
+
+  /**
+   * Compresses `length` bytes from `input` into `output`. If the effective
+   * codec is "none", returns false and leaves `output` untouched: the caller
+   * should send the input as is.
+   */
+  bool Compress(const char* input, vtkIdType length, std::vector<char>& output);
+
+  /**
+   * Returns true if `buffer` was produced by Compress().
+   */
+  static bool IsCompressedBuffer(const char* buffer, vtkIdType length);
+
+  /**
+   * Decompresses a buffer produced by Compress(). The codec is read from the
+   * buffer, so this can be used on any receiver, independently of the
+   * receiver's settings.
+   */
+  static bool Decompress(const char* input, vtkIdType length, std::vector<char>& output);
+
+  /**
+   * Report that `bytes` were transferred over this connection in `seconds`.
+   * Used to estimate the connection bandwidth when Codec is "auto".
+   */
+  void RecordTransfer(vtkIdType bytes, double seconds);
+
+  /**
+   * Returns the current bandwidth estimate, in bytes per second, or 0 if no
+   * transfer has been recorded yet.
+   */
+  vtkGetMacro(EstimatedBandwidth, double);
+
+  /**
+   * Returns the codec Compress() would use for a buffer of the given size.
+   * This is the same as Codec, unless it is "auto".
+   */
+  std::string GetEffectiveCodec(vtkIdType length);
+
+protected:
+  vtkPVDataCompressor();
+  ~vtkPVDataCompressor() override;
+
+  char* Codec;
+  int Level;
+  int ShuffleElementSize;
+  vtkIdType ChunkSize;
+  double EstimatedBandwidth;
+
+private:
+  vtkPVDataCompressor(const vtkPVDataCompressor&) = delete;
+  void operator=(const vtkPVDataCompressor&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkPVDataCompressor.h
@@ -0,0 +1,1086 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVDataObjectMarshaller.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVDataObjectMarshaller.h"
+
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataObjectTypes.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStringArray.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTypeInt32Array.h"
+#include "vtkTypeInt64Array.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+// Bump this when the layout changes. Receivers reject buffers with a
+// different version.
+const unsigned char vtkPVDataObjectMarshallerVersion = 1;
+const char vtkPVDataObjectMarshallerMagic[4] = { 'v', 't', 'k', 'n' };
+const int vtkPVDataObjectMarshallerHeaderSize = 8;
+
+// Tags used to identify what follows in the stream.
+enum ObjectTags : vtkTypeInt32
+{
+  NULL_OBJECT = -1
+};
+
+enum ArrayTags : vtkTypeInt32
+{
+  DATA_ARRAY = 0,
+  STRING_ARRAY = 1
+};
+
+unsigned char vtkPVDataObjectMarshallerByteOrder()
+{
+#ifdef VTK_WORDS_BIGENDIAN
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool CanMarshalArray(vtkAbstractArray* array)
+{
+  if (vtkStringArray::SafeDownCast(array))
+  {
+    return true;
+  }
+  vtkDataArray* da = vtkDataArray::SafeDownCast(array);
+  return da != nullptr && da->GetDataType() != VTK_BIT;
+}
+
+//----------------------------------------------------------------------------
+bool CanMarshalFieldData(vtkFieldData* fd)
+{
+  if (fd == nullptr)
+  {
+    return true;
+  }
+  for (int cc = 0, max = fd->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    if (!CanMarshalArray(fd->GetAbstractArray(cc)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//============================================================================
+class Writer
+{
+public:
+  Writer(vtkPVDataObjectMarshaller::GatherList& list)
+    : List(list)
+  {
+  }
+
+  template <typename T>
+  void Write(const T& value)
+  {
+    this->List.AppendInline(&value, sizeof(T));
+  }
+
+  void WriteString(const std::string& str)
+  {
+    this->Write(static_cast<vtkTypeInt64>(str.size()));
+    if (!str.empty())
+    {
+      this->List.AppendInline(str.c_str(), str.size());
+    }
+  }
+
+  void WriteOptionalString(const char* str)
+  {
+    this->Write(static_cast<vtkTypeInt8>(str ? 1 : 0));
+    if (str)
+    {
+      this->WriteString(str);
+    }
+  }
+
+  void WriteArray(vtkAbstractArray* array)
+  {
+    if (vtkStringArray* sa = vtkStringArray::SafeDownCast(array))
+    {
+      this->Write(static_cast<vtkTypeInt32>(STRING_ARRAY));
+      this->WriteArrayHeader(sa);
+      const vtkIdType numValues = sa->GetNumberOfValues();
+      for (vtkIdType cc = 0; cc < numValues; ++cc)
+      {
+        this->WriteString(sa->GetValue(cc));
+      }
+      return;
+    }
+
+    vtkDataArray* da = vtkDataArray::SafeDownCast(array);
+    assert(da != nullptr);
+    this->Write(static_cast<vtkTypeInt32>(DATA_ARRAY));
+    this->WriteArrayHeader(da);
+    this->Write(static_cast<vtkTypeInt32>(da->GetDataTypeSize()));
+
+    vtkSmartPointer<vtkDataArray> aos = da;
+    if (!da->HasStandardMemoryLayout())
+    {
+      // SOA or implicit arrays need to be converted to the contiguous layout
+      // before we can point at them.
+      aos.TakeReference(vtkDataArray::CreateDataArray(da->GetDataType()));
+      aos->DeepCopy(da);
+    }
+
+    const vtkIdType numBytes = static_cast<vtkIdType>(aos->GetNumberOfValues()) *
+      static_cast<vtkIdType>(aos->GetDataTypeSize());
+    if (numBytes > 0)
+    {
+      this->List.AppendExternal(aos, aos->GetVoidPointer(0), numBytes);
+    }
+  }
+
+  void WriteFieldData(vtkFieldData* fd)
+  {
+    vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+    const vtkTypeInt32 numArrays = fd ? fd->GetNumberOfArrays() : 0;
+    this->Write(numArrays);
+    for (vtkTypeInt32 cc = 0; cc < numArrays; ++cc)
+    {
+      this->Write(static_cast<vtkTypeInt32>(dsa ? dsa->IsArrayAnAttribute(cc) : -1));
+      this->WriteArray(fd->GetAbstractArray(cc));
+    }
+  }
+
+  void WriteCellArray(vtkCellArray* ca)
+  {
+    if (ca == nullptr)
+    {
+      this->Write(static_cast<vtkTypeInt8>(0));
+      return;
+    }
+    this->Write(static_cast<vtkTypeInt8>(1));
+    this->WriteArray(ca->GetOffsetsArray());
+    this->WriteArray(ca->GetConnectivityArray());
+  }
+
+  void WritePoints(vtkPoints* pts)
+  {
+    this->Write(static_cast<vtkTypeInt8>(pts ? 1 : 0));
+    if (pts)
+    {
+      this->WriteArray(pts->GetData());
+    }
+  }
+
+  void WriteDataSetAttributes(vtkDataSet* ds)
+  {
+    this->WriteFieldData(ds->GetPointData());
+    this->WriteFieldData(ds->GetCellData());
+  }
+
+  bool WriteDataObject(vtkDataObject* dobj)
+  {
+    if (dobj == nullptr)
+    {
+      this->Write(static_cast<vtkTypeInt32>(NULL_OBJECT));
+      return true;
+    }
+
+    const vtkTypeInt32 type = dobj->GetDataObjectType();
+    this->Write(type);
+    switch (type)
+    {
+      case VTK_POLY_DATA:
+      {
+        vtkPolyData* pd = vtkPolyData::SafeDownCast(dobj);
+        this->WritePoints(pd->GetPoints());
+        this->WriteCellArray(pd->GetVerts());
+        this->WriteCellArray(pd->GetLines());
+        this->WriteCellArray(pd->GetPolys());
+        this->WriteCellArray(pd->GetStrips());
+        this->WriteDataSetAttributes(pd);
+      }
+      break;
+
+      case VTK_UNSTRUCTURED_GRID:
+      {
+        vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dobj);
+        this->WritePoints(ug->GetPoints());
+        vtkUnsignedCharArray* types = ug->GetCellTypesArray();
+        this->Write(static_cast<vtkTypeInt8>(types ? 1 : 0));
+        if (types)
+        {
+          this->WriteArray(types);
+        }
+        this->WriteCellArray(ug->GetCells());
+        vtkIdTypeArray* faces = ug->GetFaces();
+        vtkIdTypeArray* faceLocations = ug->GetFaceLocations();
+        const bool hasFaces = (faces != nullptr && faceLocations != nullptr);
+        this->Write(static_cast<vtkTypeInt8>(hasFaces ? 1 : 0));
+        if (hasFaces)
+        {
+          this->WriteArray(faceLocations);
+          this->WriteArray(faces);
+        }
+        this->WriteDataSetAttributes(ug);
+      }
+      break;
+
+      case VTK_IMAGE_DATA:
+      case VTK_UNIFORM_GRID:
+      case VTK_STRUCTURED_POINTS:
+      {
+        vtkImageData* id = vtkImageData::SafeDownCast(dobj);
+        int extent[6];
+        id->GetExtent(extent);
+        for (int cc = 0; cc < 6; ++cc)
+        {
+          this->Write(static_cast<vtkTypeInt32>(extent[cc]));
+        }
+        double origin[3], spacing[3];
+        id->GetOrigin(origin);
+        id->GetSpacing(spacing);
+        for (int cc = 0; cc < 3; ++cc)
+        {
+          this->Write(origin[cc]);
+        }
+        for (int cc = 0; cc < 3; ++cc)
+        {
+          this->Write(spacing[cc]);
+        }
+        this->WriteDataSetAttributes(id);
+      }
+      break;
+
+      case VTK_STRUCTURED_GRID:
+      {
+        vtkStructuredGrid* sg = vtkStructuredGrid::SafeDownCast(dobj);
+        int extent[6];
+        sg->GetExtent(extent);
+        for (int cc = 0; cc < 6; ++cc)
+        {
+          this->Write(static_cast<vtkTypeInt32>(extent[cc]));
+        }
+        this->WritePoints(sg->GetPoints());
+        this->WriteDataSetAttributes(sg);
+      }
+      break;
+
+      case VTK_MULTIBLOCK_DATA_SET:
+      {
+        vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(dobj);
+        const vtkTypeInt32 numBlocks = static_cast<vtkTypeInt32>(mb->GetNumberOfBlocks());
+        this->Write(numBlocks);
+        for (vtkTypeInt32 cc = 0; cc < numBlocks; ++cc)
+        {
+          const char* name = mb->HasMetaData(cc)
+            ? mb->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME())
+            : nullptr;
+          this->WriteOptionalString(name);
+          if (!this->WriteDataObject(mb->GetBlock(cc)))
+          {
+            return false;
+          }
+        }
+      }
+      break;
+
+      case VTK_MULTIPIECE_DATA_SET:
+      {
+        vtkMultiPieceDataSet* mp = vtkMultiPieceDataSet::SafeDownCast(dobj);
+        const vtkTypeInt32 numPieces = static_cast<vtkTypeInt32>(mp->GetNumberOfPieces());
+        this->Write(numPieces);
+        for (vtkTypeInt32 cc = 0; cc < numPieces; ++cc)
+        {
+          const char* name = mp->HasMetaData(cc)
+            ? mp->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME())
+            : nullptr;
+          this->WriteOptionalString(name);
+          if (!this->WriteDataObject(mp->GetPieceAsDataObject(cc)))
+          {
+            return false;
+          }
+        }
+      }
+      break;
+
+      default:
+        return false;
+    }
+
+    this->WriteFieldData(dobj->GetFieldData());
+    return true;
+  }
+
+private:
+  void WriteArrayHeader(vtkAbstractArray* array)
+  {
+    this->Write(static_cast<vtkTypeInt32>(array->GetDataType()));
+    this->Write(static_cast<vtkTypeInt32>(array->GetNumberOfComponents()));
+    this->Write(static_cast<vtkTypeInt64>(array->GetNumberOfTuples()));
+    this->WriteOptionalString(array->GetName());
+    const int numComps = array->GetNumberOfComponents();
+    const bool hasComponentNames = array->HasAComponentName();
+    this->Write(static_cast<vtkTypeInt8>(hasComponentNames ? 1 : 0));
+    if (hasComponentNames)
+    {
+      for (int cc = 0; cc < numComps; ++cc)
+      {
+        this->WriteOptionalString(array->GetComponentName(cc));
+      }
+    }
+  }
+
+  vtkPVDataObjectMarshaller::GatherList& List;
+};
+
+//============================================================================
+class Reader
+{
+public:
+  Reader(const char* buffer, vtkIdType length, bool swap)
+    : Pointer(buffer)
+    , End(buffer + length)
+    , Swap(swap)
+    , Failed(false)
+  {
+  }
+
+  bool HasFailed() const { return this->Failed; }
+
+  template <typename T>
+  bool Read(T& value)
+  {
+    if (!this->ReadBytes(&value, sizeof(T)))
+    {
+      return false;
+    }
+    if (this->Swap && sizeof(T) > 1)
+    {
+      vtkByteSwap::SwapVoidRange(&value, 1, sizeof(T));
+    }
+    return true;
+  }
+
+  bool ReadBytes(void* dest, vtkIdType length)
+  {
+    if (this->Failed || length < 0 || this->End - this->Pointer < length)
+    {
+      this->Failed = true;
+      return false;
+    }
+    if (length > 0)
+    {
+      memcpy(dest, this->Pointer, static_cast<size_t>(length));
+      this->Pointer += length;
+    }
+    return true;
+  }
+
+  bool ReadString(std::string& str)
+  {
+    vtkTypeInt64 length = 0;
+    if (!this->Read(length) || length < 0 || this->End - this->Pointer < length)
+    {
+      this->Failed = true;
+      return false;
+    }
+    str.assign(this->Pointer, static_cast<size_t>(length));
+    this->Pointer += length;
+    return true;
+  }
+
+  bool ReadOptionalString(std::string& str, bool& valid)
+  {
+    vtkTypeInt8 flag = 0;
+    valid = false;
+    if (!this->Read(flag))
+    {
+      return false;
+    }
+    valid = (flag != 0);
+    return valid ? this->ReadString(str) : true;
+  }
+
+  vtkSmartPointer<vtkAbstractArray> ReadArray()
+  {
+    vtkTypeInt32 kind, dataType, numComps;
+    vtkTypeInt64 numTuples;
+    if (!this->Read(kind) || !this->Read(dataType) || !this->Read(numComps) ||
+      !this->Read(numTuples) || numComps < 1 || numTuples < 0)
+    {
+      this->Failed = true;
+      return nullptr;
+    }
+
+    std::string name;
+    bool hasName;
+    vtkTypeInt8 hasComponentNames = 0;
+    if (!this->ReadOptionalString(name, hasName) || !this->Read(hasComponentNames))
+    {
+      return nullptr;
+    }
+    std::vector<std::pair<bool, std::string> > componentNames;
+    for (vtkTypeInt32 cc = 0; hasComponentNames && cc < numComps; ++cc)
+    {
+      componentNames.emplace_back();
+      if (!this->ReadOptionalString(componentNames.back().second, componentNames.back().first))
+      {
+        return nullptr;
+      }
+    }
+
+    vtkSmartPointer<vtkAbstractArray> result;
+    if (kind == STRING_ARRAY)
+    {
+      vtkNew<vtkStringArray> sa;
+      sa->SetNumberOfComponents(numComps);
+      sa->SetNumberOfTuples(numTuples);
+      for (vtkIdType cc = 0, max = sa->GetNumberOfValues(); cc < max; ++cc)
+      {
+        std::string value;
+        if (!this->ReadString(value))
+        {
+          return nullptr;
+        }
+        sa->SetValue(cc, value);
+      }
+      result = sa.GetPointer();
+    }
+    else if (kind == DATA_ARRAY)
+    {
+      vtkTypeInt32 typeSize;
+      if (!this->Read(typeSize) || typeSize <= 0)
+      {
+        this->Failed = true;
+        return nullptr;
+      }
+      result = this->ReadDataArrayValues(dataType, typeSize, numComps, numTuples);
+    }
+    else
+    {
+      this->Failed = true;
+    }
+
+    if (result)
+    {
+      if (hasName)
+      {
+        result->SetName(name.c_str());
+      }
+      for (size_t cc = 0; cc < componentNames.size(); ++cc)
+      {
+        if (componentNames[cc].first)
+        {
+          result->SetComponentName(
+            static_cast<vtkIdType>(cc), componentNames[cc].second.c_str());
+        }
+      }
+    }
+    return result;
+  }
+
+  vtkSmartPointer<vtkPoints> ReadPoints()
+  {
+    vtkTypeInt8 flag = 0;
+    if (!this->Read(flag) || flag == 0)
+    {
+      return nullptr;
+    }
+    vtkSmartPointer<vtkDataArray> da = vtkDataArray::SafeDownCast(this->ReadArray());
+    if (da == nullptr || da->GetNumberOfComponents() != 3)
+    {
+      this->Failed = true;
+      return nullptr;
+    }
+    vtkNew<vtkPoints> pts;
+    pts->SetData(da);
+    return pts.GetPointer();
+  }
+
+  vtkSmartPointer<vtkCellArray> ReadCellArray()
+  {
+    vtkTypeInt8 flag = 0;
+    if (!this->Read(flag) || flag == 0)
+    {
+      return nullptr;
+    }
+    auto offsets = this->ReadCellArrayStorage();
+    auto connectivity = this->ReadCellArrayStorage();
+    vtkNew<vtkCellArray> ca;
+    if (offsets == nullptr || connectivity == nullptr || !ca->SetData(offsets, connectivity))
+    {
+      this->Failed = true;
+      return nullptr;
+    }
+    return ca.GetPointer();
+  }
+
+  bool ReadFieldData(vtkFieldData* fd)
+  {
+    vtkTypeInt32 numArrays = 0;
+    if (!this->Read(numArrays) || numArrays < 0)
+    {
+      this->Failed = true;
+      return false;
+    }
+    vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+    for (vtkTypeInt32 cc = 0; cc < numArrays; ++cc)
+    {
+      vtkTypeInt32 attributeType = -1;
+      if (!this->Read(attributeType))
+      {
+        return false;
+      }
+      vtkSmartPointer<vtkAbstractArray> array = this->ReadArray();
+      if (!array)
+      {
+        this->Failed = true;
+        return false;
+      }
+      const int index = fd->AddArray(array);
+      if (dsa && attributeType >= 0 && attributeType < vtkDataSetAttributes::NUM_ATTRIBUTES)
+      {
+        dsa->SetActiveAttribute(index, attributeType);
+      }
+    }
+    return true;
+  }
+
+  bool ReadDataSetAttributes(vtkDataSet* ds)
+  {
+    return this->ReadFieldData(ds->GetPointData()) && this->ReadFieldData(ds->GetCellData());
+  }
+
+  bool ReadExtent(int extent[6])
+  {
+    for (int cc = 0; cc < 6; ++cc)
+    {
+      vtkTypeInt32 value;
+      if (!this->Read(value))
+      {
+        return false;
+      }
+      extent[cc] = value;
+    }
+    return true;
+  }
+
+  vtkSmartPointer<vtkDataObject> ReadDataObject()
+  {
+    vtkTypeInt32 type;
+    if (!this->Read(type) || type == NULL_OBJECT)
+    {
+      return nullptr;
+    }
+
+    vtkSmartPointer<vtkDataObject> result;
+    switch (type)
+    {
+      case VTK_POLY_DATA:
+      {
+        vtkNew<vtkPolyData> pd;
+        pd->SetPoints(this->ReadPoints());
+        auto verts = this->ReadCellArray();
+        auto lines = this->ReadCellArray();
+        auto polys = this->ReadCellArray();
+        auto strips = this->ReadCellArray();
+        if (this->Failed)
+        {
+          return nullptr;
+        }
+        pd->SetVerts(verts);
+        pd->SetLines(lines);
+        pd->SetPolys(polys);
+        pd->SetStrips(strips);
+        if (!this->ReadDataSetAttributes(pd))
+        {
+          return nullptr;
+        }
+        result = pd.GetPointer();
+      }
+      break;
+
+      case VTK_UNSTRUCTURED_GRID:
+      {
+        vtkNew<vtkUnstructuredGrid> ug;
+        ug->SetPoints(this->ReadPoints());
+        vtkTypeInt8 hasTypes = 0;
+        this->Read(hasTypes);
+        vtkSmartPointer<vtkUnsignedCharArray> types;
+        if (hasTypes)
+        {
+          types = vtkUnsignedCharArray::SafeDownCast(this->ReadArray());
+        }
+        auto cells = this->ReadCellArray();
+        vtkTypeInt8 hasFaces = 0;
+        this->Read(hasFaces);
+        vtkSmartPointer<vtkIdTypeArray> faceLocations;
+        vtkSmartPointer<vtkIdTypeArray> faces;
+        if (hasFaces)
+        {
+          faceLocations = vtkIdTypeArray::SafeDownCast(this->ReadArray());
+          faces = vtkIdTypeArray::SafeDownCast(this->ReadArray());
+        }
+        if (this->Failed)
+        {
+          return nullptr;
+        }
+        if (types && cells)
+        {
+          ug->SetCells(types, cells, faceLocations, faces);
+        }
+        if (!this->ReadDataSetAttributes(ug))
+        {
+          return nullptr;
+        }
+        result = ug.GetPointer();
+      }
+      break;
+
+      case VTK_IMAGE_DATA:
+      case VTK_UNIFORM_GRID:
+      case VTK_STRUCTURED_POINTS:
+      {
+        vtkSmartPointer<vtkImageData> id;
+        id.TakeReference(vtkImageData::SafeDownCast(vtkDataObjectTypes::NewDataObject(type)));
+        int extent[6];
+        double origin[3], spacing[3];
+        if (!id || !this->ReadExtent(extent) || !this->Read(origin[0]) ||
+          !this->Read(origin[1]) || !this->Read(origin[2]) || !this->Read(spacing[0]) ||
+          !this->Read(spacing[1]) || !this->Read(spacing[2]))
+        {
+          this->Failed = true;
+          return nullptr;
+        }
+        id->SetExtent(extent);
+        id->SetOrigin(origin);
+        id->SetSpacing(spacing);
+        if (!this->ReadDataSetAttributes(id))
+        {
+          return nullptr;
+        }
+        result = id;
+      }
+      break;
+
+      case VTK_STRUCTURED_GRID:
+      {
+        vtkNew<vtkStructuredGrid> sg;
+        int extent[6];
+        if (!this->ReadExtent(extent))
+        {
+          return nullptr;
+        }
+        sg->SetExtent(extent);
+        sg->SetPoints(this->ReadPoints());
+        if (this->Failed || !this->ReadDataSetAttributes(sg))
+        {
+          return nullptr;
+        }
+        result = sg.GetPointer();
+      }
+      break;
+
+      case VTK_MULTIBLOCK_DATA_SET:
+      {
+        vtkNew<vtkMultiBlockDataSet> mb;
+        vtkTypeInt32 numBlocks = 0;
+        if (!this->Read(numBlocks) || numBlocks < 0)
+        {
+          this->Failed = true;
+          return nullptr;
+        }
+        mb->SetNumberOfBlocks(static_cast<unsigned int>(numBlocks));
+        for (vtkTypeInt32 cc = 0; cc < numBlocks; ++cc)
+        {
+          std::string name;
+          bool hasName;
+          if (!this->ReadOptionalString(name, hasName))
+          {
+            return nullptr;
+          }
+          vtkSmartPointer<vtkDataObject> block = this->ReadDataObject();
+          if (this->Failed)
+          {
+            return nullptr;
+          }
+          mb->SetBlock(cc, block);
+          if (hasName)
+          {
+            mb->GetMetaData(cc)->Set(vtkCompositeDataSet::NAME(), name.c_str());
+          }
+        }
+        result = mb.GetPointer();
+      }
+      break;
+
+      case VTK_MULTIPIECE_DATA_SET:
+      {
+        vtkNew<vtkMultiPieceDataSet> mp;
+        vtkTypeInt32 numPieces = 0;
+        if (!this->Read(numPieces) || numPieces < 0)
+        {
+          this->Failed = true;
+          return nullptr;
+        }
+        mp->SetNumberOfPieces(static_cast<unsigned int>(numPieces));
+        for (vtkTypeInt32 cc = 0; cc < numPieces; ++cc)
+        {
+          std::string name;
+          bool hasName;
+          if (!this->ReadOptionalString(name, hasName))
+          {
+            return nullptr;
+          }
+          vtkSmartPointer<vtkDataObject> piece = this->ReadDataObject();
+          if (this->Failed)
+          {
+            return nullptr;
+          }
+          mp->SetPiece(cc, piece);
+          if (hasName)
+          {
+            mp->GetMetaData(cc)->Set(vtkCompositeDataSet::NAME(), name.c_str());
+          }
+        }
+        result = mp.GetPointer();
+      }
+      break;
+
+      default:
+        this->Failed = true;
+        return nullptr;
+    }
+
+    if (!this->ReadFieldData(result->GetFieldData()))
+    {
+      return nullptr;
+    }
+    return result;
+  }
+
+private:
+  vtkSmartPointer<vtkDataArray> ReadDataArrayValues(
+    int dataType, int typeSize, int numComps, vtkIdType numTuples)
+  {
+    vtkSmartPointer<vtkDataArray> array;
+    array.TakeReference(vtkDataArray::CreateDataArray(dataType));
+    if (!array)
+    {
+      this->Failed = true;
+      return nullptr;
+    }
+    array->SetNumberOfComponents(numComps);
+    array->SetNumberOfTuples(numTuples);
+    const vtkIdType numValues = array->GetNumberOfValues();
+
+    if (array->GetDataTypeSize() == typeSize)
+    {
+      if (!this->ReadBytes(array->GetVoidPointer(0), numValues * typeSize))
+      {
+        return nullptr;
+      }
+      if (this->Swap && typeSize > 1)
+      {
+        vtkByteSwap::SwapVoidRange(array->GetVoidPointer(0), numValues, typeSize);
+      }
+    }
+    else if (dataType == VTK_ID_TYPE && (typeSize == 4 || typeSize == 8))
+    {
+      // Sender and receiver were built with different vtkIdType sizes.
+      vtkIdType* ids = static_cast<vtkIdType*>(array->GetVoidPointer(0));
+      for (vtkIdType cc = 0; cc < numValues; ++cc)
+      {
+        if (typeSize == 4)
+        {
+          vtkTypeInt32 value;
+          this->Read(value);
+          ids[cc] = static_cast<vtkIdType>(value);
+        }
+        else
+        {
+          vtkTypeInt64 value;
+          this->Read(value);
+          ids[cc] = static_cast<vtkIdType>(value);
+        }
+      }
+      if (this->Failed)
+      {
+        return nullptr;
+      }
+    }
+    else
+    {
+      this->Failed = true;
+      return nullptr;
+    }
+    return array;
+  }
+
+  // vtkCellArray only accepts vtkTypeInt32Array / vtkTypeInt64Array storage,
+  // so we explicitly instantiate those rather than going through
+  // vtkDataArray::CreateDataArray.
+  vtkSmartPointer<vtkDataArray> ReadCellArrayStorage()
+  {
+    vtkSmartPointer<vtkDataArray> values = vtkDataArray::SafeDownCast(this->ReadArray());
+    if (!values || values->GetNumberOfComponents() != 1)
+    {
+      this->Failed = true;
+      return nullptr;
+    }
+
+    vtkSmartPointer<vtkDataArray> storage;
+    if (values->GetDataTypeSize() == 8)
+    {
+      storage = vtkSmartPointer<vtkTypeInt64Array>::New();
+    }
+    else if (values->GetDataTypeSize() == 4)
+    {
+      storage = vtkSmartPointer<vtkTypeInt32Array>::New();
+    }
+    else
+    {
+      this->Failed = true;
+      return nullptr;
+    }
+    if (storage->GetDataType() == values->GetDataType())
+    {
+      // Avoid the copy: both arrays share the reference-counted buffer we
+      // just read.
+      storage->ShallowCopy(values);
+      return storage;
+    }
+    storage->DeepCopy(values);
+    return storage;
+  }
+
+  const char* Pointer;
+  const char* End;
+  bool Swap;
+  bool Failed;
+};
+}
+
+//============================================================================
+void vtkPVDataObjectMarshaller::GatherList::AppendInline(const void* data, size_t length)
+{
+  if (this->Segments.empty() || this->Segments.back().External != nullptr)
+  {
+    this->Segments.emplace_back();
+  }
+  Segment& segment = this->Segments.back();
+  segment.Inline.append(static_cast<const char*>(data), length);
+  segment.Length += static_cast<vtkIdType>(length);
+  this->TotalLength += static_cast<vtkIdType>(length);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataObjectMarshaller::GatherList::AppendExternal(
+  vtkAbstractArray* owner, const void* data, vtkIdType length)
+{
+  Segment segment;
+  segment.External = static_cast<const char*>(data);
+  segment.Length = length;
+  this->Segments.push_back(std::move(segment));
+  this->Arrays.push_back(owner);
+  this->TotalLength += length;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVDataObjectMarshaller::GatherList::GetSegmentPointer(size_t index) const
+{
+  const Segment& segment = this->Segments[index];
+  return segment.External ? segment.External : segment.Inline.c_str();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVDataObjectMarshaller::GatherList::GetSegmentLength(size_t index) const
+{
+  return this->Segments[index].Length;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataObjectMarshaller::GatherList::CopyTo(char* buffer) const
+{
+  for (const auto& segment : this->Segments)
+  {
+    memcpy(buffer, segment.External ? segment.External : segment.Inline.c_str(),
+      static_cast<size_t>(segment.Length));
+    buffer += segment.Length;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataObjectMarshaller::GatherList::Reset()
+{
+  this->Segments.clear();
+  this->Arrays.clear();
+  this->TotalLength = 0;
+}
+
+//============================================================================
+vtkStandardNewMacro(vtkPVDataObjectMarshaller);
+//----------------------------------------------------------------------------
+vtkPVDataObjectMarshaller::vtkPVDataObjectMarshaller()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVDataObjectMarshaller::~vtkPVDataObjectMarshaller()
+{
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataObjectMarshaller::CanMarshal(vtkDataObject* data)
+{
+  if (data == nullptr)
+  {
+    return false;
+  }
+
+  if (!CanMarshalFieldData(data->GetFieldData()))
+  {
+    return false;
+  }
+
+  switch (data->GetDataObjectType())
+  {
+    case VTK_POLY_DATA:
+    case VTK_UNSTRUCTURED_GRID:
+    case VTK_IMAGE_DATA:
+    case VTK_UNIFORM_GRID:
+    case VTK_STRUCTURED_POINTS:
+    case VTK_STRUCTURED_GRID:
+    {
+      vtkDataSet* ds = vtkDataSet::SafeDownCast(data);
+      return CanMarshalFieldData(ds->GetPointData()) && CanMarshalFieldData(ds->GetCellData());
+    }
+
+    case VTK_MULTIBLOCK_DATA_SET:
+    {
+      vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(data);
+      for (unsigned int cc = 0; cc < mb->GetNumberOfBlocks(); ++cc)
+      {
+        vtkDataObject* block = mb->GetBlock(cc);
+        if (block && !vtkPVDataObjectMarshaller::CanMarshal(block))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    case VTK_MULTIPIECE_DATA_SET:
+    {
+      vtkMultiPieceDataSet* mp = vtkMultiPieceDataSet::SafeDownCast(data);
+      for (unsigned int cc = 0; cc < mp->GetNumberOfPieces(); ++cc)
+      {
+        vtkDataObject* piece = mp->GetPieceAsDataObject(cc);
+        if (piece && !vtkPVDataObjectMarshaller::CanMarshal(piece))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataObjectMarshaller::Marshal(vtkDataObject* data, GatherList& list)
+{
+  list.Reset();
+  if (!vtkPVDataObjectMarshaller::CanMarshal(data))
+  {
+    return false;
+  }
+
+  char header[vtkPVDataObjectMarshallerHeaderSize] = { 0 };
+  memcpy(header, vtkPVDataObjectMarshallerMagic, 4);
+  header[4] = static_cast<char>(vtkPVDataObjectMarshallerVersion);
+  header[5] = static_cast<char>(vtkPVDataObjectMarshallerByteOrder());
+  list.AppendInline(header, sizeof(header));
+
+  Writer writer(list);
+  if (!writer.WriteDataObject(data))
+  {
+    list.Reset();
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataObjectMarshaller::IsNativeBuffer(const char* buffer, vtkIdType length)
+{
+  return buffer != nullptr && length >= vtkPVDataObjectMarshallerHeaderSize &&
+    memcmp(buffer, vtkPVDataObjectMarshallerMagic, 4) == 0;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkPVDataObjectMarshaller::Unmarshal(
+  const char* buffer, vtkIdType length)
+{
+  if (!vtkPVDataObjectMarshaller::IsNativeBuffer(buffer, length))
+  {
+    vtkGenericWarningMacro("Buffer was not produced by vtkPVDataObjectMarshaller.");
+    return nullptr;
+  }
+  if (static_cast<unsigned char>(buffer[4]) != vtkPVDataObjectMarshallerVersion)
+  {
+    vtkGenericWarningMacro("Unsupported marshalling version '"
+      << static_cast<int>(static_cast<unsigned char>(buffer[4])) << "'.");
+    return nullptr;
+  }
+
+  const bool swap =
+    static_cast<unsigned char>(buffer[5]) != vtkPVDataObjectMarshallerByteOrder();
+  Reader reader(buffer + vtkPVDataObjectMarshallerHeaderSize,
+    length - vtkPVDataObjectMarshallerHeaderSize, swap);
+  vtkSmartPointer<vtkDataObject> result = reader.ReadDataObject();
+  if (reader.HasFailed())
+  {
+    vtkGenericWarningMacro("Failed to unmarshal data object. Buffer may be corrupt.");
+    return nullptr;
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataObjectMarshaller::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
@@ -0,0 +1,153 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVDataObjectMarshaller.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVDataObjectMarshaller
+ * @brief   native binary marshalling of data objects.
+ *
+ * vtkPVDataObjectMarshaller is a collection of helper routines used to
+ * serialize data objects for transfer between processes without going through
+ * the legacy VTK file format. Instead of writing a dataset into a string and
+ * parsing it back on the receiving end, the marshaller describes a dataset as
+ * a gather list: a sequence of small inline header segments interleaved with
+ * segments that point directly at the memory of the dataset's arrays (points,
+ * cell offsets and connectivity, cell types, attribute arrays). The receiver
+ * allocates the arrays with the right type and size and copies the raw bytes
+ * into them.
+ *
+ * Supported types are vtkPolyData, vtkUnstructuredGrid, vtkImageData,
+ * vtkStructuredGrid and vtkMultiBlockDataSet / vtkMultiPieceDataSet trees of
+ * those. Attribute arrays must be vtkDataArray subclasses (excluding
+ * vtkBitArray) or vtkStringArray. Use CanMarshal() to check if a data object
+ * can be handled; callers are expected to fall back to the legacy writer
+ * otherwise.
+ *
+ * Buffers start with a 4 byte magic tag, "vtkn", followed by format version
+ * and byte-order. Byte swapping is done on the receiver, if needed.
+ *
+ * @sa vtkMPIMoveData
+ */
+
+#ifndef vtkPVDataObjectMarshaller_h
+#define vtkPVDataObjectMarshaller_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+#include "vtkSmartPointer.h"                          // needed for vtkSmartPointer
+
+#include <string> // needed for std::string
+#include <vector> // needed for std::vector
+
+class vtkAbstractArray;
+class vtkDataObject;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkPVDataObjectMarshaller : public vtkObject
+{
+public:
+  static vtkPVDataObjectMarshaller* New();
+  vtkTypeMacro(vtkPVDataObjectMarshaller, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * A scatter/gather list describing a marshalled data object. Segments
+   * either own a small inline block of bytes (headers) or reference the
+   * memory of an array. The list keeps references to all arrays it points to,
+   * so it remains valid even if the data object is modified or released.
+   */
+  class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT GatherList
+  {
+  public:
+    /**
+     * Appends bytes to the trailing inline segment, adding one if needed.
+     */
+    void AppendInline(const void* data, size_t length);
+
+    /**
+     * Appends a segment referencing `length` bytes at `data`, owned by
+     * `owner`.
+     */
+    void AppendExternal(vtkAbstractArray* owner, const void* data, vtkIdType length);
+
+    /**
+     * Returns the total number of bytes described by the list.
+     */
+    vtkIdType GetTotalLength() const { return this->TotalLength; }
+
+    //@{
+    /**
+     * Access individual segments.
+     */
+    size_t GetNumberOfSegments() const { return this->Segments.size(); }
+    const char* GetSegmentPointer(size_t index) const;
+    vtkIdType GetSegmentLength(size_t index) const;
+    //@}
+
+    /**
+     * Copies all segments, in order, to `buffer` which must be at least
+     * GetTotalLength() bytes long.
+     */
+    void CopyTo(char* buffer) const;
+
+    /**
+     * Clears the list, releasing all array references.
+     */
+    void Reset();
+
+  private:
+    struct Segment
+    {
+      std::string Inline;
+      const char* External = nullptr;
+      vtkIdType Length = 0;
+    };
+    std::vector<Segment> Segments;
+    std::vector<vtkSmartPointer<vtkAbstractArray> > Arrays;
+    vtkIdType TotalLength = 0;
+  };
+
+  /**
+   * Returns true if `data` (and all its leaves, for composite datasets) can be
+   * marshalled natively.
+   */
+  static bool CanMarshal(vtkDataObject* data);
+
+  /**
+   * Marshals `data` into `list`. Returns false if the data object is not
+   * supported, in which case `list` is left empty.
+   */
+  static bool Marshal(vtkDataObject* data, GatherList& list);
+
+  /**
+   * Returns true if `buffer` starts with the native marshalling header.
+   */
+  static bool IsNativeBuffer(const char* buffer, vtkIdType length);
+
+  /**
+   * Reconstructs a data object from a buffer produced by Marshal(). Returns
+   * nullptr if the buffer is corrupt or was produced by an incompatible
+   * version.
+   */
+  static vtkSmartPointer<vtkDataObject> Unmarshal(const char* buffer, vtkIdType length);
+
+protected:
+  vtkPVDataObjectMarshaller();
+  ~vtkPVDataObjectMarshaller() override;
+
+private:
+  vtkPVDataObjectMarshaller(const vtkPVDataObjectMarshaller&) = delete;
+  void operator=(const vtkPVDataObjectMarshaller&) = delete;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkPVDataObjectMarshaller.h
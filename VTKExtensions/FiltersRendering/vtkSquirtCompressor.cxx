@@ -20,216 +20,144 @@
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkUnsignedCharArray.h"
+
 #include <algorithm>
+#include <cstring>
 #include <sstream>
 
-vtkStandardNewMacro(vtkSquirtCompressor);
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
+namespace
+{
 //-----------------------------------------------------------------------------
-vtkSquirtCompressor::vtkSquirtCompressor()
-  : SquirtLevel(3)
+// Returns the number of pixels following `index` (at most 15) that have the
+// same masked color as `color`.
+inline int ComputeRunRGBA(const unsigned int* pixels, vtkIdType index, vtkIdType end,
+  unsigned int color, unsigned int mask)
 {
+  const unsigned int maskedColor = color & mask;
+  vtkIdType run = 0;
+#if defined(__SSE2__)
+  // Compare 4 pixels at a time, the scalar loop below finishes the run.
+  const __m128i vmask = _mm_set1_epi32(static_cast<int>(mask));
+  const __m128i vcolor = _mm_set1_epi32(static_cast<int>(maskedColor));
+  while (run < 0x0F && index + run + 4 <= end)
+  {
+    const __m128i values =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + index + run));
+    const int matches =
+      _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(values, vmask), vcolor)));
+    if (matches != 0x0F)
+    {
+      for (int cc = 0; (matches >> cc) & 0x1; ++cc)
+      {
+        ++run;
+      }
+      return static_cast<int>(std::min<vtkIdType>(run, 0x0F));
+    }
+    run += 4;
+  }
+  run = std::min<vtkIdType>(run, 0x0F);
+#endif
+  while (run < 0x0F && index + run < end && (pixels[index + run] & mask) == maskedColor)
+  {
+    ++run;
+  }
+  return static_cast<int>(run);
 }
 
 //-----------------------------------------------------------------------------
-vtkSquirtCompressor::~vtkSquirtCompressor()
+inline unsigned int ReadRGB(const unsigned char* rgb)
 {
+  unsigned int color = 0;
+  unsigned char* p = reinterpret_cast<unsigned char*>(&color);
+  p[0] = rgb[0];
+  p[1] = rgb[1];
+  p[2] = rgb[2];
+  return color;
 }
 
 //-----------------------------------------------------------------------------
-int vtkSquirtCompressor::Compress()
+vtkIdType CompressRGBA(
+  const unsigned int* _rawColorBuffer, vtkIdType numPixels, unsigned int compress_mask,
+  unsigned int* _rawCompressedBuffer)
 {
-  if (!(this->Input && this->Output))
-  {
-    vtkWarningMacro("Cannot compress empty input or output detected.");
-    return VTK_ERROR;
-  }
+  vtkIdType index = 0;
+  vtkIdType comp_index = 0;
 
-  vtkUnsignedCharArray* input = this->GetInput();
-
-  if (input->GetNumberOfComponents() != 4 && input->GetNumberOfComponents() != 3)
-  {
-    vtkErrorMacro("Squirt only works with RGBA or RGB");
-    return VTK_ERROR;
-  }
-
-  int count = 0;
-  int index = 0;
-  int comp_index = 0;
-  int end_index;
-  int compress_level = this->LossLessMode ? 0 : this->SquirtLevel;
-  unsigned int current_color;
-  unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
-    { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
-    { 0xE0, 0xF0, 0xE0, 0xE0 } };
-
-  if (compress_level < 0 || compress_level > 5)
+  // Go through color buffer and put RLE format into compressed buffer
+  while (index < numPixels)
   {
-    vtkErrorMacro("Squirt compression level (" << compress_level << ") is out of range [0,5].");
-    compress_level = 1;
-  }
-
-  // Set bitmask based on compress_level
-  unsigned int compress_mask;
-  // I shifted the level by one so that 0 means no compression.
-  memcpy(&compress_mask, &compress_masks[compress_level], 4);
-
-  // Access raw arrays directly
-  if (input->GetNumberOfComponents() == 4)
-  {
-    unsigned int* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned int*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < end_index) && (comp_index < end_index))
+    // Record color
+    unsigned int current_color = _rawCompressedBuffer[comp_index] = _rawColorBuffer[index];
+    unsigned char opacity = *(((unsigned char*)&current_color) + 3);
+    index++;
+
+    // Compute Run
+    int count = ComputeRunRGBA(_rawColorBuffer, index, numPixels, current_color, compress_mask);
+    index += count;
+    if (opacity > 0)
     {
-
-      // Record color
-      current_color = _rawCompressedBuffer[comp_index] = _rawColorBuffer[index];
-      unsigned char opacity = *(((unsigned char*)&current_color) + 3);
-      index++;
-
-      // Compute Run
-      while ((index < end_index) && (count < 0x0F) &&
-        ((current_color & compress_mask) == (_rawColorBuffer[index] & compress_mask)))
-      {
-        index++;
-        count++;
-      }
-      if (opacity > 0)
-      {
-        opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
-        opacity = opacity << 4;
-        count |= opacity;
-      }
-
-      // Record Run length
-      *((unsigned char*)_rawCompressedBuffer + comp_index * 4 + 3) = (unsigned char)count;
-      comp_index++;
-
-      count = 0;
+      opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
+      opacity = opacity << 4;
+      count |= opacity;
     }
-  }
-  else if (input->GetNumberOfComponents() == 3)
-  {
-    unsigned char* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned char*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < 3 * numPixels) && (comp_index < end_index))
-    {
-
-      int next_color = 0;
-      // Record color
-      unsigned char* p = (unsigned char*)&current_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      _rawCompressedBuffer[comp_index] = current_color;
-      index += 3;
-
-      p = (unsigned char*)&next_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      // Compute Run
-      while (((current_color & compress_mask) == (next_color & compress_mask)) &&
-        (index < 3 * numPixels) && (count < 255))
-      {
-        index += 3;
-        count++;
-        if (index < 3 * numPixels)
-        {
-          p = (unsigned char*)&next_color;
-          *p++ = _rawColorBuffer[index];
-          *p++ = _rawColorBuffer[index + 1];
-          *p++ = _rawColorBuffer[index + 2];
-          *p = 0x0;
-        }
-      }
-
-      // Record Run length
-      reinterpret_cast<unsigned char*>(_rawCompressedBuffer)[comp_index * 4 + 3] =
-        static_cast<unsigned char>(count);
-      comp_index++;
 
-      count = 0;
-    }
+    // Record Run length
+    *((unsigned char*)_rawCompressedBuffer + comp_index * 4 + 3) = (unsigned char)count;
+    comp_index++;
   }
-
-  // Back to vtk arrays :)
-  this->Output->SetNumberOfComponents(1);
-  this->Output->SetNumberOfTuples(4 * comp_index);
-
-  return VTK_OK;
+  return 4 * comp_index;
 }
 
 //-----------------------------------------------------------------------------
-int vtkSquirtCompressor::Decompress()
+vtkIdType CompressRGB(const unsigned char* _rawColorBuffer, vtkIdType numPixels,
+  unsigned int compress_mask, unsigned int* _rawCompressedBuffer)
 {
-  if (!(this->Input && this->Output))
-  {
-    vtkWarningMacro("Cannot decompress empty input or output detected.");
-    return VTK_ERROR;
-  }
-
-  vtkUnsignedCharArray* out = this->GetOutput();
+  vtkIdType index = 0;
+  vtkIdType comp_index = 0;
 
-  // We assume that 'out' has exactly the same number of component set as the
-  // input before compression.
-  switch (out->GetNumberOfComponents())
+  // Go through color buffer and put RLE format into compressed buffer
+  while (index < numPixels)
   {
-    case 3:
-      return this->DecompressRGB();
-    case 4:
-      return this->DecompressRGBA();
-
-    default:
-      vtkErrorMacro("SQUIRT only support 3 or 4 component arrays.");
-      return VTK_ERROR;
+    // Record color
+    const unsigned int current_color = ReadRGB(_rawColorBuffer + 3 * index);
+    _rawCompressedBuffer[comp_index] = current_color;
+    index++;
+
+    // Compute Run
+    int count = 0;
+    while (index < numPixels && count < 255 &&
+      (current_color & compress_mask) == (ReadRGB(_rawColorBuffer + 3 * index) & compress_mask))
+    {
+      index++;
+      count++;
+    }
+
+    // Record Run length
+    reinterpret_cast<unsigned char*>(_rawCompressedBuffer)[comp_index * 4 + 3] =
+      static_cast<unsigned char>(count);
+    comp_index++;
   }
+  return 4 * comp_index;
 }
 
 //-----------------------------------------------------------------------------
-int vtkSquirtCompressor::DecompressRGBA()
+bool DecompressRGBA(const unsigned int* _rawCompressedBuffer, vtkIdType compSize,
+  unsigned int* _rawColorBuffer, vtkIdType numPixels)
 {
-  vtkUnsignedCharArray* in = this->GetInput();
-  vtkUnsignedCharArray* out = this->GetOutput();
-  assert(out->GetNumberOfComponents() == 4);
-
-  int count = 0;
-  int index = 0;
-  unsigned int current_color;
-  unsigned int* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
-
-  // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
-
-  // Access raw arrays directly
-  _rawColorBuffer = (unsigned int*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
+  vtkIdType index = 0;
 
   // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
+  for (vtkIdType i = 0; i < compSize; i++)
   {
     // Get color and count
-    current_color = _rawCompressedBuffer[i];
+    unsigned int current_color = _rawCompressedBuffer[i];
 
     // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
+    int count = *((unsigned char*)&current_color + 3);
 
     if (count > 0x0f)
     {
@@ -245,60 +173,147 @@ int vtkSquirtCompressor::DecompressRGBA()
     }
     count &= 0x0F;
 
-    // Set color
-    _rawColorBuffer[index++] = current_color;
+    if (index + count + 1 > numPixels)
+    {
+      return false;
+    }
 
     // Blast color into color buffer
-    for (int j = 0; j < count; j++)
+    std::fill(_rawColorBuffer + index, _rawColorBuffer + index + count + 1, current_color);
+    index += count + 1;
+  }
+  return index == numPixels;
+}
+
+//-----------------------------------------------------------------------------
+bool DecompressRGB(const unsigned int* _rawCompressedBuffer, vtkIdType compSize,
+  unsigned char* _rawColorBuffer, vtkIdType numPixels)
+{
+  vtkIdType index = 0;
+
+  // Go through compress buffer and extract RLE format into color buffer
+  for (vtkIdType i = 0; i < compSize; i++)
+  {
+    // Get color and count
+    const unsigned int current_color = _rawCompressedBuffer[i];
+
+    // Get run length count;
+    const int count = *((const unsigned char*)&current_color + 3);
+    if (index + count + 1 > numPixels)
+    {
+      return false;
+    }
+
+    const unsigned char* current_color_rgb = reinterpret_cast<const unsigned char*>(&current_color);
+    for (int j = 0; j <= count; j++)
     {
-      _rawColorBuffer[index++] = current_color;
+      std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer + 3 * index);
+      index++;
     }
   }
-  return VTK_OK;
+  return index == numPixels;
 }
+}
+
+vtkStandardNewMacro(vtkSquirtCompressor);
 
 //-----------------------------------------------------------------------------
-int vtkSquirtCompressor::DecompressRGB()
+vtkSquirtCompressor::vtkSquirtCompressor()
+  : SquirtLevel(3)
+  , CompressMask(0xFFFFFFFF)
 {
-  vtkUnsignedCharArray* in = this->GetInput();
-  vtkUnsignedCharArray* out = this->GetOutput();
-  assert(out->GetNumberOfComponents() == 3);
+}
 
-  int count = 0;
-  unsigned int current_color;
-  unsigned char* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
+//-----------------------------------------------------------------------------
+vtkSquirtCompressor::~vtkSquirtCompressor()
+{
+}
 
-  // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
+//-----------------------------------------------------------------------------
+int vtkSquirtCompressor::Compress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress empty input or output detected.");
+    return VTK_ERROR;
+  }
 
-  // Access raw arrays directly
-  _rawColorBuffer = (unsigned char*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
+  vtkUnsignedCharArray* input = this->GetInput();
 
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
+  if (input->GetNumberOfComponents() != 4 && input->GetNumberOfComponents() != 3)
   {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
+    vtkErrorMacro("Squirt only works with RGBA or RGB");
+    return VTK_ERROR;
+  }
 
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
+  int compress_level = this->LossLessMode ? 0 : this->SquirtLevel;
+  unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
+    { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
+    { 0xE0, 0xF0, 0xE0, 0xE0 } };
 
-    *((unsigned char*)&current_color + 3) = 0xff;
+  if (compress_level < 0 || compress_level > 5)
+  {
+    vtkErrorMacro("Squirt compression level (" << compress_level << ") is out of range [0,5].");
+    compress_level = 1;
+  }
 
-    unsigned char current_color_rgb[3];
-    std::copy(reinterpret_cast<const unsigned char*>(&current_color),
-      reinterpret_cast<const unsigned char*>(&current_color) + 3, current_color_rgb);
-    std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-    _rawColorBuffer += 3;
-    for (int j = 0; j < count; j++)
-    {
-      std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-      _rawColorBuffer += 3;
-    }
+  // Set bitmask based on compress_level
+  // I shifted the level by one so that 0 means no compression.
+  memcpy(&this->CompressMask, &compress_masks[compress_level], 4);
+
+  // Tiles are run-length encoded independently.
+  return this->CompressTiles();
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkSquirtCompressor::GetMaximumCompressedTileSize(vtkIdType numberOfPixels, int)
+{
+  // one 4-byte run per pixel in the worst case, for RGB as well.
+  return 4 * numberOfPixels;
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkSquirtCompressor::CompressTile(const unsigned char* input, vtkIdType numberOfPixels,
+  int numberOfComponents, unsigned char* output)
+{
+  unsigned int* compressed = reinterpret_cast<unsigned int*>(output);
+  return numberOfComponents == 4
+    ? CompressRGBA(reinterpret_cast<const unsigned int*>(input), numberOfPixels,
+        this->CompressMask, compressed)
+    : CompressRGB(input, numberOfPixels, this->CompressMask, compressed);
+}
+
+//-----------------------------------------------------------------------------
+int vtkSquirtCompressor::Decompress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress empty input or output detected.");
+    return VTK_ERROR;
   }
-  return VTK_OK;
+
+  // We assume that 'out' has exactly the same number of component set as the
+  // input before compression.
+  const int numComps = this->GetOutput()->GetNumberOfComponents();
+  if (numComps != 3 && numComps != 4)
+  {
+    vtkErrorMacro("SQUIRT only support 3 or 4 component arrays.");
+    return VTK_ERROR;
+  }
+  return this->DecompressTiles();
+}
+
+//-----------------------------------------------------------------------------
+bool vtkSquirtCompressor::DecompressTile(const unsigned char* input, vtkIdType inputSize,
+  unsigned char* output, vtkIdType numberOfPixels, int numberOfComponents)
+{
+  // Runs are 4 bytes and so is the tiled stream header, hence tiles are
+  // 4-byte aligned.
+  const unsigned int* runs = reinterpret_cast<const unsigned int*>(input);
+  const vtkIdType compSize = inputSize / 4; /// NOTE 1->4
+  return numberOfComponents == 4
+    ? DecompressRGBA(runs, compSize, reinterpret_cast<unsigned int*>(output), numberOfPixels)
+    : DecompressRGB(runs, compSize, output, numberOfPixels);
 }
 
 //-----------------------------------------------------------------------------
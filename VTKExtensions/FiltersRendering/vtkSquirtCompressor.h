@@ -44,6 +44,10 @@
  * The compressor uses a modified SQUIRT implementation where encode 4-bit
  * opacity information as well. This is needed to improve background color
  * blending for translucent renderings in ParaView.
+ *
+ * The image is split in tiles which are encoded and decoded concurrently (see
+ * vtkImageCompressor::SetNumberOfTiles). Runs of RGBA pixels are detected
+ * using SSE2 when available.
  * @par Thanks:
  * Thanks to Sandia National Laboratories for this compression technique
 */
@@ -96,11 +100,18 @@ public:
 protected:
   vtkSquirtCompressor();
   ~vtkSquirtCompressor() override;
-  int DecompressRGB();
-  int DecompressRGBA();
+
+  vtkIdType GetMaximumCompressedTileSize(vtkIdType numberOfPixels, int numberOfComponents) override;
+  vtkIdType CompressTile(const unsigned char* input, vtkIdType numberOfPixels,
+    int numberOfComponents, unsigned char* output) override;
+  bool DecompressTile(const unsigned char* input, vtkIdType inputSize, unsigned char* output,
+    vtkIdType numberOfPixels, int numberOfComponents) override;
 
   int SquirtLevel;
 
+  // Color mask used to detect runs, set by Compress().
+  unsigned int CompressMask;
+
 private:
   vtkSquirtCompressor(const vtkSquirtCompressor&) = delete;
   void operator=(const vtkSquirtCompressor&) = delete;
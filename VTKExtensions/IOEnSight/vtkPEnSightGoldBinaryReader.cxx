@@ -12,20 +12,275 @@
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkStructuredGrid.h"
+#include "vtkType.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#include <algorithm>
 #include <ctype.h>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <streambuf>
 #include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
 
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
+namespace
+{
+bool vtkPEnSightUseMemoryMappedFiles = true;
+
+//----------------------------------------------------------------------------
+// Byte-swaps `count` 4-byte words from `source` into `dest` (which may be the
+// same). Written as a flat loop over 32-bit integers, without aliasing or
+// alignment assumptions, so that compilers turn it into vector shuffles.
+void vtkPEnSightSwap4Range(const void* source, void* dest, size_t count)
+{
+  const unsigned char* src = static_cast<const unsigned char*>(source);
+  unsigned char* dst = static_cast<unsigned char*>(dest);
+  for (size_t i = 0; i < count; ++i)
+  {
+    vtkTypeUInt32 word;
+    memcpy(&word, src + 4 * i, 4);
+    word = ((word & 0x000000ffu) << 24) | ((word & 0x0000ff00u) << 8) |
+      ((word & 0x00ff0000u) >> 8) | ((word & 0xff000000u) >> 24);
+    memcpy(dst + 4 * i, &word, 4);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Returns true if 4-byte words read from a file must be swapped. Files with
+// an unknown byte order are handled as big endian, as in the rest of the
+// reader.
+bool vtkPEnSightNeedsSwap(bool littleEndianFile)
+{
+#ifdef VTK_WORDS_BIGENDIAN
+  return littleEndianFile;
+#else
+  return !littleEndianFile;
+#endif
+}
+
+//----------------------------------------------------------------------------
+// Copies `count` 4-byte words from the file image at `source` to `dest`,
+// converting them to the host byte order.
+void vtkPEnSightCopy4Range(const void* source, void* dest, size_t count, bool littleEndianFile)
+{
+  if (vtkPEnSightNeedsSwap(littleEndianFile))
+  {
+    vtkPEnSightSwap4Range(source, dest, count);
+  }
+  else if (source != dest)
+  {
+    memcpy(dest, source, 4 * count);
+  }
+}
+
+//----------------------------------------------------------------------------
+// A read-only memory mapping of a whole file. Mappings are shared between
+// all readers of the process through vtkPEnSightMappedFile::Open(); since
+// they are backed by the page cache, ranks running on the same node share
+// the physical pages as well.
+class vtkPEnSightMappedFile
+{
+public:
+  ~vtkPEnSightMappedFile()
+  {
+#ifndef _WIN32
+    munmap(const_cast<char*>(this->Data), this->Size);
+#endif
+  }
+
+  const char* GetData() const { return this->Data; }
+  size_t GetSize() const { return this->Size; }
+
+  // Returns a mapping of `filename`, or nullptr if the file cannot be mapped
+  // in which case callers should fall back to regular stream I/O.
+  static std::shared_ptr<vtkPEnSightMappedFile> Open(const char* filename)
+  {
+#ifdef _WIN32
+    (void)filename;
+    return nullptr;
+#else
+    struct stat st;
+    if (stat(filename, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+    {
+      return nullptr;
+    }
+
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<vtkPEnSightMappedFile> > mappings;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Reuse an existing mapping, unless the file changed since.
+    auto iter = mappings.find(filename);
+    if (iter != mappings.end())
+    {
+      std::shared_ptr<vtkPEnSightMappedFile> existing = iter->second.lock();
+      if (existing && existing->Size == static_cast<size_t>(st.st_size) &&
+        existing->ModifiedTime == st.st_mtime)
+      {
+        return existing;
+      }
+      mappings.erase(iter);
+    }
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+      return nullptr;
+    }
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+      return nullptr;
+    }
+
+    std::shared_ptr<vtkPEnSightMappedFile> mapping(new vtkPEnSightMappedFile());
+    mapping->Data = static_cast<const char*>(data);
+    mapping->Size = static_cast<size_t>(st.st_size);
+    mapping->ModifiedTime = st.st_mtime;
+    mappings[filename] = mapping;
+
+    // Drop expired entries so that the registry does not grow with the number
+    // of files (typically one per time step and variable) ever opened.
+    for (auto it = mappings.begin(); it != mappings.end();)
+    {
+      it = it->second.expired() ? mappings.erase(it) : std::next(it);
+    }
+    return mapping;
+#endif
+  }
+
+private:
+  vtkPEnSightMappedFile() = default;
+  vtkPEnSightMappedFile(const vtkPEnSightMappedFile&) = delete;
+  void operator=(const vtkPEnSightMappedFile&) = delete;
+
+  const char* Data = nullptr;
+  size_t Size = 0;
+  time_t ModifiedTime = 0;
+};
+
+//----------------------------------------------------------------------------
+// A seekable stream buffer over a mapped file. Seeks only move the get
+// pointer and reads are plain memory copies, which avoids the system calls
+// and buffer refills of std::ifstream on the many small, skipping reads the
+// EnSight format requires.
+class vtkPEnSightMappedBuffer : public std::streambuf
+{
+public:
+  explicit vtkPEnSightMappedBuffer(std::shared_ptr<vtkPEnSightMappedFile> file)
+    : File(std::move(file))
+  {
+    char* begin = const_cast<char*>(this->File->GetData());
+    this->setg(begin, begin, begin + this->File->GetSize());
+  }
+
+  const vtkPEnSightMappedFile* GetFile() const { return this->File.get(); }
+
+protected:
+  pos_type seekoff(off_type offset, std::ios_base::seekdir dir,
+    std::ios_base::openmode which = std::ios_base::in) override
+  {
+    if (!(which & std::ios_base::in))
+    {
+      return pos_type(off_type(-1));
+    }
+    off_type base = 0;
+    if (dir == std::ios_base::cur)
+    {
+      base = this->gptr() - this->eback();
+    }
+    else if (dir == std::ios_base::end)
+    {
+      base = this->egptr() - this->eback();
+    }
+    off_type position = base + offset;
+    if (position < 0 || position > this->egptr() - this->eback())
+    {
+      return pos_type(off_type(-1));
+    }
+    this->setg(this->eback(), this->eback() + position, this->egptr());
+    return pos_type(position);
+  }
+
+  pos_type seekpos(
+    pos_type position, std::ios_base::openmode which = std::ios_base::in) override
+  {
+    return this->seekoff(off_type(position), std::ios_base::beg, which);
+  }
+
+  std::streamsize showmanyc() override { return this->egptr() - this->gptr(); }
+
+private:
+  std::shared_ptr<vtkPEnSightMappedFile> File;
+};
+
+//----------------------------------------------------------------------------
+class vtkPEnSightMappedStream : public std::istream
+{
+public:
+  explicit vtkPEnSightMappedStream(std::shared_ptr<vtkPEnSightMappedFile> file)
+    : std::istream(nullptr)
+    , Buffer(std::move(file))
+  {
+    this->rdbuf(&this->Buffer);
+  }
+
+  const vtkPEnSightMappedFile* GetFile() const { return this->Buffer.GetFile(); }
+
+private:
+  vtkPEnSightMappedBuffer Buffer;
+};
+
+//----------------------------------------------------------------------------
+// Returns the mapped image of the file `stream` reads from, or nullptr if
+// the stream is not memory mapped.
+const vtkPEnSightMappedFile* vtkPEnSightGetMappedFile(istream* stream)
+{
+  vtkPEnSightMappedStream* mapped = dynamic_cast<vtkPEnSightMappedStream*>(stream);
+  return mapped ? mapped->GetFile() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+// Returns the mapped image of the next `length` bytes `stream` would read, or
+// nullptr if the stream is not memory mapped or ends before.
+const char* vtkPEnSightGetMappedBlock(istream* stream, vtkIdType length)
+{
+  const vtkPEnSightMappedFile* mapping = vtkPEnSightGetMappedFile(stream);
+  if (!mapping)
+  {
+    return nullptr;
+  }
+  const vtkIdType position = static_cast<vtkIdType>(stream->tellg());
+  if (position < 0 || length < 0 ||
+    position + length > static_cast<vtkIdType>(mapping->GetSize()))
+  {
+    return nullptr;
+  }
+  return mapping->GetData() + position;
+}
+}
+
 //----------------------------------------------------------------------------
 vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
 {
@@ -56,6 +311,18 @@ vtkPEnSightGoldBinaryReader::~vtkPEnSightGoldBinaryReader()
   free(this->FloatBuffer);
 }
 
+//----------------------------------------------------------------------------
+void vtkPEnSightGoldBinaryReader::SetUseMemoryMappedFiles(bool use)
+{
+  vtkPEnSightUseMemoryMappedFiles = use;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPEnSightGoldBinaryReader::GetUseMemoryMappedFiles()
+{
+  return vtkPEnSightUseMemoryMappedFiles;
+}
+
 //----------------------------------------------------------------------------
 int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
 {
@@ -77,11 +344,23 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = (long)(fs.st_size);
 
+    std::shared_ptr<vtkPEnSightMappedFile> mapping;
+    if (vtkPEnSightUseMemoryMappedFiles)
+    {
+      mapping = vtkPEnSightMappedFile::Open(filename);
+    }
+    if (mapping)
+    {
+      this->IFile = new vtkPEnSightMappedStream(mapping);
+    }
+    else
+    {
 #ifdef _WIN32
-    this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
+      this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
 #else
-    this->IFile = new vtksys::ifstream(filename, ios::in);
+      this->IFile = new vtksys::ifstream(filename, ios::in);
 #endif
+    }
   }
   else
   {
@@ -666,7 +945,6 @@ int vtkPEnSightGoldBinaryReader::SkipUnstructuredGrid(char line[256])
     else if (strncmp(line, "nsided", 6) == 0 || strncmp(line, "g_nsided", 8) == 0)
     {
       vtkDebugMacro("nsided");
-      int* numNodesPerElement;
       int numNodes = 0;
 
       // cellType = vtkPEnSightReader::NSIDED;
@@ -683,15 +961,9 @@ int vtkPEnSightGoldBinaryReader::SkipUnstructuredGrid(char line[256])
         this->IFile->seekg(sizeof(int) * numElements, ios::cur);
       }
 
-      numNodesPerElement = new int[numElements];
-      this->ReadIntArray(numNodesPerElement, numElements);
-      for (i = 0; i < numElements; i++)
-      {
-        numNodes += numNodesPerElement[i];
-      }
+      this->SumIntArray(numElements, &numNodes);
       // Skip nodeIdList.
       this->IFile->seekg(sizeof(int) * numNodes, ios::cur);
-      delete[] numNodesPerElement;
     }
     else if (strncmp(line, "tria3", 5) == 0 || strncmp(line, "tria6", 5) == 0 ||
       strncmp(line, "g_tria3", 7) == 0 || strncmp(line, "g_tria6", 7) == 0)
@@ -772,8 +1044,6 @@ int vtkPEnSightGoldBinaryReader::SkipUnstructuredGrid(char line[256])
     else if (strncmp(line, "nfaced", 6) == 0)
     {
       vtkDebugMacro("nfaced");
-      int* numFacesPerElement;
-      int* numNodesPerFace;
       int numFaces = 0;
       int numNodes = 0;
 
@@ -790,22 +1060,10 @@ int vtkPEnSightGoldBinaryReader::SkipUnstructuredGrid(char line[256])
         this->IFile->seekg(sizeof(int) * numElements, ios::cur);
       }
 
-      numFacesPerElement = new int[numElements];
-      this->ReadIntArray(numFacesPerElement, numElements);
-      for (i = 0; i < numElements; i++)
-      {
-        numFaces += numFacesPerElement[i];
-      }
-      delete[] numFacesPerElement;
-      numNodesPerFace = new int[numFaces];
-      this->ReadIntArray(numNodesPerFace, numFaces);
-      for (i = 0; i < numFaces; i++)
-      {
-        numNodes += numNodesPerFace[i];
-      }
+      this->SumIntArray(numElements, &numFaces);
+      this->SumIntArray(numFaces, &numNodes);
       // Skip nodeIdList.
       this->IFile->seekg(sizeof(int) * numNodes, ios::cur);
-      delete[] numNodesPerFace;
     }
     else if (strncmp(line, "tetra4", 6) == 0 || strncmp(line, "tetra10", 7) == 0 ||
       strncmp(line, "g_tetra4", 8) == 0 || strncmp(line, "g_tetra10", 9) == 0)
@@ -2879,7 +3137,6 @@ int vtkPEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
     {
       // skipping ghost cells
       vtkDebugMacro("g_nsided");
-      int* numNodesPerElement;
       int numNodes = 0;
 
       // cellType = vtkPEnSightReader::NSIDED;
@@ -2896,15 +3153,9 @@ int vtkPEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
         this->IFile->seekg(sizeof(int) * numElements, ios::cur);
       }
 
-      numNodesPerElement = new int[numElements];
-      this->ReadIntArray(numNodesPerElement, numElements);
-      for (i = 0; i < numElements; i++)
-      {
-        numNodes += numNodesPerElement[i];
-      }
+      this->SumIntArray(numElements, &numNodes);
       // Skip nodeIdList.
       this->IFile->seekg(sizeof(int) * numNodes, ios::cur);
-      delete[] numNodesPerElement;
     }
     else if (strncmp(line, "tria3", 5) == 0 || strncmp(line, "tria6", 5) == 0)
     {
@@ -4196,19 +4447,21 @@ int vtkPEnSightGoldBinaryReader::ReadIntArray(int* result, int numInts)
     }
   }
 
-  if (!this->IFile->read((char*)result, sizeof(int) * numInts).good())
+  // With a mapped file, decode the whole block straight from the file image.
+  const vtkIdType length = sizeof(int) * static_cast<vtkIdType>(numInts);
+  if (const char* block = vtkPEnSightGetMappedBlock(this->IFile, length))
   {
-    vtkErrorMacro("Read failed.");
-    return 0;
+    vtkPEnSightCopy4Range(block, result, numInts, this->ByteOrder == FILE_LITTLE_ENDIAN);
+    this->IFile->seekg(length, ios::cur);
   }
-
-  if (this->ByteOrder == FILE_LITTLE_ENDIAN)
+  else if (this->IFile->read((char*)result, length).good())
   {
-    vtkByteSwap::Swap4LERange(result, numInts);
+    vtkPEnSightCopy4Range(result, result, numInts, this->ByteOrder == FILE_LITTLE_ENDIAN);
   }
   else
   {
-    vtkByteSwap::Swap4BERange(result, numInts);
+    vtkErrorMacro("Read failed.");
+    return 0;
   }
 
   if (this->Fortran)
@@ -4223,6 +4476,43 @@ int vtkPEnSightGoldBinaryReader::ReadIntArray(int* result, int numInts)
   return 1;
 }
 
+// Internal function to read an integer array and add its values to `sum`,
+// without keeping the values. Returns zero if there was an error.
+int vtkPEnSightGoldBinaryReader::SumIntArray(int numInts, int* sum)
+{
+  if (numInts <= 0)
+  {
+    return 1;
+  }
+
+  const vtkIdType fortranMarker = this->Fortran ? 4 : 0;
+  const vtkIdType length = sizeof(int) * static_cast<vtkIdType>(numInts);
+  const char* block = vtkPEnSightGetMappedBlock(this->IFile, length + 2 * fortranMarker);
+  if (!block)
+  {
+    std::vector<int> values(numInts);
+    if (!this->ReadIntArray(values.data(), numInts))
+    {
+      return 0;
+    }
+    *sum = std::accumulate(values.begin(), values.end(), *sum);
+    return 1;
+  }
+
+  // With a mapped file, sum the values straight from the file image.
+  const bool littleEndian = this->ByteOrder == FILE_LITTLE_ENDIAN;
+  block += fortranMarker;
+  int values[1024];
+  for (int first = 0; first < numInts; first += 1024)
+  {
+    const int count = std::min(1024, numInts - first);
+    vtkPEnSightCopy4Range(block + sizeof(int) * first, values, count, littleEndian);
+    *sum = std::accumulate(values, values + count, *sum);
+  }
+  this->IFile->seekg(length + 2 * fortranMarker, ios::cur);
+  return 1;
+}
+
 // Internal function to read a float array.
 // Returns zero if there was an error.
 int vtkPEnSightGoldBinaryReader::ReadFloatArray(float* result, int numFloats)
@@ -4248,14 +4538,7 @@ int vtkPEnSightGoldBinaryReader::ReadFloatArray(float* result, int numFloats)
     return 0;
   }
 
-  if (this->ByteOrder == FILE_LITTLE_ENDIAN)
-  {
-    vtkByteSwap::Swap4LERange(result, numFloats);
-  }
-  else
-  {
-    vtkByteSwap::Swap4BERange(result, numFloats);
-  }
+  vtkPEnSightCopy4Range(result, result, numFloats, this->ByteOrder == FILE_LITTLE_ENDIAN);
 
   if (this->Fortran)
   {
@@ -4299,9 +4582,8 @@ int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
   long currentPositionInFile = this->IFile->tellg();
 
   this->FloatBufferFilePosition = currentPositionInFile;
-  this->FloatBufferIndexBegin = 0;
+  this->FloatBufferIndexBegin = -1;
   this->FloatBufferNumberOfVectors = numPts;
-  this->UpdateFloatBuffer();
 
   // Position to reach at the end of this method
   long endFilePosition = currentPositionInFile + 3 * numPts * (long)sizeof(float);
@@ -4339,6 +4621,9 @@ int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
       int localNumberOfIds = this->GetPointIds(partId)->GetLocalNumberOfIds();
       points->Allocate(localNumberOfIds);
       points->SetNumberOfPoints(localNumberOfIds);
+      // Write straight into the coordinates array when possible.
+      vtkFloatArray* coordinates = vtkFloatArray::SafeDownCast(points->GetData());
+      float* coordinatesPtr = coordinates ? coordinates->GetPointer(0) : nullptr;
       int maxId = -1;
       int minId = -1;
       for (i = 0; i < numPts; i++)
@@ -4352,7 +4637,14 @@ int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
           if ((maxId == -1) || (maxId < id))
             maxId = id;
           this->GetVectorFromFloatBuffer(i, vec);
-          points->SetPoint(id, vec[0], vec[1], vec[2]);
+          if (coordinatesPtr)
+          {
+            memcpy(coordinatesPtr + 3 * static_cast<vtkIdType>(id), vec, sizeof(vec));
+          }
+          else
+          {
+            points->SetPoint(id, vec[0], vec[1], vec[2]);
+          }
         }
       }
 
@@ -4437,8 +4729,6 @@ void vtkPEnSightGoldBinaryReader::GetVectorFromFloatBuffer(vtkIdType i, float* v
 //----------------------------------------------------------------------------
 void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
 {
-  long currentPosition = this->IFile->tellg();
-
   vtkIdType sizeToRead;
   if (this->FloatBufferIndexBegin + this->FloatBufferSize > this->FloatBufferNumberOfVectors)
   {
@@ -4449,6 +4739,33 @@ void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
     sizeToRead = this->FloatBufferSize;
   }
 
+  // With a mapped file, decode the three components straight from the file
+  // image, without moving the stream.
+  if (const vtkPEnSightMappedFile* mapping = vtkPEnSightGetMappedFile(this->IFile))
+  {
+    vtkIdType componentStride = this->FloatBufferNumberOfVectors * sizeof(float);
+    vtkIdType first = this->FloatBufferFilePosition + this->FloatBufferIndexBegin * sizeof(float);
+    if (this->Fortran)
+    {
+      componentStride += 8;
+      first += 4;
+    }
+    if (first < 0 || first + 2 * componentStride + sizeToRead * (vtkIdType)sizeof(float) >
+        static_cast<vtkIdType>(mapping->GetSize()))
+    {
+      vtkErrorMacro("Read failed");
+      return;
+    }
+    for (vtkIdType i = 0; i < 3; i++)
+    {
+      vtkPEnSightCopy4Range(mapping->GetData() + first + i * componentStride,
+        this->FloatBuffer[i], sizeToRead, this->ByteOrder == FILE_LITTLE_ENDIAN);
+    }
+    return;
+  }
+
+  long currentPosition = this->IFile->tellg();
+
   for (vtkIdType i = 0; i < 3; i++)
   {
     // We cannot use ReadFloatArray method, because Fortran format has dummy things
@@ -4474,14 +4791,8 @@ void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
       vtkErrorMacro("Read failed");
     }
 
-    if (this->ByteOrder == FILE_LITTLE_ENDIAN)
-    {
-      vtkByteSwap::Swap4LERange(this->FloatBuffer[i], sizeToRead);
-    }
-    else
-    {
-      vtkByteSwap::Swap4BERange(this->FloatBuffer[i], sizeToRead);
-    }
+    vtkPEnSightCopy4Range(this->FloatBuffer[i], this->FloatBuffer[i], sizeToRead,
+      this->ByteOrder == FILE_LITTLE_ENDIAN);
   }
 
   this->IFile->seekg(currentPosition);
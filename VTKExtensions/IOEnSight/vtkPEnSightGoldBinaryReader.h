@@ -46,6 +46,19 @@ public:
   vtkTypeMacro(vtkPEnSightGoldBinaryReader, vtkPEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  //@{
+  /**
+   * When enabled (default), binary files are memory mapped rather than read
+   * through a file stream. Mappings are shared by all readers of the process
+   * and seeks become free, which matters for the many small skips done while
+   * locating parts. Coordinates are then decoded straight from the file image
+   * into the output points. Falls back to stream I/O on platforms or files
+   * that cannot be mapped.
+   */
+  static void SetUseMemoryMappedFiles(bool use);
+  static bool GetUseMemoryMappedFiles();
+  //@}
+
 protected:
   vtkPEnSightGoldBinaryReader();
   ~vtkPEnSightGoldBinaryReader() override;
@@ -164,6 +177,12 @@ protected:
    */
   int ReadIntArray(int* result, int numInts);
 
+  /**
+   * Internal function to read in an integer array and add its values to
+   * `sum`, without keeping them. Returns zero if there was an error.
+   */
+  int SumIntArray(int numInts, int* sum);
+
   /**
    * Internal function to read in a float array.
    * Returns zero if there was an error.
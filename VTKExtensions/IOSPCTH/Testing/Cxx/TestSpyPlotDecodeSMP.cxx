@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSpyPlotDecodeSMP.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkSpyPlotUniReader, which decodes the cell field planes
+// concurrently, produces the same cell arrays as a serial decode.
+
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDummyController.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpyPlotReader.h"
+#include "vtkTestUtilities.h"
+
+#include <cstring>
+#include <vector>
+
+#define CHECK(cond)                                                                                \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: Condition FAILED!! : " << #cond << " (line " << __LINE__ << ")" << endl;       \
+    success = false;                                                                               \
+  }
+
+namespace
+{
+// Reads every cell array of `fname` with a new reader, so that nothing is
+// cached, and returns them block by block.
+std::vector<vtkSmartPointer<vtkDataArray> > ReadCellArrays(
+  const char* fname, vtkMultiProcessController* controller)
+{
+  vtkNew<vtkSpyPlotReader> reader;
+  reader->SetFileName(fname);
+  reader->SetGlobalController(controller);
+  reader->DownConvertVolumeFractionOn();
+  reader->DistributeFilesOn();
+  reader->UpdateInformation();
+  for (int array = 0; array < reader->GetNumberOfCellArrays(); ++array)
+  {
+    reader->SetCellArrayStatus(reader->GetCellArrayName(array), 1);
+  }
+  reader->Update();
+
+  std::vector<vtkSmartPointer<vtkDataArray> > arrays;
+  vtkCompositeDataSet* output = vtkCompositeDataSet::SafeDownCast(reader->GetOutputDataObject(0));
+  if (output == nullptr)
+  {
+    return arrays;
+  }
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(output->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    vtkCellData* cd = ds ? ds->GetCellData() : nullptr;
+    for (int cc = 0; cd && cc < cd->GetNumberOfArrays(); ++cc)
+    {
+      if (vtkDataArray* array = cd->GetArray(cc))
+      {
+        arrays.push_back(array);
+      }
+    }
+  }
+  return arrays;
+}
+}
+
+int TestSpyPlotDecodeSMP(int argc, char* argv[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  char* fname = vtkTestUtilities::ExpandDataFileName(
+    argc, argv, "Testing/Data/SPCTH/Dave_Karelitz_Small/spcth.0");
+
+  vtkSMPTools::Initialize(1);
+  auto expected = ReadCellArrays(fname, controller);
+  // 0 restores the default number of threads.
+  vtkSMPTools::Initialize(0);
+  auto actual = ReadCellArrays(fname, controller);
+  delete[] fname;
+
+  bool success = true;
+  CHECK(!expected.empty());
+  CHECK(expected.size() == actual.size());
+  for (size_t cc = 0; success && cc < expected.size(); ++cc)
+  {
+    vtkDataArray* a = expected[cc];
+    vtkDataArray* b = actual[cc];
+    CHECK(a->GetName() && b->GetName() && strcmp(a->GetName(), b->GetName()) == 0);
+    CHECK(a->GetDataType() == b->GetDataType());
+    CHECK(a->GetNumberOfComponents() == b->GetNumberOfComponents());
+    CHECK(a->GetNumberOfTuples() == b->GetNumberOfTuples());
+    // bitwise, so that NaN values compare equal.
+    CHECK(success &&
+      memcmp(a->GetVoidPointer(0), b->GetVoidPointer(0),
+        static_cast<size_t>(a->GetNumberOfValues()) * a->GetDataTypeSize()) == 0);
+    if (!success)
+    {
+      cerr << "ERROR: cell array " << cc << " differs from the serial decode." << endl;
+    }
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
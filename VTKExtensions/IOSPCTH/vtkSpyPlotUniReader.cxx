@@ -5,6 +5,8 @@
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkSpyPlotBlock.h"
 #include "vtkSpyPlotIStream.h"
 #include "vtkUnsignedCharArray.h"
@@ -12,6 +14,8 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/RegularExpression.hxx"
 
+#include <algorithm>
+#include <atomic>
 #include <sstream>
 #include <vector>
 
@@ -41,6 +45,140 @@ inline ostream& operator<<(ostream& os, const vtkSpyPlotWriteString& c)
   return os;
 }
 
+//-----------------------------------------------------------------------------
+/* Run-length decoding kernel. Each run starts with a byte: below 128, it is
+   the number of times the big-endian float that follows is repeated,
+   otherwise 128 plus the number of floats that follow verbatim. Repeated
+   values are expanded with std::fill_n and verbatim ones converted in a
+   single loop so that both can be vectorized. Returns false if the runs
+   overflow *in or *out; errors are not reported here so that planes can be
+   decoded from several threads. */
+namespace
+{
+template <class t>
+void vtkSpyPlotUniReaderDecodeValues(const unsigned char* in, int count, t* out, t scale)
+{
+  for (int k = 0; k < count; ++k)
+  {
+    float val;
+    memcpy(&val, in + 4 * k, sizeof(float));
+    vtkByteSwap::SwapBE(&val);
+    out[k] = static_cast<t>(val * scale);
+  }
+}
+
+// floats are never scaled.
+void vtkSpyPlotUniReaderDecodeValues(const unsigned char* in, int count, float* out, float)
+{
+  memcpy(out, in, count * sizeof(float));
+  vtkByteSwap::SwapBERange(out, static_cast<size_t>(count));
+}
+
+template <class t>
+bool vtkSpyPlotUniReaderRunLengthDecode(
+  const unsigned char* in, int inSize, t* out, int outSize, t scale)
+{
+  const unsigned char* inEnd = in + inSize;
+  t* outEnd = out + outSize;
+  while (out < outEnd && in < inEnd)
+  {
+    const int runLength = *in++;
+    if (runLength < 128)
+    {
+      if (inEnd - in < 4 || outEnd - out < runLength)
+      {
+        return false;
+      }
+      float val;
+      memcpy(&val, in, sizeof(float));
+      vtkByteSwap::SwapBE(&val);
+      in += 4;
+      out = std::fill_n(out, runLength, static_cast<t>(val * scale));
+    }
+    else
+    {
+      const int count = runLength - 128;
+      if (inEnd - in < 4 * count || outEnd - out < count)
+      {
+        return false;
+      }
+      vtkSpyPlotUniReaderDecodeValues(in, count, out, scale);
+      in += 4 * count;
+      out += count;
+    }
+  }
+  return true;
+}
+
+template <class t>
+int vtkSpyPlotUniReaderRunLengthDataDecode(
+  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale = 1)
+{
+  if (!vtkSpyPlotUniReaderRunLengthDecode(in, inSize, out, outSize, scale))
+  {
+    vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
+        << "Truncated data or too much data generated. Expected: " << outSize);
+    return 0;
+  }
+  return 1;
+}
+
+// Compressed planes of the cell fields of a time step. The planes are read
+// from the file first, then decoded concurrently.
+class vtkSpyPlotUniReaderPlaneDecoder
+{
+public:
+  struct Plane
+  {
+    size_t Offset; // in Buffer
+    int Size;
+    float* FloatOut;
+    unsigned char* UnsignedCharOut;
+    int OutSize;
+  };
+
+  std::vector<unsigned char> Buffer;
+  std::vector<Plane> Planes;
+  std::atomic<int> NumberOfFailures;
+
+  vtkSpyPlotUniReaderPlaneDecoder()
+    : NumberOfFailures(0)
+  {
+  }
+
+  unsigned char* AddPlane(int numBytes, float* floatOut, unsigned char* ucharOut, int outSize)
+  {
+    Plane plane = { this->Buffer.size(), numBytes, floatOut, ucharOut, outSize };
+    this->Planes.push_back(plane);
+    this->Buffer.resize(this->Buffer.size() + numBytes);
+    return this->Buffer.data() + plane.Offset;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const Plane& plane = this->Planes[cc];
+      const unsigned char* in = this->Buffer.data() + plane.Offset;
+      const bool decoded = plane.FloatOut
+        ? vtkSpyPlotUniReaderRunLengthDecode(in, plane.Size, plane.FloatOut, plane.OutSize, 1.0f)
+        : vtkSpyPlotUniReaderRunLengthDecode(in, plane.Size, plane.UnsignedCharOut,
+            plane.OutSize, static_cast<unsigned char>(255));
+      if (!decoded)
+      {
+        ++this->NumberOfFailures;
+      }
+    }
+  }
+
+  bool Decode()
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->Planes.size()), *this);
+    return this->NumberOfFailures == 0;
+  }
+};
+}
+
 //-----------------------------------------------------------------------------
 vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 {
@@ -328,6 +466,32 @@ int vtkSpyPlotUniReader::MakeCurrent()
   dump = this->CurrentTimeStep;
   dp = this->DataDumps + dump;
 
+  // Only the fields whose array status is enabled are read. Their compressed
+  // planes are read first and decoded all at once, across planes and fields,
+  // once the reads are done.
+  vtkSpyPlotUniReaderPlaneDecoder decoder;
+
+  // The new arrays are only stored in the variables once all their planes are
+  // decoded: on failure, the variables are left without data blocks so that
+  // the next update reads them again.
+  struct PendingBlock
+  {
+    vtkSpyPlotUniReader::Variable* Variable;
+    int BlockId;
+    vtkSmartPointer<vtkDataArray> Array;
+  };
+  std::vector<PendingBlock> pendingBlocks;
+  std::vector<vtkSpyPlotUniReader::Variable*> allocatedVariables;
+  auto discardAllocatedBlocks = [&allocatedVariables]() {
+    for (vtkSpyPlotUniReader::Variable* var : allocatedVariables)
+    {
+      delete[] var->DataBlocks;
+      var->DataBlocks = 0;
+      delete[] var->GhostCellsFixed;
+      var->GhostCellsFixed = 0;
+    }
+  };
+
   for (int fieldCnt = 0; fieldCnt < dp->NumVars; ++fieldCnt)
   {
     vtkSpyPlotUniReader::Variable* var = dp->Variables + fieldCnt;
@@ -376,6 +540,7 @@ int vtkSpyPlotUniReader::MakeCurrent()
       var->GhostCellsFixed = new int[dp->ActualNumberOfBlocks];
       memset(var->GhostCellsFixed, 0, dp->ActualNumberOfBlocks * sizeof(int));
       vtkDebugMacro(" Allocate DataBlocks: " << var->DataBlocks);
+      allocatedVariables.push_back(var);
       blocksExists = 0;
     }
 
@@ -400,18 +565,18 @@ int vtkSpyPlotUniReader::MakeCurrent()
       {
         vtkFloatArray* floatArray = 0;
         vtkUnsignedCharArray* unsignedCharArray = 0;
-        vtkDataArray* dataArray = 0;
+        vtkSmartPointer<vtkDataArray> dataArray;
         if (this->CellArraySelection->ArrayIsEnabled(var->Name) && !var->DataBlocks[actualBlockId])
         {
           if (this->DownConvertVolumeFraction && this->IsVolumeFraction(var))
           {
             unsignedCharArray = vtkUnsignedCharArray::New();
-            dataArray = unsignedCharArray;
+            dataArray.TakeReference(unsignedCharArray);
           }
           else
           {
             floatArray = vtkFloatArray::New();
-            dataArray = floatArray;
+            dataArray.TakeReference(floatArray);
           }
           dataArray->SetNumberOfComponents(1);
           dataArray->SetNumberOfTuples(
@@ -429,47 +594,56 @@ int vtkSpyPlotUniReader::MakeCurrent()
           if (!spis.ReadInt32s(&numBytes, 1))
           {
             vtkErrorMacro("Problem reading the number of bytes");
+            discardAllocatedBlocks();
             return 0;
           }
-          if (static_cast<int>(arrayBuffer.size()) < numBytes)
+          if (numBytes < 0)
           {
-            arrayBuffer.resize(numBytes);
-          }
-          if (!spis.ReadString(&*arrayBuffer.begin(), numBytes))
-          {
-            vtkErrorMacro("Problem reading the bytes");
+            vtkErrorMacro("Invalid number of bytes: " << numBytes);
+            discardAllocatedBlocks();
             return 0;
           }
-          if (floatArray)
+          if (!dataArray)
           {
-            float* ptr = floatArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding float data array");
-              return 0;
-            }
+            spis.Seek(numBytes, true);
+            continue;
           }
-          if (unsignedCharArray)
+          float* floatPtr = floatArray ? floatArray->GetPointer(zax * planeSize) : nullptr;
+          unsigned char* ucharPtr =
+            unsignedCharArray ? unsignedCharArray->GetPointer(zax * planeSize) : nullptr;
+          unsigned char* bytes = decoder.AddPlane(numBytes, floatPtr, ucharPtr, planeSize);
+          if (numBytes > 0 && !spis.ReadString(bytes, numBytes))
           {
-            unsigned char* ptr = unsignedCharArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding unsigned char data array");
-              return 0;
-            }
+            vtkErrorMacro("Problem reading the bytes");
+            discardAllocatedBlocks();
+            return 0;
           }
         }
         if (dataArray)
         {
-          var->DataBlocks[actualBlockId] = dataArray;
-          var->GhostCellsFixed[actualBlockId] = 0;
-          vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
+          PendingBlock pending = { var, actualBlockId, dataArray };
+          pendingBlocks.push_back(pending);
           actualBlockId++;
         }
       }
     }
   }
 
+  if (!decoder.Decode())
+  {
+    vtkErrorMacro("Problem RLD decoding " << decoder.NumberOfFailures << " data array planes");
+    discardAllocatedBlocks();
+    return 0;
+  }
+  for (const PendingBlock& pending : pendingBlocks)
+  {
+    // DataBlocks own their arrays.
+    pending.Array->Register(nullptr);
+    pending.Variable->DataBlocks[pending.BlockId] = pending.Array;
+    pending.Variable->GhostCellsFixed[pending.BlockId] = 0;
+    vtkDebugMacro(" " << pending.Array << " initialized: " << pending.Array->GetName());
+  }
+
   if (blocksUpdated && needMarkers)
   {
     if (this->ReadMarkerDumps(&spis) == 0)
@@ -664,67 +838,6 @@ void vtkSpyPlotUniReader::PrintInformation()
    to provide allocated space for *data which will be
    n bytes long. */
 
-//-----------------------------------------------------------------------------
-template <class t>
-int vtkSpyPlotUniReaderRunLengthDataDecode(
-  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale = 1)
-{
-  int outIndex = 0, inIndex = 0;
-
-  const unsigned char* ptmp = in;
-
-  /* Run-length decode */
-  while ((outIndex < outSize) && (inIndex < inSize))
-  {
-    // Okay get the run length
-    unsigned char runLength = *ptmp;
-    ptmp++;
-    if (runLength < 128)
-    {
-      float val;
-      memcpy(&val, ptmp, sizeof(float));
-      vtkByteSwap::SwapBE(&val);
-      ptmp += 4;
-      // Now populate the out data
-      int k;
-      for (k = 0; k < runLength; ++k)
-      {
-        if (outIndex >= outSize)
-        {
-          vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
-              << "Too much data generated. Expected: " << outSize);
-          return 0;
-        }
-        out[outIndex] = static_cast<t>(val * scale);
-        outIndex++;
-      }
-      inIndex += 5;
-    }
-    else // runLength >= 128
-    {
-      int k;
-      for (k = 0; k < runLength - 128; ++k)
-      {
-        if (outIndex >= outSize)
-        {
-          vtkErrorWithObjectMacro(self, "Problem doing RLD decode. "
-              << "Too much data generated. Expected: " << outSize);
-          return 0;
-        }
-        float val;
-        memcpy(&val, ptmp, sizeof(float));
-        vtkByteSwap::SwapBE(&val);
-        out[outIndex] = static_cast<t>(val * scale);
-        outIndex++;
-        ptmp += 4;
-      }
-      inIndex += 4 * (runLength - 128) + 1;
-    }
-  } // while
-
-  return 1;
-}
-
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::RunLengthDataDecode(
   const unsigned char* in, int inSize, float* out, int outSize)
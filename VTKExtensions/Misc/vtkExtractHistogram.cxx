@@ -14,9 +14,11 @@
 =========================================================================*/
 #include "vtkExtractHistogram.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkGraph.h"
@@ -27,12 +29,19 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
 #include <map>
 #include <string>
+#include <thread>
 #include <vector>
 
 struct vtkEHInternals
@@ -43,9 +52,14 @@ struct vtkEHInternals
   }
   struct ArrayValuesType
   {
-    // The total of the values per bin - the second vector
-    // is for arrays with multiple components
-    std::vector<std::vector<double> > TotalValues;
+    ArrayValuesType()
+      : NumberOfComponents(0)
+    {
+    }
+    int NumberOfComponents;
+    // The total of the values per bin, stored as BinCount tuples of
+    // NumberOfComponents values.
+    std::vector<double> TotalValues;
   };
   typedef std::map<std::string, ArrayValuesType> ArrayMapType;
   ArrayMapType ArrayValues;
@@ -283,6 +297,220 @@ inline int vtkExtractHistogramClamp(int value, int min, int max)
   return value;
 }
 
+namespace
+{
+// Number of tuples processed at once by the binning kernel. Values and bin
+// indices of a block are computed in tight loops the compiler can vectorize
+// before the bins are incremented.
+const vtkIdType vtkEHBlockSize = 1024;
+
+// An array whose values are totaled per bin when CalculateAverages is on.
+struct vtkEHAveragedArray
+{
+  vtkDataArray* Array;
+  int NumberOfComponents;
+  std::vector<double>* TotalValues;
+};
+
+// Adds the tuples of a block to the totals of the bins they fall in.
+struct vtkEHAccumulateWorker
+{
+  const int* Bins;
+  vtkIdType Begin;
+  vtkIdType End;
+  int NumberOfComponents;
+  double* TotalValues;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array) const
+  {
+    vtkDataArrayAccessor<ArrayT> accessor(array);
+    const int numComps = this->NumberOfComponents;
+    for (vtkIdType tuple = this->Begin; tuple < this->End; ++tuple)
+    {
+      double* totals = this->TotalValues + this->Bins[tuple - this->Begin] * numComps;
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        totals[comp] += static_cast<double>(accessor.Get(tuple, comp));
+      }
+    }
+  }
+};
+
+struct vtkEHLocalBins
+{
+  std::vector<vtkIdType> Counts;
+  std::vector<std::vector<double> > TotalValues;
+};
+
+// Bins the tuples of an array using per-thread bins that are merged in
+// Reduce(). Progress is only reported from the thread that created the
+// functor, since observers of ProgressEvent expect to be called from it.
+template <typename ArrayT>
+class vtkEHBinningFunctor
+{
+public:
+  vtkEHBinningFunctor(ArrayT* array, int component, int binCount, double min, double shift,
+    double delta, const std::vector<vtkEHAveragedArray>& averaged, vtkExtractHistogram* self)
+    : Array(array)
+    , Component(component)
+    , BinCount(binCount)
+    , Min(min)
+    , Shift(shift)
+    , Delta(delta)
+    , Averaged(averaged)
+    , Self(self)
+    , Counts(binCount, 0)
+    , CallingThread(std::this_thread::get_id())
+  {
+    this->ProcessedTuples = 0;
+  }
+
+  void Initialize()
+  {
+    vtkEHLocalBins& local = this->Local.Local();
+    local.Counts.assign(this->BinCount, 0);
+    local.TotalValues.resize(this->Averaged.size());
+    for (size_t cc = 0; cc < this->Averaged.size(); ++cc)
+    {
+      local.TotalValues[cc].assign(
+        static_cast<size_t>(this->BinCount) * this->Averaged[cc].NumberOfComponents, 0.0);
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkEHLocalBins& local = this->Local.Local();
+    const bool reportProgress = std::this_thread::get_id() == this->CallingThread;
+
+    vtkDataArrayAccessor<ArrayT> accessor(this->Array);
+    const int numComps = this->Array->GetNumberOfComponents();
+    // if component is equal to the number of components, then the magnitude
+    // was requested.
+    const bool magnitude = (this->Component == numComps);
+    const double numTuples = static_cast<double>(this->Array->GetNumberOfTuples());
+
+    double values[vtkEHBlockSize];
+    int bins[vtkEHBlockSize];
+    for (vtkIdType blockBegin = begin; blockBegin < end; blockBegin += vtkEHBlockSize)
+    {
+      const vtkIdType blockEnd = std::min(blockBegin + vtkEHBlockSize, end);
+      const vtkIdType blockSize = blockEnd - blockBegin;
+      if (magnitude)
+      {
+        std::fill(values, values + blockSize, 0.0);
+        for (int comp = 0; comp < numComps; ++comp)
+        {
+          for (vtkIdType cc = 0; cc < blockSize; ++cc)
+          {
+            const double value = static_cast<double>(accessor.Get(blockBegin + cc, comp));
+            values[cc] += value * value;
+          }
+        }
+        for (vtkIdType cc = 0; cc < blockSize; ++cc)
+        {
+          values[cc] = std::sqrt(values[cc]);
+        }
+      }
+      else
+      {
+        for (vtkIdType cc = 0; cc < blockSize; ++cc)
+        {
+          values[cc] = static_cast<double>(accessor.Get(blockBegin + cc, this->Component));
+        }
+      }
+
+      // If the value is equal to max, include it in the last bin.
+      for (vtkIdType cc = 0; cc < blockSize; ++cc)
+      {
+        const int index = static_cast<int>((values[cc] - this->Min + this->Shift) / this->Delta);
+        bins[cc] = ::vtkExtractHistogramClamp(index, 0, this->BinCount - 1);
+      }
+      for (vtkIdType cc = 0; cc < blockSize; ++cc)
+      {
+        ++local.Counts[bins[cc]];
+      }
+
+      for (size_t cc = 0; cc < this->Averaged.size(); ++cc)
+      {
+        vtkEHAccumulateWorker worker = { bins, blockBegin, blockEnd,
+          this->Averaged[cc].NumberOfComponents, local.TotalValues[cc].data() };
+        if (!vtkArrayDispatch::Dispatch::Execute(this->Averaged[cc].Array, worker))
+        {
+          worker(this->Averaged[cc].Array);
+        }
+      }
+
+      const vtkIdType processed = (this->ProcessedTuples += blockSize);
+      if (reportProgress)
+      {
+        this->Self->UpdateProgress(0.10 + 0.90 * processed / numTuples);
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    for (const vtkEHLocalBins& local : this->Local)
+    {
+      for (int cc = 0; cc < this->BinCount; ++cc)
+      {
+        this->Counts[cc] += local.Counts[cc];
+      }
+      for (size_t cc = 0; cc < this->Averaged.size(); ++cc)
+      {
+        std::vector<double>& totals = *this->Averaged[cc].TotalValues;
+        std::transform(totals.begin(), totals.end(), local.TotalValues[cc].begin(),
+          totals.begin(), std::plus<double>());
+      }
+    }
+  }
+
+  const std::vector<vtkIdType>& GetCounts() const { return this->Counts; }
+
+private:
+  ArrayT* Array;
+  int Component;
+  int BinCount;
+  double Min;
+  double Shift;
+  double Delta;
+  const std::vector<vtkEHAveragedArray>& Averaged;
+  vtkExtractHistogram* Self;
+  std::vector<vtkIdType> Counts;
+  std::thread::id CallingThread;
+  std::atomic<vtkIdType> ProcessedTuples;
+  vtkSMPThreadLocal<vtkEHLocalBins> Local;
+};
+
+struct vtkEHBinningWorker
+{
+  int Component;
+  int BinCount;
+  double Min;
+  double Shift;
+  double Delta;
+  const std::vector<vtkEHAveragedArray>* Averaged;
+  vtkExtractHistogram* Self;
+  vtkIntArray* BinValues;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array) const
+  {
+    vtkEHBinningFunctor<ArrayT> functor(array, this->Component, this->BinCount, this->Min,
+      this->Shift, this->Delta, *this->Averaged, this->Self);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), functor);
+
+    const std::vector<vtkIdType>& counts = functor.GetCounts();
+    for (int cc = 0; cc < this->BinCount; ++cc)
+    {
+      this->BinValues->SetValue(
+        cc, this->BinValues->GetValue(cc) + static_cast<int>(counts[cc]));
+    }
+  }
+};
+}
+
 //-----------------------------------------------------------------------------
 void vtkExtractHistogram::BinAnArray(
   vtkDataArray* data_array, vtkIntArray* bin_values, double min, double max, vtkFieldData* field)
@@ -295,66 +523,54 @@ void vtkExtractHistogram::BinAnArray(
     return;
   }
 
-  int num_of_tuples = data_array->GetNumberOfTuples();
+  vtkIdType num_of_tuples = data_array->GetNumberOfTuples();
+  if (num_of_tuples == 0)
+  {
+    return;
+  }
+
   double bin_delta =
     (max - min) / (this->CenterBinsAroundMinAndMax ? (this->BinCount - 1) : this->BinCount);
   double half_delta = bin_delta / 2.0;
 
-  for (int i = 0; i != num_of_tuples; ++i)
+  // Look up the arrays to average once, rather than for every tuple. For
+  // each bin, we accumulate the total of each array; at the end, each total is
+  // divided by the number of elements in the bin.
+  std::vector<vtkEHAveragedArray> averaged;
+  if (this->CalculateAverages && field)
   {
-    if (i % 1000 == 0)
+    int num_arrays = field->GetNumberOfArrays();
+    for (int idx = 0; idx < num_arrays; idx++)
     {
-      this->UpdateProgress(0.10 + 0.90 * i / num_of_tuples);
-    }
-    double value;
-    // if component is equal to the number of components, then the magnitude was requested.
-    if (this->Component == data_array->GetNumberOfComponents())
-    {
-      value = 0;
-      double comp;
-      for (int j = 0; j < data_array->GetNumberOfComponents(); ++j)
+      vtkDataArray* array = field->GetArray(idx);
+      if (array && array != data_array && array->GetName() &&
+        array->GetNumberOfTuples() >= num_of_tuples)
       {
-        comp = data_array->GetComponent(i, j);
-        value += comp * comp;
-      }
-      value = sqrt(value);
-    }
-    else
-    {
-      value = data_array->GetComponent(i, this->Component);
-    }
-    int index = static_cast<int>(
-      (value - min + (this->CenterBinsAroundMinAndMax ? half_delta : 0.)) / bin_delta);
-
-    // If the value is equal to max, include it in the last bin.
-    index = ::vtkExtractHistogramClamp(index, 0, this->BinCount - 1);
-    bin_values->SetValue(index, bin_values->GetValue(index) + 1);
-
-    if (this->CalculateAverages)
-    {
-      // Get all other arrays, add their value to the bin
-      // For each bin, we will need 2 values per array ->
-      // total, num. elements
-      // at the end, divide each total by num. elements
-      int num_arrays = field->GetNumberOfArrays();
-      for (int idx = 0; idx < num_arrays; idx++)
-      {
-        vtkDataArray* array = field->GetArray(idx);
-        if (array && array != data_array && array->GetName())
+        vtkEHInternals::ArrayValuesType& arrayValues =
+          this->Internal->ArrayValues[array->GetName()];
+        int numComps = array->GetNumberOfComponents();
+        if (arrayValues.TotalValues.empty())
         {
-          vtkEHInternals::ArrayValuesType& arrayValues =
-            this->Internal->ArrayValues[array->GetName()];
-          arrayValues.TotalValues.resize(this->BinCount);
-          int numComps = array->GetNumberOfComponents();
-          arrayValues.TotalValues[index].resize(numComps);
-          for (int comp = 0; comp < numComps; comp++)
-          {
-            arrayValues.TotalValues[index][comp] += array->GetComponent(i, comp);
-          }
+          arrayValues.NumberOfComponents = numComps;
+          arrayValues.TotalValues.assign(static_cast<size_t>(this->BinCount) * numComps, 0.0);
+        }
+        else if (arrayValues.NumberOfComponents != numComps)
+        {
+          // Blocks disagree on the number of components; skip this block's
+          // values rather than mixing them up.
+          continue;
         }
+        averaged.push_back(vtkEHAveragedArray{ array, numComps, &arrayValues.TotalValues });
       }
     }
   }
+
+  vtkEHBinningWorker worker = { this->Component, this->BinCount, min,
+    (this->CenterBinsAroundMinAndMax ? half_delta : 0.), bin_delta, &averaged, this, bin_values };
+  if (!vtkArrayDispatch::Dispatch::Execute(data_array, worker))
+  {
+    worker(data_array);
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -434,7 +650,7 @@ int vtkExtractHistogram::RequestData(vtkInformation* /*request*/,
       vtkSmartPointer<vtkDoubleArray> aa = vtkSmartPointer<vtkDoubleArray>::New();
       std::string newname2 = iter->first + "_average";
       aa->SetName(newname2.c_str());
-      int numComps = static_cast<int>(iter->second.TotalValues[0].size());
+      int numComps = iter->second.NumberOfComponents;
       da->SetNumberOfComponents(numComps);
       da->SetNumberOfTuples(this->BinCount);
       aa->SetNumberOfComponents(numComps);
@@ -443,22 +659,14 @@ int vtkExtractHistogram::RequestData(vtkInformation* /*request*/,
       {
         for (int j = 0; j < numComps; j++)
         {
-          if (iter->second.TotalValues[i].size() == (unsigned int)numComps)
+          double total = iter->second.TotalValues[i * numComps + j];
+          da->SetValue(i * numComps + j, total);
+          if (bin_values->GetValue(i))
           {
-            da->SetValue(i * numComps + j, iter->second.TotalValues[i][j]);
-            if (bin_values->GetValue(i))
-            {
-              aa->SetValue(
-                i * numComps + j, iter->second.TotalValues[i][j] / bin_values->GetValue(i));
-            }
-            else
-            {
-              aa->SetValue(i * numComps + j, 0);
-            }
+            aa->SetValue(i * numComps + j, total / bin_values->GetValue(i));
           }
           else
           {
-            da->SetValue(i * numComps + j, 0);
             aa->SetValue(i * numComps + j, 0);
           }
         }